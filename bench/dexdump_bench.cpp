@@ -0,0 +1,1497 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/Adler32.h"
+#include "core/CpuFeatures.h"
+#include "core/DexContext.h"
+#include "core/DexDump.h"
+#include "core/DexGenerator.h"
+#include "core/DexReader.h"
+#include "core/PhaseStats.h"
+#include "core/Sha1.h"
+#include "core/ThreadPool.h"
+#include "formatter/ClassPrint.h"
+#include "formatter/CodePrint.h"
+#include "formatter/FieldPrint.h"
+#include "formatter/HeaderPrint.h"
+#include "formatter/JsonWriter.h"
+#include "formatter/MethodPrint.h"
+#include "formatter/OrderedRender.h"
+#include "formatter/OutputSink.h"
+#include "formatter/ProtoPrint.h"
+#include "formatter/StringPrint.h"
+#include "formatter/TypePrint.h"
+#include "log/log.h"
+#include "parser/CodeParser.h"
+#include "parser/OperandFormat.h"
+
+namespace
+{
+    // 基准测试参数
+    struct BenchOptions {
+        size_t syntheticSize = 50u << 20;  // 合成数据大小（字节）
+        uint32_t threadCount = 0;          // 线程数，0表示默认
+        uint32_t warmup = 2;               // 每项的预热次数
+        uint32_t repetitions = 20;         // 重复次数
+        std::string filter;                // 只运行名称包含该文本的测试组
+        std::string jsonPath;              // JSON结果输出路径
+        std::vector<std::string> datasets; // DEX数据集目录
+        std::vector<std::string> files;    // 额外的DEX文件
+        uint32_t generateClasses = 0;      // 合成DEX数据集的类数量，0表示不生成
+    };
+
+    // 单项测试结果（毫秒）
+    struct BenchResult {
+        double minMs = 0;
+        double meanMs = 0;
+        double medianMs = 0;
+        double p90Ms = 0;
+        double p99Ms = 0;
+        double maxMs = 0;
+    };
+
+    // 一项测试的记录，用于JSON输出
+    struct BenchRecord {
+        std::string group;
+        std::string dataset;
+        std::string name;
+        uint64_t bytes;
+        uint64_t items;
+        uint32_t samples;
+        BenchResult result;
+    };
+
+    // 当前测试组和数据集，report()记录到这里
+    struct BenchState {
+        std::string group;
+        std::string dataset;
+        uint32_t samples = 0;
+        std::vector<BenchRecord> records;
+    };
+
+    BenchState& benchState()
+    {
+        static BenchState state;
+        return state;
+    }
+
+    // 开始一个测试组，之后的report()归入该组
+    void beginGroup(const char* group, const std::string& dataset)
+    {
+        benchState().group = group;
+        benchState().dataset = dataset;
+    }
+
+    // 是否运行该测试组
+    bool selected(const BenchOptions& options, const char* group)
+    {
+        return options.filter.empty() || std::string_view(group).find(options.filter) != std::string_view::npos;
+    }
+
+    // 最近秩法的百分位数，samples已排序
+    double percentile(const std::vector<double>& samples, double p)
+    {
+        const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(samples.size())));
+        return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+    }
+
+    BenchResult summarize(std::vector<double>& samples)
+    {
+        std::sort(samples.begin(), samples.end());
+        BenchResult result;
+        result.minMs = samples.front();
+        result.maxMs = samples.back();
+        result.medianMs = percentile(samples, 50);
+        result.p90Ms = percentile(samples, 90);
+        result.p99Ms = percentile(samples, 99);
+        double sum = 0;
+        for (const double sample : samples)
+        {
+            sum += sample;
+        }
+        result.meanMs = sum / static_cast<double>(samples.size());
+        benchState().samples = static_cast<uint32_t>(samples.size());
+        return result;
+    }
+
+    /**
+     * 先预热，再重复计时
+     * @param setup 每次计时前调用，不计入耗时，可以为空
+     */
+    BenchResult measure(const BenchOptions& options, uint32_t repetitions, const std::function<void()>& setup,
+                        const std::function<void()>& fn)
+    {
+        for (uint32_t i = 0; i < options.warmup; i++)
+        {
+            if (setup)
+            {
+                setup();
+            }
+            fn();
+        }
+
+        std::vector<double> samples;
+        samples.reserve(repetitions);
+        for (uint32_t i = 0; i < repetitions; i++)
+        {
+            if (setup)
+            {
+                setup();
+            }
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return summarize(samples);
+    }
+
+    BenchResult measure(const BenchOptions& options, uint32_t repetitions, const std::function<void()>& fn)
+    {
+        return measure(options, repetitions, nullptr, fn);
+    }
+
+    /**
+     * 输出并记录一项结果，吞吐量按中位数计算
+     * @param bytes 每次处理的字节数，为0时不输出字节吞吐量
+     * @param items 每次处理的条目数，为0时不输出条目吞吐量
+     */
+    void report(const char* name, size_t bytes, const BenchResult& result, uint64_t items = 0)
+    {
+        const double seconds = result.medianMs / 1000.0;
+        printf("  %-28s %10.3f ms (min %8.3f, p90 %8.3f, p99 %8.3f)", name, result.medianMs, result.minMs,
+               result.p90Ms, result.p99Ms);
+        if (bytes > 0)
+        {
+            printf("  %8.2f GB/s", static_cast<double>(bytes) / seconds / 1e9);
+        }
+        if (items > 0)
+        {
+            printf("  %8.2f M/s", static_cast<double>(items) / seconds / 1e6);
+        }
+        printf("\n");
+
+        BenchState& state = benchState();
+        state.records.push_back({state.group, state.dataset, name, bytes, items, state.samples, result});
+    }
+
+    // 逐字节参考实现，作为对比基线
+    uint32_t adler32Reference(const uint8_t* data, size_t size)
+    {
+        uint32_t s1 = 1;
+        uint32_t s2 = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            s1 = (s1 + data[i]) % 65521;
+            s2 = (s2 + s1) % 65521;
+        }
+        return (s2 << 16) | s1;
+    }
+
+    void benchAdler32(const char* label, const uint8_t* data, size_t size, const BenchOptions& options)
+    {
+        beginGroup("adler32", label);
+        printf("\n[adler32] %s, %zu 字节\n", label, size);
+
+        volatile uint32_t sink = 0;
+        const uint32_t expected = adler32Reference(data, size);
+
+        report("reference (bytewise)", size, measure(options, std::max(1u, options.repetitions / 4), [&]()
+        {
+            sink = adler32Reference(data, size);
+        }));
+        report(dex::cpuHasAvx2() ? "adler32 (avx2)" : "adler32 (scalar)", size, measure(options, options.repetitions, [&]()
+        {
+            sink = dex::adler32(1, data, size);
+        }));
+        report("adler32Parallel", size, measure(options, options.repetitions, [&]()
+        {
+            sink = dex::adler32Parallel(data, size, options.threadCount);
+        }));
+
+        if (dex::adler32(1, data, size) != expected || dex::adler32Parallel(data, size, options.threadCount) != expected)
+        {
+            printf("  错误: 校验和结果与参考实现不一致\n");
+        }
+        (void)sink;
+    }
+
+    void benchSha1(const char* label, const uint8_t* data, size_t size, const BenchOptions& options)
+    {
+        beginGroup("sha1", label);
+        printf("\n[sha1] %s, %zu 字节\n", label, size);
+
+        volatile uint8_t sink = 0;
+        report(dex::Sha1::isAccelerated() ? "sha1 (sha-ni)" : "sha1 (scalar)", size, measure(options, options.repetitions, [&]()
+        {
+            sink = dex::Sha1::hash(data, size)[0];
+        }));
+
+        // 流式输入：按4KB分段追加，结果必须与一次性计算相同
+        const dex::Sha1Digest expected = dex::Sha1::hash(data, size);
+        dex::Sha1Digest streamed{};
+        report("sha1 (4 KB updates)", size, measure(options, options.repetitions, [&]()
+        {
+            dex::Sha1 sha1;
+            for (size_t offset = 0; offset < size; offset += 4096)
+            {
+                sha1.update(data + offset, std::min<size_t>(4096, size - offset));
+            }
+            streamed = sha1.finish();
+        }));
+
+        if (streamed != expected)
+        {
+            printf("  错误: 流式计算结果与一次性计算不一致\n");
+        }
+        (void)sink;
+    }
+
+    // 写入ULEB128/SLEB128编码的数值
+    void writeULEB128(std::vector<uint8_t>& out, uint32_t value)
+    {
+        do
+        {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            out.push_back(value != 0 ? (byte | 0x80) : byte);
+        }
+        while (value != 0);
+    }
+
+    void writeSLEB128(std::vector<uint8_t>& out, int32_t value)
+    {
+        while (true)
+        {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            if ((value == 0 && !(byte & 0x40)) || (value == -1 && (byte & 0x40)))
+            {
+                out.push_back(byte);
+                return;
+            }
+            out.push_back(byte | 0x80);
+        }
+    }
+
+    // 按(ULEB128, SLEB128)对解码整个数据流，与class_data、调试信息的读取模式相同
+    template <bool Checked>
+    uint64_t decodeLebPairs(const uint8_t* data, size_t size, size_t pairCount)
+    {
+        dex::DexReader<Checked> reader(data, size);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < pairCount; i++)
+        {
+            sum += reader.readULEB128();
+            sum += static_cast<uint32_t>(reader.readSLEB128());
+        }
+        return reader.ok() ? sum : 0;
+    }
+
+    void benchReader(size_t size, const BenchOptions& options)
+    {
+        // 数值分布接近真实DEX：大多数为1字节的小增量，少量为多字节的偏移量
+        std::vector<uint8_t> stream;
+        stream.reserve(size + 16);
+        std::mt19937 rng(54321);
+        size_t pairCount = 0;
+        while (stream.size() < size)
+        {
+            const uint32_t r = rng();
+            writeULEB128(stream, (r & 7) != 0 ? (r >> 8) & 0x7F : r >> 4);
+            writeSLEB128(stream, (r & 0x30) != 0 ? static_cast<int32_t>((r >> 16) & 0x3F) - 32 : static_cast<int32_t>(r));
+            pairCount++;
+        }
+
+        beginGroup("reader", "synthetic");
+        printf("\n[reader] ULEB128/SLEB128数据流, %zu 字节, %zu 对\n", stream.size(), pairCount);
+
+        volatile uint64_t sink = 0;
+        const uint64_t expected = decodeLebPairs<false>(stream.data(), stream.size(), pairCount);
+        report("DexReader<true> (checked)", stream.size(), measure(options, options.repetitions, [&]()
+        {
+            sink = decodeLebPairs<true>(stream.data(), stream.size(), pairCount);
+        }));
+        report("DexReader<false> (unchecked)", stream.size(), measure(options, options.repetitions, [&]()
+        {
+            sink = decodeLebPairs<false>(stream.data(), stream.size(), pairCount);
+        }));
+
+        if (decodeLebPairs<true>(stream.data(), stream.size(), pairCount) != expected)
+        {
+            printf("  错误: 两种模式的解码结果不一致\n");
+        }
+        (void)sink;
+    }
+
+    // 输出测试用的一行表格数据，字段与StringPrint、CodePrint的行相同
+    struct OutputRow {
+        uint32_t index;
+        uint32_t offset;
+        uint32_t length;
+        std::string mnemonic;
+        std::string text;
+    };
+
+    // printf路径：与格式化器原来的逐行输出方式相同
+    void writeRowsPrintf(FILE* file, const std::vector<OutputRow>& rows)
+    {
+        for (const OutputRow& row : rows)
+        {
+            fprintf(file, "| %4u | 0x%12X | %-29s |\n", row.index, row.offset, row.text.c_str());
+            fprintf(file, "| 0x%04X | %-5u | %-18s | %-33s |\n", row.index * 2, row.length, row.mnemonic.c_str(), row.text.c_str());
+        }
+        fflush(file);
+    }
+
+    // OutputSink路径：与格式化器现在的输出方式相同
+    void writeRowsSink(dex::print::OutputSink& out, const std::vector<OutputRow>& rows)
+    {
+        for (const OutputRow& row : rows)
+        {
+            out.write("| ");
+            out.writeDec(row.index, 4);
+            out.write(" | 0x");
+            out.writeHex(row.offset, 12, ' ');
+            out.write(" | ");
+            out.writePadded(row.text, 29);
+            out.write(" |\n| 0x");
+            out.writeHex(row.index * 2, 4);
+            out.write(" | ");
+            out.writeDec(row.length, -5);
+            out.write(" | ");
+            out.writePadded(row.mnemonic, 18);
+            out.write(" | ");
+            out.writePadded(row.text, 33);
+            out.write(" |\n");
+        }
+        out.flush();
+    }
+
+    void benchOutput(const BenchOptions& options)
+    {
+        static const char* const kMnemonics[] = {"invoke-virtual", "const-string", "iget-object", "move-result", "return-void"};
+
+        std::vector<OutputRow> rows(200000);
+        std::mt19937 rng(777);
+        for (uint32_t i = 0; i < rows.size(); i++)
+        {
+            const uint32_t r = rng();
+            rows[i] = {i, r, 1 + (r & 3), kMnemonics[r % 5], "Lcom/example/C" + std::to_string(r % 100000) + ";"};
+        }
+
+        // 先在内存中生成一份，检查两种路径的输出逐字节一致
+        dex::print::MemorySink memory;
+        writeRowsSink(memory, rows);
+        const size_t bytes = memory.str().size();
+
+        beginGroup("output", "synthetic");
+        printf("\n[output] 表格行输出, %zu 行, %zu 字节\n", rows.size() * 2, bytes);
+
+        FILE* file = tmpfile();
+        if (file == nullptr)
+        {
+            printf("  错误: 无法创建临时文件\n");
+            return;
+        }
+        writeRowsPrintf(file, rows);
+        std::string expected(bytes, '\0');
+        rewind(file);
+        if (fread(expected.data(), 1, bytes, file) != bytes || expected != memory.str())
+        {
+            printf("  错误: OutputSink输出与printf不一致\n");
+        }
+
+        report("fprintf per row", bytes, measure(options, options.repetitions, [&]()
+        {
+            rewind(file);
+            writeRowsPrintf(file, rows);
+        }));
+        dex::print::FileSink fileSink(file);
+        report("FileSink", bytes, measure(options, options.repetitions, [&]()
+        {
+            rewind(file);
+            writeRowsSink(fileSink, rows);
+        }));
+        report("MemorySink", bytes, measure(options, options.repetitions, [&]()
+        {
+            memory.clear();
+            writeRowsSink(memory, rows);
+        }));
+        fclose(file);
+    }
+
+    void benchOrderedRender(const BenchOptions& options)
+    {
+        static const char* const kMnemonics[] = {"invoke-virtual", "const-string", "iget-object", "move-result", "return-void"};
+        static constexpr size_t kRowsPerChunk = 64;
+
+        std::vector<OutputRow> rows(200000);
+        std::mt19937 rng(4242);
+        for (uint32_t i = 0; i < rows.size(); i++)
+        {
+            const uint32_t r = rng();
+            rows[i] = {i, r, 1 + (r & 3), kMnemonics[r % 5], "Lcom/example/C" + std::to_string(r % 100000) + ";"};
+        }
+
+        // 每行按类详情的方式用printf格式化，模拟ClassPrint/CodePrint的渲染开销
+        auto render = [&](dex::print::OutputSink& out, size_t, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const OutputRow& row = rows[i];
+                out.printf("\n[%u] %s\n  访问标志: 0x%08X\n  [%u] %s %s (代码偏移量: 0x%08X)\n",
+                           row.index, row.text.c_str(), row.offset, row.length, row.mnemonic.c_str(), row.text.c_str(), row.offset);
+            }
+        };
+
+        const uint32_t threadCount = options.threadCount == 0 ? dex::getDefaultThreadCount() : options.threadCount;
+        dex::print::MemorySink serial;
+        dex::print::renderOrdered(serial, rows.size(), kRowsPerChunk, 1, render);
+        dex::print::MemorySink parallel;
+        dex::print::renderOrdered(parallel, rows.size(), kRowsPerChunk, threadCount, render);
+        const size_t bytes = serial.str().size();
+
+        beginGroup("render", "synthetic");
+        printf("\n[render] 按块并行渲染, %zu 行, %zu 字节, %u 线程\n", rows.size(), bytes, threadCount);
+        if (parallel.str() != serial.str())
+        {
+            printf("  错误: 并行渲染输出与单线程不一致\n");
+        }
+
+        report("1 thread", bytes, measure(options, options.repetitions, [&]()
+        {
+            serial.clear();
+            dex::print::renderOrdered(serial, rows.size(), kRowsPerChunk, 1, render);
+        }));
+        report("renderOrdered", bytes, measure(options, options.repetitions, [&]()
+        {
+            parallel.clear();
+            dex::print::renderOrdered(parallel, rows.size(), kRowsPerChunk, threadCount, render);
+        }));
+    }
+
+    // 生成常见格式的解码后指令，分布接近真实代码：寄存器操作和方法调用占多数
+    std::vector<std::pair<dex::parser::DecodedInstruction, uint32_t>> makeInstructions(size_t count)
+    {
+        using dex::parser::IndexType;
+        struct Shape {
+            uint16_t opcode;
+            dex::parser::DalvikFormatFlag format;
+            IndexType indexType;
+        };
+        static const Shape kShapes[] = {
+            {0x01, dex::parser::kFmt12x, IndexType::None},
+            {0x0a, dex::parser::kFmt11x, IndexType::None},
+            {0x12, dex::parser::kFmt11n, IndexType::None},
+            {0x13, dex::parser::kFmt21s, IndexType::None},
+            {0x14, dex::parser::kFmt31i, IndexType::None},
+            {0x15, dex::parser::kFmt21h, IndexType::None},
+            {0x18, dex::parser::kFmt51l, IndexType::None},
+            {0x1a, dex::parser::kFmt21c, IndexType::String},
+            {0x22, dex::parser::kFmt21c, IndexType::Type},
+            {0x28, dex::parser::kFmt10t, IndexType::None},
+            {0x32, dex::parser::kFmt22t, IndexType::None},
+            {0x38, dex::parser::kFmt21t, IndexType::None},
+            {0x44, dex::parser::kFmt23x, IndexType::None},
+            {0x54, dex::parser::kFmt22c, IndexType::Field},
+            {0x6e, dex::parser::kFmt35c, IndexType::Method},
+            {0x6e, dex::parser::kFmt35c, IndexType::Method},
+            {0x74, dex::parser::kFmt3rc, IndexType::Method},
+            {0xd8, dex::parser::kFmt22b, IndexType::None},
+        };
+
+        std::vector<std::pair<dex::parser::DecodedInstruction, uint32_t>> instructions(count);
+        std::mt19937 rng(9090);
+        uint32_t offset = 0;
+        for (auto& [insn, insnOffset] : instructions)
+        {
+            const uint32_t r = rng();
+            const Shape& shape = kShapes[r % (sizeof(kShapes) / sizeof(kShapes[0]))];
+            insn = {};
+            insn.opcode = shape.opcode;
+            insn.format = shape.format;
+            insn.indexType = shape.indexType;
+            insn.vA = (r >> 8) & 0xF;
+            insn.vB = (r >> 12) & 0xFF;
+            insn.vC = (r >> 20) & 0xFF;
+            insn.index = rng() & 0xFFFF;
+            insn.literal = static_cast<int32_t>(rng()) >> (r & 31);
+            insn.branch = static_cast<int8_t>(r >> 24);
+            if (shape.format == dex::parser::kFmt21h)
+            {
+                insn.literal = static_cast<int64_t>(static_cast<int16_t>(r >> 16)) * 65536;
+            }
+            else if (shape.format == dex::parser::kFmt35c)
+            {
+                insn.vA = (r >> 4) % 6;
+                for (uint16_t& arg : insn.args)
+                {
+                    arg = static_cast<uint16_t>(rng() & 0xF);
+                }
+            }
+            insnOffset = offset;
+            offset += 1 + (r & 3);
+        }
+        return instructions;
+    }
+
+    // 流式参考实现：与CodeParser原来的方式相同，每条指令构造一个stringstream，输出与renderOperands一致
+    std::string formatOperandsStream(const dex::parser::DecodedInstruction& insn, uint32_t offset)
+    {
+        using namespace dex::parser;
+        std::stringstream ss;
+        const auto reference = [&]()
+        {
+            ss << (insn.indexType == IndexType::String ? "string@" :
+                   insn.indexType == IndexType::Type ? "type@" :
+                   insn.indexType == IndexType::Field ? "field@" : "method@") << std::dec << insn.index;
+        };
+        const auto branch = [&]()
+        {
+            ss << "0x" << std::hex << std::uppercase << std::setw(4) << std::setfill('0')
+               << static_cast<uint32_t>(offset + insn.branch) * 2ULL << std::dec;
+        };
+
+        switch (insn.format)
+        {
+            case kFmt12x: ss << "v" << insn.vA << ", v" << insn.vB; break;
+            case kFmt11x: ss << "v" << insn.vA; break;
+            case kFmt11n:
+            case kFmt21s:
+            case kFmt31i:
+            case kFmt51l: ss << "v" << insn.vA << ", #" << insn.literal; break;
+            case kFmt21h: ss << "v" << insn.vA << ", #0x" << std::hex << std::uppercase << static_cast<uint32_t>(insn.literal); break;
+            case kFmt21c: ss << "v" << insn.vA << ", "; reference(); break;
+            case kFmt10t: branch(); break;
+            case kFmt21t: ss << "v" << insn.vA << ", "; branch(); break;
+            case kFmt22t: ss << "v" << insn.vA << ", v" << insn.vB << ", "; branch(); break;
+            case kFmt23x: ss << "v" << insn.vA << ", v" << insn.vB << ", v" << insn.vC; break;
+            case kFmt22b: ss << "v" << insn.vA << ", v" << insn.vB << ", #" << insn.literal; break;
+            case kFmt22c: ss << "v" << insn.vA << ", v" << insn.vB << ", "; reference(); break;
+            case kFmt35c:
+                ss << "{";
+                for (uint32_t i = 0; i < insn.vA; i++)
+                {
+                    ss << (i > 0 ? ", v" : "v") << insn.args[i];
+                }
+                ss << "}, ";
+                reference();
+                break;
+            case kFmt3rc:
+                ss << "{";
+                if (insn.vA > 0)
+                {
+                    ss << "v" << insn.vC;
+                    if (insn.vA > 1)
+                    {
+                        ss << " .. v" << insn.vC + insn.vA - 1;
+                    }
+                }
+                ss << "}, ";
+                reference();
+                break;
+            default: break;
+        }
+        return ss.str();
+    }
+
+    void benchOperands(const BenchOptions& options)
+    {
+        const auto instructions = makeInstructions(500000);
+
+        // 先检查两种实现的输出一致
+        size_t bytes = 0;
+        char buffer[dex::parser::kOperandBufferSize];
+        for (const auto& [insn, offset] : instructions)
+        {
+            const size_t length = dex::parser::renderOperands(insn, offset, dex::parser::IndexResolver(), buffer, sizeof(buffer));
+            if (formatOperandsStream(insn, offset) != std::string_view(buffer, length))
+            {
+                printf("  错误: renderOperands与流式实现不一致: %s / %s\n",
+                       formatOperandsStream(insn, offset).c_str(), buffer);
+                return;
+            }
+            bytes += length;
+        }
+
+        beginGroup("operands", "synthetic");
+        printf("\n[operands] 指令操作数渲染, %zu 条, %zu 字节\n", instructions.size(), bytes);
+
+        volatile size_t sink = 0;
+        report("stringstream", bytes, measure(options, options.repetitions, [&]()
+        {
+            size_t total = 0;
+            for (const auto& [insn, offset] : instructions)
+            {
+                total += formatOperandsStream(insn, offset).size();
+            }
+            sink = total;
+        }));
+        report("renderOperands + string", bytes, measure(options, options.repetitions, [&]()
+        {
+            size_t total = 0;
+            std::string text;
+            for (const auto& [insn, offset] : instructions)
+            {
+                char operands[dex::parser::kOperandBufferSize];
+                text.assign(operands, dex::parser::renderOperands(insn, offset, dex::parser::IndexResolver(),
+                                                                  operands, sizeof(operands)));
+                total += text.size();
+            }
+            sink = total;
+        }));
+        report("renderOperands", bytes, measure(options, options.repetitions, [&]()
+        {
+            size_t total = 0;
+            for (const auto& [insn, offset] : instructions)
+            {
+                char operands[dex::parser::kOperandBufferSize];
+                total += dex::parser::renderOperands(insn, offset, dex::parser::IndexResolver(), operands, sizeof(operands));
+            }
+            sink = total;
+        }));
+        (void)sink;
+    }
+
+    // 按MUTF-8编码一个UTF-16码元
+    void writeMutf8Unit(std::vector<uint8_t>& out, uint16_t unit)
+    {
+        if (unit != 0 && unit < 0x80)
+        {
+            out.push_back(static_cast<uint8_t>(unit));
+        }
+        else if (unit < 0x800)
+        {
+            out.push_back(static_cast<uint8_t>(0xC0 | (unit >> 6)));
+            out.push_back(static_cast<uint8_t>(0x80 | (unit & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<uint8_t>(0xE0 | (unit >> 12)));
+            out.push_back(static_cast<uint8_t>(0x80 | ((unit >> 6) & 0x3F)));
+            out.push_back(static_cast<uint8_t>(0x80 | (unit & 0x3F)));
+        }
+    }
+
+    // 字符串数据在文件中的位置：MUTF-8数据和UTF-16长度
+    struct Mutf8String {
+        const uint8_t* data;
+        uint32_t length;
+    };
+
+    // 解码全部字符串，返回解码后的总字节数
+    size_t decodeAll(const std::vector<Mutf8String>& strings)
+    {
+        size_t total = 0;
+        for (const Mutf8String& string : strings)
+        {
+            total += dex::DexContext::decodeMUTF8(string.data, string.length).size();
+        }
+        return total;
+    }
+
+    void benchMutf8(const BenchOptions& options)
+    {
+        // 分布接近真实DEX：大多数是ASCII标识符，少量双字节、CJK和代理对
+        std::vector<uint8_t> buffer;
+        std::vector<std::pair<size_t, uint32_t>> layout;
+        std::mt19937 rng(2718);
+        for (size_t i = 0; i < 200000; i++)
+        {
+            const size_t start = buffer.size();
+            const uint32_t length = 8 + rng() % 33;
+            uint32_t units = 0;
+            while (units < length)
+            {
+                const uint32_t r = rng() % 100;
+                if (r < 85)
+                {
+                    writeMutf8Unit(buffer, static_cast<uint16_t>('a' + rng() % 26));
+                    units++;
+                }
+                else if (r < 92)
+                {
+                    writeMutf8Unit(buffer, static_cast<uint16_t>(0x80 + rng() % 0x780));
+                    units++;
+                }
+                else if (r < 98)
+                {
+                    writeMutf8Unit(buffer, static_cast<uint16_t>(0x4E00 + rng() % 0x5000));
+                    units++;
+                }
+                else if (units + 2 <= length)
+                {
+                    writeMutf8Unit(buffer, static_cast<uint16_t>(0xD800 + rng() % 0x400));
+                    writeMutf8Unit(buffer, static_cast<uint16_t>(0xDC00 + rng() % 0x400));
+                    units += 2;
+                }
+            }
+            buffer.push_back(0);
+            layout.emplace_back(start, length);
+        }
+
+        std::vector<Mutf8String> strings;
+        strings.reserve(layout.size());
+        for (const auto& [start, length] : layout)
+        {
+            strings.push_back({buffer.data() + start, length});
+        }
+
+        beginGroup("mutf8", "synthetic");
+        printf("\n[mutf8] 合成字符串, %zu 个, %zu 字节\n", strings.size(), buffer.size());
+
+        volatile size_t sink = 0;
+        report("decodeMUTF8", buffer.size(), measure(options, options.repetitions, [&]()
+        {
+            sink = decodeAll(strings);
+        }), strings.size());
+        (void)sink;
+    }
+
+    // 已打开DEX文件中全部方法的指令数组
+    std::vector<std::pair<const uint16_t*, uint32_t>> collectInstructions(const dex::DexContext& context)
+    {
+        std::vector<std::pair<const uint16_t*, uint32_t>> code;
+        const auto add = [&](const std::vector<dex::ClassDefInfo::ClassDataInfo::EncodedMethodInfo>& methods)
+        {
+            for (const auto& method : methods)
+            {
+                const DexCode* item = method.codeOff != 0 ? context.getCodeItem(method.codeOff) : nullptr;
+                if (item != nullptr && item->insns_size > 0)
+                {
+                    code.emplace_back(item->insns, item->insns_size);
+                }
+            }
+        };
+        for (uint32_t i = 0; i < context.getClassDefsCount(); i++)
+        {
+            const dex::ClassDefInfo info = context.getClassDefInfo(i);
+            add(info.classData.directMethods);
+            add(info.classData.virtualMethods);
+        }
+        return code;
+    }
+
+    // 带代码和调试信息的方法
+    struct DebugMethod {
+        uint32_t methodIdx;
+        uint32_t insnsSize;
+        std::shared_ptr<const dex::DebugInfoData> debugInfo;
+        std::vector<dex::PositionInfo> positions;   // 按地址排序的位置，用于参考实现
+        std::vector<uint32_t> lines;                // 出现过的行号，去重
+    };
+
+    std::vector<DebugMethod> collectDebugMethods(const dex::DexContext& context)
+    {
+        std::vector<DebugMethod> methods;
+        const auto add = [&](const std::vector<dex::ClassDefInfo::ClassDataInfo::EncodedMethodInfo>& encoded)
+        {
+            for (const auto& method : encoded)
+            {
+                const DexCode* item = method.codeOff != 0 ? context.getCodeItem(method.codeOff) : nullptr;
+                const std::shared_ptr<const dex::DebugInfoData> debugInfo =
+                    item != nullptr && item->debug_info_off != 0 ? context.getDebugInfo(item->debug_info_off) : nullptr;
+                if (debugInfo == nullptr || debugInfo->lines.empty())
+                {
+                    continue;
+                }
+
+                DebugMethod& entry = methods.emplace_back();
+                entry.methodIdx = method.methodIdx;
+                entry.insnsSize = item->insns_size;
+                entry.debugInfo = debugInfo;
+                entry.positions = debugInfo->lines.decode();
+                for (const dex::PositionInfo& position : entry.positions)
+                {
+                    entry.lines.push_back(position.lineNum);
+                }
+                std::sort(entry.lines.begin(), entry.lines.end());
+                entry.lines.erase(std::unique(entry.lines.begin(), entry.lines.end()), entry.lines.end());
+            }
+        };
+        for (uint32_t i = 0; i < context.getClassDefsCount(); i++)
+        {
+            const dex::ClassDefInfo info = context.getClassDefInfo(i);
+            add(info.classData.directMethods);
+            add(info.classData.virtualMethods);
+        }
+        return methods;
+    }
+
+    // 参考实现：在位置列表中线性查找地址不大于pc的最后一个位置
+    int32_t lineForPcReference(const std::vector<dex::PositionInfo>& positions, uint32_t pc)
+    {
+        int32_t line = -1;
+        for (const dex::PositionInfo& position : positions)
+        {
+            if (position.address > pc)
+            {
+                break;
+            }
+            line = static_cast<int32_t>(position.lineNum);
+        }
+        return line;
+    }
+
+    // 带try块的方法
+    struct TryMethod {
+        uint32_t methodIdx;
+        std::shared_ptr<const dex::CodeInfo> codeInfo;
+    };
+
+    std::vector<TryMethod> collectTryMethods(const dex::DexContext& context)
+    {
+        std::vector<TryMethod> methods;
+        const auto add = [&](const std::vector<dex::ClassDefInfo::ClassDataInfo::EncodedMethodInfo>& encoded)
+        {
+            for (const auto& method : encoded)
+            {
+                const DexCode* item = method.codeOff != 0 ? context.getCodeItem(method.codeOff) : nullptr;
+                if (item == nullptr || item->tries_size == 0)
+                {
+                    continue;
+                }
+                if (std::shared_ptr<const dex::CodeInfo> codeInfo = context.getTryCatchInfo(method.codeOff))
+                {
+                    methods.push_back({method.methodIdx, std::move(codeInfo)});
+                }
+            }
+        };
+        for (uint32_t i = 0; i < context.getClassDefsCount(); i++)
+        {
+            const dex::ClassDefInfo info = context.getClassDefInfo(i);
+            add(info.classData.directMethods);
+            add(info.classData.virtualMethods);
+        }
+        return methods;
+    }
+
+    // 参考实现：线性查找覆盖pc的try块
+    const dex::TryBlockInfo* findTryBlockReference(const dex::CodeInfo& codeInfo, uint32_t pc)
+    {
+        for (const dex::TryBlockInfo& tryInfo : codeInfo.tries)
+        {
+            if (pc >= tryInfo.startAddr && pc - tryInfo.startAddr < tryInfo.insnCount)
+            {
+                return &tryInfo;
+            }
+        }
+        return nullptr;
+    }
+
+    // 查找表和解码的微基准，数据来自已打开的DEX文件
+    void benchDexMicro(const std::string& path, const BenchOptions& options)
+    {
+        dex::DexDump dump;
+        if (!dump.open(path.c_str()))
+        {
+            printf("\n无法解析DEX文件: %s\n", path.c_str());
+            return;
+        }
+        const dex::DexContext& context = dex::DexContext::getInstance();
+        volatile size_t sink = 0;
+
+        if (selected(options, "strings"))
+        {
+            std::vector<Mutf8String> strings;
+            size_t bytes = 0;
+            for (const DexStringId& id : context.getStringIds())
+            {
+                dex::UncheckedReader reader(context.getFileData(), context.getFileSize(), id.stringDataOff);
+                const uint32_t length = reader.readULEB128();
+                strings.push_back({reader.current(), length});
+            }
+            for (uint32_t i = 0; i < context.getStringIdsCount(); i++)
+            {
+                bytes += context.getStringData(i).size();
+            }
+            const uint32_t count = context.getStringIdsCount();
+
+            beginGroup("strings", path);
+            printf("\n[strings] %s, %u 个, %zu 字节\n", path.c_str(), count, bytes);
+            report("decodeMUTF8", bytes, measure(options, options.repetitions, [&]()
+            {
+                sink = decodeAll(strings);
+            }), count);
+            report("getString (cached)", bytes, measure(options, options.repetitions, [&]()
+            {
+                size_t total = 0;
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    total += context.getString(i).size();
+                }
+                sink = total;
+            }), count);
+            report("getStringData", bytes, measure(options, options.repetitions, [&]()
+            {
+                size_t total = 0;
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    total += context.getStringData(i).size();
+                }
+                sink = total;
+            }), count);
+        }
+
+        if (selected(options, "typelist"))
+        {
+            const uint32_t count = context.getProtoIdsCount();
+            beginGroup("typelist", path);
+            printf("\n[typelist] %s, %u 个方法原型\n", path.c_str(), count);
+            report("getProtoParameters", 0, measure(options, options.repetitions, [&]()
+            {
+                size_t total = 0;
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    const dex::TypeListData* parameters = context.getProtoParameters(i);
+                    total += parameters != nullptr ? parameters->size : 0;
+                }
+                sink = total;
+            }), count);
+        }
+
+        if (selected(options, "decode"))
+        {
+            const auto code = collectInstructions(context);
+            size_t units = 0;
+            size_t instructions = 0;
+            for (const auto& [insns, size] : code)
+            {
+                units += size;
+                dex::parser::DecodedInstruction decoded;
+                for (uint32_t pc = 0; pc < size && dex::parser::CodeParser::decodeInstruction(insns, size, pc, decoded);
+                     pc += decoded.length)
+                {
+                    instructions++;
+                }
+            }
+
+            beginGroup("decode", path);
+            printf("\n[decode] %s, %zu 个方法, %zu 条指令, %zu 字节\n", path.c_str(), code.size(), instructions,
+                   units * 2);
+            report("decodeInstruction", units * 2, measure(options, options.repetitions, [&]()
+            {
+                size_t total = 0;
+                dex::parser::DecodedInstruction decoded;
+                for (const auto& [insns, size] : code)
+                {
+                    for (uint32_t pc = 0; pc < size && dex::parser::CodeParser::decodeInstruction(insns, size, pc, decoded);
+                         pc += decoded.length)
+                    {
+                        total += decoded.opcode;
+                    }
+                }
+                sink = total;
+            }), instructions);
+        }
+
+        if (selected(options, "lines"))
+        {
+            // 每个方法查询全部代码单元的行号，以及每个出现过的行号的地址范围
+            const std::vector<DebugMethod> methods = collectDebugMethods(context);
+            size_t pcCount = 0;
+            size_t lineCount = 0;
+            bool consistent = true;
+            for (const DebugMethod& method : methods)
+            {
+                pcCount += method.insnsSize;
+                lineCount += method.lines.size();
+                for (uint32_t pc = 0; pc < method.insnsSize; pc++)
+                {
+                    consistent &= context.lineForPc(method.methodIdx, pc) == lineForPcReference(method.positions, pc);
+                }
+                for (const uint32_t line : method.lines)
+                {
+                    for (const dex::PcRange& range : context.pcRangeForLine(method.methodIdx, line))
+                    {
+                        for (uint32_t pc = range.startPc; pc < range.endPc; pc++)
+                        {
+                            consistent &= lineForPcReference(method.positions, pc) == static_cast<int32_t>(line);
+                        }
+                    }
+                }
+            }
+
+            beginGroup("lines", path);
+            printf("\n[lines] %s, %zu 个方法, %zu 个地址, %zu 个行号\n", path.c_str(), methods.size(), pcCount,
+                   lineCount);
+            report("linear scan (decoded)", 0, measure(options, std::max(1u, options.repetitions / 4), [&]()
+            {
+                int64_t total = 0;
+                for (const DebugMethod& method : methods)
+                {
+                    for (uint32_t pc = 0; pc < method.insnsSize; pc++)
+                    {
+                        total += lineForPcReference(method.positions, pc);
+                    }
+                }
+                sink = static_cast<size_t>(total);
+            }), pcCount);
+            report("LineTable::lineForPc", 0, measure(options, options.repetitions, [&]()
+            {
+                size_t total = 0;
+                for (const DebugMethod& method : methods)
+                {
+                    for (uint32_t pc = 0; pc < method.insnsSize; pc++)
+                    {
+                        uint32_t line = 0;
+                        total += method.debugInfo->lines.lineForPc(pc, line) ? line : 0;
+                    }
+                }
+                sink = total;
+            }), pcCount);
+            // 包含按方法查找代码段和调试信息缓存的开销
+            report("DexContext::lineForPc", 0, measure(options, options.repetitions, [&]()
+            {
+                int64_t total = 0;
+                for (const DebugMethod& method : methods)
+                {
+                    for (uint32_t pc = 0; pc < method.insnsSize; pc++)
+                    {
+                        total += context.lineForPc(method.methodIdx, pc);
+                    }
+                }
+                sink = static_cast<size_t>(total);
+            }), pcCount);
+            report("DexContext::pcRangeForLine", 0, measure(options, options.repetitions, [&]()
+            {
+                size_t total = 0;
+                for (const DebugMethod& method : methods)
+                {
+                    for (const uint32_t line : method.lines)
+                    {
+                        total += context.pcRangeForLine(method.methodIdx, line).size();
+                    }
+                }
+                sink = total;
+            }), lineCount);
+
+            if (!consistent)
+            {
+                printf("  错误: lineForPc/pcRangeForLine与线性查找不一致\n");
+            }
+        }
+
+        if (selected(options, "trycatch"))
+        {
+            // 每个带try块的方法查询全部代码单元
+            const std::vector<TryMethod> methods = collectTryMethods(context);
+            size_t pcCount = 0;
+            bool consistent = true;
+            for (const TryMethod& method : methods)
+            {
+                const dex::CodeInfo& codeInfo = *method.codeInfo;
+                pcCount += codeInfo.insnsSize;
+                for (uint32_t pc = 0; pc < codeInfo.insnsSize; pc++)
+                {
+                    const dex::TryBlockInfo* expected = findTryBlockReference(codeInfo, pc);
+                    const std::shared_ptr<const dex::CatchHandlerInfo> handler =
+                        context.findCatchHandler(method.methodIdx, pc);
+                    consistent &= dex::DexContext::findTryBlock(codeInfo, pc) == expected;
+                    consistent &= expected != nullptr ? handler.get() == &codeInfo.handlers[expected->handlerIdx]
+                                                      : handler == nullptr;
+                }
+            }
+
+            beginGroup("trycatch", path);
+            printf("\n[trycatch] %s, %zu 个方法, %zu 个地址\n", path.c_str(), methods.size(), pcCount);
+            report("linear scan", 0, measure(options, options.repetitions, [&]()
+            {
+                size_t total = 0;
+                for (const TryMethod& method : methods)
+                {
+                    for (uint32_t pc = 0; pc < method.codeInfo->insnsSize; pc++)
+                    {
+                        total += findTryBlockReference(*method.codeInfo, pc) != nullptr;
+                    }
+                }
+                sink = total;
+            }), pcCount);
+            report("findTryBlock", 0, measure(options, options.repetitions, [&]()
+            {
+                size_t total = 0;
+                for (const TryMethod& method : methods)
+                {
+                    for (uint32_t pc = 0; pc < method.codeInfo->insnsSize; pc++)
+                    {
+                        total += dex::DexContext::findTryBlock(*method.codeInfo, pc) != nullptr;
+                    }
+                }
+                sink = total;
+            }), pcCount);
+            // 包含按方法查找代码段和try/catch缓存的开销
+            report("DexContext::findCatchHandler", 0, measure(options, options.repetitions, [&]()
+            {
+                size_t total = 0;
+                for (const TryMethod& method : methods)
+                {
+                    for (uint32_t pc = 0; pc < method.codeInfo->insnsSize; pc++)
+                    {
+                        total += context.findCatchHandler(method.methodIdx, pc) != nullptr;
+                    }
+                }
+                sink = total;
+            }), pcCount);
+
+            if (!consistent)
+            {
+                printf("  错误: findTryBlock/findCatchHandler与线性查找不一致\n");
+            }
+        }
+        (void)sink;
+    }
+
+    // 打开、解析阶段、完整输出和交叉引用索引的宏基准
+    void benchDexMacro(const std::string& path, const BenchOptions& options)
+    {
+        dex::DexDump dump;
+        if (!dump.open(path.c_str()))
+        {
+            printf("\n无法解析DEX文件: %s\n", path.c_str());
+            return;
+        }
+        const dex::DexContext& context = dex::DexContext::getInstance();
+        const size_t fileSize = context.getFileSize();
+        const uint32_t classCount = context.getClassDefsCount();
+        const auto reopen = [&]()
+        {
+            dump.open(path.c_str());
+        };
+
+        if (selected(options, "open"))
+        {
+            beginGroup("open", path);
+            printf("\n[open] %s, %zu 字节, %u 个类\n", path.c_str(), fileSize, classCount);
+            report("open", fileSize, measure(options, options.repetitions, reopen), classCount);
+
+            // 各解析阶段单独计时，计时点本身有少量开销
+            static constexpr dex::Phase kPhases[] = {
+                dex::Phase::Map, dex::Phase::Header, dex::Phase::StringIds, dex::Phase::TypeIds,
+                dex::Phase::ProtoIds, dex::Phase::FieldIds, dex::Phase::MethodIds, dex::Phase::ClassDefs,
+                dex::Phase::ClassData,
+            };
+            std::vector<std::vector<double>> samples(std::size(kPhases));
+            std::vector<dex::PhaseTotals> totals(std::size(kPhases));
+            dex::PhaseStats::setEnabled(true);
+            for (uint32_t i = 0; i < options.warmup + options.repetitions; i++)
+            {
+                dex::PhaseStats::reset();
+                reopen();
+                for (size_t phase = 0; phase < std::size(kPhases); phase++)
+                {
+                    totals[phase] = dex::PhaseStats::get(kPhases[phase]);
+                    if (i >= options.warmup)
+                    {
+                        samples[phase].push_back(static_cast<double>(totals[phase].wallNs) / 1e6);
+                    }
+                }
+            }
+            dex::PhaseStats::setEnabled(false);
+            dex::PhaseStats::reset();
+            for (size_t phase = 0; phase < std::size(kPhases); phase++)
+            {
+                const std::string name = std::string("phase ") + dex::PhaseStats::name(kPhases[phase]);
+                report(name.c_str(), totals[phase].bytes, summarize(samples[phase]), totals[phase].items);
+            }
+        }
+
+        if (selected(options, "dump"))
+        {
+            // 完整文本输出到内存：打开加上全部表格和代码
+            dex::print::MemorySink sink;
+            size_t outputSize = 0;
+            const auto dumpAll = [&]()
+            {
+                reopen();
+                sink.clear();
+                dex::print::HeaderPrint header_print{};
+                dex::print::StringPrint string_print{};
+                dex::print::TypePrint type_print{};
+                dex::print::ProtoPrint proto_print{};
+                dex::print::FieldPrint field_print{};
+                dex::print::MethodPrint method_print{};
+                dex::print::ClassPrint class_print{};
+                dex::print::CodePrint code_print{};
+                dex::print::BasePrint* const printers[] = {
+                    &header_print, &string_print, &type_print, &proto_print,
+                    &field_print, &method_print, &class_print, &code_print,
+                };
+                for (dex::print::BasePrint* printer : printers)
+                {
+                    printer->setSink(sink);
+                    printer->print();
+                }
+                outputSize = sink.str().size();
+            };
+            dumpAll();
+
+            beginGroup("dump", path);
+            printf("\n[dump] %s, 输出 %zu 字节, %u 线程\n", path.c_str(), outputSize,
+                   options.threadCount == 0 ? dex::getDefaultThreadCount() : options.threadCount);
+            report("open + full text dump", fileSize, measure(options, options.repetitions, dumpAll), classCount);
+        }
+
+        if (selected(options, "xrefs"))
+        {
+            // 每次计时前重新打开，索引从头构建
+            beginGroup("xrefs", path);
+            printf("\n[xrefs] %s, %u 个字段, %u 个类型\n", path.c_str(), context.getFieldIdsCount(),
+                   context.getTypeIdsCount());
+            report("buildFieldXrefs", fileSize, measure(options, options.repetitions, reopen, [&]()
+            {
+                context.buildFieldXrefs();
+            }), context.getFieldIdsCount());
+            report("buildTypeUsages", fileSize, measure(options, options.repetitions, reopen, [&]()
+            {
+                context.buildTypeUsages();
+            }), context.getTypeIdsCount());
+        }
+    }
+
+    // 查找数据集目录中的DEX文件，按路径排序
+    void collectDataset(const std::string& dir, std::vector<std::string>& files)
+    {
+        std::vector<std::string> found;
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator(dir, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            if (it->is_regular_file(ec) && it->path().extension() == ".dex")
+            {
+                found.push_back(it->path().string());
+            }
+        }
+        if (ec)
+        {
+            printf("无法读取数据集目录: %s\n", dir.c_str());
+        }
+        std::sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
+    }
+
+    // 把全部结果写成一个JSON文档，便于在不同提交之间比较
+    bool writeJson(const BenchOptions& options, const std::string& path)
+    {
+        const std::unique_ptr<dex::print::FileSink> file = dex::print::FileSink::open(path.c_str());
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        dex::print::JsonWriter json(*file);
+        json.beginObject();
+        json.field("kind", "bench");
+        json.field("warmup", options.warmup);
+        json.field("repetitions", options.repetitions);
+        json.field("threads", options.threadCount == 0 ? dex::getDefaultThreadCount() : options.threadCount);
+        json.key("avx2");
+        json.value(dex::cpuHasAvx2());
+        json.key("shaNi");
+        json.value(dex::cpuHasShaNi());
+        json.beginArray("results");
+        for (const BenchRecord& record : benchState().records)
+        {
+            json.beginObject();
+            json.field("group", record.group);
+            json.field("dataset", record.dataset);
+            json.field("name", record.name);
+            json.field("samples", record.samples);
+            json.field("bytes", record.bytes);
+            json.field("items", record.items);
+            const std::pair<const char*, double> values[] = {
+                {"minMs", record.result.minMs}, {"meanMs", record.result.meanMs},
+                {"p50Ms", record.result.medianMs}, {"p90Ms", record.result.p90Ms},
+                {"p99Ms", record.result.p99Ms}, {"maxMs", record.result.maxMs},
+            };
+            for (const auto& [name, value] : values)
+            {
+                json.key(name);
+                json.valueDouble(value);
+            }
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+        file->flush();
+        return true;
+    }
+
+    bool readFile(const std::string& path, std::vector<uint8_t>& data)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    void printUsage(const char* program)
+    {
+        printf("用法: %s [--size MB] [--threads N] [--warmup N] [--reps N] [--filter 组名] [--dataset 目录]...\n"
+               "       [--generate 类数量] [--json 路径] [dex文件...]\n"
+               "未指定--dataset时使用resources目录中的DEX文件，--generate在临时目录生成合成DEX数据集\n", program);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+        {
+            options.syntheticSize = strtoull(argv[++i], nullptr, 10) << 20;
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            options.threadCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+        {
+            options.warmup = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc)
+        {
+            options.repetitions = std::max(1u, static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            options.filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--dataset") == 0 && i + 1 < argc)
+        {
+            options.datasets.emplace_back(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc)
+        {
+            options.generateClasses = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            options.jsonPath = argv[++i];
+        }
+        else if (argv[i][0] == '-')
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+        else
+        {
+            options.files.emplace_back(argv[i]);
+        }
+    }
+
+    log_set_level(LOG_LEVEL_WARNING);
+    dex::DexContext::getInstance().setThreadCount(options.threadCount);
+
+    // 合成数据：随机字节，固定种子保证可重复
+    std::vector<uint8_t> synthetic(options.syntheticSize);
+    std::mt19937 rng(12345);
+    for (auto& byte : synthetic)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+    if (selected(options, "adler32"))
+    {
+        benchAdler32("synthetic", synthetic.data(), synthetic.size(), options);
+    }
+    if (selected(options, "sha1"))
+    {
+        benchSha1("synthetic", synthetic.data(), synthetic.size(), options);
+    }
+    if (selected(options, "reader"))
+    {
+        benchReader(options.syntheticSize, options);
+    }
+    if (selected(options, "mutf8"))
+    {
+        benchMutf8(options);
+    }
+    if (selected(options, "output"))
+    {
+        benchOutput(options);
+    }
+    if (selected(options, "render"))
+    {
+        benchOrderedRender(options);
+    }
+    if (selected(options, "operands"))
+    {
+        benchOperands(options);
+    }
+
+    // 数据集目录中的DEX文件，加上命令行给出的文件
+    std::vector<std::string> files;
+    if (options.datasets.empty() && std::filesystem::is_directory("resources"))
+    {
+        options.datasets.emplace_back("resources");
+    }
+    for (const std::string& dir : options.datasets)
+    {
+        collectDataset(dir, files);
+    }
+    files.insert(files.end(), options.files.begin(), options.files.end());
+    if (options.generateClasses > 0)
+    {
+        // 其余规模参数使用生成器的默认值，超出方法上限时生成多个文件
+        dex::DexGeneratorOptions generatorOptions;
+        generatorOptions.classes = options.generateClasses;
+        generatorOptions.strings = options.generateClasses * 10;
+        const std::string dir = (std::filesystem::temp_directory_path() / "dexdump_bench_dataset").string();
+        if (!dex::DexGenerator(generatorOptions).writeFiles(dir, files))
+        {
+            printf("生成合成DEX数据集失败: %s\n", dir.c_str());
+            return 1;
+        }
+    }
+
+    for (const std::string& path : files)
+    {
+        // 与HeaderParser一致，校验和覆盖偏移12、签名覆盖偏移32到文件末尾
+        std::vector<uint8_t> data;
+        if (!readFile(path, data) || data.size() < 12)
+        {
+            printf("\n无法读取文件: %s\n", path.c_str());
+            continue;
+        }
+        if (selected(options, "adler32"))
+        {
+            benchAdler32(path.c_str(), data.data() + 12, data.size() - 12, options);
+        }
+        if (selected(options, "sha1") && data.size() >= 32)
+        {
+            benchSha1(path.c_str(), data.data() + 32, data.size() - 32, options);
+        }
+
+        benchDexMicro(path, options);
+        benchDexMacro(path, options);
+    }
+
+    if (!options.jsonPath.empty() && !writeJson(options, options.jsonPath))
+    {
+        printf("无法写入JSON结果: %s\n", options.jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/DexGenerator.h"
+
+namespace
+{
+    void printUsage(const char* program)
+    {
+        const dex::DexGeneratorOptions defaults;
+        printf("用法: %s [选项] <输出目录>\n"
+               "生成用于规模测试的合成DEX文件，方法或字段超出单个文件上限时拆分为classes2.dex等多个文件\n"
+               "  --classes N       类数量（默认%u）\n"
+               "  --methods N       每个类的方法数，包括构造函数（默认%u）\n"
+               "  --fields N        每个类的字段数（默认%u）\n"
+               "  --strings N       额外的字符串常量数量（默认%u）\n"
+               "  --types N         额外引用的外部类型数量（默认%u）\n"
+               "  --code-units N    每个方法的指令长度，16位码元（默认%u）\n"
+               "  --tries N         每个方法的try块数量（默认%u）\n"
+               "  --max-methods N   单个文件的方法ID上限（默认%u）\n"
+               "  --seed N          随机种子（默认%u）\n"
+               "  --package NAME    生成类所在的包（默认%s）\n"
+               "  --no-debug-info   不生成调试信息\n",
+               program, defaults.classes, defaults.methodsPerClass, defaults.fieldsPerClass, defaults.strings,
+               defaults.types, defaults.codeUnits, defaults.triesPerMethod, defaults.maxMethodsPerFile,
+               defaults.seed, defaults.packageName.c_str());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    dex::DexGeneratorOptions options;
+    std::string outputDir;
+    const struct
+    {
+        const char* name;
+        uint32_t* value;
+    } numberOptions[] = {
+        {"--classes", &options.classes},
+        {"--methods", &options.methodsPerClass},
+        {"--fields", &options.fieldsPerClass},
+        {"--strings", &options.strings},
+        {"--types", &options.types},
+        {"--code-units", &options.codeUnits},
+        {"--tries", &options.triesPerMethod},
+        {"--max-methods", &options.maxMethodsPerFile},
+        {"--seed", &options.seed},
+    };
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool matched = false;
+        for (const auto& option : numberOptions)
+        {
+            if (strcmp(argv[i], option.name) == 0 && i + 1 < argc)
+            {
+                *option.value = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+                matched = true;
+                break;
+            }
+        }
+        if (matched)
+        {
+            continue;
+        }
+        if (strcmp(argv[i], "--package") == 0 && i + 1 < argc)
+        {
+            options.packageName = argv[++i];
+        }
+        else if (strcmp(argv[i], "--no-debug-info") == 0)
+        {
+            options.debugInfo = false;
+        }
+        else if (argv[i][0] == '-' || !outputDir.empty())
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+        else
+        {
+            outputDir = argv[i];
+        }
+    }
+    if (outputDir.empty())
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const dex::DexGenerator generator(options);
+    if (generator.getFileCount() == 0)
+    {
+        fprintf(stderr, "参数无效：类数量和方法数不能为0，单个类的方法数不能超过单个文件的上限\n");
+        return 1;
+    }
+
+    std::vector<std::string> paths;
+    if (!generator.writeFiles(outputDir, paths))
+    {
+        return 1;
+    }
+    for (const std::string& path : paths)
+    {
+        std::error_code ec;
+        printf("%s (%ju 字节)\n", path.c_str(), static_cast<uintmax_t>(std::filesystem::file_size(path, ec)));
+    }
+    printf("共 %zu 个文件，%u 个类，每个类 %u 个方法\n", paths.size(), options.classes, options.methodsPerClass);
+    return 0;
+}
@@ -0,0 +1,160 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "Adler32.h"
+
+#include <algorithm>
+#include <vector>
+#include "CpuFeatures.h"
+#include "ThreadPool.h"
+
+#if defined(DEX_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+namespace dex
+{
+    // 小于2^16的最大素数
+    static constexpr uint32_t kBase = 65521;
+
+    // 保证s2不溢出32位的最大连续字节数：255n(n+1)/2 + (n+1)(kBase-1) <= 2^32-1
+    static constexpr size_t kNmax = 5552;
+
+    // 多线程计算时每块的字节数
+    static constexpr size_t kParallelChunkSize = 1 << 20;
+
+    static uint32_t adler32Scalar(uint32_t adler, const uint8_t* data, size_t size)
+    {
+        uint32_t s1 = adler & 0xFFFF;
+        uint32_t s2 = adler >> 16;
+
+        while (size > 0)
+        {
+            size_t n = std::min(size, kNmax);
+            size -= n;
+            while (n-- > 0)
+            {
+                s1 += *data++;
+                s2 += s1;
+            }
+            s1 %= kBase;
+            s2 %= kBase;
+        }
+
+        return (s2 << 16) | s1;
+    }
+
+#if defined(DEX_ARCH_X86)
+    // 8个32位整数水平求和
+    DEX_TARGET("avx2") static uint32_t horizontalSum(__m256i v)
+    {
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return static_cast<uint32_t>(_mm_cvtsi128_si32(sum));
+    }
+
+    /**
+     * AVX2实现：每次处理32字节
+     * s1累加字节和(vpsadbw)，s2累加按位置加权(32..1)的字节和(vpmaddubsw)，
+     * 每块开始时的s1对s2的贡献(32*s1)延迟到一轮结束后统一加上。
+     * 各通道的中间值可能回绕，但一轮不超过kNmax字节，总和模2^32仍然精确。
+     */
+    DEX_TARGET("avx2") static uint32_t adler32Avx2(uint32_t adler, const uint8_t* data, size_t size)
+    {
+        uint32_t s1 = adler & 0xFFFF;
+        uint32_t s2 = adler >> 16;
+
+        const __m256i weights = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+                                                 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+        const __m256i ones = _mm256_set1_epi16(1);
+        const __m256i zero = _mm256_setzero_si256();
+
+        while (size >= 32)
+        {
+            size_t blocks = std::min(size, kNmax) / 32;
+            size -= blocks * 32;
+
+            __m256i vs1 = _mm256_setr_epi32(static_cast<int>(s1), 0, 0, 0, 0, 0, 0, 0);
+            __m256i vs2 = _mm256_setr_epi32(static_cast<int>(s2), 0, 0, 0, 0, 0, 0, 0);
+            __m256i vs1Blocks = zero;
+
+            do
+            {
+                const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+                vs1Blocks = _mm256_add_epi32(vs1Blocks, vs1);
+                vs1 = _mm256_add_epi32(vs1, _mm256_sad_epu8(bytes, zero));
+                vs2 = _mm256_add_epi32(vs2, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, weights), ones));
+                data += 32;
+            }
+            while (--blocks > 0);
+
+            vs2 = _mm256_add_epi32(vs2, _mm256_slli_epi32(vs1Blocks, 5));
+            s1 = horizontalSum(vs1) % kBase;
+            s2 = horizontalSum(vs2) % kBase;
+        }
+
+        return adler32Scalar((s2 << 16) | s1, data, size);
+    }
+#endif
+
+    uint32_t adler32(uint32_t adler, const uint8_t* data, size_t size)
+    {
+#if defined(DEX_ARCH_X86)
+        if (cpuHasAvx2())
+        {
+            return adler32Avx2(adler, data, size);
+        }
+#endif
+        return adler32Scalar(adler, data, size);
+    }
+
+    uint32_t adler32Combine(uint32_t adler1, uint32_t adler2, size_t size2)
+    {
+        // adler(A+B): s1 = s1A + s1B - 1, s2 = s2A + s2B + size2*s1A - size2
+        const uint32_t rem = static_cast<uint32_t>(size2 % kBase);
+        uint32_t sum1 = adler1 & 0xFFFF;
+        uint32_t sum2 = (rem * sum1) % kBase;
+        sum1 += (adler2 & 0xFFFF) + kBase - 1;
+        sum2 += (adler1 >> 16) + (adler2 >> 16) + kBase - rem;
+
+        if (sum1 >= kBase) sum1 -= kBase;
+        if (sum1 >= kBase) sum1 -= kBase;
+        if (sum2 >= (kBase << 1)) sum2 -= (kBase << 1);
+        if (sum2 >= kBase) sum2 -= kBase;
+
+        return (sum2 << 16) | sum1;
+    }
+
+    uint32_t adler32Parallel(const uint8_t* data, size_t size, uint32_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = getDefaultThreadCount();
+        }
+
+        // 数据量较小或单线程时直接计算
+        if (threadCount == 1 || size <= kParallelChunkSize * 2)
+        {
+            return adler32(1, data, size);
+        }
+
+        const size_t chunkCount = (size + kParallelChunkSize - 1) / kParallelChunkSize;
+        std::vector<uint32_t> parts(chunkCount);
+        parallelFor(size, kParallelChunkSize, threadCount,
+                    [&](size_t chunk, size_t begin, size_t end)
+                    {
+                        parts[chunk] = adler32(1, data + begin, end - begin);
+                    });
+
+        // 按块顺序合并
+        uint32_t result = parts[0];
+        for (size_t i = 1; i < chunkCount; i++)
+        {
+            const size_t chunkSize = std::min(kParallelChunkSize, size - i * kParallelChunkSize);
+            result = adler32Combine(result, parts[i], chunkSize);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,41 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef ADLER32_H
+#define ADLER32_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dex
+{
+    /**
+     * 计算Adler-32校验和（支持AVX2时使用向量化实现）
+     * @param adler 初始值，新计算时传1，也可传入上一段的结果继续计算
+     * @param data 数据
+     * @param size 数据长度
+     * @return 校验和
+     */
+    uint32_t adler32(uint32_t adler, const uint8_t* data, size_t size);
+
+    /**
+     * 合并两段相邻数据的Adler-32校验和
+     * @param adler1 前一段的校验和
+     * @param adler2 后一段的校验和（初始值为1）
+     * @param size2 后一段的长度
+     * @return 两段拼接后的校验和
+     */
+    uint32_t adler32Combine(uint32_t adler1, uint32_t adler2, size_t size2);
+
+    /**
+     * 分块多线程计算Adler-32校验和，各块结果按顺序合并
+     * @param data 数据
+     * @param size 数据长度
+     * @param threadCount 线程数，0表示使用默认线程数
+     * @return 校验和（初始值为1）
+     */
+    uint32_t adler32Parallel(const uint8_t* data, size_t size, uint32_t threadCount);
+}
+
+#endif // ADLER32_H
@@ -0,0 +1,381 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "BatchRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include "DexContext.h"
+#include "DexDump.h"
+#include "ThreadPool.h"
+#include "ZipArchive.h"
+#include "util.h"
+#include "log/log.h"
+
+namespace dex
+{
+    namespace
+    {
+        // 检查文件是否为ZIP（APK）
+        bool isZipFile(const std::string& path)
+        {
+            FILE* file = fopen(path.c_str(), "rb");
+            if (file == nullptr)
+            {
+                return false;
+            }
+            uint8_t magic[4];
+            const bool isZip = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                               ZipArchive::isZip(magic, sizeof(magic));
+            fclose(file);
+            return isZip;
+        }
+
+        // 把APK展开为其中的DEX条目路径（app.apk!classes.dex、app.apk!classes2.dex...）
+        void collectArchive(const std::string& path, std::vector<std::string>& files)
+        {
+            uint8_t* data = nullptr;
+            size_t size = 0;
+            if (util::mapFile(path.c_str(), &data, &size) != 0)
+            {
+                // 保留原路径，打开时记录为失败
+                files.push_back(path);
+                return;
+            }
+
+            ZipArchive archive;
+            if (!archive.open(data, size))
+            {
+                files.push_back(path);
+            }
+            else
+            {
+                const std::vector<const ZipEntry*> entries = archive.getDexEntries();
+                if (entries.empty())
+                {
+                    LOGW("APK中没有DEX文件: %s", path.c_str());
+                }
+                for (const ZipEntry* entry : entries)
+                {
+                    files.push_back(ZipArchive::entryPath(path, entry->name));
+                }
+            }
+            util::unmapFile(data);
+        }
+
+        // 展开单个文件：APK展开为DEX条目，其他文件原样保留
+        void collectFile(const std::string& path, std::vector<std::string>& files)
+        {
+            if (isZipFile(path))
+            {
+                collectArchive(path, files);
+            }
+            else
+            {
+                files.push_back(path);
+            }
+        }
+
+        // 递归查找目录中的.dex和.apk文件
+        void collectDirectory(const std::filesystem::path& dir, std::vector<std::string>& files)
+        {
+            std::vector<std::string> found;
+            std::error_code ec;
+            auto it = std::filesystem::recursive_directory_iterator(
+                dir, std::filesystem::directory_options::skip_permission_denied, ec);
+            if (ec)
+            {
+                LOGW("无法读取目录: %s (%s)", dir.string().c_str(), ec.message().c_str());
+                return;
+            }
+            for (const auto end = std::filesystem::recursive_directory_iterator(); it != end; it.increment(ec))
+            {
+                if (ec)
+                {
+                    LOGW("遍历目录出错: %s (%s)", dir.string().c_str(), ec.message().c_str());
+                    break;
+                }
+                const std::filesystem::path extension = it->path().extension();
+                if (it->is_regular_file(ec) && (extension == ".dex" || extension == ".apk"))
+                {
+                    found.push_back(it->path().string());
+                }
+            }
+            std::sort(found.begin(), found.end());
+            for (const std::string& path : found)
+            {
+                collectFile(path, files);
+            }
+        }
+
+        // 逐行读取路径列表，忽略空行
+        void readPathList(std::istream& in, std::vector<std::string>& files)
+        {
+            std::string line;
+            while (std::getline(in, line))
+            {
+                while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+                {
+                    line.pop_back();
+                }
+                if (!line.empty())
+                {
+                    collectFile(line, files);
+                }
+            }
+        }
+
+        // 尚未轮到输出的文件最多缓冲的总字节数
+        constexpr uint64_t kMaxBufferedBytes = 64u << 20;
+
+        // 各文件按输入顺序交接汇总输出的状态
+        struct OutputOrder
+        {
+            OutputOrder(print::OutputSink& out, size_t count) : out(out), pending(count), done(count, 0)
+            {
+            }
+
+            print::OutputSink& out;
+            std::mutex mutex;
+            std::condition_variable turnChanged;
+            size_t turn = 0;                    // 当前直接写入out的文件
+            uint64_t buffered = 0;              // 尚未轮到的文件缓冲的总字节数
+            std::vector<std::string> pending;   // 已处理完但尚未轮到的文件输出
+            std::vector<uint8_t> done;          // 文件是否已处理完
+        };
+
+        /**
+         * 单个文件的输出目标
+         * 轮到该文件时直接写入汇总输出；否则先缓冲，缓冲总量达到kMaxBufferedBytes时
+         * 等到轮到该文件再继续。当前文件从不等待，所以总能推进，内存占用不随文件输出大小增长。
+         */
+        class OrderedFileSink final : public print::OutputSink
+        {
+        public:
+            OrderedFileSink(OutputOrder& order, size_t index) : order_(order), index_(index)
+            {
+            }
+
+            // 文件处理完毕：已轮到时顺带提交之后已处理完的文件并交出输出，否则留给前面的文件提交
+            void finish()
+            {
+                flush();
+                {
+                    std::lock_guard lock(order_.mutex);
+                    if (!owner_ && order_.turn != index_)
+                    {
+                        order_.pending[index_] = std::move(buffer_);
+                        order_.done[index_] = 1;
+                        return;
+                    }
+                }
+                takeTurn();
+
+                size_t next = index_ + 1;
+                for (;;)
+                {
+                    std::string text;
+                    {
+                        std::lock_guard lock(order_.mutex);
+                        if (next == order_.done.size() || !order_.done[next])
+                        {
+                            order_.turn = next;
+                            break;
+                        }
+                        text = std::move(order_.pending[next]);
+                        order_.buffered -= text.size();
+                        next++;
+                    }
+                    order_.out.write(text);
+                }
+                order_.turnChanged.notify_all();
+            }
+
+        protected:
+            void emit(const char* data, size_t size) override
+            {
+                if (!owner_)
+                {
+                    std::unique_lock lock(order_.mutex);
+                    if (order_.turn != index_)
+                    {
+                        if (order_.buffered + size <= kMaxBufferedBytes)
+                        {
+                            buffer_.append(data, size);
+                            order_.buffered += size;
+                            return;
+                        }
+                        order_.turnChanged.wait(lock, [&]() { return order_.turn == index_; });
+                    }
+                }
+                takeTurn();
+                order_.out.write(std::string_view(data, size));
+            }
+
+        private:
+            // 已轮到该文件：释放缓冲计数并写出缓冲的内容，之后直接写入
+            void takeTurn()
+            {
+                if (!owner_)
+                {
+                    std::lock_guard lock(order_.mutex);
+                    order_.buffered -= buffer_.size();
+                    owner_ = true;
+                }
+                if (!buffer_.empty())
+                {
+                    order_.out.write(buffer_);
+                    std::string().swap(buffer_);
+                }
+            }
+
+            OutputOrder& order_;
+            size_t index_;
+            bool owner_ = false;    // 是否已轮到该文件
+            std::string buffer_;    // 轮到之前的输出
+        };
+    }
+
+    double BatchStats::filesPerSecond() const
+    {
+        return seconds > 0 ? static_cast<double>(files) / seconds : 0;
+    }
+
+    double BatchStats::megabytesPerSecond() const
+    {
+        return seconds > 0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0;
+    }
+
+    bool BatchRunner::collectInputs(const std::vector<std::string>& inputs, const std::string& listPath,
+                                    std::vector<std::string>& files)
+    {
+        for (const std::string& input : inputs)
+        {
+            std::error_code ec;
+            if (std::filesystem::is_directory(input, ec))
+            {
+                collectDirectory(input, files);
+            }
+            else
+            {
+                collectFile(input, files);
+            }
+        }
+
+        if (listPath.empty())
+        {
+            return true;
+        }
+        if (listPath == "-")
+        {
+            readPathList(std::cin, files);
+            return true;
+        }
+        std::ifstream list(listPath);
+        if (!list)
+        {
+            LOGE("无法读取路径列表: %s", listPath.c_str());
+            return false;
+        }
+        readPathList(list, files);
+        return true;
+    }
+
+    BatchRunner::BatchRunner(const DexContext& config)
+        : verifyChecksum_(config.getVerifyChecksum()), verifySignature_(config.getVerifySignature()),
+          snapshotDir_(config.getSnapshotDir()), classFilter_(config.getClassFilter()),
+          memoryBudget_(config.getMemoryBudget())
+    {
+    }
+
+    void BatchRunner::setThreadCount(uint32_t threadCount)
+    {
+        threadCount_ = threadCount;
+    }
+
+    BatchStats BatchRunner::run(const std::vector<std::string>& files, print::OutputSink& out,
+                                const FileHandler& handler) const
+    {
+        std::atomic<size_t> failed{0};
+        std::atomic<uint64_t> bytes{0};
+        std::mutex logMutex;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        // 文件按输入顺序领取，输出按输入顺序交接
+        OutputOrder order(out, files.size());
+        parallelFor(files.size(), 1, threadCount_, [&](size_t, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                BatchFile file;
+                file.path = files[i];
+
+                // 独立的上下文，文件内部单线程处理
+                const auto context = std::make_unique<DexContext>();
+                context->setThreadCount(1);
+                context->setVerifyChecksum(verifyChecksum_);
+                context->setVerifySignature(verifySignature_);
+                context->setSnapshotDir(snapshotDir_);
+                context->setClassFilter(classFilter_);
+                context->setMemoryBudget(memoryBudget_);
+
+                OrderedFileSink sink(order, i);
+                bool ok;
+                {
+                    ScopedDexContext scope(*context);
+                    log_set_thread_capture(&file.log);
+
+                    // 每个文件一个DexDump，APK条目的解压缓冲区随文件释放，不在线程上留存最大的一个
+                    DexDump dexDump;
+                    file.opened = dexDump.open(file.path.c_str());
+                    if (file.opened)
+                    {
+                        file.size = context->getFileSize();
+                    }
+                    else
+                    {
+                        std::error_code ec;
+                        const auto size = std::filesystem::file_size(file.path, ec);
+                        file.size = ec ? 0 : size;
+                    }
+                    ok = handler(file, sink) && file.opened;
+                    dexDump.close();
+
+                    log_set_thread_capture(nullptr);
+                }
+                sink.finish();
+
+                bytes += file.size;
+                if (!ok)
+                {
+                    failed++;
+                }
+
+                // 捕获的日志整体写入stderr，不同文件之间不交错
+                if (!file.log.empty())
+                {
+                    std::lock_guard lock(logMutex);
+                    fprintf(stderr, "%s:\n%s", file.path.c_str(), file.log.c_str());
+                }
+            }
+        });
+
+        BatchStats stats;
+        stats.files = files.size();
+        stats.failed = failed;
+        stats.bytes = bytes;
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+}
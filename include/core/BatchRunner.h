@@ -0,0 +1,102 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "ClassFilter.h"
+#include "formatter/OutputSink.h"
+
+namespace dex
+{
+    class DexContext;
+
+    // 批量处理中的单个文件
+    struct BatchFile
+    {
+        std::string path;       // 文件路径
+        uint64_t size = 0;      // 文件大小（字节）
+        bool opened = false;    // 是否成功打开并解析
+        std::string log;        // 处理期间捕获的日志
+    };
+
+    // 批量处理统计
+    struct BatchStats
+    {
+        size_t files = 0;       // 文件数量
+        size_t failed = 0;      // 失败的文件数量
+        uint64_t bytes = 0;     // 文件总大小（字节）
+        double seconds = 0;     // 总耗时（秒）
+
+        // 每秒处理的文件数
+        double filesPerSecond() const;
+
+        // 每秒处理的数据量（MB）
+        double megabytesPerSecond() const;
+    };
+
+    /**
+     * BatchRunner - 批量处理DEX文件
+     * 文件由有上限的工作线程并行处理，每个文件使用独立的上下文并绑定到处理它的线程，
+     * 文件内部不再并行。处理期间的日志按文件捕获，各文件的输出按输入顺序写入同一个输出目标：
+     * 轮到的文件直接写出，其余文件的输出先缓冲，缓冲总量有上限，超出时等到轮到该文件再继续。
+     */
+    class BatchRunner
+    {
+    public:
+        /**
+         * 文件处理函数，在处理该文件的线程上调用，此时线程已绑定到该文件的上下文
+         * file.opened为false表示打开或解析失败，只需输出错误记录
+         * 返回false表示处理失败
+         */
+        using FileHandler = std::function<bool(const BatchFile& file, print::OutputSink& sink)>;
+
+        /**
+         * 展开输入路径
+         * 目录递归查找.dex和.apk文件（按路径排序），APK展开为其中的classes*.dex条目，
+         * 其他路径按DEX文件处理；
+         * listPath不为空时逐行读取路径列表，"-"表示标准输入
+         * @param inputs 命令行给出的文件或目录
+         * @param listPath 路径列表文件
+         * @param files 输出参数，展开后的文件路径
+         * @return 读取路径列表失败时返回false
+         */
+        static bool collectInputs(const std::vector<std::string>& inputs, const std::string& listPath,
+                                  std::vector<std::string>& files);
+
+        /**
+         * 构造函数
+         * @param config 配置来源，每个文件的上下文复制其校验选项、快照目录、类过滤器和缓存预算
+         */
+        explicit BatchRunner(const DexContext& config);
+
+        // 设置工作线程数，0表示使用硬件线程数
+        void setThreadCount(uint32_t threadCount);
+
+        /**
+         * 处理全部文件
+         * @param files 文件路径
+         * @param out 汇总输出目标
+         * @param handler 文件处理函数
+         * @return 统计信息
+         */
+        BatchStats run(const std::vector<std::string>& files, print::OutputSink& out,
+                       const FileHandler& handler) const;
+
+    private:
+        bool verifyChecksum_;
+        bool verifySignature_;
+        std::string snapshotDir_;
+        ClassFilter classFilter_;
+        uint64_t memoryBudget_;
+        uint32_t threadCount_ = 0;
+    };
+}
+
+#endif //BATCHRUNNER_H
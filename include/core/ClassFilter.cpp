@@ -0,0 +1,165 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "ClassFilter.h"
+
+#include <algorithm>
+#include "DexContext.h"
+
+namespace dex
+{
+    namespace
+    {
+        constexpr std::string_view kWildcards = "*?";
+    }
+
+    bool ClassFilter::addPattern(std::string_view pattern)
+    {
+        // 去掉首尾空白
+        while (!pattern.empty() && (pattern.front() == ' ' || pattern.front() == '\t'))
+        {
+            pattern.remove_prefix(1);
+        }
+        while (!pattern.empty() && (pattern.back() == ' ' || pattern.back() == '\t'))
+        {
+            pattern.remove_suffix(1);
+        }
+        if (pattern.empty())
+        {
+            return false;
+        }
+
+        patterns_.push_back(normalize(pattern));
+        return true;
+    }
+
+    bool ClassFilter::empty() const
+    {
+        return patterns_.empty();
+    }
+
+    const std::vector<std::string>& ClassFilter::getPatterns() const
+    {
+        return patterns_;
+    }
+
+    bool ClassFilter::matches(std::string_view descriptor) const
+    {
+        return std::any_of(patterns_.begin(), patterns_.end(),
+                           [descriptor](const std::string& pattern)
+                           {
+                               return matchPattern(pattern, descriptor);
+                           });
+    }
+
+    std::vector<uint8_t> ClassFilter::selectTypes(const DexContext& context) const
+    {
+        const std::span<const DexTypeId> typeIds = context.getTypeIds();
+        std::vector<uint8_t> selected(typeIds.size(), 0);
+
+        const auto descriptorAt = [&](size_t typeIdx)
+        {
+            return context.getStringData(typeIds[typeIdx].descriptor_idx);
+        };
+
+        for (const std::string& pattern : patterns_)
+        {
+            const std::string_view literal = std::string_view(pattern).substr(0, pattern.find_first_of(kWildcards));
+
+            // 第一个描述符不小于字面前缀的类型
+            size_t low = 0;
+            size_t high = typeIds.size();
+            while (low < high)
+            {
+                const size_t mid = low + (high - low) / 2;
+                if (descriptorAt(mid) < literal)
+                {
+                    low = mid + 1;
+                }
+                else
+                {
+                    high = mid;
+                }
+            }
+
+            // 以字面前缀开头的类型是连续的
+            for (size_t i = low; i < typeIds.size(); i++)
+            {
+                const std::string_view descriptor = descriptorAt(i);
+                if (!descriptor.starts_with(literal))
+                {
+                    break;
+                }
+                if (!selected[i] && matchPattern(pattern, descriptor))
+                {
+                    selected[i] = 1;
+                }
+            }
+        }
+
+        return selected;
+    }
+
+    std::string ClassFilter::normalize(std::string_view pattern)
+    {
+        // 已经是描述符形式
+        if (pattern.find('.') == std::string_view::npos && (pattern.front() == 'L' || pattern.front() == '['))
+        {
+            return std::string(pattern);
+        }
+
+        std::string result;
+        result.reserve(pattern.size() + 1);
+        result.push_back('L');
+        for (const char c : pattern)
+        {
+            result.push_back(c == '.' ? '/' : c);
+        }
+        return result;
+    }
+
+    bool ClassFilter::matchPattern(std::string_view pattern, std::string_view descriptor)
+    {
+        if (pattern.find_first_of(kWildcards) == std::string_view::npos)
+        {
+            return descriptor.starts_with(pattern);
+        }
+        return globMatch(pattern, descriptor);
+    }
+
+    bool ClassFilter::globMatch(std::string_view pattern, std::string_view text)
+    {
+        while (!pattern.empty())
+        {
+            if (pattern.front() == '*')
+            {
+                const bool crossPackage = pattern.size() > 1 && pattern[1] == '*';
+                const std::string_view rest = pattern.substr(crossPackage ? 2 : 1);
+                for (size_t i = 0;; i++)
+                {
+                    if (globMatch(rest, text.substr(i)))
+                    {
+                        return true;
+                    }
+                    if (i == text.size() || (!crossPackage && text[i] == '/'))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            if (text.empty())
+            {
+                return false;
+            }
+            if (pattern.front() == '?' ? text.front() == '/' : pattern.front() != text.front())
+            {
+                return false;
+            }
+            pattern.remove_prefix(1);
+            text.remove_prefix(1);
+        }
+        return text.empty();
+    }
+}
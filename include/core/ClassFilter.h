@@ -0,0 +1,69 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef CLASSFILTER_H
+#define CLASSFILTER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dex
+{
+    class DexContext;
+
+    /**
+     * ClassFilter - 类描述符过滤器
+     * 多个模式之间是“或”的关系。模式可以写成描述符（Lcom/ourco/）或Java名（com.ourco.），
+     * Java名中的.替换为/并补上开头的L。
+     * 不含通配符的模式按前缀匹配；含通配符时整体匹配：
+     *   *  匹配任意个除/以外的字符（同一包内）
+     *   ** 匹配任意个字符（包括子包）
+     *   ?  匹配一个除/以外的字符
+     */
+    class ClassFilter
+    {
+    public:
+        /**
+         * 添加一个模式
+         * @param pattern 描述符或Java名形式的模式
+         * @return 模式为空时返回false
+         */
+        bool addPattern(std::string_view pattern);
+
+        // 是否没有任何模式（不过滤）
+        bool empty() const;
+
+        // 获取规范化后的模式
+        const std::vector<std::string>& getPatterns() const;
+
+        // 检查类描述符是否匹配任一模式
+        bool matches(std::string_view descriptor) const;
+
+        /**
+         * 在类型表中选出匹配的类型
+         * 类型表按描述符排序，每个模式先用通配符之前的字面前缀二分查找候选区间，
+         * 只对区间内的类型做完整匹配，不解码任何字符串
+         * @param context 已设置字符串ID表和类型ID表的上下文
+         * @return 按类型索引的选中标记
+         */
+        std::vector<uint8_t> selectTypes(const DexContext& context) const;
+
+    private:
+        // 把模式规范化为描述符形式
+        static std::string normalize(std::string_view pattern);
+
+        // 检查描述符是否匹配单个规范化后的模式
+        static bool matchPattern(std::string_view pattern, std::string_view descriptor);
+
+        // 通配符匹配
+        static bool globMatch(std::string_view pattern, std::string_view text);
+
+        // 规范化后的模式
+        std::vector<std::string> patterns_;
+    };
+}
+
+#endif //CLASSFILTER_H
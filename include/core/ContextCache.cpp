@@ -0,0 +1,229 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "ContextCache.h"
+
+#include <system_error>
+#include "ZipArchive.h"
+#include "log/log.h"
+
+namespace dex
+{
+    namespace
+    {
+        // APK条目检查APK本身的修改时间和大小
+        std::filesystem::path statPath(const std::string& path)
+        {
+            std::string archivePath;
+            std::string entryName;
+            if (ZipArchive::splitEntryPath(path, archivePath, entryName))
+            {
+                return archivePath;
+            }
+            return path;
+        }
+    }
+
+    CachedDex::~CachedDex()
+    {
+        // DexDump::close重置的是当前线程绑定的上下文
+        ScopedDexContext scope(context);
+        dump.close();
+    }
+
+    ContextCache::ContextCache(uint64_t memoryBudget, const DexContext& config)
+        : memoryBudget_(memoryBudget), verifyChecksum_(config.getVerifyChecksum()),
+          verifySignature_(config.getVerifySignature()), snapshotDir_(config.getSnapshotDir()),
+          classFilter_(config.getClassFilter()), contextBudget_(config.getMemoryBudget())
+    {
+    }
+
+    ContextCache::Lease ContextCache::acquire(const std::string& path)
+    {
+        std::shared_ptr<CachedDex> entry;
+        {
+            std::lock_guard lock(mutex_);
+            if (const auto it = index_.find(path); it != index_.end())
+            {
+                lru_.splice(lru_.begin(), lru_, it->second);
+                entry = *it->second;
+            }
+            else
+            {
+                entry = std::make_shared<CachedDex>();
+                entry->path = path;
+                lru_.push_front(entry);
+                index_.emplace(path, lru_.begin());
+            }
+        }
+
+        // 解析在缓存锁之外进行，同一文件的其他请求在entry的锁上等待
+        std::unique_lock entryLock(entry->mutex);
+
+        if (entry->loaded)
+        {
+            std::error_code sizeError;
+            std::error_code timeError;
+            const std::filesystem::path file = statPath(entry->path);
+            const uintmax_t size = std::filesystem::file_size(file, sizeError);
+            const auto modified = std::filesystem::last_write_time(file, timeError);
+            if (sizeError || timeError || size != entry->fileSize || modified != entry->modified)
+            {
+                LOGI("文件已改变，重新解析: %s", entry->path.c_str());
+                {
+                    ScopedDexContext scope(entry->context);
+                    entry->dump.close();
+                }
+                entry->loaded = false;
+
+                // 等待entry的锁期间文件可能已被淘汰或替换，那时它的开销已经扣除
+                std::lock_guard lock(mutex_);
+                if (const auto it = index_.find(entry->path); it != index_.end() && it->second->get() == entry.get())
+                {
+                    usage_ -= entry->cost;
+                }
+                entry->cost = 0;
+            }
+        }
+
+        if (!entry->loaded)
+        {
+            if (!load(*entry))
+            {
+                std::lock_guard lock(mutex_);
+                removeLocked(*entry);
+                return {};
+            }
+
+            std::lock_guard lock(mutex_);
+            if (const auto it = index_.find(path); it != index_.end() && it->second->get() == entry.get())
+            {
+                entry->cost = estimateCost(*entry);
+                usage_ += entry->cost;
+                evictLocked(entry.get());
+            }
+        }
+
+        return {std::move(entry), std::move(entryLock)};
+    }
+
+    void ContextCache::updateCost(const Lease& lease)
+    {
+        CachedDex& entry = *lease.entry;
+        entry.context.trimCaches();
+        const uint64_t cost = estimateCost(entry);
+
+        std::lock_guard lock(mutex_);
+        if (const auto it = index_.find(entry.path); it == index_.end() || it->second->get() != &entry)
+        {
+            return;
+        }
+        usage_ = usage_ - entry.cost + cost;
+        entry.cost = cost;
+        evictLocked(&entry);
+    }
+
+    std::vector<ContextCache::EntryInfo> ContextCache::list() const
+    {
+        std::lock_guard lock(mutex_);
+        std::vector<EntryInfo> entries;
+        entries.reserve(lru_.size());
+        for (const auto& entry : lru_)
+        {
+            entries.push_back({entry->path, entry->cost});
+        }
+        return entries;
+    }
+
+    uint64_t ContextCache::memoryUsage() const
+    {
+        std::lock_guard lock(mutex_);
+        return usage_;
+    }
+
+    uint64_t ContextCache::memoryBudget() const
+    {
+        return memoryBudget_;
+    }
+
+    uint64_t ContextCache::estimateCost(const CachedDex& entry)
+    {
+        // 映射的文件，加上APK中解压或复制出来的DEX数据和解析缓存
+        uint64_t cost = entry.fileSize;
+        if (entry.context.getFileData() != nullptr && entry.context.getFileSize() != entry.fileSize)
+        {
+            cost += entry.context.getFileSize();
+        }
+        return cost + entry.context.getMemoryUsage().totalBytes();
+    }
+
+    bool ContextCache::load(CachedDex& entry) const
+    {
+        // 先记录修改时间再解析，解析期间文件被修改时下次获取会重新解析
+        std::error_code sizeError;
+        std::error_code timeError;
+        const std::filesystem::path file = statPath(entry.path);
+        entry.fileSize = std::filesystem::file_size(file, sizeError);
+        entry.modified = std::filesystem::last_write_time(file, timeError);
+        if (sizeError || timeError)
+        {
+            LOGE("无法访问文件: %s (%s)", entry.path.c_str(),
+                 (sizeError ? sizeError : timeError).message().c_str());
+            return false;
+        }
+
+        // 同一文件的请求已经串行，文件内部不再并行
+        entry.context.setThreadCount(1);
+        entry.context.setVerifyChecksum(verifyChecksum_);
+        entry.context.setVerifySignature(verifySignature_);
+        entry.context.setSnapshotDir(snapshotDir_);
+        entry.context.setClassFilter(classFilter_);
+        entry.context.setMemoryBudget(contextBudget_);
+
+        ScopedDexContext scope(entry.context);
+        if (!entry.dump.open(entry.path.c_str()))
+        {
+            LOGE("打开DEX文件失败: %s", entry.path.c_str());
+            return false;
+        }
+        entry.loaded = true;
+        LOGI("已解析: %s", entry.path.c_str());
+        return true;
+    }
+
+    void ContextCache::removeLocked(const CachedDex& entry)
+    {
+        const auto it = index_.find(entry.path);
+        if (it == index_.end() || it->second->get() != &entry)
+        {
+            return;
+        }
+        usage_ -= entry.cost;
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    void ContextCache::evictLocked(const CachedDex* keep)
+    {
+        if (memoryBudget_ == 0)
+        {
+            return;
+        }
+        // 从最久未使用的一端淘汰，正在使用的文件在释放后关闭
+        auto it = lru_.end();
+        while (usage_ > memoryBudget_ && it != lru_.begin())
+        {
+            --it;
+            const std::shared_ptr<CachedDex>& entry = *it;
+            if (entry.get() == keep || entry->cost == 0)
+            {
+                continue;
+            }
+            LOGI("内存超出预算，淘汰: %s", entry->path.c_str());
+            usage_ -= entry->cost;
+            index_.erase(entry->path);
+            it = lru_.erase(it);
+        }
+    }
+}
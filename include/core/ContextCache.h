@@ -0,0 +1,133 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef CONTEXTCACHE_H
+#define CONTEXTCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ClassFilter.h"
+#include "DexContext.h"
+#include "DexDump.h"
+
+namespace dex
+{
+    /**
+     * 缓存中的一个已解析文件
+     * 上下文的延迟缓存不是线程安全的，使用前必须持有mutex并把当前线程绑定到context
+     */
+    struct CachedDex
+    {
+        std::string path;                               // 文件路径（可以是app.apk!classes2.dex）
+        DexContext context;                             // 该文件独立的上下文
+        DexDump dump;                                   // 持有文件映射
+        std::mutex mutex;                               // 同一文件的请求串行处理
+        bool loaded = false;                            // 是否已成功解析
+        uint64_t cost = 0;                              // 计入内存预算的字节数，由ContextCache::mutex_保护
+        uintmax_t fileSize = 0;                         // 解析时的文件大小
+        std::filesystem::file_time_type modified;       // 解析时的修改时间
+
+        CachedDex() = default;
+        ~CachedDex();
+
+        CachedDex(const CachedDex&) = delete;
+        CachedDex& operator=(const CachedDex&) = delete;
+    };
+
+    /**
+     * ContextCache - 已解析文件的LRU缓存
+     * 按路径缓存每个文件的上下文和映射，总开销超过内存预算时淘汰最久未使用的文件。
+     * 文件的修改时间或大小变化后在下次获取时重新解析。
+     * 被淘汰但仍在使用中的文件在最后一个使用者释放后才关闭。
+     */
+    class ContextCache
+    {
+    public:
+        /**
+         * 已锁定的缓存文件，持有期间独占该文件
+         * entry为nullptr表示打开或解析失败
+         */
+        struct Lease
+        {
+            std::shared_ptr<CachedDex> entry;
+            std::unique_lock<std::mutex> lock;
+
+            explicit operator bool() const
+            {
+                return entry != nullptr;
+            }
+        };
+
+        // 缓存文件的状态
+        struct EntryInfo
+        {
+            std::string path;   // 文件路径
+            uint64_t cost;      // 计入预算的字节数，正在解析的文件为0
+        };
+
+        /**
+         * 构造函数
+         * @param memoryBudget 内存预算（字节），0表示不限制
+         * @param config 配置来源，每个文件的上下文复制其校验选项、快照目录、类过滤器和缓存预算
+         */
+        ContextCache(uint64_t memoryBudget, const DexContext& config);
+
+        /**
+         * 获取并锁定已解析的文件，不在缓存中或文件已改变时重新解析
+         * 新解析的文件计入预算后按LRU淘汰其他文件，当前文件即使超出预算也保留
+         * @param path 文件路径
+         * @return 解析失败时entry为nullptr，错误记录在日志中
+         */
+        Lease acquire(const std::string& path);
+
+        /**
+         * 请求结束后按上下文的缓存预算淘汰冷缓存，并按新的缓存占用重新计入预算
+         * 调用时持有租约，缓存增长使总占用超出预算时淘汰其他文件
+         * @param lease acquire返回的租约
+         */
+        void updateCost(const Lease& lease);
+
+        // 当前缓存的文件，最近使用的在前
+        std::vector<EntryInfo> list() const;
+
+        // 已计入预算的总字节数
+        uint64_t memoryUsage() const;
+
+        // 内存预算（字节）
+        uint64_t memoryBudget() const;
+
+    private:
+        // 估算已解析文件计入预算的字节数
+        static uint64_t estimateCost(const CachedDex& entry);
+
+        // 解析文件，调用时持有entry的锁
+        bool load(CachedDex& entry) const;
+
+        // 把文件移出缓存（仍在使用中的文件在释放后关闭），文件已被替换或淘汰时不做任何事，调用时持有mutex_
+        void removeLocked(const CachedDex& entry);
+
+        // 淘汰最久未使用的文件直到不超过预算，keep不会被淘汰，调用时持有mutex_
+        void evictLocked(const CachedDex* keep);
+
+        uint64_t memoryBudget_;
+        bool verifyChecksum_;
+        bool verifySignature_;
+        std::string snapshotDir_;
+        ClassFilter classFilter_;
+        uint64_t contextBudget_;
+
+        mutable std::mutex mutex_;
+        std::list<std::shared_ptr<CachedDex>> lru_;
+        std::unordered_map<std::string, std::list<std::shared_ptr<CachedDex>>::iterator> index_;
+        uint64_t usage_ = 0;
+    };
+}
+
+#endif //CONTEXTCACHE_H
@@ -0,0 +1,115 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "CpuFeatures.h"
+
+#include <cstdint>
+
+#if defined(DEX_ARCH_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace dex
+{
+#if defined(DEX_ARCH_X86)
+    // 执行cpuid指令
+    static void cpuid(uint32_t leaf, uint32_t subLeaf, uint32_t regs[4])
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+        for (int i = 0; i < 4; i++)
+        {
+            regs[i] = static_cast<uint32_t>(info[i]);
+        }
+#else
+        __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
+    // 读取XCR0，判断操作系统是否启用了AVX状态保存
+    static uint64_t readXcr0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        uint32_t eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+    }
+
+    static bool detectAvx2()
+    {
+        uint32_t regs[4];
+        cpuid(0, 0, regs);
+        if (regs[0] < 7)
+        {
+            return false;
+        }
+
+        // CPUID.1:ECX.OSXSAVE[27] 和 AVX[28]
+        cpuid(1, 0, regs);
+        if ((regs[2] & (1u << 27)) == 0 || (regs[2] & (1u << 28)) == 0)
+        {
+            return false;
+        }
+
+        // XMM和YMM状态均由操作系统保存
+        if ((readXcr0() & 0x6) != 0x6)
+        {
+            return false;
+        }
+
+        // CPUID.7.0:EBX.AVX2[5]
+        cpuid(7, 0, regs);
+        return (regs[1] & (1u << 5)) != 0;
+    }
+
+    static bool detectShaNi()
+    {
+        uint32_t regs[4];
+        cpuid(0, 0, regs);
+        if (regs[0] < 7)
+        {
+            return false;
+        }
+
+        // CPUID.1:ECX.SSSE3[9] 和 SSE4.1[19]
+        cpuid(1, 0, regs);
+        if ((regs[2] & (1u << 9)) == 0 || (regs[2] & (1u << 19)) == 0)
+        {
+            return false;
+        }
+
+        // CPUID.7.0:EBX.SHA[29]
+        cpuid(7, 0, regs);
+        return (regs[1] & (1u << 29)) != 0;
+    }
+#endif
+
+    bool cpuHasAvx2()
+    {
+#if defined(DEX_ARCH_X86)
+        static const bool hasAvx2 = detectAvx2();
+        return hasAvx2;
+#else
+        return false;
+#endif
+    }
+
+    bool cpuHasShaNi()
+    {
+#if defined(DEX_ARCH_X86)
+        static const bool hasShaNi = detectShaNi();
+        return hasShaNi;
+#else
+        return false;
+#endif
+    }
+}
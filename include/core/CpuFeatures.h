@@ -0,0 +1,34 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DEX_ARCH_X86 1
+#endif
+
+// GCC/Clang需要为使用扩展指令集的函数单独指定目标，MSVC可直接使用内建函数
+#if defined(DEX_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define DEX_TARGET(isa) __attribute__((target(isa)))
+#else
+#define DEX_TARGET(isa)
+#endif
+
+namespace dex
+{
+    /**
+     * 运行时检测CPU是否支持AVX2（同时检查操作系统是否保存YMM寄存器）
+     * @return 是否支持
+     */
+    bool cpuHasAvx2();
+
+    /**
+     * 运行时检测CPU是否支持SHA扩展指令（SHA-NI，同时要求SSSE3和SSE4.1）
+     * @return 是否支持
+     */
+    bool cpuHasShaNi();
+}
+
+#endif // CPUFEATURES_H
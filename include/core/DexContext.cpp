@@ -3,20 +3,195 @@
 //
 
 #include "DexContext.h"
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
+#include <iterator>
+#include <unordered_map>
 #include "log/log.h"
+#include "parser/CodeParser.h"
+#include "PhaseStats.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
 
 namespace dex
 {
+    namespace
+    {
+        // 当前线程绑定的上下文
+        thread_local DexContext* currentContext = nullptr;
+
+        constexpr const char* kCacheNames[] = {
+            "strings", "types", "protos", "fields", "methods", "class_defs", "class_data",
+            "type_lists", "debug_info", "try_catch", "indexes",
+        };
+        static_assert(std::size(kCacheNames) == static_cast<size_t>(CacheKind::Count));
+
+        // 短字符串存放在对象内部，不占用堆内存
+        const size_t kInlineStringCapacity = std::string().capacity();
+
+        // std::map节点在键值之外的开销：三个指针和颜色
+        constexpr uint64_t kMapNodeOverhead = 4 * sizeof(void*);
+
+        // 字符串的堆内存
+        uint64_t heapBytes(const std::string& string)
+        {
+            return string.capacity() > kInlineStringCapacity ? string.capacity() + 1 : 0;
+        }
+
+        template <typename T>
+        uint64_t vectorBytes(const std::vector<T>& vector)
+        {
+            return vector.capacity() * sizeof(T);
+        }
+
+        // 字符串数组及其元素的堆内存，entries为非空字符串数量
+        uint64_t stringsBytes(const std::vector<std::string>& strings, uint64_t* entries = nullptr)
+        {
+            uint64_t bytes = vectorBytes(strings);
+            for (const std::string& string : strings)
+            {
+                bytes += heapBytes(string);
+                if (entries != nullptr && !string.empty())
+                {
+                    (*entries)++;
+                }
+            }
+            return bytes;
+        }
+
+        // 代码信息中try块和处理器表的堆内存
+        uint64_t codeInfoBytes(const CodeInfo& codeInfo)
+        {
+            uint64_t bytes = vectorBytes(codeInfo.tries) + vectorBytes(codeInfo.handlers);
+            for (const CatchHandlerInfo& handler : codeInfo.handlers)
+            {
+                bytes += vectorBytes(handler.catches);
+            }
+            return bytes;
+        }
+
+        // 类数据的堆内存（对象本身在类定义缓存中）
+        uint64_t classDataBytes(const ClassDefInfo::ClassDataInfo& classData)
+        {
+            uint64_t bytes = vectorBytes(classData.staticFields) + vectorBytes(classData.instanceFields) +
+                             vectorBytes(classData.directMethods) + vectorBytes(classData.virtualMethods);
+            for (const auto* fields : {&classData.staticFields, &classData.instanceFields})
+            {
+                for (const auto& field : *fields)
+                {
+                    bytes += heapBytes(field.name) + heapBytes(field.type);
+                }
+            }
+            for (const auto* methods : {&classData.directMethods, &classData.virtualMethods})
+            {
+                for (const auto& method : *methods)
+                {
+                    bytes += heapBytes(method.name) + heapBytes(method.proto) + codeInfoBytes(method.codeInfo);
+                }
+            }
+            return bytes;
+        }
+
+        // 类定义信息中字符串的堆内存，不含类数据
+        uint64_t classDefBytes(const ClassDefInfo& info)
+        {
+            return heapBytes(info.className) + heapBytes(info.superClassName) + heapBytes(info.sourceFileName) +
+                   stringsBytes(info.interfaces);
+        }
+
+        // 类型列表缓存中一个条目的内存
+        uint64_t typeListBytes(const TypeListData& typeList)
+        {
+            return kMapNodeOverhead + sizeof(std::pair<const uint32_t, TypeListData>) + vectorBytes(typeList.items);
+        }
+
+        // 调试信息的全部内存
+        uint64_t debugInfoBytes(const DebugInfoData& debugInfo)
+        {
+            uint64_t bytes = sizeof(DebugInfoData) - sizeof(LineTable) + debugInfo.lines.memoryUsage() +
+                             stringsBytes(debugInfo.parameterNames) + vectorBytes(debugInfo.localVars) +
+                             vectorBytes(debugInfo.localEvents);
+            for (const LocalVarInfo& local : debugInfo.localVars)
+            {
+                bytes += heapBytes(local.name) + heapBytes(local.type) + heapBytes(local.signature);
+            }
+            return bytes;
+        }
+        // ULEB128最多占5字节，编码字段为2个、编码方法为3个
+        constexpr uint64_t kMaxULEB128Size = 5;
+
+        /**
+         * 解码类数据中的字段和方法列表（索引为相对前一项的差值）
+         * Reader为CheckedReader或UncheckedReader，由调用方根据段内剩余长度选择
+         */
+        template <typename Reader>
+        void decodeClassMembers(Reader& reader, ClassDefInfo::ClassDataInfo& classData)
+        {
+            for (auto* fields : {&classData.staticFields, &classData.instanceFields})
+            {
+                uint32_t fieldIdx = 0;
+                for (ClassDefInfo::ClassDataInfo::EncodedFieldInfo& field : *fields)
+                {
+                    fieldIdx += reader.readULEB128();
+                    field.fieldIdx = fieldIdx;
+                    field.accessFlags = reader.readULEB128();
+                }
+            }
+
+            for (auto* methods : {&classData.directMethods, &classData.virtualMethods})
+            {
+                uint32_t methodIdx = 0;
+                for (ClassDefInfo::ClassDataInfo::EncodedMethodInfo& method : *methods)
+                {
+                    methodIdx += reader.readULEB128();
+                    method.methodIdx = methodIdx;
+                    method.accessFlags = reader.readULEB128();
+                    method.codeOff = reader.readULEB128();
+                }
+            }
+        }
+
+        // 解码一个异常处理器的catch项和catch-all地址，Reader的选择同上
+        template <typename Reader>
+        void decodeCatchHandler(Reader& reader, CatchHandlerInfo& handler)
+        {
+            for (CatchHandlerInfo::CatchInfo& catchInfo : handler.catches)
+            {
+                catchInfo.typeIdx = reader.readULEB128();
+                catchInfo.address = reader.readULEB128();
+            }
+
+            if (handler.hasCatchAll)
+            {
+                handler.catchAllAddr = reader.readULEB128();
+            }
+        }
+    }
+
     DexContext& DexContext::getInstance()
     {
+        if (currentContext != nullptr)
+        {
+            return *currentContext;
+        }
         static DexContext instance;
         return instance;
     }
 
+    DexContext* DexContext::bindCurrent(DexContext* context)
+    {
+        DexContext* previous = currentContext;
+        currentContext = context;
+        return previous;
+    }
+
     DexContext::DexContext() : fileData_(nullptr), fileSize_(0), stringsLoaded_(false), typeSLoad_(false),
                                protoLoad_(false), fieldsLoaded_(false), methodsLoaded_(false),
-                               classDefsLoaded_(false), isValid_(false)
+                               classDefsLoaded_(false), isValid_(false), threadCount_(0),
+                               verifyChecksum_(true), verifySignature_(true), contentHash_{},
+                               hasContentHash_(false), snapshot_(nullptr), memoryBudget_(0),
+                               cacheEpoch_(0), classDataEvicted_(false)
     {
         // 清空头部结构和DexFile结构
         memset(&header_, 0, sizeof(DexHeader));
@@ -39,6 +214,24 @@ namespace dex
         return fileSize_;
     }
 
+    // 检查数据是否完整位于映射的文件范围内
+    bool DexContext::isMappedRange(const void* data, size_t size) const
+    {
+        if (fileData_ == nullptr || data == nullptr)
+        {
+            return false;
+        }
+
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(fileData_);
+        const uintptr_t addr = reinterpret_cast<uintptr_t>(data);
+        if (addr < begin || size > fileSize_ || addr - begin > fileSize_ - size)
+        {
+            LOGE("ID表不在映射的文件范围内");
+            return false;
+        }
+        return true;
+    }
+
     // Header头
     void DexContext::setHeader(const DexHeader& header)
     {
@@ -59,14 +252,14 @@ namespace dex
     void DexContext::setStringIds(const DexStringId* stringIds, uint32_t count)
     {
         // 清空现有字符串ID表
-        stringIds_.clear();
+        stringIds_ = {};
         stringCache_.clear();
         stringsLoaded_ = false;
 
-        // 复制字符串ID表
-        if (stringIds != nullptr && count > 0)
+        // 直接引用映射文件中的字符串ID表
+        if (stringIds != nullptr && count > 0 && isMappedRange(stringIds, count * sizeof(DexStringId)))
         {
-            stringIds_.assign(stringIds, stringIds + count);
+            stringIds_ = std::span<const DexStringId>(stringIds, count);
 
             // 初始化字符串缓存，但不加载内容
             stringCache_.resize(count);
@@ -74,9 +267,10 @@ namespace dex
             // 更新全局DexFile中的字符串ID表指针
             dexFile_.pStringIds = stringIds_.data();
         }
+        measureCache(CacheKind::Strings);
     }
 
-    const std::vector<DexStringId>& DexContext::getStringIds() const
+    std::span<const DexStringId> DexContext::getStringIds() const
     {
         return stringIds_;
     }
@@ -100,6 +294,12 @@ namespace dex
             return stringCache_[idx];
         }
 
+        // 快照中保存的是解码后的字符串
+        if (snapshot_ != nullptr)
+        {
+            return std::string(snapshot_->getString(idx));
+        }
+
         // 获取字符串数据的偏移量
         const uint32_t offset = stringIds_[idx].stringDataOff;
 
@@ -110,9 +310,30 @@ namespace dex
             return "";
         }
 
-        // 获取字符串数据指针并解码
-        const uint8_t* stringData = fileData_ + offset;
-        return decodeMUTF8(stringData);
+        // 字符串数据已由StringPoolParser验证位于文件范围内，这里不再逐字节检查
+        PhaseTimer timer(Phase::StringDecode);
+        UncheckedReader reader(fileData_, fileSize_, offset);
+        const uint32_t length = reader.readULEB128();
+        std::string text = decodeMUTF8(reader.current(), length);
+        timer.addBytes(text.size());
+        timer.addItems(1);
+        return text;
+    }
+
+    std::string_view DexContext::getStringData(uint32_t idx) const
+    {
+        if (idx >= stringIds_.size() || fileData_ == nullptr || stringIds_[idx].stringDataOff >= fileSize_)
+        {
+            return {};
+        }
+
+        // 长度前缀是UTF-16码元数量而不是字节数，按结尾的0确定字节范围
+        UncheckedReader reader(fileData_, fileSize_, stringIds_[idx].stringDataOff);
+        reader.readULEB128();
+        const char* data = reinterpret_cast<const char*>(reader.current());
+        const size_t remaining = reader.remaining();
+        const void* terminator = memchr(data, 0, remaining);
+        return {data, terminator != nullptr ? static_cast<size_t>(static_cast<const char*>(terminator) - data) : remaining};
     }
 
     bool DexContext::loadAllStrings() const
@@ -141,6 +362,7 @@ namespace dex
 
         // 标记为已加载所有字符串
         stringsLoaded_ = true;
+        measureCache(CacheKind::Strings);
 
         LOGI("加载了 %zu 个字符串", stringCache_.size());
         return true;
@@ -151,22 +373,25 @@ namespace dex
     void DexContext::setTypeIds(const DexTypeId* typeIds, uint32_t count)
     {
         // 清空现有TypeID表
-        typeIds_.clear();
+        typeIds_ = {};
         typeCache_.clear();
         typeSLoad_ = false;
-        // 复制TypeID表
-        if (typeIds != nullptr && count > 0)
+        // 直接引用映射文件中的TypeID表
+        if (typeIds != nullptr && count > 0 && isMappedRange(typeIds, count * sizeof(DexTypeId)))
         {
-            typeIds_.assign(typeIds, typeIds + count);
+            typeIds_ = std::span<const DexTypeId>(typeIds, count);
 
             typeCache_.resize(count);
 
             // 更新全局DexFile中的TypeID表指针
             dexFile_.pTypeIds = typeIds_.data();
         }
+        measureCache(CacheKind::Types);
+
+        applyClassFilter();
     }
 
-    const std::vector<DexTypeId>& DexContext::getTypeIds() const
+    std::span<const DexTypeId> DexContext::getTypeIds() const
     {
         return typeIds_;
     }
@@ -196,6 +421,7 @@ namespace dex
             typeCache_[i] = getString(typeIds_[i].descriptor_idx);
         }
         typeSLoad_ = true;
+        measureCache(CacheKind::Types);
         LOGI("加载了 %zu 个类型", typeCache_.size());
         return true;
     }
@@ -224,8 +450,8 @@ namespace dex
 
     const TypeListData* DexContext::parseTypeList(uint32_t offset) const
     {
-        // 检查偏移量是否有效
-        if (offset == 0 || offset >= fileSize_)
+        // 检查偏移量是否有效（type_list要求4字节对齐且位于type_list段内）
+        if (offset == 0 || offset % 4 != 0 || !isInSection(kDexTypeTypeList, offset, sizeof(uint32_t)))
         {
             LOGE("TypeList偏移量无效: %u", offset);
             return nullptr;
@@ -241,10 +467,11 @@ namespace dex
         // 指向TypeList的指针
         const DexTypeList* rawTypeList = reinterpret_cast<const DexTypeList*>(fileData_ + offset);
 
-        // 检查size字段是否有效
-        if (offset + sizeof(uint32_t) + rawTypeList->size * sizeof(DexTypeItem) > fileSize_)
+        // 整个列表位于段内时逐项复制不再检查
+        if (!isInSection(kDexTypeTypeList, offset,
+                         sizeof(uint32_t) + static_cast<uint64_t>(rawTypeList->size) * sizeof(DexTypeItem)))
         {
-            LOGE("TypeList大小无效: %u", rawTypeList->size);
+            LOGE("TypeList大小无效: 0x%08X", offset);
             return nullptr;
         }
 
@@ -261,28 +488,31 @@ namespace dex
                 typeListData.items[i] = rawTypeList->list[i];
             }
         }
+        addCacheUsage(CacheKind::TypeLists, 1, static_cast<int64_t>(typeListBytes(typeListData)));
 
         return &typeListData;
     }
 
     void DexContext::setProtoIds(const DexProtoId* proto_id, uint32_t count)
     {
-        protoIds_.clear();
-        protoCacheShort_.clear();
+        protoIds_ = {};
         protoCacheShort_.clear();
+        protoCacheReturn_.clear();
         protoCacheParameter_.clear();
         typeListCache_.clear();
         protoLoad_ = false;
 
-        if (proto_id != nullptr && count > 0)
+        if (proto_id != nullptr && count > 0 && isMappedRange(proto_id, count * sizeof(DexProtoId)))
         {
-            protoIds_.assign(proto_id, proto_id + count);
+            protoIds_ = std::span<const DexProtoId>(proto_id, count);
 
             protoCacheShort_.resize(count);
             protoCacheReturn_.resize(count);
             protoCacheParameter_.resize(count);
             dexFile_.pProtoIds = protoIds_.data();
         }
+        measureCache(CacheKind::Protos);
+        measureCache(CacheKind::TypeLists);
 
         if (!loadAllProtos())
         {
@@ -314,18 +544,16 @@ namespace dex
             protoCacheReturn_[i] = getType(protoIds_[i].return_type_idx);
             if (protoIds_[i].parameters_off != 0)
             {
-                const unsigned char* offset = fileData_ + protoIds_[i].parameters_off;
-                const DexTypeList* typeList{};
-
                 parseTypeList(protoIds_[i].parameters_off);
             }
         }
         protoLoad_ = true;
+        measureCache(CacheKind::Protos);
         LOGI("加载了:%zu 个Proto", protoIds_.size());
         return true;
     }
 
-    const std::vector<DexProtoId>& DexContext::getProtoIds() const
+    std::span<const DexProtoId> DexContext::getProtoIds() const
     {
         return protoIds_;
     }
@@ -385,18 +613,55 @@ namespace dex
         return parseTypeList(parameters_off);
     }
 
+    std::string DexContext::getProtoString(uint32_t idx) const
+    {
+        if (idx >= protoIds_.size())
+        {
+            LOGE("Proto索引无效");
+            return "";
+        }
+
+        if (snapshot_ != nullptr)
+        {
+            return std::string(snapshot_->getProtoString(idx));
+        }
+
+        // 构建参数列表字符串
+        std::string paramStr = "(";
+        if (const TypeListData* paramTypeList = getProtoParameters(idx))
+        {
+            bool first = true;
+            for (uint32_t i = 0; i < paramTypeList->size; i++)
+            {
+                const uint32_t typeIdx = paramTypeList->items[i].typeIdx;
+                if (typeIdx < typeIds_.size())
+                {
+                    if (!first)
+                    {
+                        paramStr += ", ";
+                    }
+                    paramStr += getType(typeIdx);
+                    first = false;
+                }
+            }
+        }
+        paramStr += ")";
+
+        return getProtoReturnType(idx) + " " + paramStr;
+    }
+
     // Field相关方法
     void DexContext::setFieldIds(const DexFieldId* fieldIds, uint32_t count)
     {
         // 清空现有FieldId表和缓存
-        fieldIds_.clear();
+        fieldIds_ = {};
         fieldCache_.clear();
         fieldsLoaded_ = false;
 
-        // 复制FieldId表
-        if (fieldIds != nullptr && count > 0)
+        // 直接引用映射文件中的FieldId表
+        if (fieldIds != nullptr && count > 0 && isMappedRange(fieldIds, count * sizeof(DexFieldId)))
         {
-            fieldIds_.assign(fieldIds, fieldIds + count);
+            fieldIds_ = std::span<const DexFieldId>(fieldIds, count);
 
             // 初始化字段信息缓存
             fieldCache_.resize(count);
@@ -404,9 +669,10 @@ namespace dex
             // 更新全局DexFile中的字段ID表指针
             dexFile_.pFieldIds = fieldIds_.data();
         }
+        measureCache(CacheKind::Fields);
     }
 
-    const std::vector<DexFieldId>& DexContext::getFieldIds() const
+    std::span<const DexFieldId> DexContext::getFieldIds() const
     {
         return fieldIds_;
     }
@@ -428,8 +694,8 @@ namespace dex
             return info;
         }
 
-        // 如果已加载所有字段信息，直接返回缓存
-        if (fieldsLoaded_ && idx < fieldCache_.size())
+        // 如果已加载所有字段信息，直接返回缓存（未选中类的字段不在缓存中）
+        if (fieldsLoaded_ && idx < fieldCache_.size() && isTypeSelected(fieldIds_[idx].classIdx))
         {
             return fieldCache_[idx];
         }
@@ -485,6 +751,12 @@ namespace dex
             // 获取字段ID
             const DexFieldId& fieldId = fieldIds_[i];
 
+            // 未选中类的字段按需解析
+            if (!isTypeSelected(fieldId.classIdx))
+            {
+                continue;
+            }
+
             // 填充基本信息
             fieldCache_[i].classIdx = fieldId.classIdx;
             fieldCache_[i].typeIdx = fieldId.typeIdx;
@@ -509,6 +781,7 @@ namespace dex
 
         // 标记为已加载所有字段信息
         fieldsLoaded_ = true;
+        measureCache(CacheKind::Fields);
 
         LOGI("加载了 %zu 个字段信息", fieldCache_.size());
         return true;
@@ -518,14 +791,14 @@ namespace dex
     void DexContext::setMethodIds(const DexMethodId* methodIds, uint32_t count)
     {
         // 清空现有MethodId表和缓存
-        methodIds_.clear();
+        methodIds_ = {};
         methodCache_.clear();
         methodsLoaded_ = false;
 
-        // 复制MethodId表
-        if (methodIds != nullptr && count > 0)
+        // 直接引用映射文件中的MethodId表
+        if (methodIds != nullptr && count > 0 && isMappedRange(methodIds, count * sizeof(DexMethodId)))
         {
-            methodIds_.assign(methodIds, methodIds + count);
+            methodIds_ = std::span<const DexMethodId>(methodIds, count);
 
             // 初始化方法信息缓存
             methodCache_.resize(count);
@@ -533,9 +806,10 @@ namespace dex
             // 更新全局DexFile中的方法ID表指针
             dexFile_.pMethodIds = methodIds_.data();
         }
+        measureCache(CacheKind::Methods);
     }
 
-    const std::vector<DexMethodId>& DexContext::getMethodIds() const
+    std::span<const DexMethodId> DexContext::getMethodIds() const
     {
         return methodIds_;
     }
@@ -558,8 +832,8 @@ namespace dex
             return info;
         }
 
-        // 如果已加载所有方法信息，直接返回缓存
-        if (methodsLoaded_ && idx < methodCache_.size())
+        // 如果已加载所有方法信息，直接返回缓存（未选中类的方法不在缓存中）
+        if (methodsLoaded_ && idx < methodCache_.size() && isTypeSelected(methodIds_[idx].classIdx))
         {
             return methodCache_[idx];
         }
@@ -632,6 +906,12 @@ namespace dex
             // 获取方法ID
             const DexMethodId& methodId = methodIds_[i];
 
+            // 未选中类的方法按需解析
+            if (!isTypeSelected(methodId.classIdx))
+            {
+                continue;
+            }
+
             // 填充基本信息
             methodCache_[i].classIdx = methodId.classIdx;
             methodCache_[i].protoIdx = methodId.protoIdx;
@@ -674,6 +954,7 @@ namespace dex
 
         // 标记为已加载所有方法信息
         methodsLoaded_ = true;
+        measureCache(CacheKind::Methods);
 
         LOGI("加载了 %zu 个方法信息", methodCache_.size());
         return true;
@@ -712,42 +993,45 @@ namespace dex
         memset(&dexFile_, 0, sizeof(DexFile));
 
         // 清空各种数据和缓存
-        stringIds_.clear();
+        stringIds_ = {};
         stringCache_.clear();
-        typeIds_.clear();
+        typeIds_ = {};
         typeCache_.clear();
-        protoIds_.clear();
+        protoIds_ = {};
         protoCacheShort_.clear();
         protoCacheReturn_.clear();
         protoCacheParameter_.clear();
-        fieldIds_.clear();
+        fieldIds_ = {};
         fieldCache_.clear();
-        methodIds_.clear();
+        methodIds_ = {};
         methodCache_.clear();
-        classDefs_.clear();
+        classDefs_ = {};
         classDefCache_.clear();
+        mapSections_.clear();
         typeListCache_.clear();
+        debugInfoCache_.clear();
+        tryCatchCache_.clear();
+        resetClassDataEpochs(0);
+        for (size_t i = 0; i < static_cast<size_t>(CacheKind::Count); i++)
+        {
+            cacheEntries_[i] = 0;
+            cacheBytes_[i] = 0;
+        }
+        hasContentHash_ = false;
+        methodCodeOffs_.clear();
+        fieldXrefs_ = FieldXrefIndex();
+        typeUsages_ = TypeUsageIndex();
+        snapshot_ = nullptr;
+        selectedClassDefs_.clear();
+        selectedTypes_.clear();
 
         LOGI("DexContext重置完成");
     }
 
-    std::string DexContext::decodeMUTF8(const uint8_t* data)
+    std::string DexContext::decodeMUTF8(const uint8_t* data, uint32_t length)
     {
         std::string result;
 
-        // 首先读取ULEB128编码的字符串长度
-        uint32_t length = 0;
-        uint32_t shift = 0;
-        uint8_t byte;
-
-        do
-        {
-            byte = *data++;
-            length |= (byte & 0x7F) << shift;
-            shift += 7;
-        }
-        while (byte & 0x80);
-
         // 预分配结果字符串空间
         result.reserve(length);
 
@@ -798,24 +1082,30 @@ namespace dex
     void DexContext::setClassDefs(const DexClassDef* classDefs, uint32_t count)
     {
         // 清空现有ClassDef表和缓存
-        classDefs_.clear();
+        classDefs_ = {};
         classDefCache_.clear();
+        resetClassDataEpochs(0);
         classDefsLoaded_ = false;
 
-        // 复制ClassDef表
-        if (classDefs != nullptr && count > 0)
+        // 直接引用映射文件中的ClassDef表
+        if (classDefs != nullptr && count > 0 && isMappedRange(classDefs, count * sizeof(DexClassDef)))
         {
-            classDefs_.assign(classDefs, classDefs + count);
+            classDefs_ = std::span<const DexClassDef>(classDefs, count);
 
             // 初始化类定义信息缓存
             classDefCache_.resize(count);
+            resetClassDataEpochs(count);
 
             // 更新全局DexFile中的类定义表指针
             dexFile_.pClassDefs = classDefs_.data();
         }
+        measureCache(CacheKind::ClassDefs);
+        measureCache(CacheKind::ClassData);
+
+        applyClassFilter();
     }
 
-    const std::vector<DexClassDef>& DexContext::getClassDefs() const
+    std::span<const DexClassDef> DexContext::getClassDefs() const
     {
         return classDefs_;
     }
@@ -825,6 +1115,53 @@ namespace dex
         return static_cast<uint32_t>(classDefs_.size());
     }
 
+    // map_list段表
+    void DexContext::setMapList(const DexMapList* mapList, std::vector<MapSection> sections)
+    {
+        mapSections_ = std::move(sections);
+        dexFile_.pMapList = mapList;
+    }
+
+    std::span<const MapSection> DexContext::getMapSections() const
+    {
+        return mapSections_;
+    }
+
+    const MapSection* DexContext::findSectionAt(uint32_t offset) const
+    {
+        // 段表按起始偏移量排序，找到最后一个起始偏移量不大于offset的段
+        auto it = std::upper_bound(mapSections_.begin(), mapSections_.end(), offset,
+                                   [](uint32_t value, const MapSection& section)
+                                   {
+                                       return value < section.offset;
+                                   });
+        if (it == mapSections_.begin())
+        {
+            return nullptr;
+        }
+
+        --it;
+        return offset < it->endOffset ? &*it : nullptr;
+    }
+
+    uint32_t DexContext::getSectionEnd(uint16_t type, uint32_t offset) const
+    {
+        // 没有map_list时无法按段限制，只能以文件结尾为界
+        if (mapSections_.empty())
+        {
+            return offset < fileSize_ ? static_cast<uint32_t>(fileSize_) : 0;
+        }
+
+        const MapSection* section = findSectionAt(offset);
+        return section != nullptr && section->type == type ? section->endOffset : 0;
+    }
+
+    bool DexContext::isInSection(uint16_t type, uint32_t offset, uint64_t size) const
+    {
+        const uint32_t end = getSectionEnd(type, offset);
+        return end != 0 && size <= end - offset;
+    }
+
     ClassDefInfo DexContext::getClassDefInfo(uint32_t idx) const
     {
         // 准备空的类定义信息
@@ -837,9 +1174,18 @@ namespace dex
             return info;
         }
 
-        // 如果已加载所有类定义信息，直接返回缓存
-        if (classDefsLoaded_ && idx < classDefCache_.size())
+        // 如果已加载所有类定义信息，直接返回缓存（未选中的类不在缓存中）
+        if (classDefsLoaded_ && idx < classDefCache_.size() && isClassDefSelected(idx))
         {
+            // 类数据被淘汰后重新解码
+            if (classDataEvicted_)
+            {
+                parseClassData(idx);
+            }
+            else
+            {
+                touchClassData(idx);
+            }
             return classDefCache_[idx];
         }
 
@@ -897,7 +1243,17 @@ namespace dex
             // 将临时信息存入缓存
             if (idx < classDefCache_.size())
             {
+                // 替换缓存中的旧条目，类数据的占用由parseClassData重新计入
+                const ClassDefInfo& cached = classDefCache_[idx];
+                addCacheUsage(CacheKind::ClassDefs, cached.className.empty() ? 0 : -1,
+                              -static_cast<int64_t>(classDefBytes(cached)));
+                if (cached.classData.isLoaded && cached.classDataOff != 0)
+                {
+                    addCacheUsage(CacheKind::ClassData, -1, -static_cast<int64_t>(classDataBytes(cached.classData)));
+                }
                 classDefCache_[idx] = info;
+                addCacheUsage(CacheKind::ClassDefs, info.className.empty() ? 0 : 1,
+                              static_cast<int64_t>(classDefBytes(info)));
                 // 解析类数据
                 parseClassData(idx);
                 // 更新info
@@ -910,9 +1266,17 @@ namespace dex
 
     bool DexContext::loadAllClassDefs() const
     {
-        // 如果已加载所有类定义信息，直接返回成功
+        // 如果已加载所有类定义信息，只需重新解码被淘汰的类数据
         if (classDefsLoaded_)
         {
+            if (classDataEvicted_)
+            {
+                for (const uint32_t i : selectedClassDefs_)
+                {
+                    parseClassData(i);
+                }
+                classDataEvicted_ = false;
+            }
             return true;
         }
 
@@ -926,8 +1290,8 @@ namespace dex
         // 重新调整缓存大小
         classDefCache_.resize(classDefs_.size());
 
-        // 逐个解析类定义信息
-        for (uint32_t i = 0; i < classDefs_.size(); i++)
+        // 逐个解析选中的类定义信息
+        for (const uint32_t i : selectedClassDefs_)
         {
             // 获取类定义
             const DexClassDef& classDef = classDefs_[i];
@@ -983,8 +1347,10 @@ namespace dex
 
         // 标记为已加载所有类定义信息
         classDefsLoaded_ = true;
+        measureCache(CacheKind::ClassDefs);
+        measureCache(CacheKind::ClassData);
 
-        LOGI("加载了 %zu 个类定义信息", classDefCache_.size());
+        LOGI("加载了 %zu 个类定义信息", selectedClassDefs_.size());
         return true;
     }
 
@@ -1081,26 +1447,6 @@ namespace dex
         return result;
     }
 
-    // 读取ULEB128编码的数值
-    uint32_t DexContext::readULEB128(const uint8_t** pData)
-    {
-        const uint8_t* data = *pData;
-        uint32_t result = 0;
-        uint32_t shift = 0;
-        uint8_t byte;
-
-        do
-        {
-            byte = *data++;
-            result |= (byte & 0x7F) << shift;
-            shift += 7;
-        }
-        while (byte & 0x80);
-
-        *pData = data;
-        return result;
-    }
-
     // 解析类数据
     bool DexContext::parseClassData(uint32_t classDefIdx) const
     {
@@ -1111,15 +1457,27 @@ namespace dex
             return false;
         }
 
-        // 获取类定义
-        const DexClassDef& classDef = classDefs_[classDefIdx];
-
         // 检查是否已加载类数据
+        touchClassData(classDefIdx);
         if (classDefCache_[classDefIdx].classData.isLoaded)
         {
             return true;
         }
 
+        const bool ok = snapshot_ != nullptr ? loadClassDataFromSnapshot(classDefIdx) : decodeClassData(classDefIdx);
+        const auto& classData = classDefCache_[classDefIdx].classData;
+        if (classData.isLoaded && classDefs_[classDefIdx].classDataOff != 0)
+        {
+            addCacheUsage(CacheKind::ClassData, 1, static_cast<int64_t>(classDataBytes(classData)));
+        }
+        return ok;
+    }
+
+    bool DexContext::decodeClassData(uint32_t classDefIdx) const
+    {
+        // 获取类定义
+        const DexClassDef& classDef = classDefs_[classDefIdx];
+
         // 检查类数据偏移量是否有效
         if (classDef.classDataOff == 0)
         {
@@ -1128,199 +1486,196 @@ namespace dex
             return true;
         }
 
-        if (classDef.classDataOff >= fileSize_)
+        // 类数据只能位于class_data_item段内，读取器以段结尾为界
+        const uint32_t sectionEnd = getSectionEnd(kDexTypeClassDataItem, classDef.classDataOff);
+        if (sectionEnd == 0)
         {
             LOGE("类数据偏移量无效: %u", classDef.classDataOff);
             return false;
         }
 
-        // 获取类数据指针
-        const uint8_t* dataPtr = fileData_ + classDef.classDataOff;
+        PhaseTimer timer(Phase::ClassData);
+        timer.addItems(1);
+
+        // 头部4个数量的编码长度未知，用带检查的读取器读取
+        CheckedReader reader(fileData_, sectionEnd, classDef.classDataOff);
 
         // 读取字段和方法的数量信息(ULEB128编码)
-        classDefCache_[classDefIdx].classData.staticFieldsSize = readULEB128(&dataPtr);
-        classDefCache_[classDefIdx].classData.instanceFieldsSize = readULEB128(&dataPtr);
-        classDefCache_[classDefIdx].classData.directMethodsSize = readULEB128(&dataPtr);
-        classDefCache_[classDefIdx].classData.virtualMethodsSize = readULEB128(&dataPtr);
+        auto& classData = classDefCache_[classDefIdx].classData;
+        classData.staticFieldsSize = reader.readULEB128();
+        classData.instanceFieldsSize = reader.readULEB128();
+        classData.directMethodsSize = reader.readULEB128();
+        classData.virtualMethodsSize = reader.readULEB128();
+
+        // 字段条目至少占2字节、方法条目至少占3字节，数量不可能超过剩余数据长度
+        const uint64_t minSize = (static_cast<uint64_t>(classData.staticFieldsSize) + classData.instanceFieldsSize) * 2 +
+                                 (static_cast<uint64_t>(classData.directMethodsSize) + classData.virtualMethodsSize) * 3;
+        if (!reader.ok() || minSize > reader.remaining())
+        {
+            LOGE("类数据大小无效: 0x%08X", classDef.classDataOff);
+            classData = ClassDefInfo::ClassDataInfo();
+            return false;
+        }
 
         // 准备字段和方法列表
-        auto& classData = classDefCache_[classDefIdx].classData;
         classData.staticFields.resize(classData.staticFieldsSize);
         classData.instanceFields.resize(classData.instanceFieldsSize);
         classData.directMethods.resize(classData.directMethodsSize);
         classData.virtualMethods.resize(classData.virtualMethodsSize);
 
-        // 解析静态字段(ULEB128编码)
-        uint32_t fieldIdx = 0;
-        for (uint32_t i = 0; i < classData.staticFieldsSize; i++)
+        // 字段和方法列表在最坏编码长度下也位于class_data_item段内时，逐项读取不再检查边界
+        const uint64_t maxSize = (static_cast<uint64_t>(classData.staticFieldsSize) + classData.instanceFieldsSize) *
+                                     2 * kMaxULEB128Size +
+                                 (static_cast<uint64_t>(classData.directMethodsSize) + classData.virtualMethodsSize) *
+                                     3 * kMaxULEB128Size;
+        size_t endOffset = 0;
+        if (maxSize <= reader.remaining())
         {
-            fieldIdx += readULEB128(&dataPtr);
-            classData.staticFields[i].fieldIdx = fieldIdx;
-            classData.staticFields[i].accessFlags = readULEB128(&dataPtr);
-
-            // 获取字段详细信息
-            if (fieldIdx < fieldIds_.size())
-            {
-                const DexFieldId& fieldId = fieldIds_[fieldIdx];
-                if (fieldId.nameIdx < stringIds_.size())
-                {
-                    classData.staticFields[i].name = getString(fieldId.nameIdx);
-                }
-                if (fieldId.typeIdx < typeIds_.size())
-                {
-                    classData.staticFields[i].type = getType(fieldId.typeIdx);
-                }
-            }
+            UncheckedReader unchecked(fileData_, sectionEnd, reader.offset());
+            decodeClassMembers(unchecked, classData);
+            endOffset = unchecked.offset();
         }
-
-        // 解析实例字段(ULEB128编码)
-        fieldIdx = 0;
-        for (uint32_t i = 0; i < classData.instanceFieldsSize; i++)
+        else
         {
-            fieldIdx += readULEB128(&dataPtr);
-            classData.instanceFields[i].fieldIdx = fieldIdx;
-            classData.instanceFields[i].accessFlags = readULEB128(&dataPtr);
-
-            // 获取字段详细信息
-            if (fieldIdx < fieldIds_.size())
+            decodeClassMembers(reader, classData);
+            if (!reader.ok())
             {
-                const DexFieldId& fieldId = fieldIds_[fieldIdx];
-                if (fieldId.nameIdx < stringIds_.size())
-                {
-                    classData.instanceFields[i].name = getString(fieldId.nameIdx);
-                }
-                if (fieldId.typeIdx < typeIds_.size())
-                {
-                    classData.instanceFields[i].type = getType(fieldId.typeIdx);
-                }
+                LOGE("类数据超出段范围: 0x%08X", classDef.classDataOff);
+                classData = ClassDefInfo::ClassDataInfo();
+                return false;
             }
+            endOffset = reader.offset();
         }
 
-        // 解析直接方法(ULEB128编码)
-        uint32_t methodIdx = 0;
-        for (uint32_t i = 0; i < classData.directMethodsSize; i++)
+        // 获取字段详细信息
+        for (auto* fields : {&classData.staticFields, &classData.instanceFields})
         {
-            methodIdx += readULEB128(&dataPtr);
-            classData.directMethods[i].methodIdx = methodIdx;
-            classData.directMethods[i].accessFlags = readULEB128(&dataPtr);
-            classData.directMethods[i].codeOff = readULEB128(&dataPtr);
-
-            // 获取方法详细信息
-            if (methodIdx < methodIds_.size())
+            for (ClassDefInfo::ClassDataInfo::EncodedFieldInfo& field : *fields)
             {
-                const DexMethodId& methodId = methodIds_[methodIdx];
-                if (methodId.nameIdx < stringIds_.size())
-                {
-                    classData.directMethods[i].name = getString(methodId.nameIdx);
-                }
-
-                if (methodId.protoIdx < protoIds_.size())
+                if (field.fieldIdx < fieldIds_.size())
                 {
-                    // 获取方法的完整信息以构建更详细的原型字符串
-                    MethodInfo methodInfo = getMethodInfo(methodIdx);
-
-                    // 构建参数列表字符串
-                    std::string paramStr = "";
-                    if (methodInfo.hasParameterList && !methodInfo.parameterTypes.empty())
+                    const DexFieldId& fieldId = fieldIds_[field.fieldIdx];
+                    if (fieldId.nameIdx < stringIds_.size())
                     {
-                        paramStr = "(";
-                        for (size_t j = 0; j < methodInfo.parameterTypes.size(); j++)
-                        {
-                            if (j > 0)
-                            {
-                                paramStr += ", ";
-                            }
-                            paramStr += methodInfo.parameterTypes[j];
-                        }
-                        paramStr += ")";
+                        field.name = getString(fieldId.nameIdx);
                     }
-                    else
+                    if (fieldId.typeIdx < typeIds_.size())
                     {
-                        paramStr = "()";
+                        field.type = getType(fieldId.typeIdx);
                     }
-
-                    // 更新Proto字符串，包含返回类型和参数列表
-                    classData.directMethods[i].proto = methodInfo.returnType + " " + paramStr;
                 }
             }
         }
 
-        // 解析虚拟方法(ULEB128编码)
-        methodIdx = 0;
-        for (uint32_t i = 0; i < classData.virtualMethodsSize; i++)
+        // 获取方法详细信息
+        for (auto* methods : {&classData.directMethods, &classData.virtualMethods})
         {
-            methodIdx += readULEB128(&dataPtr);
-            classData.virtualMethods[i].methodIdx = methodIdx;
-            classData.virtualMethods[i].accessFlags = readULEB128(&dataPtr);
-            classData.virtualMethods[i].codeOff = readULEB128(&dataPtr);
-
-            // 获取方法详细信息
-            if (methodIdx < methodIds_.size())
+            for (ClassDefInfo::ClassDataInfo::EncodedMethodInfo& method : *methods)
             {
-                const DexMethodId& methodId = methodIds_[methodIdx];
-                if (methodId.nameIdx < stringIds_.size())
+                if (method.methodIdx < methodIds_.size())
                 {
-                    classData.virtualMethods[i].name = getString(methodId.nameIdx);
-                }
-
-                if (methodId.protoIdx < protoIds_.size())
-                {
-                    // 获取方法的完整信息以构建更详细的原型字符串
-                    MethodInfo methodInfo = getMethodInfo(methodIdx);
-
-                    // 构建参数列表字符串
-                    std::string paramStr = "";
-                    if (methodInfo.hasParameterList && !methodInfo.parameterTypes.empty())
+                    const DexMethodId& methodId = methodIds_[method.methodIdx];
+                    if (methodId.nameIdx < stringIds_.size())
                     {
-                        paramStr = "(";
-                        for (size_t j = 0; j < methodInfo.parameterTypes.size(); j++)
-                        {
-                            if (j > 0)
-                            {
-                                paramStr += ", ";
-                            }
-                            paramStr += methodInfo.parameterTypes[j];
-                        }
-                        paramStr += ")";
+                        method.name = getString(methodId.nameIdx);
                     }
-                    else
+
+                    if (methodId.protoIdx < protoIds_.size())
                     {
-                        paramStr = "()";
+                        // Proto字符串，包含返回类型和参数列表
+                        method.proto = getProtoString(methodId.protoIdx);
                     }
-
-                    // 更新Proto字符串，包含返回类型和参数列表
-                    classData.virtualMethods[i].proto = methodInfo.returnType + " " + paramStr;
                 }
             }
         }
 
+        timer.addBytes(endOffset - classDef.classDataOff);
+
         // 标记类数据已加载
-        classDefCache_[classDefIdx].classData.isLoaded = true;
+        classData.isLoaded = true;
 
         return true;
     }
 
-    int32_t DexContext::readSLEB128(const uint8_t** pData)
+    // 从解析快照填充类数据
+    bool DexContext::loadClassDataFromSnapshot(uint32_t classDefIdx) const
     {
-        const uint8_t* data = *pData;
-        int32_t result = 0;
-        int shift = 0;
-        uint8_t byte;
-
-        do {
-            byte = *data++;
-            result |= ((byte & 0x7F) << shift);
-            shift += 7;
-        } while (byte & 0x80);
-
-        // 如果最高位是1，则进行符号扩展
-        if (shift < 32 && (byte & 0x40)) {
-            // 负数，进行符号扩展
-            result |= ~0 << shift;
+        auto& classData = classDefCache_[classDefIdx].classData;
+        const SnapshotClassData* record = snapshot_->getClassData(classDefIdx);
+        const std::span<const SnapshotMember> members =
+            record != nullptr ? snapshot_->getMembers(*record) : std::span<const SnapshotMember>();
+        if (record == nullptr || !record->isValid ||
+            members.size() != static_cast<uint64_t>(record->staticFieldsSize) + record->instanceFieldsSize +
+                              record->directMethodsSize + record->virtualMethodsSize)
+        {
+            LOGE("快照中的类数据无效: %u", classDefIdx);
+            classData = ClassDefInfo::ClassDataInfo();
+            return false;
         }
 
-        *pData = data;
-        return result;
+        classData.staticFieldsSize = record->staticFieldsSize;
+        classData.instanceFieldsSize = record->instanceFieldsSize;
+        classData.directMethodsSize = record->directMethodsSize;
+        classData.virtualMethodsSize = record->virtualMethodsSize;
+
+        // 字段和方法的名称仍按索引从字符串区获取
+        auto fillFields = [&](std::vector<ClassDefInfo::ClassDataInfo::EncodedFieldInfo>& fields,
+                              std::span<const SnapshotMember> items)
+        {
+            fields.resize(items.size());
+            for (size_t i = 0; i < items.size(); i++)
+            {
+                fields[i].fieldIdx = items[i].idx;
+                fields[i].accessFlags = items[i].accessFlags;
+                if (items[i].idx < fieldIds_.size())
+                {
+                    const DexFieldId& fieldId = fieldIds_[items[i].idx];
+                    if (fieldId.nameIdx < stringIds_.size())
+                    {
+                        fields[i].name = getString(fieldId.nameIdx);
+                    }
+                    if (fieldId.typeIdx < typeIds_.size())
+                    {
+                        fields[i].type = getType(fieldId.typeIdx);
+                    }
+                }
+            }
+        };
+        auto fillMethods = [&](std::vector<ClassDefInfo::ClassDataInfo::EncodedMethodInfo>& methods,
+                               std::span<const SnapshotMember> items)
+        {
+            methods.resize(items.size());
+            for (size_t i = 0; i < items.size(); i++)
+            {
+                methods[i].methodIdx = items[i].idx;
+                methods[i].accessFlags = items[i].accessFlags;
+                methods[i].codeOff = items[i].codeOff;
+                if (items[i].idx < methodIds_.size())
+                {
+                    const DexMethodId& methodId = methodIds_[items[i].idx];
+                    if (methodId.nameIdx < stringIds_.size())
+                    {
+                        methods[i].name = getString(methodId.nameIdx);
+                    }
+                    if (methodId.protoIdx < protoIds_.size())
+                    {
+                        methods[i].proto = getProtoString(methodId.protoIdx);
+                    }
+                }
+            }
+        };
+
+        size_t next = 0;
+        fillFields(classData.staticFields, members.subspan(next, record->staticFieldsSize));
+        next += record->staticFieldsSize;
+        fillFields(classData.instanceFields, members.subspan(next, record->instanceFieldsSize));
+        next += record->instanceFieldsSize;
+        fillMethods(classData.directMethods, members.subspan(next, record->directMethodsSize));
+        next += record->directMethodsSize;
+        fillMethods(classData.virtualMethods, members.subspan(next, record->virtualMethodsSize));
+
+        classData.isLoaded = true;
+        return true;
     }
 
     // 解析方法代码信息
@@ -1330,16 +1685,23 @@ namespace dex
         uint32_t codeOffset = 0;
         ClassDefInfo::ClassDataInfo::EncodedMethodInfo* pMethod = nullptr;
 
-        // 遍历所有类定义
-        for (uint32_t i = 0; i < getClassDefsCount(); i++)
+        // 方法只会出现在所属类的类数据中，只查找（必要时重新解码）这一个类
+        const uint32_t classIdx = methodIdx < methodIds_.size() ? methodIds_[methodIdx].classIdx : 0xFFFFFFFF;
+        for (uint32_t i = 0; i < classDefs_.size() && i < classDefCache_.size(); i++)
         {
-            ClassDefInfo& classInfo = classDefCache_[i];
+            if (classDefs_[i].classIdx != classIdx)
+            {
+                continue;
+            }
+            if (classDefs_[i].classDataOff == 0 || !isClassDefSelected(i) || !parseClassData(i))
+            {
+                break;
+            }
 
-            // 检查是否有类数据
-            if (classInfo.classDataOff != 0 && classInfo.classData.isLoaded)
+            ClassDefInfo::ClassDataInfo& classData = classDefCache_[i].classData;
+            for (auto* methods : {&classData.directMethods, &classData.virtualMethods})
             {
-                // 查找直接方法
-                for (auto& method : classInfo.classData.directMethods)
+                for (auto& method : *methods)
                 {
                     if (method.methodIdx == methodIdx && method.codeOff != 0)
                     {
@@ -1348,26 +1710,12 @@ namespace dex
                         break;
                     }
                 }
-
-                // 如果在直接方法中没找到，查找虚拟方法
-                if (pMethod == nullptr)
-                {
-                    for (auto& method : classInfo.classData.virtualMethods)
-                    {
-                        if (method.methodIdx == methodIdx && method.codeOff != 0)
-                        {
-                            codeOffset = method.codeOff;
-                            pMethod = &method;
-                            break;
-                        }
-                    }
-                }
-
-                if (pMethod != nullptr)
+                if (pMethod != nullptr)
                 {
                     break;
                 }
             }
+            break;
         }
 
         if (pMethod == nullptr || codeOffset == 0)
@@ -1376,18 +1724,16 @@ namespace dex
             return false;
         }
 
-        // 检查偏移量是否有效
-        if (codeOffset >= fileSize_)
+        // 获取DexCode结构
+        const DexCode* dexCode = getCodeItem(codeOffset);
+        if (dexCode == nullptr)
         {
-            LOGE("代码偏移量无效: 0x%08X", codeOffset);
             return false;
         }
 
-        // 获取DexCode结构
-        const DexCode* dexCode = reinterpret_cast<const DexCode*>(fileData_ + codeOffset);
-
-        // 填充代码信息
+        // 填充代码信息，try/catch表的增量计入类数据的占用
         CodeInfo& codeInfo = pMethod->codeInfo;
+        const uint64_t previousBytes = codeInfoBytes(codeInfo);
         codeInfo.codeOff = codeOffset;
         codeInfo.registersSize = dexCode->registers_size;
         codeInfo.insSize = dexCode->ins_size;
@@ -1396,11 +1742,7 @@ namespace dex
         codeInfo.debugInfoOff = dexCode->debug_info_off;
         codeInfo.insnsSize = dexCode->insns_size;
 
-        // 解析调试信息
-        if (dexCode->debug_info_off != 0)
-        {
-            parseDebugInfo(dexCode->debug_info_off, codeInfo.debugInfo);
-        }
+        // 调试信息按需通过getDebugInfo解码，这里只记录偏移量
 
         // 解析try/catch信息
         if (dexCode->tries_size > 0)
@@ -1409,42 +1751,66 @@ namespace dex
         }
 
         codeInfo.isLoaded = true;
+        addCacheUsage(CacheKind::ClassData, 0,
+                      static_cast<int64_t>(codeInfoBytes(codeInfo)) - static_cast<int64_t>(previousBytes));
         return true;
     }
 
-    // 解析调试信息
-    bool DexContext::parseDebugInfo(uint32_t debugInfoOff, DebugInfoData& debugInfo) const
+    // 获取调试信息
+    std::shared_ptr<const DebugInfoData> DexContext::getDebugInfo(uint32_t debugInfoOff) const
     {
         // 检查缓存
-        auto it = debugInfoCache_.find(debugInfoOff);
-        if (it != debugInfoCache_.end())
+        if (std::shared_ptr<const DebugInfoData> cached = debugInfoCache_.find(debugInfoOff))
         {
-            debugInfo = it->second;
-            return true;
+            return cached;
         }
 
-        // 检查偏移量是否有效
-        if (debugInfoOff == 0 || debugInfoOff >= fileSize_)
+        // 检查偏移量是否有效（调试信息只能位于debug_info_item段内）
+        if (debugInfoOff == 0 || getSectionEnd(kDexTypeDebugInfoItem, debugInfoOff) == 0)
         {
             LOGE("调试信息偏移量无效: 0x%08X", debugInfoOff);
-            return false;
+            return nullptr;
+        }
+
+        auto debugInfo = std::make_shared<DebugInfoData>();
+        if (!decodeDebugInfo(debugInfoOff, *debugInfo))
+        {
+            return nullptr;
         }
 
-        const uint8_t* pData = fileData_ + debugInfoOff;
+        const uint64_t bytes = debugInfoBytes(*debugInfo) + SharedLruCache<DebugInfoData>::kEntryOverhead;
+        std::shared_ptr<const DebugInfoData> shared = std::move(debugInfo);
+        debugInfoCache_.insert(debugInfoOff, shared, bytes);
+        enforceDecodedBudget();
+        return shared;
+    }
+
+    // 解码调试信息状态机
+    bool DexContext::decodeDebugInfo(uint32_t debugInfoOff, DebugInfoData& debugInfo) const
+    {
+        // 状态机长度无法预知，读取器以debug_info_item段结尾为界，不会读入其他段
+        CheckedReader reader(fileData_, getSectionEnd(kDexTypeDebugInfoItem, debugInfoOff), debugInfoOff);
 
         // 读取起始行号(ULEB128)
         debugInfo.debugInfoOff = debugInfoOff;
-        debugInfo.lineStart = readULEB128(&pData);
+        debugInfo.lineStart = reader.readULEB128();
 
         // 读取参数数量(ULEB128)
-        debugInfo.parametersSize = readULEB128(&pData);
+        debugInfo.parametersSize = reader.readULEB128();
 
-        // 读取参数名称索引(ULEB128)
+        // 每个参数名称至少占1字节，数量不可能超过剩余数据长度
+        if (!reader.ok() || debugInfo.parametersSize > reader.remaining())
+        {
+            LOGE("调试信息参数数量无效: 0x%08X", debugInfoOff);
+            return false;
+        }
+
+        // 读取参数名称索引(ULEB128p1，0表示无名称)
         debugInfo.parameterNames.clear();
         for (uint32_t i = 0; i < debugInfo.parametersSize; i++)
         {
-            uint32_t nameIdx = readULEB128(&pData);
-            if (nameIdx != 0 && nameIdx < stringIds_.size())
+            uint32_t nameIdx = reader.readULEB128p1();
+            if (nameIdx < stringIds_.size())
             {
                 debugInfo.parameterNames.push_back(getString(nameIdx));
             }
@@ -1456,6 +1822,8 @@ namespace dex
         }
 
         // 状态机初始状态
+        std::vector<PositionInfo> positions;
+        std::unordered_map<uint32_t, uint32_t> lastLocals; // 寄存器 -> 最近的局部变量下标
         uint32_t address = 0;       // 当前地址
         uint32_t line = debugInfo.lineStart;  // 当前行号
         int32_t registerNum = -1;   // 当前寄存器编号
@@ -1466,8 +1834,8 @@ namespace dex
         // 使用状态机处理调试指令
         while (true)
         {
-            // 获取当前指令操作码
-            uint8_t opcode = *pData++;
+            // 获取当前指令操作码（越界时读取器返回0，按序列结束处理后统一报错）
+            uint8_t opcode = reader.read<uint8_t>();
 
             // 处理操作码
             switch (opcode)
@@ -1478,38 +1846,41 @@ namespace dex
 
                 case DexDebugOpCode::DBG_ADVANCE_PC:
                     // 推进PC地址
-                    address += readULEB128(&pData);
+                    address += reader.readULEB128();
                     break;
 
                 case DexDebugOpCode::DBG_ADVANCE_LINE:
                     // 推进行号
-                    line += readSLEB128(&pData);
+                    line += reader.readSLEB128();
                     break;
 
                 case DexDebugOpCode::DBG_START_LOCAL:
                     // 局部变量作用域开始
                     {
-                        registerNum = readULEB128(&pData);
-                        nameIdx = readULEB128(&pData);
-                        typeIdx = readULEB128(&pData);
+                        registerNum = reader.readULEB128();
+                        nameIdx = reader.readULEB128p1();
+                        typeIdx = reader.readULEB128p1();
 
                         LocalVarInfo var;
                         var.registerNum = registerNum;
                         var.nameIdx = nameIdx;
                         var.typeIdx = typeIdx;
-                        var.sigIdx = 0;  // 无签名
+                        var.sigIdx = 0xFFFFFFFF;  // 无签名(NO_INDEX)
 
                         // 获取变量名和类型
-                        if (nameIdx != 0 && nameIdx < stringIds_.size())
+                        if (nameIdx < stringIds_.size())
                         {
                             var.name = getString(nameIdx);
                         }
 
-                        if (typeIdx != 0 && typeIdx < typeIds_.size())
+                        if (typeIdx < typeIds_.size())
                         {
                             var.type = getType(typeIdx);
                         }
 
+                        lastLocals[registerNum] = static_cast<uint32_t>(debugInfo.localVars.size());
+                        debugInfo.localEvents.push_back({address, static_cast<uint32_t>(registerNum),
+                                                         lastLocals[registerNum], LOCAL_START});
                         debugInfo.localVars.push_back(var);
                     }
                     break;
@@ -1517,10 +1888,10 @@ namespace dex
                 case DexDebugOpCode::DBG_START_LOCAL_EXTENDED:
                     // 带签名的局部变量作用域开始
                     {
-                        registerNum = readULEB128(&pData);
-                        nameIdx = readULEB128(&pData);
-                        typeIdx = readULEB128(&pData);
-                        sigIdx = readULEB128(&pData);
+                        registerNum = reader.readULEB128();
+                        nameIdx = reader.readULEB128p1();
+                        typeIdx = reader.readULEB128p1();
+                        sigIdx = reader.readULEB128p1();
 
                         LocalVarInfo var;
                         var.registerNum = registerNum;
@@ -1529,33 +1900,39 @@ namespace dex
                         var.sigIdx = sigIdx;
 
                         // 获取变量名、类型和签名
-                        if (nameIdx != 0 && nameIdx < stringIds_.size())
+                        if (nameIdx < stringIds_.size())
                         {
                             var.name = getString(nameIdx);
                         }
 
-                        if (typeIdx != 0 && typeIdx < typeIds_.size())
+                        if (typeIdx < typeIds_.size())
                         {
                             var.type = getType(typeIdx);
                         }
 
-                        if (sigIdx != 0 && sigIdx < stringIds_.size())
+                        if (sigIdx < stringIds_.size())
                         {
                             var.signature = getString(sigIdx);
                         }
 
+                        lastLocals[registerNum] = static_cast<uint32_t>(debugInfo.localVars.size());
+                        debugInfo.localEvents.push_back({address, static_cast<uint32_t>(registerNum),
+                                                         lastLocals[registerNum], LOCAL_START});
                         debugInfo.localVars.push_back(var);
                     }
                     break;
 
                 case DexDebugOpCode::DBG_END_LOCAL:
-                    // 局部变量作用域结束
-                    registerNum = readULEB128(&pData);
-                    break;
-
                 case DexDebugOpCode::DBG_RESTART_LOCAL:
-                    // 重新开始一个局部变量
-                    registerNum = readULEB128(&pData);
+                    // 局部变量作用域结束或重新开始，关联到该寄存器最近的变量
+                    {
+                        registerNum = reader.readULEB128();
+                        auto last = lastLocals.find(registerNum);
+                        debugInfo.localEvents.push_back({
+                            address, static_cast<uint32_t>(registerNum),
+                            last != lastLocals.end() ? last->second : 0xFFFFFFFF,
+                            opcode == DexDebugOpCode::DBG_END_LOCAL ? LOCAL_END : LOCAL_RESTART});
+                    }
                     break;
 
                 case DexDebugOpCode::DBG_SET_PROLOGUE_END:
@@ -1568,7 +1945,7 @@ namespace dex
 
                 case DexDebugOpCode::DBG_SET_FILE:
                     // 设置当前源文件
-                    readULEB128(&pData);  // 文件名索引
+                    reader.readULEB128();  // 文件名索引
                     break;
 
                 default:
@@ -1591,16 +1968,21 @@ namespace dex
                         PositionInfo pos;
                         pos.address = address;
                         pos.lineNum = line;
-                        debugInfo.positions.push_back(pos);
+                        positions.push_back(pos);
                     }
                     break;
             }
         }
 
     done:
-        // 将调试信息添加到缓存
+        if (!reader.ok())
+        {
+            LOGE("调试信息超出文件范围: 0x%08X", debugInfoOff);
+            return false;
+        }
+
+        debugInfo.lines = LineTable(std::move(positions));
         debugInfo.isLoaded = true;
-        debugInfoCache_[debugInfoOff] = debugInfo;
 
         return true;
     }
@@ -1608,16 +1990,14 @@ namespace dex
     // 解析Try/Catch信息
     bool DexContext::parseTryCatchInfo(uint32_t codeOff, CodeInfo& codeInfo) const
     {
-        // 检查偏移量是否有效
-        if (codeOff == 0 || codeOff >= fileSize_)
+        // 获取DexCode结构（已检查头部和指令数组位于文件范围内）
+        const DexCode* dexCode = getCodeItem(codeOff);
+        if (dexCode == nullptr)
         {
             LOGE("代码偏移量无效: 0x%08X", codeOff);
             return false;
         }
 
-        // 获取DexCode结构
-        const DexCode* dexCode = reinterpret_cast<const DexCode*>(fileData_ + codeOff);
-
         // 检查try块数量
         if (dexCode->tries_size == 0)
         {
@@ -1626,71 +2006,1017 @@ namespace dex
 
         // 获取tries数组的起始位置
         // tries数组在insns之后，但如果insns的大小是奇数，中间会有两个字节的padding
-        const uint8_t* pData = reinterpret_cast<const uint8_t*>(dexCode->insns + dexCode->insns_size);
+        size_t triesOff = static_cast<size_t>(codeOff) + offsetof(DexCode, insns) +
+                          static_cast<size_t>(dexCode->insns_size) * sizeof(uint16_t);
         if (dexCode->insns_size % 2 != 0) {
-            pData += 2;  // 添加2字节的padding
+            triesOff += 2;  // 添加2字节的padding
         }
 
-        // 获取DexTry数组
-        const DexTry* tries = reinterpret_cast<const DexTry*>(pData);
+        // 获取DexTry数组并检查其位于code_item段内（getCodeItem已验证codeOff所在的段）
+        const uint32_t sectionEnd = getSectionEnd(kDexTypeCodeItem, codeOff);
+        CheckedReader reader(fileData_, sectionEnd);
+        const DexTry* tries = reader.array<DexTry>(triesOff, dexCode->tries_size);
+        if (tries == nullptr)
+        {
+            LOGE("try块数组超出代码段范围: 0x%08X", codeOff);
+            return false;
+        }
 
-        // 获取handlers区域的起始位置
-        const uint8_t* handlersData = pData + (dexCode->tries_size * sizeof(DexTry));
+        // handlers区域紧跟tries数组（handler_off相对于此处，包含开头的列表大小）
+        const size_t handlersStart = triesOff + dexCode->tries_size * sizeof(DexTry);
+        reader.seek(handlersStart);
 
-        // 读取handlers区域的大小
-        uint32_t handlersSize = readULEB128(&handlersData);
+        // 顺序解码整个encoded_catch_handler_list，每个处理器只解码一次
+        uint32_t handlersSize = reader.readULEB128();
 
-        // 解析每个try块
+        // 每个处理器至少占1字节，数量不可能超过剩余数据长度
+        if (!reader.ok() || handlersSize > reader.remaining())
+        {
+            LOGE("异常处理器列表无效: 0x%08X", codeOff);
+            return false;
+        }
+
+        codeInfo.handlers.clear();
+        codeInfo.handlers.reserve(handlersSize);
+        for (uint32_t i = 0; i < handlersSize; i++)
+        {
+            CatchHandlerInfo handler;
+            handler.handlerOff = static_cast<uint32_t>(reader.offset() - handlersStart);
+
+            // 读取handler的大小，非正数表示带catch-all
+            int32_t size = reader.readSLEB128();
+            handler.hasCatchAll = size <= 0;
+            handler.catchAllAddr = 0;
+            uint32_t catchCount = handler.hasCatchAll ? 0u - static_cast<uint32_t>(size) : static_cast<uint32_t>(size);
+
+            // 每个catch项至少占2字节
+            if (!reader.ok() || catchCount > reader.remaining() / 2)
+            {
+                LOGE("异常处理器超出文件范围: 0x%08X [%u]", codeOff, i);
+                return false;
+            }
+
+            // 解析每个catch类型和catch-all地址，最坏编码长度也位于段内时逐项读取不再检查边界
+            handler.catches.resize(catchCount);
+            if ((static_cast<uint64_t>(catchCount) * 2 + 1) * kMaxULEB128Size <= reader.remaining())
+            {
+                UncheckedReader unchecked(fileData_, sectionEnd, reader.offset());
+                decodeCatchHandler(unchecked, handler);
+                reader.seek(unchecked.offset());
+            }
+            else
+            {
+                decodeCatchHandler(reader, handler);
+            }
+
+            if (!reader.ok())
+            {
+                LOGE("异常处理器超出文件范围: 0x%08X [%u]", codeOff, i);
+                return false;
+            }
+
+            codeInfo.handlers.push_back(std::move(handler));
+        }
+
+        // 解析每个try块，按偏移量引用处理器表
         codeInfo.tries.clear();
+        codeInfo.tries.reserve(dexCode->tries_size);
         for (uint32_t i = 0; i < dexCode->tries_size; i++)
         {
             TryBlockInfo tryInfo;
             tryInfo.startAddr = tries[i].start_addr;
             tryInfo.insnCount = tries[i].insn_count;
             tryInfo.handlerOff = tries[i].handler_off;
-            tryInfo.hasCatchAll = false;
 
-            // 找到对应的handler
-            const uint8_t* handlerData = handlersData + tryInfo.handlerOff;
+            // try块必须按地址升序且互不重叠，pc查找依赖这一点
+            if (!codeInfo.tries.empty() &&
+                tryInfo.startAddr < codeInfo.tries.back().startAddr + codeInfo.tries.back().insnCount)
+            {
+                LOGE("try块未按地址升序排列或存在重叠: 0x%08X [%u]", codeOff, i);
+                return false;
+            }
+
+            // 处理器表按偏移量升序排列，二分查找
+            auto it = std::lower_bound(codeInfo.handlers.begin(), codeInfo.handlers.end(), tryInfo.handlerOff,
+                                       [](const CatchHandlerInfo& handler, uint32_t off) { return handler.handlerOff < off; });
+            if (it == codeInfo.handlers.end() || it->handlerOff != tryInfo.handlerOff)
+            {
+                LOGE("try块处理器偏移量无效: 0x%08X + 0x%04X", codeOff, tryInfo.handlerOff);
+                return false;
+            }
+            tryInfo.handlerIdx = static_cast<uint32_t>(it - codeInfo.handlers.begin());
+
+            codeInfo.tries.push_back(tryInfo);
+        }
+
+        return true;
+    }
+
+    // 获取代码段的Try/Catch信息
+    std::shared_ptr<const CodeInfo> DexContext::getTryCatchInfo(uint32_t codeOff) const
+    {
+        // 检查缓存
+        if (std::shared_ptr<const CodeInfo> cached = tryCatchCache_.find(codeOff))
+        {
+            return cached;
+        }
+
+        const DexCode* dexCode = getCodeItem(codeOff);
+        if (dexCode == nullptr)
+        {
+            return nullptr;
+        }
+
+        auto codeInfo = std::make_shared<CodeInfo>();
+        codeInfo->codeOff = codeOff;
+        codeInfo->registersSize = dexCode->registers_size;
+        codeInfo->insSize = dexCode->ins_size;
+        codeInfo->outsSize = dexCode->outs_size;
+        codeInfo->triesSize = dexCode->tries_size;
+        codeInfo->debugInfoOff = dexCode->debug_info_off;
+        codeInfo->insnsSize = dexCode->insns_size;
+        if (!parseTryCatchInfo(codeOff, *codeInfo))
+        {
+            return nullptr;
+        }
+        codeInfo->isLoaded = true;
+
+        const uint64_t bytes = sizeof(CodeInfo) + codeInfoBytes(*codeInfo) + SharedLruCache<CodeInfo>::kEntryOverhead;
+        std::shared_ptr<const CodeInfo> shared = std::move(codeInfo);
+        tryCatchCache_.insert(codeOff, shared, bytes);
+        enforceDecodedBudget();
+        return shared;
+    }
 
-            // 读取handler的大小
-            int32_t size = readSLEB128(&handlerData);
-            bool hasCatchAll = size <= 0;
-            uint32_t catchCount = hasCatchAll ? -size : size;
+    // 查找覆盖pc的try块
+    const TryBlockInfo* DexContext::findTryBlock(const CodeInfo& codeInfo, uint32_t pc)
+    {
+        // 找到起始地址不大于pc的最后一个try块
+        auto it = std::upper_bound(codeInfo.tries.begin(), codeInfo.tries.end(), pc,
+                                   [](uint32_t value, const TryBlockInfo& tryInfo) { return value < tryInfo.startAddr; });
+        if (it == codeInfo.tries.begin())
+        {
+            return nullptr;
+        }
+        --it;
 
-            // 解析每个catch类型
-            for (uint32_t j = 0; j < catchCount; j++)
+        if (pc - it->startAddr >= it->insnCount)
+        {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    // 查找方法中覆盖pc的异常处理器
+    std::shared_ptr<const CatchHandlerInfo> DexContext::findCatchHandler(uint32_t methodIdx, uint32_t pc) const
+    {
+        std::shared_ptr<const CodeInfo> codeInfo = getTryCatchInfo(getMethodCodeOff(methodIdx));
+        if (codeInfo == nullptr)
+        {
+            return nullptr;
+        }
+
+        const TryBlockInfo* tryInfo = findTryBlock(*codeInfo, pc);
+        if (tryInfo == nullptr)
+        {
+            return nullptr;
+        }
+
+        // 与代码信息共享所有权，调用方持有期间处理器表保持有效
+        return std::shared_ptr<const CatchHandlerInfo>(codeInfo, &codeInfo->handlers[tryInfo->handlerIdx]);
+    }
+
+    // 获取指定偏移处的代码段
+    const DexCode* DexContext::getCodeItem(uint32_t codeOff) const
+    {
+        if (codeOff == 0 || fileData_ == nullptr)
+        {
+            return nullptr;
+        }
+
+        // 检查code_item头部是否位于code_item段内（code_item要求4字节对齐）
+        if (codeOff % 4 != 0 || !isInSection(kDexTypeCodeItem, codeOff, offsetof(DexCode, insns)))
+        {
+            LOGE("代码偏移量无效: 0x%08X", codeOff);
+            return nullptr;
+        }
+
+        // 指令数组整体位于段内后，解码时只需按insns_size检查，不再检查文件范围
+        const DexCode* dexCode = reinterpret_cast<const DexCode*>(fileData_ + codeOff);
+        if (!isInSection(kDexTypeCodeItem, codeOff,
+                         offsetof(DexCode, insns) + static_cast<uint64_t>(dexCode->insns_size) * sizeof(uint16_t)))
+        {
+            LOGE("代码段指令数组超出代码段范围: 0x%08X", codeOff);
+            return nullptr;
+        }
+
+        return dexCode;
+    }
+
+    // 收集所有带代码的方法
+    std::vector<std::pair<uint32_t, uint32_t>> DexContext::collectCodeItems() const
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> items;
+
+        for (const uint32_t classDefIdx : selectedClassDefs_)
+        {
+            const ClassDefInfo& classInfo = classDefCache_[classDefIdx];
+            if (!classInfo.classData.isLoaded)
             {
-                TryBlockInfo::CatchInfo catchInfo;
+                continue;
+            }
 
-                // 读取捕获的异常类型
-                uint32_t typeIdx = readULEB128(&handlerData);
-                catchInfo.typeIdx = typeIdx;
+            for (const auto& method : classInfo.classData.directMethods)
+            {
+                if (method.codeOff != 0)
+                {
+                    items.emplace_back(method.methodIdx, method.codeOff);
+                }
+            }
+
+            for (const auto& method : classInfo.classData.virtualMethods)
+            {
+                if (method.codeOff != 0)
+                {
+                    items.emplace_back(method.methodIdx, method.codeOff);
+                }
+            }
+        }
 
-                // 读取处理器地址
-                uint32_t addr = readULEB128(&handlerData);
-                catchInfo.address = addr;
+        return items;
+    }
 
-                // 获取类型名称
-                if (typeIdx < typeIds_.size())
+    // 构建字段交叉引用索引
+    bool DexContext::buildFieldXrefs() const
+    {
+        // 快照中已保存构建好的索引
+        if (fieldXrefs_.isBuilt || snapshot_ != nullptr)
+        {
+            return true;
+        }
+
+        // 需要完整的类数据才能找到所有代码段
+        if (!classDefs_.empty() && !loadAllClassDefs())
+        {
+            LOGE("加载类定义失败，无法构建字段交叉引用");
+            return false;
+        }
+
+        const uint32_t fieldCount = getFieldIdsCount();
+
+        // 第一遍：按扫描顺序收集(fieldIdx, 访问点)
+        std::vector<std::pair<uint32_t, FieldAccessSite>> found;
+        for (const auto& [methodIdx, codeOff] : collectCodeItems())
+        {
+            const DexCode* dexCode = getCodeItem(codeOff);
+            if (dexCode == nullptr)
+            {
+                continue;
+            }
+
+            parser::DecodedInstruction insn;
+            uint32_t pc = 0;
+            while (parser::CodeParser::decodeInstruction(dexCode->insns, dexCode->insns_size, pc, insn))
+            {
+                if (insn.indexType == parser::IndexType::Field && insn.index < fieldCount)
                 {
-                    catchInfo.typeName = getType(typeIdx);
+                    FieldAccessSite site;
+                    site.methodIdx = methodIdx;
+                    site.pc = pc;
+                    site.opcode = static_cast<uint8_t>(insn.opcode);
+                    site.isWrite = parser::CodeParser::isFieldWrite(insn.opcode);
+                    site.isStatic = parser::CodeParser::isStaticFieldAccess(insn.opcode);
+                    found.emplace_back(insn.index, site);
                 }
+                pc += insn.length;
+            }
+        }
 
-                tryInfo.catches.push_back(catchInfo);
+        // 计数排序：按fieldIdx分组，组内保持扫描顺序
+        FieldXrefIndex index;
+        index.offsets.assign(fieldCount + 1, 0);
+        for (const auto& entry : found)
+        {
+            index.offsets[entry.first + 1]++;
+        }
+        for (uint32_t i = 0; i < fieldCount; i++)
+        {
+            index.offsets[i + 1] += index.offsets[i];
+        }
+
+        index.sites.resize(found.size());
+        std::vector<uint32_t> cursor(index.offsets.begin(), index.offsets.end() - 1);
+        for (const auto& entry : found)
+        {
+            index.sites[cursor[entry.first]++] = entry.second;
+        }
+
+        // 统计读写方法数量：同一方法的访问点在组内是连续的
+        index.readerCounts.assign(fieldCount, 0);
+        index.writerCounts.assign(fieldCount, 0);
+        for (uint32_t i = 0; i < fieldCount; i++)
+        {
+            uint32_t lastReader = UINT32_MAX;
+            uint32_t lastWriter = UINT32_MAX;
+            for (uint32_t j = index.offsets[i]; j < index.offsets[i + 1]; j++)
+            {
+                const FieldAccessSite& site = index.sites[j];
+                if (site.isWrite && site.methodIdx != lastWriter)
+                {
+                    index.writerCounts[i]++;
+                    lastWriter = site.methodIdx;
+                }
+                else if (!site.isWrite && site.methodIdx != lastReader)
+                {
+                    index.readerCounts[i]++;
+                    lastReader = site.methodIdx;
+                }
             }
+        }
+
+        index.isBuilt = true;
+        fieldXrefs_ = std::move(index);
+
+        LOGI("字段交叉引用构建完成: %zu 个访问点", fieldXrefs_.sites.size());
+        return true;
+    }
+
+    std::span<const FieldAccessSite> DexContext::getFieldAccessors(uint32_t fieldIdx) const
+    {
+        if (!buildFieldXrefs() || fieldIdx >= getFieldIdsCount())
+        {
+            return {};
+        }
+        if (snapshot_ != nullptr)
+        {
+            return snapshot_->getFieldAccessors(fieldIdx);
+        }
+
+        const uint32_t begin = fieldXrefs_.offsets[fieldIdx];
+        const uint32_t end = fieldXrefs_.offsets[fieldIdx + 1];
+        return {fieldXrefs_.sites.data() + begin, end - begin};
+    }
+
+    uint32_t DexContext::getFieldReaderCount(uint32_t fieldIdx) const
+    {
+        if (!buildFieldXrefs() || fieldIdx >= getFieldIdsCount())
+        {
+            return 0;
+        }
+        if (snapshot_ != nullptr)
+        {
+            return snapshot_->getFieldReaderCount(fieldIdx);
+        }
+        return fieldXrefs_.readerCounts[fieldIdx];
+    }
+
+    uint32_t DexContext::getFieldWriterCount(uint32_t fieldIdx) const
+    {
+        if (!buildFieldXrefs() || fieldIdx >= getFieldIdsCount())
+        {
+            return 0;
+        }
+        if (snapshot_ != nullptr)
+        {
+            return snapshot_->getFieldWriterCount(fieldIdx);
+        }
+        return fieldXrefs_.writerCounts[fieldIdx];
+    }
+
+    // 构建类型使用索引
+    bool DexContext::buildTypeUsages() const
+    {
+        // 快照中已保存构建好的索引
+        if (typeUsages_.isBuilt || snapshot_ != nullptr)
+        {
+            return true;
+        }
+
+        if (!classDefs_.empty() && !loadAllClassDefs())
+        {
+            LOGE("加载类定义失败，无法构建类型使用索引");
+            return false;
+        }
+
+        const uint32_t typeCount = getTypeIdsCount();
+        const std::vector<std::pair<uint32_t, uint32_t>> codeItems = collectCodeItems();
 
-            // 如果有catch-all处理器
-            if (hasCatchAll)
+        // 并行扫描：每块代码段的结果单独存放，合并时按块顺序保证结果确定
+        static constexpr size_t kMethodsPerChunk = 64;
+        std::vector<std::vector<std::pair<uint32_t, TypeUsageSite>>> parts(
+            (codeItems.size() + kMethodsPerChunk - 1) / kMethodsPerChunk);
+
+        parallelFor(codeItems.size(), kMethodsPerChunk, threadCount_,
+                    [&](size_t chunk, size_t begin, size_t end)
+                    {
+                        auto& found = parts[chunk];
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            const uint32_t methodIdx = codeItems[i].first;
+                            const uint32_t codeOff = codeItems[i].second;
+                            const DexCode* dexCode = getCodeItem(codeOff);
+                            if (dexCode == nullptr)
+                            {
+                                continue;
+                            }
+
+                            // 引用类型的指令
+                            parser::DecodedInstruction insn;
+                            uint32_t pc = 0;
+                            while (parser::CodeParser::decodeInstruction(dexCode->insns, dexCode->insns_size, pc, insn))
+                            {
+                                if (insn.indexType == parser::IndexType::Type && insn.index < typeCount)
+                                {
+                                    TypeUsageSite site;
+                                    site.methodIdx = methodIdx;
+                                    site.pc = pc;
+                                    switch (insn.opcode)
+                                    {
+                                        case 0x1c: site.kind = TYPE_USAGE_CONST_CLASS; break;
+                                        case 0x1f: site.kind = TYPE_USAGE_CHECK_CAST; break;
+                                        case 0x20: site.kind = TYPE_USAGE_INSTANCE_OF; break;
+                                        case 0x22: site.kind = TYPE_USAGE_NEW_INSTANCE; break;
+                                        default: site.kind = TYPE_USAGE_NEW_ARRAY; break;
+                                    }
+                                    found.emplace_back(insn.index, site);
+                                }
+                                pc += insn.length;
+                            }
+
+                            // catch处理器的异常类型（处理器表中每个处理器只出现一次）
+                            if (dexCode->tries_size > 0)
+                            {
+                                CodeInfo codeInfo;
+                                if (parseTryCatchInfo(codeOff, codeInfo))
+                                {
+                                    for (const CatchHandlerInfo& handler : codeInfo.handlers)
+                                    {
+                                        for (const CatchHandlerInfo::CatchInfo& catchInfo : handler.catches)
+                                        {
+                                            if (catchInfo.typeIdx < typeCount)
+                                            {
+                                                TypeUsageSite site;
+                                                site.methodIdx = methodIdx;
+                                                site.pc = catchInfo.address;
+                                                site.kind = TYPE_USAGE_CATCH;
+                                                found.emplace_back(catchInfo.typeIdx, site);
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    });
+
+        // 计数排序：按typeIdx分组，组内保持扫描顺序
+        TypeUsageIndex index;
+        index.offsets.assign(typeCount + 1, 0);
+        size_t total = 0;
+        for (const auto& part : parts)
+        {
+            for (const auto& entry : part)
             {
-                tryInfo.hasCatchAll = true;
-                tryInfo.catchAllAddr = readULEB128(&handlerData);
+                index.offsets[entry.first + 1]++;
             }
+            total += part.size();
+        }
+        for (uint32_t i = 0; i < typeCount; i++)
+        {
+            index.offsets[i + 1] += index.offsets[i];
+        }
 
-            codeInfo.tries.push_back(tryInfo);
+        index.sites.resize(total);
+        std::vector<uint32_t> cursor(index.offsets.begin(), index.offsets.end() - 1);
+        for (const auto& part : parts)
+        {
+            for (const auto& entry : part)
+            {
+                index.sites[cursor[entry.first]++] = entry.second;
+            }
         }
 
+        index.isBuilt = true;
+        typeUsages_ = std::move(index);
+
+        LOGI("类型使用索引构建完成: %zu 个使用点", typeUsages_.sites.size());
+        return true;
+    }
+
+    std::span<const TypeUsageSite> DexContext::getTypeUsages(uint32_t typeIdx) const
+    {
+        if (!buildTypeUsages() || typeIdx >= getTypeIdsCount())
+        {
+            return {};
+        }
+        if (snapshot_ != nullptr)
+        {
+            return snapshot_->getTypeUsages(typeIdx);
+        }
+
+        const uint32_t begin = typeUsages_.offsets[typeIdx];
+        const uint32_t end = typeUsages_.offsets[typeIdx + 1];
+        return {typeUsages_.sites.data() + begin, end - begin};
+    }
+
+    // 获取方法的代码偏移量
+    uint32_t DexContext::getMethodCodeOff(uint32_t methodIdx) const
+    {
+        if (snapshot_ != nullptr)
+        {
+            return snapshot_->getMethodCodeOff(methodIdx);
+        }
+
+        if (methodCodeOffs_.empty() && !methodIds_.empty())
+        {
+            // 需要完整的类数据才能建立方法到代码段的映射
+            if (!classDefs_.empty() && !loadAllClassDefs())
+            {
+                LOGE("加载类定义失败，无法建立方法代码索引");
+                return 0;
+            }
+
+            methodCodeOffs_.assign(methodIds_.size(), 0);
+            for (const auto& [itemMethodIdx, codeOff] : collectCodeItems())
+            {
+                if (itemMethodIdx < methodCodeOffs_.size())
+                {
+                    methodCodeOffs_[itemMethodIdx] = codeOff;
+                }
+            }
+        }
+
+        if (methodIdx >= methodCodeOffs_.size())
+        {
+            return 0;
+        }
+        return methodCodeOffs_[methodIdx];
+    }
+
+    // 获取方法的调试信息
+    std::shared_ptr<const DebugInfoData> DexContext::getMethodDebugInfo(uint32_t methodIdx) const
+    {
+        const DexCode* dexCode = getCodeItem(getMethodCodeOff(methodIdx));
+        if (dexCode == nullptr || dexCode->debug_info_off == 0)
+        {
+            return nullptr;
+        }
+        return getDebugInfo(dexCode->debug_info_off);
+    }
+
+    // 查找方法中pc对应的源代码行号
+    int32_t DexContext::lineForPc(uint32_t methodIdx, uint32_t pc) const
+    {
+        // 行号表的最后一个条目覆盖到方法末尾，超出指令范围的pc需要单独排除
+        const DexCode* dexCode = getCodeItem(getMethodCodeOff(methodIdx));
+        if (dexCode == nullptr || dexCode->debug_info_off == 0 || pc >= dexCode->insns_size)
+        {
+            return -1;
+        }
+
+        std::shared_ptr<const DebugInfoData> debugInfo = getDebugInfo(dexCode->debug_info_off);
+        uint32_t line = 0;
+        if (debugInfo == nullptr || !debugInfo->lines.lineForPc(pc, line))
+        {
+            return -1;
+        }
+        return static_cast<int32_t>(line);
+    }
+
+    // 查找方法中某源代码行对应的pc范围
+    std::vector<PcRange> DexContext::pcRangeForLine(uint32_t methodIdx, uint32_t line) const
+    {
+        const DexCode* dexCode = getCodeItem(getMethodCodeOff(methodIdx));
+        if (dexCode == nullptr || dexCode->debug_info_off == 0)
+        {
+            return {};
+        }
+
+        std::shared_ptr<const DebugInfoData> debugInfo = getDebugInfo(dexCode->debug_info_off);
+        if (debugInfo == nullptr)
+        {
+            return {};
+        }
+
+        // 最后一个位置的范围延伸到方法末尾
+        std::vector<PcRange> ranges = debugInfo->lines.pcRangesForLine(line);
+        std::vector<PcRange> result;
+        result.reserve(ranges.size());
+        for (PcRange range : ranges)
+        {
+            range.endPc = std::min(range.endPc, dexCode->insns_size);
+            if (range.startPc < range.endPc)
+            {
+                result.push_back(range);
+            }
+        }
+        return result;
+    }
+
+    void DexContext::setThreadCount(uint32_t threadCount)
+    {
+        threadCount_ = threadCount;
+    }
+
+    uint32_t DexContext::getThreadCount() const
+    {
+        return threadCount_;
+    }
+
+    void DexContext::setVerifyChecksum(bool verify)
+    {
+        verifyChecksum_ = verify;
+    }
+
+    bool DexContext::getVerifyChecksum() const
+    {
+        return verifyChecksum_;
+    }
+
+    void DexContext::setVerifySignature(bool verify)
+    {
+        verifySignature_ = verify;
+    }
+
+    bool DexContext::getVerifySignature() const
+    {
+        return verifySignature_;
+    }
+
+    void DexContext::setSnapshotDir(const std::string& dir)
+    {
+        snapshotDir_ = dir;
+    }
+
+    const std::string& DexContext::getSnapshotDir() const
+    {
+        return snapshotDir_;
+    }
+
+    void DexContext::setClassFilter(ClassFilter filter)
+    {
+        classFilter_ = std::move(filter);
+        applyClassFilter();
+    }
+
+    const ClassFilter& DexContext::getClassFilter() const
+    {
+        return classFilter_;
+    }
+
+    bool DexContext::hasClassFilter() const
+    {
+        return !classFilter_.empty();
+    }
+
+    std::span<const uint32_t> DexContext::getSelectedClassDefs() const
+    {
+        return selectedClassDefs_;
+    }
+
+    bool DexContext::isTypeSelected(uint32_t typeIdx) const
+    {
+        if (classFilter_.empty())
+        {
+            return true;
+        }
+        return typeIdx < selectedTypes_.size() && selectedTypes_[typeIdx] != 0;
+    }
+
+    bool DexContext::isClassDefSelected(uint32_t classDefIdx) const
+    {
+        return classDefIdx < classDefs_.size() && isTypeSelected(classDefs_[classDefIdx].classIdx);
+    }
+
+    void DexContext::applyClassFilter()
+    {
+        // 类型表有序，过滤器只比较映射文件中的描述符，不填充字符串缓存
+        selectedTypes_.clear();
+        if (!classFilter_.empty())
+        {
+            selectedTypes_ = classFilter_.selectTypes(*this);
+        }
+
+        selectedClassDefs_.clear();
+        selectedClassDefs_.reserve(classDefs_.size());
+        for (uint32_t i = 0; i < classDefs_.size(); i++)
+        {
+            if (isClassDefSelected(i))
+            {
+                selectedClassDefs_.push_back(i);
+            }
+        }
+    }
+
+    bool DexContext::loadSnapshot(const Snapshot& snapshot)
+    {
+        if (fileData_ == nullptr)
+        {
+            LOGE("文件数据为空，无法使用快照");
+            return false;
+        }
+
+        // 头部已与快照中保存的头部逐字节比较，ID表范围在写入快照前由解析器验证过
+        const DexHeader& header = snapshot.getHeader();
+        setHeader(header);
+        stringIds_ = mappedTable<DexStringId>(header.stringIdsOff, header.stringIdsSize);
+        typeIds_ = mappedTable<DexTypeId>(header.typeIdsOff, header.typeIdsSize);
+        protoIds_ = mappedTable<DexProtoId>(header.protoIdsOff, header.protoIdsSize);
+        fieldIds_ = mappedTable<DexFieldId>(header.fieldIdsOff, header.fieldIdsSize);
+        methodIds_ = mappedTable<DexMethodId>(header.methodIdsOff, header.methodIdsSize);
+        classDefs_ = mappedTable<DexClassDef>(header.classDefsOff, header.classDefsSize);
+        if (stringIds_.size() != header.stringIdsSize || typeIds_.size() != header.typeIdsSize ||
+            protoIds_.size() != header.protoIdsSize || fieldIds_.size() != header.fieldIdsSize ||
+            methodIds_.size() != header.methodIdsSize || classDefs_.size() != header.classDefsSize)
+        {
+            LOGE("快照中的ID表超出文件范围");
+            reset();
+            return false;
+        }
+
+        dexFile_.pStringIds = stringIds_.data();
+        dexFile_.pTypeIds = typeIds_.data();
+        dexFile_.pProtoIds = protoIds_.data();
+        dexFile_.pFieldIds = fieldIds_.data();
+        dexFile_.pMethodIds = methodIds_.data();
+        dexFile_.pClassDefs = classDefs_.data();
+
+        const std::span<const MapSection> sections = snapshot.getMapSections();
+        setMapList(header.mapOff != 0 ? reinterpret_cast<const DexMapList*>(fileData_ + header.mapOff) : nullptr,
+                   std::vector<MapSection>(sections.begin(), sections.end()));
+
+        // 只有签名与内容一致的文件才会写入快照，签名即内容哈希
+        Sha1Digest signature;
+        memcpy(signature.data(), header.signature, signature.size());
+        setContentHash(signature);
+
+        // 类定义信息按需填充，其余缓存在快照模式下不使用
+        classDefCache_.resize(classDefs_.size());
+        resetClassDataEpochs(classDefs_.size());
+        measureCache(CacheKind::ClassDefs);
+        measureCache(CacheKind::ClassData);
+        applyClassFilter();
+        snapshot_ = &snapshot;
+        isValid_ = true;
         return true;
     }
 
+    const Snapshot* DexContext::getSnapshot() const
+    {
+        return snapshot_;
+    }
+
+    void DexContext::setContentHash(const Sha1Digest& digest)
+    {
+        contentHash_ = digest;
+        hasContentHash_ = true;
+    }
+
+    const Sha1Digest& DexContext::getContentHash() const
+    {
+        if (!hasContentHash_)
+        {
+            constexpr size_t kSignatureStart = offsetof(DexHeader, fileSize);
+            if (fileData_ != nullptr && fileSize_ >= kSignatureStart)
+            {
+                contentHash_ = Sha1::hash(fileData_ + kSignatureStart, fileSize_ - kSignatureStart);
+            }
+            else
+            {
+                contentHash_ = {};
+            }
+            hasContentHash_ = true;
+        }
+        return contentHash_;
+    }
+
+    std::string DexContext::getContentHashString() const
+    {
+        return Sha1::toHex(getContentHash());
+    }
+
+    MemoryUsage DexContext::getMemoryUsage() const
+    {
+        MemoryUsage usage;
+        for (size_t i = 0; i < static_cast<size_t>(CacheKind::Count); i++)
+        {
+            usage.caches[i] = {cacheEntries_[i].load(std::memory_order_relaxed),
+                               cacheBytes_[i].load(std::memory_order_relaxed)};
+        }
+
+        usage[CacheKind::DebugInfo] = {debugInfoCache_.size(), debugInfoCache_.bytes()};
+        usage[CacheKind::TryCatch] = {tryCatchCache_.size(), tryCatchCache_.bytes()};
+
+        // 索引只由几个数组组成，直接统计
+        CacheUsage& indexes = usage[CacheKind::Indexes];
+        indexes.entries = (methodCodeOffs_.empty() ? 0 : 1) + (fieldXrefs_.isBuilt ? 1 : 0) +
+                          (typeUsages_.isBuilt ? 1 : 0);
+        indexes.bytes = vectorBytes(methodCodeOffs_) + vectorBytes(fieldXrefs_.offsets) +
+                        vectorBytes(fieldXrefs_.sites) + vectorBytes(fieldXrefs_.readerCounts) +
+                        vectorBytes(fieldXrefs_.writerCounts) + vectorBytes(typeUsages_.offsets) +
+                        vectorBytes(typeUsages_.sites);
+        return usage;
+    }
+
+    void DexContext::measureCache(CacheKind kind) const
+    {
+        CacheUsage usage;
+        switch (kind)
+        {
+            case CacheKind::Strings:
+                usage.bytes = stringsBytes(stringCache_, &usage.entries);
+                break;
+            case CacheKind::Types:
+                usage.bytes = stringsBytes(typeCache_, &usage.entries);
+                break;
+            case CacheKind::Protos:
+                usage.bytes = stringsBytes(protoCacheShort_, &usage.entries) + stringsBytes(protoCacheReturn_) +
+                              stringsBytes(protoCacheParameter_);
+                break;
+            case CacheKind::Fields:
+                usage.bytes = vectorBytes(fieldCache_);
+                for (const FieldInfo& field : fieldCache_)
+                {
+                    usage.entries += field.name.empty() ? 0 : 1;
+                    usage.bytes += heapBytes(field.className) + heapBytes(field.typeName) + heapBytes(field.name);
+                }
+                break;
+            case CacheKind::Methods:
+                usage.bytes = vectorBytes(methodCache_);
+                for (const MethodInfo& method : methodCache_)
+                {
+                    usage.entries += method.name.empty() ? 0 : 1;
+                    usage.bytes += heapBytes(method.className) + heapBytes(method.protoShorty) +
+                                   heapBytes(method.returnType) + heapBytes(method.name) +
+                                   stringsBytes(method.parameterTypes);
+                }
+                break;
+            case CacheKind::ClassDefs:
+                // 类数据对象内嵌在类定义信息中，它的堆内存计入class_data
+                usage.bytes = vectorBytes(classDefCache_) + vectorBytes(classDataEpochs_);
+                for (const ClassDefInfo& info : classDefCache_)
+                {
+                    usage.entries += info.className.empty() ? 0 : 1;
+                    usage.bytes += classDefBytes(info);
+                }
+                break;
+            case CacheKind::ClassData:
+                for (size_t i = 0; i < classDefCache_.size() && i < classDefs_.size(); i++)
+                {
+                    const ClassDefInfo::ClassDataInfo& classData = classDefCache_[i].classData;
+                    if (classData.isLoaded && classDefs_[i].classDataOff != 0)
+                    {
+                        usage.entries++;
+                        usage.bytes += classDataBytes(classData);
+                    }
+                }
+                break;
+            case CacheKind::TypeLists:
+                usage.entries = typeListCache_.size();
+                for (const auto& [offset, typeList] : typeListCache_)
+                {
+                    usage.bytes += typeListBytes(typeList);
+                }
+                break;
+            default:
+                // 调试信息、try/catch信息和索引在getMemoryUsage中直接读取
+                return;
+        }
+        cacheEntries_[static_cast<size_t>(kind)].store(usage.entries, std::memory_order_relaxed);
+        cacheBytes_[static_cast<size_t>(kind)].store(usage.bytes, std::memory_order_relaxed);
+    }
+
+    void DexContext::addCacheUsage(CacheKind kind, int64_t entries, int64_t bytes) const
+    {
+        // 无符号数按模运算，加上负数的补码即为减法
+        cacheEntries_[static_cast<size_t>(kind)].fetch_add(static_cast<uint64_t>(entries), std::memory_order_relaxed);
+        cacheBytes_[static_cast<size_t>(kind)].fetch_add(static_cast<uint64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    uint64_t DexContext::residentBytes() const
+    {
+        const MemoryUsage usage = getMemoryUsage();
+        return usage.totalBytes() - usage[CacheKind::DebugInfo].bytes - usage[CacheKind::TryCatch].bytes;
+    }
+
+    const char* DexContext::getCacheName(CacheKind kind)
+    {
+        return kind < CacheKind::Count ? kCacheNames[static_cast<size_t>(kind)] : "unknown";
+    }
+
+    void DexContext::setMemoryBudget(uint64_t bytes)
+    {
+        memoryBudget_ = bytes;
+    }
+
+    uint64_t DexContext::getMemoryBudget() const
+    {
+        return memoryBudget_;
+    }
+
+    uint64_t DexContext::trimCaches() const
+    {
+        if (memoryBudget_ == 0)
+        {
+            cacheEpoch_++;
+            return 0;
+        }
+
+        const uint64_t total = getMemoryUsage().totalBytes();
+        uint64_t freed = 0;
+        uint64_t classDataFreed = 0;
+        uint64_t bytes = 0;
+
+        // 调试信息和try/catch信息只在查看单个方法时使用，先于类数据淘汰
+        while (total - freed > memoryBudget_ && debugInfoCache_.evictOldest(bytes))
+        {
+            freed += bytes;
+        }
+        while (total - freed > memoryBudget_ && tryCatchCache_.evictOldest(bytes))
+        {
+            freed += bytes;
+        }
+
+        // 类数据成批淘汰：降到预算的3/4，且类数据不足预算的1/4时不扫描，
+        // 逐类调用时（即使其他缓存已超出预算）每次扫描至少释放预算的1/4
+        const uint64_t classDataTotal = cacheBytes_[static_cast<size_t>(CacheKind::ClassData)].load(
+            std::memory_order_relaxed);
+        if (total - freed > memoryBudget_ && classDataTotal >= memoryBudget_ / 4)
+        {
+            // 按最近使用的周期排序，同一周期内按类定义顺序
+            std::vector<std::pair<uint32_t, uint32_t>> loaded;
+            for (uint32_t i = 0; i < classDefCache_.size() && i < classDefs_.size(); i++)
+            {
+                if (classDefCache_[i].classData.isLoaded && classDefs_[i].classDataOff != 0)
+                {
+                    loaded.emplace_back(classDataEpochs_[i].load(std::memory_order_relaxed), i);
+                }
+            }
+            std::sort(loaded.begin(), loaded.end());
+
+            const uint64_t target = memoryBudget_ - memoryBudget_ / 4;
+            for (const auto& [epoch, classDefIdx] : loaded)
+            {
+                if (total - freed <= target)
+                {
+                    break;
+                }
+                ClassDefInfo::ClassDataInfo& classData = classDefCache_[classDefIdx].classData;
+                bytes = classDataBytes(classData);
+                freed += bytes;
+                classDataFreed += bytes;
+                addCacheUsage(CacheKind::ClassData, -1, -static_cast<int64_t>(bytes));
+                classData = ClassDefInfo::ClassDataInfo();
+                classDataEvicted_ = true;
+            }
+        }
+
+        cacheEpoch_++;
+        if (classDataFreed > 0)
+        {
+            LOGI("缓存超出内存预算，释放 %llu 字节（类数据 %llu 字节），当前 %llu 字节",
+                 static_cast<unsigned long long>(freed), static_cast<unsigned long long>(classDataFreed),
+                 static_cast<unsigned long long>(total - freed));
+        }
+        return freed;
+    }
+
+    void DexContext::resetClassDataEpochs(size_t count)
+    {
+        classDataEpochs_ = std::vector<std::atomic<uint32_t>>(count);
+        classDataEvicted_ = false;
+    }
+
+    void DexContext::touchClassData(uint32_t classDefIdx) const
+    {
+        if (classDefIdx < classDataEpochs_.size())
+        {
+            classDataEpochs_[classDefIdx].store(cacheEpoch_, std::memory_order_relaxed);
+        }
+    }
+
+    void DexContext::enforceDecodedBudget() const
+    {
+        if (memoryBudget_ == 0)
+        {
+            return;
+        }
+        // 保留刚插入的条目（位于两个缓存的最近使用端）
+        const uint64_t resident = residentBytes();
+        uint64_t bytes = 0;
+        while (resident + debugInfoCache_.bytes() + tryCatchCache_.bytes() > memoryBudget_)
+        {
+            if (debugInfoCache_.size() > 1)
+            {
+                debugInfoCache_.evictOldest(bytes);
+            }
+            else if (tryCatchCache_.size() > 1)
+            {
+                tryCatchCache_.evictOldest(bytes);
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
 }
@@ -5,15 +5,27 @@
 #ifndef DEXCONTEXT_H
 #define DEXCONTEXT_H
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
+#include <memory>
+#include <span>
+#include <utility>
+#include "ClassFilter.h"
 #include "DexFile.h"
+#include "DexReader.h"
+#include "LineTable.h"
+#include "LruCache.h"
+#include "Sha1.h"
 #include "parser/ProtoParser.h"
 
 namespace dex
 {
+    class Snapshot;
+
     // 用于存储TypeList及其相关TypeItem的结构
     struct TypeListData {
         uint32_t size;                      // 列表中项的数量
@@ -71,26 +83,36 @@ namespace dex
         uint32_t registerNum;         // 寄存器编号
         uint32_t nameIdx;             // 变量名索引(字符串表)
         uint32_t typeIdx;             // 变量类型索引(类型表)
-        uint32_t sigIdx;              // 类型签名索引(字符串表)，仅用于泛型
+        uint32_t sigIdx;              // 类型签名索引(字符串表)，仅用于泛型，NO_INDEX表示无签名
         std::string name;             // 变量名
         std::string type;             // 变量类型
         std::string signature;        // 类型签名
     };
     
-    // 位置信息结构体
-    struct PositionInfo {
-        uint32_t address;             // 指令地址
-        uint32_t lineNum;             // 源代码行号
+    // 局部变量作用域事件种类
+    enum LocalScopeEventKind : uint8_t {
+        LOCAL_START = 0,              // DBG_START_LOCAL / DBG_START_LOCAL_EXTENDED
+        LOCAL_END,                    // DBG_END_LOCAL
+        LOCAL_RESTART,                // DBG_RESTART_LOCAL
     };
-    
-    // 调试信息结构体
+
+    // 局部变量作用域事件，按调试指令顺序排列
+    struct LocalScopeEvent {
+        uint32_t address;             // 事件地址(16位字)
+        uint32_t registerNum;         // 寄存器编号
+        uint32_t localIdx;            // 对应localVars中的下标（结束和重新开始时为该寄存器最近的变量），没有时为0xFFFFFFFF
+        LocalScopeEventKind kind;     // 事件种类
+    };
+
+    // 调试信息结构体，解码后只读，按偏移量在方法间共享
     struct DebugInfoData {
         uint32_t debugInfoOff;        // 调试信息在文件中的偏移量
         uint32_t lineStart;           // 起始行号
         uint32_t parametersSize;      // 参数数量
         std::vector<std::string> parameterNames; // 参数名称列表
         std::vector<LocalVarInfo> localVars;     // 局部变量列表
-        std::vector<PositionInfo> positions;     // 位置列表
+        std::vector<LocalScopeEvent> localEvents; // 局部变量作用域事件
+        LineTable lines;              // 行号表
         bool isLoaded;                // 是否已加载
         
         // 构造函数
@@ -101,23 +123,28 @@ namespace dex
             isLoaded(false) {}
     };
     
-    // Try块信息结构体
-    struct TryBlockInfo {
-        uint32_t startAddr;           // 开始地址
-        uint32_t insnCount;           // 指令数量
-        uint32_t handlerOff;          // 处理器偏移量
-        
-        // 异常处理器信息
+    // 异常处理器信息结构体（encoded_catch_handler），同一代码段内可被多个try块共享
+    struct CatchHandlerInfo {
+        uint32_t handlerOff;          // 相对encoded_catch_handler_list起始的偏移量
+
+        // 捕获项
         struct CatchInfo {
-            int32_t typeIdx;          // 捕获的异常类型索引，-1表示catch-all
+            uint32_t typeIdx;         // 捕获的异常类型索引
             uint32_t address;         // 处理器地址
-            std::string typeName;     // 异常类型名
         };
-        
+
         std::vector<CatchInfo> catches; // 捕获列表
         bool hasCatchAll;             // 是否有catch-all处理器
         uint32_t catchAllAddr;        // catch-all处理器地址
     };
+
+    // Try块信息结构体
+    struct TryBlockInfo {
+        uint32_t startAddr;           // 开始地址
+        uint32_t insnCount;           // 指令数量
+        uint32_t handlerOff;          // 处理器偏移量
+        uint32_t handlerIdx;          // 处理器在CodeInfo::handlers中的下标
+    };
     
     // 代码信息结构体
     struct CodeInfo {
@@ -129,7 +156,7 @@ namespace dex
         uint32_t debugInfoOff;        // 调试信息偏移量
         uint32_t insnsSize;           // 指令数量
         std::vector<TryBlockInfo> tries; // try块列表
-        DebugInfoData debugInfo;      // 调试信息
+        std::vector<CatchHandlerInfo> handlers; // 异常处理器表，按handlerOff升序
         bool isLoaded;                // 是否已加载
         
         // 构造函数
@@ -144,6 +171,56 @@ namespace dex
             isLoaded(false) {}
     };
 
+    // 字段访问点（iget/iput/sget/sput指令）
+    struct FieldAccessSite {
+        uint32_t methodIdx;           // 访问者方法索引
+        uint32_t pc;                  // 指令地址(16位字)
+        uint8_t opcode;               // 访问指令操作码
+        bool isWrite;                 // 是否为写操作(iput/sput)
+        bool isStatic;                // 是否为静态字段访问(sget/sput)
+    };
+
+    // 字段交叉引用索引，按fieldIdx分组存放访问点（CSR布局）
+    struct FieldXrefIndex {
+        std::vector<uint32_t> offsets;        // fieldIdx -> sites中的起始位置，大小为字段数+1
+        std::vector<FieldAccessSite> sites;   // 按fieldIdx、扫描顺序排列的访问点
+        std::vector<uint32_t> readerCounts;   // 读取该字段的不同方法数量
+        std::vector<uint32_t> writerCounts;   // 写入该字段的不同方法数量
+        bool isBuilt = false;                 // 是否已构建
+    };
+
+    // 类型使用方式
+    enum TypeUsageKind : uint8_t {
+        TYPE_USAGE_NEW_INSTANCE = 0,  // new-instance
+        TYPE_USAGE_CHECK_CAST,        // check-cast
+        TYPE_USAGE_INSTANCE_OF,       // instance-of
+        TYPE_USAGE_CONST_CLASS,       // const-class
+        TYPE_USAGE_NEW_ARRAY,         // new-array / filled-new-array
+        TYPE_USAGE_CATCH,             // catch处理器的异常类型
+    };
+
+    // 类型使用点
+    struct TypeUsageSite {
+        uint32_t methodIdx;           // 使用者方法索引
+        uint32_t pc;                  // 指令地址(16位字)，catch为处理器地址
+        TypeUsageKind kind;           // 使用方式
+    };
+
+    // 类型使用索引，按typeIdx分组存放使用点（CSR布局）
+    struct TypeUsageIndex {
+        std::vector<uint32_t> offsets;        // typeIdx -> sites中的起始位置，大小为类型数+1
+        std::vector<TypeUsageSite> sites;     // 按typeIdx、扫描顺序排列的使用点
+        bool isBuilt = false;                 // 是否已构建
+    };
+
+    // map_list中的段信息
+    struct MapSection {
+        uint16_t type;                // 段类型(DexMapItemType)
+        uint32_t size;                // 条目数量
+        uint32_t offset;              // 段起始偏移量
+        uint32_t endOffset;           // 段结束偏移量，变长段为下一段的起始偏移量
+    };
+
     // 类定义信息结构体
     struct ClassDefInfo {
         uint32_t classIdx;          // 类索引
@@ -216,16 +293,77 @@ namespace dex
             staticValuesOff(0) {}
     };
 
+    // DexContext中的缓存
+    enum class CacheKind : uint8_t {
+        Strings,        // 字符串内容
+        Types,          // 类型描述符
+        Protos,         // 方法原型的shorty、返回类型和参数
+        Fields,         // 字段信息
+        Methods,        // 方法信息
+        ClassDefs,      // 类定义信息（不含类数据）
+        ClassData,      // 解码的类数据，可淘汰
+        TypeLists,      // 类型列表
+        DebugInfo,      // 调试信息，可淘汰
+        TryCatch,       // try/catch信息，可淘汰
+        Indexes,        // 方法代码索引、字段交叉引用和类型使用索引
+        Count
+    };
+
+    // 一个缓存的占用
+    struct CacheUsage {
+        uint64_t entries = 0;         // 已填充的条目数
+        uint64_t bytes = 0;           // 估算的字节数，包括容器和字符串的堆内存
+    };
+
+    // 全部缓存的占用
+    struct MemoryUsage {
+        CacheUsage caches[static_cast<size_t>(CacheKind::Count)];
+
+        const CacheUsage& operator[](CacheKind kind) const
+        {
+            return caches[static_cast<size_t>(kind)];
+        }
+
+        CacheUsage& operator[](CacheKind kind)
+        {
+            return caches[static_cast<size_t>(kind)];
+        }
+
+        // 全部缓存的字节数
+        uint64_t totalBytes() const
+        {
+            uint64_t total = 0;
+            for (const CacheUsage& usage : caches)
+            {
+                total += usage.bytes;
+            }
+            return total;
+        }
+    };
+
     /**
      * DexContext - 全局上下文单例类
-     * 管理全局的DEX文件数据结构，作为解析器和格式化器之间的桥梁
+     * 管理全局的DEX文件数据结构，作为解析器和格式化器之间的桥梁。
+     * 批量处理时每个文件使用独立的上下文，通过bindCurrent绑定到处理该文件的线程，
+     * 绑定期间本线程的getInstance()返回该上下文。
      */
     class DexContext
     {
     public:
-        // 获取单例实例
+        // 获取当前线程绑定的上下文，未绑定时返回全局实例
         static DexContext& getInstance();
 
+        /**
+         * 把当前线程绑定到指定上下文
+         * 绑定不会传递给并行任务的工作线程，绑定的上下文应设置线程数为1
+         * @param context 要绑定的上下文，nullptr表示恢复为全局实例
+         * @return 之前绑定的上下文，未绑定时为nullptr
+         */
+        static DexContext* bindCurrent(DexContext* context);
+
+        // 创建独立的上下文
+        DexContext();
+
         // 禁止拷贝和赋值
         DexContext(const DexContext&) = delete;
         DexContext& operator=(const DexContext&) = delete;
@@ -249,7 +387,7 @@ namespace dex
         void setStringIds(const DexStringId* stringIds, uint32_t count);
 
         // 获取字符串ID表
-        const std::vector<DexStringId>& getStringIds() const;
+        std::span<const DexStringId> getStringIds() const;
 
         // 获取字符串ID表大小
         uint32_t getStringIdsCount() const;
@@ -257,6 +395,9 @@ namespace dex
         // 获取字符串内容
         std::string getString(uint32_t idx) const;
 
+        // 获取字符串的原始MUTF-8数据（不含长度前缀和结尾的0），直接指向映射的文件，索引无效时返回空
+        std::string_view getStringData(uint32_t idx) const;
+
         // 加载所有字符串内容到内存
         bool loadAllStrings() const;
 
@@ -268,7 +409,7 @@ namespace dex
         void setTypeIds(const DexTypeId* typeIds, uint32_t count);
 
         // 获取TypeID表
-        const std::vector<DexTypeId>& getTypeIds() const;
+        std::span<const DexTypeId> getTypeIds() const;
 
         // 获取TypeID表大小
         uint32_t getTypeIdsCount() const;
@@ -280,7 +421,7 @@ namespace dex
         void setProtoIds(const DexProtoId* proto_id, uint32_t count);
         
         // 获取Proto表
-        const std::vector<DexProtoId>& getProtoIds() const;
+        std::span<const DexProtoId> getProtoIds() const;
         
         // 获取Proto表大小
         uint32_t getProtoIdsCount() const;
@@ -294,6 +435,9 @@ namespace dex
         // 获取Proto的参数列表
         const TypeListData* getProtoParameters(uint32_t idx) const;
         
+        // 获取Proto的显示字符串（"返回类型 (参数, ...)"，用于class_data中的方法）
+        std::string getProtoString(uint32_t idx) const;
+        
         // 加载所有Proto信息
         bool loadAllProtos() const;
         
@@ -304,7 +448,7 @@ namespace dex
         void setFieldIds(const DexFieldId* fieldIds, uint32_t count);
         
         // 获取Field表
-        const std::vector<DexFieldId>& getFieldIds() const;
+        std::span<const DexFieldId> getFieldIds() const;
         
         // 获取Field表大小
         uint32_t getFieldIdsCount() const;
@@ -319,7 +463,7 @@ namespace dex
         void setMethodIds(const DexMethodId* methodIds, uint32_t count);
         
         // 获取Method表
-        const std::vector<DexMethodId>& getMethodIds() const;
+        std::span<const DexMethodId> getMethodIds() const;
         
         // 获取Method表大小
         uint32_t getMethodIdsCount() const;
@@ -334,7 +478,7 @@ namespace dex
         void setClassDefs(const DexClassDef* classDefs, uint32_t count);
         
         // 获取ClassDef表
-        const std::vector<DexClassDef>& getClassDefs() const;
+        std::span<const DexClassDef> getClassDefs() const;
         
         // 获取ClassDef表大小
         uint32_t getClassDefsCount() const;
@@ -345,18 +489,172 @@ namespace dex
         // 加载所有ClassDef信息
         bool loadAllClassDefs() const;
         
+        // 设置map_list及按偏移量排序、已验证的段表
+        void setMapList(const DexMapList* mapList, std::vector<MapSection> sections);
+
+        // 获取按偏移量排序的段表，文件没有map_list时为空
+        std::span<const MapSection> getMapSections() const;
+
+        // 查找包含指定偏移量的段，不在任何段内时返回nullptr
+        const MapSection* findSectionAt(uint32_t offset) const;
+
+        // 获取offset所在的指定类型段的结束偏移量，不在该类型段内时返回0；文件没有map_list时按整个文件处理
+        uint32_t getSectionEnd(uint16_t type, uint32_t offset) const;
+
+        // 检查[offset, offset + size)是否完整位于指定类型的段内
+        bool isInSection(uint16_t type, uint32_t offset, uint64_t size) const;
+        
         // 解析方法代码信息
         bool parseMethodCode(uint32_t methodIdx) const;
         
-        // 解析调试信息
-        bool parseDebugInfo(uint32_t debugInfoOff, DebugInfoData& debugInfo) const;
+        // 获取调试信息（首次访问时解码，按偏移量共享），失败返回nullptr
+        std::shared_ptr<const DebugInfoData> getDebugInfo(uint32_t debugInfoOff) const;
+
+        // 解码调试信息状态机（不经过缓存，可在并行任务中调用）
+        bool decodeDebugInfo(uint32_t debugInfoOff, DebugInfoData& debugInfo) const;
+
+        // 获取方法的调试信息，方法没有代码或调试信息时返回nullptr
+        std::shared_ptr<const DebugInfoData> getMethodDebugInfo(uint32_t methodIdx) const;
+
+        // 获取方法的代码偏移量，没有代码时返回0
+        uint32_t getMethodCodeOff(uint32_t methodIdx) const;
+
+        // 获取指定偏移处的代码段，越界时返回nullptr
+        const DexCode* getCodeItem(uint32_t codeOff) const;
+
+        // 查找方法中pc对应的源代码行号，pc超出方法指令范围或找不到时返回-1
+        int32_t lineForPc(uint32_t methodIdx, uint32_t pc) const;
+
+        // 查找方法中某源代码行对应的pc范围，按代码长度截断
+        std::vector<PcRange> pcRangeForLine(uint32_t methodIdx, uint32_t line) const;
         
         // 解析Try/Catch信息
         bool parseTryCatchInfo(uint32_t codeOff, CodeInfo& codeInfo) const;
+
+        // 获取代码段的Try/Catch信息（首次访问时解码，按代码偏移量共享），失败返回nullptr
+        std::shared_ptr<const CodeInfo> getTryCatchInfo(uint32_t codeOff) const;
+
+        // 查找方法中覆盖pc的try块的异常处理器，pc不在任何try块内时返回nullptr
+        std::shared_ptr<const CatchHandlerInfo> findCatchHandler(uint32_t methodIdx, uint32_t pc) const;
+
+        // 在已按起始地址排序的try块中查找覆盖pc的try块，找不到时返回nullptr
+        static const TryBlockInfo* findTryBlock(const CodeInfo& codeInfo, uint32_t pc);
         
+        // 构建字段交叉引用索引（扫描全部代码段）
+        bool buildFieldXrefs() const;
+
+        // 获取访问指定字段的全部指令位置
+        std::span<const FieldAccessSite> getFieldAccessors(uint32_t fieldIdx) const;
+
+        // 获取读取指定字段的方法数量
+        uint32_t getFieldReaderCount(uint32_t fieldIdx) const;
+
+        // 获取写入指定字段的方法数量
+        uint32_t getFieldWriterCount(uint32_t fieldIdx) const;
+
+        // 构建类型使用索引（并行扫描全部代码段和catch处理器）
+        bool buildTypeUsages() const;
+
+        // 获取使用指定类型的全部位置
+        std::span<const TypeUsageSite> getTypeUsages(uint32_t typeIdx) const;
+
+        // 设置并行分析使用的线程数，0表示使用硬件线程数
+        void setThreadCount(uint32_t threadCount);
+
+        // 获取并行分析使用的线程数
+        uint32_t getThreadCount() const;
+
+        // 设置打开文件时是否校验Adler-32校验和（默认校验）
+        void setVerifyChecksum(bool verify);
+
+        // 获取打开文件时是否校验Adler-32校验和
+        bool getVerifyChecksum() const;
+
+        // 设置打开文件时是否校验SHA-1签名（默认校验）
+        void setVerifySignature(bool verify);
+
+        // 获取打开文件时是否校验SHA-1签名
+        bool getVerifySignature() const;
+
+        // 设置解析快照目录，为空时不使用快照（默认）
+        void setSnapshotDir(const std::string& dir);
+
+        // 获取解析快照目录
+        const std::string& getSnapshotDir() const;
+
+        /**
+         * 设置类过滤器，为空时不过滤（默认）
+         * 设置后解析只物化匹配的类及其引用的字符串：字段、方法和类定义缓存只填充匹配的类，
+         * 其余条目按需解析；已设置类型表时立即重新计算选中的类
+         */
+        void setClassFilter(ClassFilter filter);
+
+        // 获取类过滤器
+        const ClassFilter& getClassFilter() const;
+
+        // 是否设置了类过滤器
+        bool hasClassFilter() const;
+
+        // 获取选中的类定义索引（按类定义顺序），没有过滤器时为全部类定义
+        std::span<const uint32_t> getSelectedClassDefs() const;
+
+        // 类型是否被过滤器选中，没有过滤器时总是返回true
+        bool isTypeSelected(uint32_t typeIdx) const;
+
+        // 类定义是否被过滤器选中
+        bool isClassDefSelected(uint32_t classDefIdx) const;
+
+        /**
+         * 使用解析快照初始化上下文（代替全部解析步骤）
+         * ID表直接指向映射的文件，字符串、class_data和反向索引从快照读取；
+         * 快照由调用者持有，生命周期需覆盖到reset()为止
+         */
+        bool loadSnapshot(const Snapshot& snapshot);
+
+        // 获取当前使用的解析快照，没有时返回nullptr
+        const Snapshot* getSnapshot() const;
+
+        // 设置文件内容哈希（由头部解析时计算）
+        void setContentHash(const Sha1Digest& digest);
+
+        // 获取文件内容哈希（偏移32到文件末尾的SHA-1，与有效文件的签名一致），未计算时首次调用计算
+        const Sha1Digest& getContentHash() const;
+
+        // 获取文件内容哈希的十六进制字符串
+        std::string getContentHashString() const;
+
         // 获取AccessFlags的字符串表示
         static std::string getAccessFlagsString(uint32_t flags);
 
+        /**
+         * 获取各缓存的内存占用
+         * 各缓存在填充和淘汰时维护累计值，这里只读取累计值，可以在每次请求后调用
+         */
+        MemoryUsage getMemoryUsage() const;
+
+        // 缓存名称，例如debug_info
+        static const char* getCacheName(CacheKind kind);
+
+        /**
+         * 设置缓存的内存预算（字节），0表示不限制（默认）
+         * 字符串、类型、ID表信息和索引按文件大小一次性构建，不淘汰但计入预算；
+         * 调试信息、try/catch信息和类数据超出预算时按最久未使用淘汰，下次访问时重新解码
+         */
+        void setMemoryBudget(uint64_t bytes);
+
+        // 获取缓存的内存预算（字节）
+        uint64_t getMemoryBudget() const;
+
+        /**
+         * 按内存预算淘汰冷缓存
+         * 依次淘汰最久未使用的调试信息、try/catch信息和类数据，直到总占用不超过预算；
+         * 类数据成批淘汰到预算的3/4，避免逐类调用时每次都扫描全部类。
+         * 类数据可能正被并行渲染读取，只在这里淘汰，调用时不能有其他线程访问该上下文，
+         * 例如查询服务的请求之间、逐类顺序输出时每个类之后。
+         * @return 释放的字节数
+         */
+        uint64_t trimCaches() const;
+
         // 获取全局DexFile结构
         DexFile& getDexFile();
 
@@ -372,18 +670,54 @@ namespace dex
         // 解析类数据
         bool parseClassData(uint32_t classDefIdx) const;
 
-        // 读取ULEB128编码的数值
-        static uint32_t readULEB128(const uint8_t** pData);
-        
-        // 读取有符号SLEB128编码的数值
-        static int32_t readSLEB128(const uint8_t** pData);
+        // 解析MUTF-8字符串内容，length为字符串长度（UTF-16码元数）
+        static std::string decodeMUTF8(const uint8_t* data, uint32_t length);
 
     private:
-        // 私有构造函数
-        DexContext();
-        
-        // 解析MUTF-8字符串内容
-        static std::string decodeMUTF8(const uint8_t* data);
+
+        // 检查数据是否完整位于映射的文件范围内
+        bool isMappedRange(const void* data, size_t size) const;
+
+        // 获取映射文件中offset处的表，越界时返回空
+        template <typename T>
+        std::span<const T> mappedTable(uint32_t offset, uint32_t count) const
+        {
+            if (count == 0 || !isMappedRange(fileData_ + offset, static_cast<size_t>(count) * sizeof(T)))
+            {
+                return {};
+            }
+            return {reinterpret_cast<const T*>(fileData_ + offset), count};
+        }
+
+        // 从解析快照填充类数据
+        bool loadClassDataFromSnapshot(uint32_t classDefIdx) const;
+
+        // 收集所有带代码的方法(methodIdx, codeOff)，按类定义顺序排列，只包含选中的类
+        std::vector<std::pair<uint32_t, uint32_t>> collectCodeItems() const;
+
+        // 按类过滤器重新计算选中的类型和类定义
+        void applyClassFilter();
+
+        // 解码类数据（不经过快照）
+        bool decodeClassData(uint32_t classDefIdx) const;
+
+        // 按类定义数量重建类数据的使用记录
+        void resetClassDataEpochs(size_t count);
+
+        // 记录类数据在当前周期被使用（可在并行任务中调用）
+        void touchClassData(uint32_t classDefIdx) const;
+
+        // 插入新条目后按预算淘汰调试信息和try/catch缓存中最久未使用的条目
+        void enforceDecodedBudget() const;
+
+        // 重新统计一个缓存的占用并替换累计值，在整体填充或清空缓存后调用
+        void measureCache(CacheKind kind) const;
+
+        // 按增量更新缓存的累计占用（可在并行任务中调用）
+        void addCacheUsage(CacheKind kind, int64_t entries, int64_t bytes) const;
+
+        // 调试信息和try/catch之外的缓存的累计字节数
+        uint64_t residentBytes() const;
         
         // 文件数据指针
         const uint8_t* fileData_;
@@ -394,29 +728,45 @@ namespace dex
         // DEX头部结构
         DexHeader header_;
         
-        // 字符串ID表（动态数组）
-        std::vector<DexStringId> stringIds_;
+        // 以下ID表均为映射文件内的只读视图，由解析器校验范围后设置
+        // 字符串ID表
+        std::span<const DexStringId> stringIds_;
         
         // TypeID表
-        std::vector<DexTypeId> typeIds_;
+        std::span<const DexTypeId> typeIds_;
 
         // ProtoId表
-        std::vector<DexProtoId> protoIds_;
+        std::span<const DexProtoId> protoIds_;
         
         // FieldId表
-        std::vector<DexFieldId> fieldIds_;
+        std::span<const DexFieldId> fieldIds_;
         
         // MethodId表
-        std::vector<DexMethodId> methodIds_;
+        std::span<const DexMethodId> methodIds_;
         
         // ClassDef表
-        std::vector<DexClassDef> classDefs_;
+        std::span<const DexClassDef> classDefs_;
+
+        // map_list段表（按偏移量排序）
+        std::vector<MapSection> mapSections_;
         
         // TypeList缓存，使用偏移量作为键
         mutable std::map<uint32_t, TypeListData> typeListCache_;
         
-        // DebugInfo缓存，使用偏移量作为键
-        mutable std::map<uint32_t, DebugInfoData> debugInfoCache_;
+        // DebugInfo缓存，使用偏移量作为键，共享给所有引用该偏移量的方法
+        mutable SharedLruCache<DebugInfoData> debugInfoCache_;
+
+        // Try/Catch信息缓存，使用代码偏移量作为键
+        mutable SharedLruCache<CodeInfo> tryCatchCache_;
+
+        // methodIdx -> 代码偏移量索引，首次查询时构建
+        mutable std::vector<uint32_t> methodCodeOffs_;
+
+        // 字段交叉引用索引
+        mutable FieldXrefIndex fieldXrefs_;
+
+        // 类型使用索引
+        mutable TypeUsageIndex typeUsages_;
 
         // 已解析的字符串内容缓存（mutable允许在const方法中修改）
         mutable std::vector<std::string> stringCache_;
@@ -448,6 +798,74 @@ namespace dex
         
         // 解析状态
         bool isValid_;
+
+        // 并行分析线程数，0表示使用硬件线程数
+        uint32_t threadCount_;
+
+        // 打开文件时是否校验校验和
+        bool verifyChecksum_;
+
+        // 打开文件时是否校验签名
+        bool verifySignature_;
+
+        // 文件内容哈希
+        mutable Sha1Digest contentHash_;
+
+        // 是否已计算内容哈希
+        mutable bool hasContentHash_;
+
+        // 解析快照目录
+        std::string snapshotDir_;
+
+        // 当前使用的解析快照（由DexDump持有）
+        const Snapshot* snapshot_;
+
+        // 类过滤器
+        ClassFilter classFilter_;
+
+        // 选中的类定义索引
+        std::vector<uint32_t> selectedClassDefs_;
+
+        // 按类型索引的选中标记，没有过滤器时为空
+        std::vector<uint8_t> selectedTypes_;
+
+        // 缓存的内存预算（字节），0表示不限制
+        uint64_t memoryBudget_;
+
+        // 各缓存的累计条目数和字节数，调试信息、try/catch和索引直接从缓存读取
+        mutable std::atomic<uint64_t> cacheEntries_[static_cast<size_t>(CacheKind::Count)] = {};
+        mutable std::atomic<uint64_t> cacheBytes_[static_cast<size_t>(CacheKind::Count)] = {};
+
+        // 缓存周期，每次trimCaches后递增
+        mutable uint32_t cacheEpoch_;
+
+        // 每个类定义的类数据最近被使用的周期，用于按最久未使用淘汰
+        mutable std::vector<std::atomic<uint32_t>> classDataEpochs_;
+
+        // 是否有类数据被淘汰，loadAllClassDefs据此重新解码
+        mutable bool classDataEvicted_;
+    };
+
+    /**
+     * ScopedDexContext - 在作用域内把当前线程绑定到指定上下文，析构时恢复之前的绑定
+     */
+    class ScopedDexContext
+    {
+    public:
+        explicit ScopedDexContext(DexContext& context) : previous_(DexContext::bindCurrent(&context))
+        {
+        }
+
+        ~ScopedDexContext()
+        {
+            DexContext::bindCurrent(previous_);
+        }
+
+        ScopedDexContext(const ScopedDexContext&) = delete;
+        ScopedDexContext& operator=(const ScopedDexContext&) = delete;
+
+    private:
+        DexContext* previous_;
     };
 }
 
@@ -4,7 +4,14 @@
 
 #include "DexDump.h"
 
+#include <cstring>
+#include <span>
+#include <string>
+
+#include "PhaseStats.h"
+#include "ZipArchive.h"
 #include "parser/HeaderParser.h"
+#include "parser/MapListParser.h"
 #include "parser/StringPoolParser.h"
 #include "parser/TypeParser.h"
 #include "parser/ProtoParser.h"
@@ -35,26 +42,160 @@ namespace dex
             return false;
         }
 
+        std::span<const uint8_t> data;
+        {
+            PhaseTimer timer(Phase::Map);
+            if (!mapInput(fileName, data))
+            {
+                return false;
+            }
+            timer.addBytes(data.size());
+            timer.addItems(1);
+        }
+        return openData(data.data(), data.size());
+    }
+
+    bool DexDump::mapInput(const char* fileName, std::span<const uint8_t>& data)
+    {
+        // APK条目先映射整个APK，再从中央目录找到条目
+        std::string archivePath;
+        std::string entryName;
+        const bool isEntry = ZipArchive::splitEntryPath(fileName, archivePath, entryName);
+
         // 映射文件
-        if (const int32_t result = util::mapFile(fileName, &fileData_, &fileSize_); result != 0)
+        if (const int32_t result = util::mapFile(isEntry ? archivePath.c_str() : fileName, &fileData_, &fileSize_);
+            result != 0)
         {
             LOGE("映射文件失败: %d", result);
             return false;
         }
-        LOGI("成功打开DEX文件: %s", fileName);
 
+        if (!isEntry)
+        {
+            LOGI("成功打开DEX文件: %s", fileName);
+            data = {fileData_, fileSize_};
+            return true;
+        }
+
+        // 存储的条目直接使用映射的数据，压缩的条目解压到entryBuffer_
+        ZipArchive archive;
+        const ZipEntry* entry = nullptr;
+        if (!archive.open(fileData_, fileSize_) || (entry = archive.findEntry(entryName)) == nullptr ||
+            !archive.read(*entry, entryBuffer_, data))
+        {
+            LOGE("读取APK条目失败: %s", fileName);
+            close();
+            return false;
+        }
+        LOGI("成功打开APK中的DEX: %s (%s)", fileName, entry->method == 0 ? "存储" : "压缩");
+        return true;
+    }
+
+    bool DexDump::openData(const uint8_t* data, size_t size)
+    {
         // 设置全局上下文数据
         DexContext& context = DexContext::getInstance();
         context.reset(); // 重置上下文，以防之前有残留数据
-        context.setFileData(fileData_, fileSize_);
+        context.setFileData(data, size);
 
-        // 开始解析文件
-        parser();
+        // 设置了类过滤器时只做部分解析，不使用也不写入快照
+        if (context.hasClassFilter())
+        {
+            return parser();
+        }
 
+        // 有匹配的快照时跳过解析
+        if (openSnapshot())
+        {
+            return true;
+        }
 
+        // 开始解析文件，解析失败时文件已关闭
+        if (!parser())
+        {
+            return false;
+        }
+
+        saveSnapshot();
         return true;
     }
 
+    bool DexDump::openSnapshot()
+    {
+        DexContext& context = DexContext::getInstance();
+        if (context.getSnapshotDir().empty() || context.getFileSize() < sizeof(DexHeader))
+        {
+            return false;
+        }
+
+        // 只读取头部，不计算SHA-1，快照按头部中的签名查找
+        DexHeader header;
+        memcpy(&header, context.getFileData(), sizeof(DexHeader));
+        if (memcmp(header.magic, "dex\n", 4) != 0)
+        {
+            return false;
+        }
+
+        const std::string path = Snapshot::pathFor(context.getSnapshotDir(), header);
+        std::unique_ptr<Snapshot> snapshot = Snapshot::open(path, header, context.getFileSize());
+        if (snapshot == nullptr)
+        {
+            return false;
+        }
+
+        // 快照只代替解析，不代替校验：快照保存的头部（含校验和与签名）已与文件头部逐字节比较，
+        // 这里按校验选项对当前文件内容重新计算，内容被改动时回退到完整解析并在那里报错
+        const Sha1Digest* contentHash = nullptr;
+        parser::HeaderParser headerParser(context.getFileData(), context.getFileSize());
+        {
+            PhaseTimer timer(Phase::Header);
+            headerParser.setVerifyChecksum(context.getVerifyChecksum());
+            headerParser.setVerifySignature(context.getVerifySignature());
+            headerParser.setThreadCount(context.getThreadCount());
+            if (!headerParser.parse())
+            {
+                LOGW("文件内容校验失败，不使用解析快照");
+                return false;
+            }
+            contentHash = headerParser.getContentHash();
+            timer.addBytes(context.getVerifyChecksum() || context.getVerifySignature() ? context.getFileSize()
+                                                                                        : sizeof(DexHeader));
+            timer.addItems(1);
+        }
+
+        if (!context.loadSnapshot(*snapshot))
+        {
+            return false;
+        }
+        if (contentHash != nullptr)
+        {
+            context.setContentHash(*contentHash);
+        }
+
+        snapshot_ = std::move(snapshot);
+        LOGI("使用解析快照: %s", path.c_str());
+        return true;
+    }
+
+    void DexDump::saveSnapshot() const
+    {
+        const DexContext& context = DexContext::getInstance();
+        if (context.getSnapshotDir().empty())
+        {
+            return;
+        }
+
+        // 快照以签名为键，签名与内容不一致的文件不写入
+        const DexHeader& header = context.getHeader();
+        if (memcmp(context.getContentHash().data(), header.signature, kSHA1DigestLen) != 0)
+        {
+            LOGW("签名与文件内容不一致，不写入解析快照");
+            return;
+        }
+
+        Snapshot::write(context, Snapshot::pathFor(context.getSnapshotDir(), header));
+    }
+
     bool DexDump::parser()
     {
         // 解析头部信息
@@ -65,6 +206,14 @@ namespace dex
             return false;
         }
 
+        // 解析map_list
+        if (!parseMapList())
+        {
+            LOGE("解析map_list失败");
+            close();
+            return false;
+        }
+
         // 解析String信息
         if (!parseString())
         {
@@ -119,9 +268,13 @@ namespace dex
     bool DexDump::parseHeader()
     {
         DexContext& context = DexContext::getInstance();
+        PhaseTimer timer(Phase::Header);
 
         // 解析DEX头部
         parser::HeaderParser header_parser(context.getFileData(), context.getFileSize());
+        header_parser.setVerifyChecksum(context.getVerifyChecksum());
+        header_parser.setVerifySignature(context.getVerifySignature());
+        header_parser.setThreadCount(context.getThreadCount());
 
         // 调用parse方法执行实际解析
         if (!header_parser.parse())
@@ -132,14 +285,41 @@ namespace dex
 
         // 保存解析结果到全局上下文
         context.setHeader(header_parser.getHeader());
+        if (const Sha1Digest* contentHash = header_parser.getContentHash())
+        {
+            context.setContentHash(*contentHash);
+        }
         context.setValid(true);
 
+        // 校验和与签名校验读取整个文件
+        timer.addBytes(context.getVerifyChecksum() || context.getVerifySignature() ? context.getFileSize()
+                                                                                    : sizeof(DexHeader));
+        timer.addItems(1);
+        return true;
+    }
+
+    bool DexDump::parseMapList()
+    {
+        DexContext& context = DexContext::getInstance();
+        PhaseTimer timer(Phase::MapList);
+
+        // 解析map_list并验证段布局
+        parser::MapListParser mapList_parser(context.getFileData(), context.getFileSize());
+        if (!mapList_parser.parse())
+        {
+            LOGE("解析map_list失败: %s", mapList_parser.getLastError().c_str());
+            return false;
+        }
+
+        timer.addBytes(context.getMapSections().size() * sizeof(DexMapItem));
+        timer.addItems(context.getMapSections().size());
         return true;
     }
 
     bool DexDump::parseString()
     {
         DexContext& context = DexContext::getInstance();
+        PhaseTimer timer(Phase::StringIds);
 
         // 解析StringIds
         parser::StringPoolParser string_parser(context.getFileData(), context.getFileSize());
@@ -149,19 +329,22 @@ namespace dex
             return false;
         }
 
-        // 加载所有字符串到内存
-        if (!context.loadAllStrings())
+        // 加载所有字符串到内存；设置了类过滤器时按需解码，只有选中的类引用到的字符串会被物化
+        if (!context.hasClassFilter() && !context.loadAllStrings())
         {
             LOGW("加载字符串内容失败，但继续解析");
         }
 
         context.setValid(true);
+        timer.addBytes(context.getStringIdsCount() * sizeof(DexStringId));
+        timer.addItems(context.getStringIdsCount());
         return true;
     }
 
     bool DexDump::parseType()
     {
         DexContext& context = DexContext::getInstance();
+        PhaseTimer timer(Phase::TypeIds);
 
         // 解析TypeIds
         parser::TypeParser type_parser(context.getFileData(), context.getFileSize());
@@ -171,19 +354,22 @@ namespace dex
             return false;
         }
 
-        // 加载所有类型到内存
-        if (!context.loadStringType())
+        // 加载所有类型到内存；设置了类过滤器时按需解码
+        if (!context.hasClassFilter() && !context.loadStringType())
         {
             LOGW("加载类型内容失败，但继续解析");
         }
 
         context.setValid(true);
+        timer.addBytes(context.getTypeIdsCount() * sizeof(DexTypeId));
+        timer.addItems(context.getTypeIdsCount());
         return true;
     }
 
     bool DexDump::parseProto()
     {
         DexContext& context = DexContext::getInstance();
+        PhaseTimer timer(Phase::ProtoIds);
 
         // 解析Proto ID表
         parser::ProtoParser proto_parser(context.getFileData(), context.getFileSize());
@@ -199,12 +385,15 @@ namespace dex
             LOGW("加载Proto信息失败，但继续解析");
         }
 
+        timer.addBytes(context.getProtoIdsCount() * sizeof(DexProtoId));
+        timer.addItems(context.getProtoIdsCount());
         return true;
     }
 
     bool DexDump::parseField()
     {
         DexContext& context = DexContext::getInstance();
+        PhaseTimer timer(Phase::FieldIds);
 
         // 解析Field ID表
         parser::FieldParser field_parser(context.getFileData(), context.getFileSize());
@@ -220,12 +409,15 @@ namespace dex
             LOGW("加载Field信息失败，但继续解析");
         }
 
+        timer.addBytes(context.getFieldIdsCount() * sizeof(DexFieldId));
+        timer.addItems(context.getFieldIdsCount());
         return true;
     }
     
     bool DexDump::parseMethod()
     {
         DexContext& context = DexContext::getInstance();
+        PhaseTimer timer(Phase::MethodIds);
 
         // 解析Method ID表
         parser::MethodParser method_parser(context.getFileData(), context.getFileSize());
@@ -241,12 +433,15 @@ namespace dex
             LOGW("加载Method信息失败，但继续解析");
         }
 
+        timer.addBytes(context.getMethodIdsCount() * sizeof(DexMethodId));
+        timer.addItems(context.getMethodIdsCount());
         return true;
     }
     
     bool DexDump::parseClassDef()
     {
         DexContext& context = DexContext::getInstance();
+        PhaseTimer timer(Phase::ClassDefs);
 
         // 解析ClassDef表
         parser::ClassDefsParser classDef_parser(context.getFileData(), context.getFileSize());
@@ -262,6 +457,8 @@ namespace dex
             LOGW("加载ClassDef信息失败，但继续解析");
         }
 
+        timer.addBytes(context.getClassDefsCount() * sizeof(DexClassDef));
+        timer.addItems(context.getClassDefsCount());
         return true;
     }
     
@@ -360,76 +557,22 @@ namespace dex
             return false;
         }
         
-        // 获取方法代码偏移量和调试信息偏移量
-        uint32_t debugInfoOff = 0;
-        
-        // 遍历所有类定义
-        for (uint32_t i = 0; i < context.getClassDefsCount(); i++)
-        {
-            const ClassDefInfo classInfo = context.getClassDefInfo(i);
-            
-            // 检查是否有类数据
-            if (classInfo.classDataOff != 0 && classInfo.classData.isLoaded)
-            {
-                // 查找直接方法
-                for (const auto& method : classInfo.classData.directMethods)
-                {
-                    if (method.methodIdx == methodIdx && method.codeOff != 0)
-                    {
-                        if (!method.codeInfo.isLoaded)
-                        {
-                            return false;  // 代码未正确加载
-                        }
-                        
-                        debugInfoOff = method.codeInfo.debugInfoOff;
-                        break;
-                    }
-                }
-                
-                // 如果在直接方法中没找到，查找虚拟方法
-                if (debugInfoOff == 0)
-                {
-                    for (const auto& method : classInfo.classData.virtualMethods)
-                    {
-                        if (method.methodIdx == methodIdx && method.codeOff != 0)
-                        {
-                            if (!method.codeInfo.isLoaded)
-                            {
-                                return false;  // 代码未正确加载
-                            }
-                            
-                            debugInfoOff = method.codeInfo.debugInfoOff;
-                            break;
-                        }
-                    }
-                }
-                
-                if (debugInfoOff != 0)
-                {
-                    break;
-                }
-            }
-        }
-        
-        if (debugInfoOff == 0)
+        // 调试信息按偏移量共享，首次访问时解码
+        if (context.getMethodDebugInfo(methodIdx) == nullptr)
         {
             LOGE("未找到方法 %u 的调试信息", methodIdx);
             return false;
         }
         
-        // 解析调试信息
-        return parseDebugInfoByOffset(debugInfoOff);
+        return true;
     }
     
     bool DexDump::parseDebugInfoByOffset(uint32_t debugInfoOffset)
     {
         DexContext& context = DexContext::getInstance();
         
-        // 创建调试信息数据结构
-        dex::DebugInfoData debugInfo;
-        
         // 解析调试信息
-        if (!context.parseDebugInfo(debugInfoOffset, debugInfo))
+        if (context.getDebugInfo(debugInfoOffset) == nullptr)
         {
             LOGE("解析调试信息失败: 0x%08X", debugInfoOffset);
             return false;
@@ -447,8 +590,9 @@ namespace dex
             fileData_ = nullptr;
             fileSize_ = 0;
 
-            // 重置全局上下文
+            // 重置全局上下文，再释放上下文引用的快照
             DexContext::getInstance().reset();
+            snapshot_.reset();
         }
     }
 
@@ -6,10 +6,14 @@
 #define DEXDUMP_H
 
 #include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
 
 #include "DexFile.h"
 #include "util.h"
 #include "DexContext.h"
+#include "Snapshot.h"
 #include "log/log.h"
 
 namespace dex
@@ -28,11 +32,29 @@ namespace dex
         // 文件大小
         size_t fileSize_;
 
+        // 当前使用的解析快照
+        std::unique_ptr<Snapshot> snapshot_;
+
+        // APK中压缩或未对齐的DEX条目解压/复制到这里，多次打开之间复用
+        std::vector<uint8_t> entryBuffer_;
+
+        // 映射文件，APK条目解压或复制到entryBuffer_，得到DEX数据
+        bool mapInput(const char* fileName, std::span<const uint8_t>& data);
+
+        // 解析映射的文件或APK条目中的DEX数据
+        bool openData(const uint8_t* data, size_t size);
+
+        // 查找并使用与文件匹配的解析快照，使用前按校验选项校验文件的校验和与签名
+        bool openSnapshot();
+
+        // 解析完成后写入解析快照
+        void saveSnapshot() const;
+
     public:
         DexDump();
         ~DexDump();
 
-        // 打开DEX文件
+        // 打开并解析DEX文件或APK中的DEX条目（app.apk!classes2.dex），映射或解析失败时返回false
         bool open(const char* fileName);
 
         // 关闭DEX文件
@@ -47,6 +69,9 @@ namespace dex
         // 解析DEX头部
         static bool parseHeader();
 
+        // 解析map_list段表
+        static bool parseMapList();
+
         // 解析String信息
         static bool parseString();
 
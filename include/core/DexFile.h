@@ -230,6 +230,34 @@ struct DexCatchHandler
     // u4 catch_all_addr;     // 如果size为负，catch-all处理器地址(ULEB128)
 };
 
+/**
+ * map_list中的段类型定义
+ */
+enum DexMapItemType
+{
+    kDexTypeHeaderItem               = 0x0000,  // 头部
+    kDexTypeStringIdItem             = 0x0001,  // 字符串ID表
+    kDexTypeTypeIdItem               = 0x0002,  // 类型ID表
+    kDexTypeProtoIdItem              = 0x0003,  // 方法原型ID表
+    kDexTypeFieldIdItem              = 0x0004,  // 字段ID表
+    kDexTypeMethodIdItem             = 0x0005,  // 方法ID表
+    kDexTypeClassDefItem             = 0x0006,  // 类定义表
+    kDexTypeCallSiteIdItem           = 0x0007,  // 调用点ID表
+    kDexTypeMethodHandleItem         = 0x0008,  // 方法句柄表
+    kDexTypeMapList                  = 0x1000,  // map_list自身
+    kDexTypeTypeList                 = 0x1001,  // 类型列表
+    kDexTypeAnnotationSetRefList     = 0x1002,  // 注解集引用列表
+    kDexTypeAnnotationSetItem        = 0x1003,  // 注解集
+    kDexTypeClassDataItem            = 0x2000,  // 类数据
+    kDexTypeCodeItem                 = 0x2001,  // 代码段
+    kDexTypeStringDataItem           = 0x2002,  // 字符串数据
+    kDexTypeDebugInfoItem            = 0x2003,  // 调试信息
+    kDexTypeAnnotationItem           = 0x2004,  // 注解
+    kDexTypeEncodedArrayItem         = 0x2005,  // 编码数组（静态字段初始值、调用点）
+    kDexTypeAnnotationsDirectoryItem = 0x2006,  // 注解目录
+    kDexTypeHiddenapiClassDataItem   = 0xF000,  // 隐藏API限制数据
+};
+
 struct DexMapItem
 {
     u2 type; /* type of item */
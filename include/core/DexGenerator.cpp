@@ -0,0 +1,913 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "DexGenerator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+#include "Adler32.h"
+#include "DexContext.h"
+#include "DexFile.h"
+#include "Sha1.h"
+#include "log/log.h"
+
+namespace dex
+{
+    namespace
+    {
+        // 16位索引（类型、字段、方法ID）的上限
+        constexpr uint32_t kMaxIndexCount = 65536;
+
+        // 每个文件固定引用的类型：I、V、Object、String、Exception
+        constexpr uint32_t kBaseTypeCount = 5;
+
+        // 生成的方法使用的局部寄存器v0、v1、v2，参数寄存器在其后
+        constexpr uint16_t kLocalRegisters = 3;
+
+        // 调试信息操作码
+        constexpr uint8_t kDbgEndSequence = 0x00;
+        constexpr uint8_t kDbgAdvancePc = 0x01;
+        constexpr uint8_t kDbgStartLocal = 0x03;
+        constexpr uint8_t kDbgFirstSpecial = 0x0a;
+        constexpr int32_t kDbgLineBase = -4;
+        constexpr int32_t kDbgLineRange = 15;
+
+        // 按小端序追加数据的缓冲区
+        class ByteWriter
+        {
+        public:
+            explicit ByteWriter(std::vector<uint8_t>& data) : data_(data)
+            {
+            }
+
+            size_t size() const
+            {
+                return data_.size();
+            }
+
+            void u1(uint8_t value)
+            {
+                data_.push_back(value);
+            }
+
+            void u2(uint16_t value)
+            {
+                u1(static_cast<uint8_t>(value));
+                u1(static_cast<uint8_t>(value >> 8));
+            }
+
+            void u4(uint32_t value)
+            {
+                u2(static_cast<uint16_t>(value));
+                u2(static_cast<uint16_t>(value >> 16));
+            }
+
+            void uleb(uint32_t value)
+            {
+                while (value >= 0x80)
+                {
+                    u1(static_cast<uint8_t>(value | 0x80));
+                    value >>= 7;
+                }
+                u1(static_cast<uint8_t>(value));
+            }
+
+            void sleb(int32_t value)
+            {
+                while (true)
+                {
+                    const uint8_t byte = value & 0x7F;
+                    value >>= 7;
+                    if ((value == 0 && (byte & 0x40) == 0) || (value == -1 && (byte & 0x40) != 0))
+                    {
+                        u1(byte);
+                        return;
+                    }
+                    u1(byte | 0x80);
+                }
+            }
+
+            void bytes(const void* data, size_t size)
+            {
+                const auto* begin = static_cast<const uint8_t*>(data);
+                data_.insert(data_.end(), begin, begin + size);
+            }
+
+            // 以文件起始为基准对齐到4字节，base是缓冲区起始处的文件偏移
+            void align4(size_t base)
+            {
+                while ((base + data_.size()) % 4 != 0)
+                {
+                    u1(0);
+                }
+            }
+
+            void patchU4(size_t pos, uint32_t value)
+            {
+                for (int i = 0; i < 4; i++)
+                {
+                    data_[pos + i] = static_cast<uint8_t>(value >> (i * 8));
+                }
+            }
+
+        private:
+            std::vector<uint8_t>& data_;
+        };
+
+        // UTF-16码元数，生成的字符串只含BMP字符，每个字符一个码元
+        uint32_t utf16Length(const std::string& string)
+        {
+            uint32_t length = 0;
+            for (const char c : string)
+            {
+                if ((static_cast<uint8_t>(c) & 0xC0) != 0x80)
+                {
+                    length++;
+                }
+            }
+            return length;
+        }
+
+        // 把BMP字符编码为UTF-8（不含U+0000时与MUTF-8相同）
+        void appendUtf8(std::string& out, uint16_t unit)
+        {
+            if (unit < 0x80)
+            {
+                out += static_cast<char>(unit);
+            }
+            else if (unit < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (unit >> 6));
+                out += static_cast<char>(0x80 | (unit & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xE0 | (unit >> 12));
+                out += static_cast<char>(0x80 | ((unit >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (unit & 0x3F));
+            }
+        }
+
+        // 额外的字符串常量：序号保证唯一，后缀大多是ASCII，夹杂拉丁字母和汉字
+        std::string makeString(std::mt19937& rng, uint32_t index)
+        {
+            std::string string = "gen_" + std::to_string(index) + "_";
+            const uint32_t length = 4 + rng() % 17;
+            for (uint32_t i = 0; i < length; i++)
+            {
+                const uint32_t r = rng() % 100;
+                if (r < 80)
+                {
+                    appendUtf8(string, static_cast<uint16_t>('a' + rng() % 26));
+                }
+                else if (r < 92)
+                {
+                    appendUtf8(string, static_cast<uint16_t>(0xC0 + rng() % 0x40));
+                }
+                else
+                {
+                    appendUtf8(string, static_cast<uint16_t>(0x4E00 + rng() % 0x5000));
+                }
+            }
+            return string;
+        }
+
+        // 位置记录：特殊操作码推进地址并把行号加一，地址差过大时先用DBG_ADVANCE_PC
+        void writePosition(ByteWriter& debug, uint32_t addressDelta)
+        {
+            constexpr int32_t lineDelta = 1;
+            constexpr uint32_t maxAddressDelta = (0xFF - kDbgFirstSpecial - (lineDelta - kDbgLineBase)) / kDbgLineRange;
+            if (addressDelta > maxAddressDelta)
+            {
+                debug.u1(kDbgAdvancePc);
+                debug.uleb(addressDelta);
+                addressDelta = 0;
+            }
+            debug.u1(static_cast<uint8_t>(kDbgFirstSpecial + (lineDelta - kDbgLineBase) + addressDelta * kDbgLineRange));
+        }
+
+        // 一个文件中的字段或方法引用，按ID表的排序规则排序
+        struct MemberRef
+        {
+            uint32_t classIdx;  // 所属类型
+            uint32_t nameIdx;   // 名称字符串
+            uint32_t typeIdx;   // 字段类型或方法原型
+            uint32_t slot;      // 在生成顺序中的位置
+        };
+
+        void sortMembers(std::vector<MemberRef>& members, std::vector<uint32_t>& indices)
+        {
+            std::sort(members.begin(), members.end(), [](const MemberRef& a, const MemberRef& b)
+            {
+                if (a.classIdx != b.classIdx)
+                {
+                    return a.classIdx < b.classIdx;
+                }
+                if (a.nameIdx != b.nameIdx)
+                {
+                    return a.nameIdx < b.nameIdx;
+                }
+                return a.typeIdx < b.typeIdx;
+            });
+            indices.resize(members.size());
+            for (uint32_t i = 0; i < members.size(); i++)
+            {
+                indices[members[i].slot] = i;
+            }
+        }
+
+        // 方法体的生成状态
+        struct MethodShape
+        {
+            bool isStatic;              // 静态方法(I)I，否则为虚方法
+            uint32_t staticField;       // 本类的int静态字段，没有时为UINT32_MAX
+            uint32_t instanceField;     // 本类的String实例字段，没有时为UINT32_MAX
+            uint32_t callee;            // 下一个类的静态方法，没有时为UINT32_MAX
+            uint32_t nextType;          // 下一个类的类型
+            uint32_t nextInit;          // 下一个类的构造函数
+        };
+
+        // 生成方法指令，blockStarts记录每个指令块的起始地址，返回值寄存器为v2
+        void buildBody(const MethodShape& shape, uint32_t codeUnits, std::mt19937& rng,
+                       const std::vector<uint32_t>& stringPool, size_t& stringCursor,
+                       const std::vector<uint32_t>& typePool, size_t& typeCursor,
+                       std::vector<uint16_t>& insns, std::vector<uint32_t>& blockStarts)
+        {
+            const uint16_t thisReg = kLocalRegisters;
+            const uint16_t paramReg = shape.isStatic ? kLocalRegisters : kLocalRegisters + 1;
+
+            // const/4 v0, 0; const/4 v1, 0; const/4 v2, 0
+            insns = {0x0012, 0x0112, 0x0212};
+
+            // 结尾的return v2，以及异常处理器的move-exception v0和return v2
+            constexpr uint32_t tailUnits = 3;
+            while (true)
+            {
+                std::vector<uint16_t> block;
+                switch (rng() % 7)
+                {
+                    case 0:
+                    {
+                        const uint32_t string = stringPool[stringCursor++ % stringPool.size()];
+                        if (string <= 0xFFFF)
+                        {
+                            block = {0x001a, static_cast<uint16_t>(string)};    // const-string v0
+                        }
+                        else
+                        {
+                            block = {0x001b, static_cast<uint16_t>(string), static_cast<uint16_t>(string >> 16)};
+                        }
+                        break;
+                    }
+                    case 1:
+                        if (shape.staticField != UINT32_MAX)
+                        {
+                            const auto field = static_cast<uint16_t>(shape.staticField);
+                            block = {0x0160, field, 0x01d8, 0x0101, 0x0167, field};   // sget、add-int/lit8、sput
+                        }
+                        break;
+                    case 2:
+                        if (shape.callee != UINT32_MAX)
+                        {
+                            // invoke-static {p0}, 下一个类的静态方法; move-result v2
+                            block = {0x1071, static_cast<uint16_t>(shape.callee), paramReg, 0x020a};
+                        }
+                        break;
+                    case 3:
+                        // new-instance v0; invoke-direct {v0}, <init>
+                        block = {0x0022, static_cast<uint16_t>(shape.nextType),
+                                 0x1070, static_cast<uint16_t>(shape.nextInit), 0x0000};
+                        break;
+                    case 4:
+                        // if-eqz v2, +4; add-int/lit8 v2, v2, 1
+                        block = {0x0238, 0x0004, 0x02d8, 0x0102};
+                        break;
+                    case 5:
+                        block = {0x001c, static_cast<uint16_t>(typePool[typeCursor++ % typePool.size()])};
+                        break;
+                    default:
+                        if (!shape.isStatic && shape.instanceField != UINT32_MAX)
+                        {
+                            // iget-object v0, this
+                            block = {static_cast<uint16_t>(0x0054 | (thisReg << 12)),
+                                     static_cast<uint16_t>(shape.instanceField)};
+                        }
+                        break;
+                }
+                if (block.empty())
+                {
+                    continue;
+                }
+                if (!blockStarts.empty() && insns.size() + block.size() + tailUnits > codeUnits)
+                {
+                    break;
+                }
+                blockStarts.push_back(static_cast<uint32_t>(insns.size()));
+                insns.insert(insns.end(), block.begin(), block.end());
+            }
+        }
+    }
+
+    DexGenerator::DexGenerator(DexGeneratorOptions options) : options_(std::move(options))
+    {
+        // 单个方法的try块长度为16位
+        options_.codeUnits = std::min<uint32_t>(options_.codeUnits, 0xFFF0);
+        plan();
+    }
+
+    uint32_t DexGenerator::getFileCount() const
+    {
+        return fileCount_;
+    }
+
+    std::string DexGenerator::fileName(uint32_t fileIndex)
+    {
+        return fileIndex == 0 ? "classes.dex" : "classes" + std::to_string(fileIndex + 1) + ".dex";
+    }
+
+    void DexGenerator::plan()
+    {
+        fileCount_ = 0;
+        const uint32_t methodLimit = std::min(options_.maxMethodsPerFile, kMaxIndexCount);
+        // 每个文件额外引用Object.<init>
+        if (options_.classes == 0 || options_.methodsPerClass == 0 || methodLimit < options_.methodsPerClass + 1)
+        {
+            return;
+        }
+
+        uint32_t classesPerFile = (methodLimit - 1) / options_.methodsPerClass;
+        if (options_.fieldsPerClass > 0)
+        {
+            classesPerFile = std::min(classesPerFile, kMaxIndexCount / options_.fieldsPerClass);
+        }
+        if (classesPerFile == 0)
+        {
+            return;
+        }
+
+        // 类和外部类型共用16位的类型索引，超出时继续拆分
+        for (uint32_t files = (options_.classes + classesPerFile - 1) / classesPerFile; files <= options_.classes;
+             files++)
+        {
+            const uint64_t classes = (static_cast<uint64_t>(options_.classes) + files - 1) / files;
+            const uint64_t types = (static_cast<uint64_t>(options_.types) + files - 1) / files;
+            if (kBaseTypeCount + classes + types <= kMaxIndexCount)
+            {
+                fileCount_ = files;
+                return;
+            }
+        }
+    }
+
+    void DexGenerator::share(uint32_t total, uint32_t fileIndex, uint32_t& begin, uint32_t& end) const
+    {
+        begin = static_cast<uint32_t>(static_cast<uint64_t>(total) * fileIndex / fileCount_);
+        end = static_cast<uint32_t>(static_cast<uint64_t>(total) * (fileIndex + 1) / fileCount_);
+    }
+
+    bool DexGenerator::generate(uint32_t fileIndex, std::vector<uint8_t>& data) const
+    {
+        if (fileIndex >= fileCount_)
+        {
+            LOGE("生成参数无效或文件序号超出范围: %u", fileIndex);
+            return false;
+        }
+
+        uint32_t classBegin, classEnd, stringBegin, stringEnd, typeBegin, typeEnd;
+        share(options_.classes, fileIndex, classBegin, classEnd);
+        share(options_.strings, fileIndex, stringBegin, stringEnd);
+        share(options_.types, fileIndex, typeBegin, typeEnd);
+        const uint32_t classCount = classEnd - classBegin;
+        const uint32_t methodsPerClass = options_.methodsPerClass;
+        const uint32_t fieldsPerClass = options_.fieldsPerClass;
+        std::mt19937 rng(options_.seed * 2654435761u + fileIndex);
+
+        // 字符串表：描述符、成员名称和额外的常量，按码点排序
+        const std::string package = "L" + options_.packageName + "/";
+        std::vector<std::string> classNames;
+        classNames.reserve(classCount);
+        for (uint32_t i = classBegin; i < classEnd; i++)
+        {
+            classNames.push_back(package + "C" + std::to_string(i) + ";");
+        }
+        std::vector<std::string> externalNames;
+        for (uint32_t i = typeBegin; i < typeEnd; i++)
+        {
+            externalNames.push_back(package + "ext/T" + std::to_string(i) + ";");
+        }
+
+        std::vector<std::string> strings = {
+            "I", "V", "II", "Ljava/lang/Object;", "Ljava/lang/String;", "Ljava/lang/Exception;",
+            "<init>", "Generated.java", "x", "acc",
+        };
+        strings.insert(strings.end(), classNames.begin(), classNames.end());
+        strings.insert(strings.end(), externalNames.begin(), externalNames.end());
+        for (uint32_t k = 1; k < methodsPerClass; k++)
+        {
+            strings.push_back("m" + std::to_string(k));
+        }
+        for (uint32_t j = 0; j < fieldsPerClass; j++)
+        {
+            strings.push_back((j % 2 == 0 ? "s" : "f") + std::to_string(j / 2));
+        }
+        const size_t firstExtra = strings.size();
+        for (uint32_t i = stringBegin; i < stringEnd; i++)
+        {
+            strings.push_back(makeString(rng, i));
+        }
+        std::vector<std::string> extraStrings(strings.begin() + firstExtra, strings.end());
+        std::sort(strings.begin(), strings.end());
+        strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+        std::unordered_map<std::string, uint32_t> stringIndex;
+        stringIndex.reserve(strings.size());
+        for (uint32_t i = 0; i < strings.size(); i++)
+        {
+            stringIndex.emplace(strings[i], i);
+        }
+
+        // 类型表按描述符的字符串索引排序
+        std::vector<uint32_t> types = {
+            stringIndex["I"], stringIndex["V"], stringIndex["Ljava/lang/Object;"],
+            stringIndex["Ljava/lang/String;"], stringIndex["Ljava/lang/Exception;"],
+        };
+        for (const std::string& name : classNames)
+        {
+            types.push_back(stringIndex[name]);
+        }
+        for (const std::string& name : externalNames)
+        {
+            types.push_back(stringIndex[name]);
+        }
+        std::sort(types.begin(), types.end());
+        std::unordered_map<uint32_t, uint32_t> typeOfString;
+        typeOfString.reserve(types.size());
+        for (uint32_t i = 0; i < types.size(); i++)
+        {
+            typeOfString.emplace(types[i], i);
+        }
+        const auto typeIndex = [&](const std::string& descriptor)
+        {
+            return typeOfString[stringIndex[descriptor]];
+        };
+        const uint32_t typeInt = typeIndex("I");
+        const uint32_t typeVoid = typeIndex("V");
+        const uint32_t typeObject = typeIndex("Ljava/lang/Object;");
+        const uint32_t typeString = typeIndex("Ljava/lang/String;");
+        const uint32_t typeException = typeIndex("Ljava/lang/Exception;");
+        std::vector<uint32_t> classTypes(classCount);
+        for (uint32_t c = 0; c < classCount; c++)
+        {
+            classTypes[c] = typeIndex(classNames[c]);
+        }
+
+        // 方法原型：()V和(I)I，按返回类型排序
+        const uint32_t protoInt = typeInt < typeVoid ? 0 : 1;
+        const uint32_t protoVoid = 1 - protoInt;
+
+        // 字段：偶数位置是int静态字段，奇数位置是String实例字段
+        std::vector<MemberRef> fields;
+        fields.reserve(static_cast<size_t>(classCount) * fieldsPerClass);
+        for (uint32_t c = 0; c < classCount; c++)
+        {
+            for (uint32_t j = 0; j < fieldsPerClass; j++)
+            {
+                const bool isStatic = j % 2 == 0;
+                fields.push_back({classTypes[c], stringIndex[(isStatic ? "s" : "f") + std::to_string(j / 2)],
+                                  isStatic ? typeInt : typeString, c * fieldsPerClass + j});
+            }
+        }
+        std::vector<uint32_t> fieldIndex;
+        sortMembers(fields, fieldIndex);
+
+        // 方法：构造函数，然后是奇数位置的静态方法和偶数位置的虚方法，最后一项是Object.<init>
+        std::vector<MemberRef> methods;
+        methods.reserve(static_cast<size_t>(classCount) * methodsPerClass + 1);
+        for (uint32_t c = 0; c < classCount; c++)
+        {
+            methods.push_back({classTypes[c], stringIndex["<init>"], protoVoid, c * methodsPerClass});
+            for (uint32_t k = 1; k < methodsPerClass; k++)
+            {
+                methods.push_back({classTypes[c], stringIndex["m" + std::to_string(k)], protoInt,
+                                   c * methodsPerClass + k});
+            }
+        }
+        const uint32_t objectInitSlot = classCount * methodsPerClass;
+        methods.push_back({typeObject, stringIndex["<init>"], protoVoid, objectInitSlot});
+        std::vector<uint32_t> methodIndex;
+        sortMembers(methods, methodIndex);
+
+        // 常量指令引用的字符串和类型
+        std::vector<uint32_t> stringPool;
+        for (const std::string& string : extraStrings.empty() ? classNames : extraStrings)
+        {
+            stringPool.push_back(stringIndex[string]);
+        }
+        std::vector<uint32_t> typePool;
+        for (const std::string& name : externalNames.empty() ? classNames : externalNames)
+        {
+            typePool.push_back(typeIndex(name));
+        }
+        size_t stringCursor = 0;
+        size_t typeCursor = 0;
+
+        // 各段的位置：header、ID表，之后是数据区
+        const uint32_t stringIdsOff = sizeof(DexHeader);
+        const uint32_t typeIdsOff = stringIdsOff + static_cast<uint32_t>(strings.size() * sizeof(DexStringId));
+        const uint32_t protoIdsOff = typeIdsOff + static_cast<uint32_t>(types.size() * sizeof(DexTypeId));
+        const uint32_t fieldIdsOff = protoIdsOff + 2 * sizeof(DexProtoId);
+        const uint32_t methodIdsOff = fieldIdsOff + static_cast<uint32_t>(fields.size() * sizeof(DexFieldId));
+        const uint32_t classDefsOff = methodIdsOff + static_cast<uint32_t>(methods.size() * sizeof(DexMethodId));
+        const uint32_t dataOff = classDefsOff + classCount * static_cast<uint32_t>(sizeof(DexClassDef));
+
+        std::vector<uint8_t> section;
+        ByteWriter out(section);
+        const auto offset = [&]()
+        {
+            return static_cast<uint64_t>(dataOff) + out.size();
+        };
+
+        // type_list：(I)I的参数列表
+        const uint32_t typeListOff = static_cast<uint32_t>(offset());
+        out.u4(1);
+        out.u2(static_cast<uint16_t>(typeInt));
+        out.align4(dataOff);
+
+        // code_item，调试信息写入单独的缓冲区，位置确定后回填
+        std::vector<uint8_t> debugData;
+        ByteWriter debug(debugData);
+        std::vector<std::pair<size_t, uint32_t>> debugPatches;
+        std::vector<uint32_t> codeOffsets(static_cast<size_t>(classCount) * methodsPerClass);
+        const uint32_t codeOff = static_cast<uint32_t>(offset());
+        std::vector<uint16_t> insns;
+        std::vector<uint32_t> blockStarts;
+        for (uint32_t c = 0; c < classCount; c++)
+        {
+            const uint32_t next = (c + 1) % classCount;
+            MethodShape shape{};
+            shape.staticField = fieldsPerClass > 0 ? fieldIndex[c * fieldsPerClass] : UINT32_MAX;
+            shape.instanceField = fieldsPerClass > 1 ? fieldIndex[c * fieldsPerClass + 1] : UINT32_MAX;
+            shape.callee = methodsPerClass > 1 ? methodIndex[next * methodsPerClass + 1] : UINT32_MAX;
+            shape.nextType = classTypes[next];
+            shape.nextInit = methodIndex[next * methodsPerClass];
+
+            for (uint32_t k = 0; k < methodsPerClass; k++)
+            {
+                out.align4(dataOff);
+                codeOffsets[c * methodsPerClass + k] = static_cast<uint32_t>(offset());
+                const size_t debugPos = out.size() + 8;
+
+                if (k == 0)
+                {
+                    // 构造函数：invoke-direct {v0}, Object.<init>; return-void
+                    out.u2(1);
+                    out.u2(1);
+                    out.u2(1);
+                    out.u2(0);
+                    out.u4(0);
+                    out.u4(4);
+                    out.u2(0x1070);
+                    out.u2(static_cast<uint16_t>(methodIndex[objectInitSlot]));
+                    out.u2(0x0000);
+                    out.u2(0x000e);
+                    if (options_.debugInfo)
+                    {
+                        debugPatches.emplace_back(debugPos, static_cast<uint32_t>(debug.size()));
+                        debug.uleb(1);
+                        debug.uleb(0);
+                        debug.u1(kDbgFirstSpecial - kDbgLineBase);
+                        debug.u1(kDbgEndSequence);
+                    }
+                    continue;
+                }
+
+                shape.isStatic = k % 2 == 1;
+                blockStarts.clear();
+                buildBody(shape, options_.codeUnits, rng, stringPool, stringCursor, typePool, typeCursor, insns,
+                          blockStarts);
+                const auto bodyEnd = static_cast<uint32_t>(insns.size());
+                insns.push_back(0x020f);        // return v2
+                const auto handlerAddr = static_cast<uint32_t>(insns.size());
+                insns.push_back(0x000d);        // move-exception v0
+                insns.push_back(0x020f);
+                const uint32_t tries = std::min<uint32_t>(options_.triesPerMethod,
+                                                          static_cast<uint32_t>(blockStarts.size()));
+
+                const uint16_t ins = shape.isStatic ? 1 : 2;
+                out.u2(kLocalRegisters + ins);
+                out.u2(ins);
+                out.u2(1);
+                out.u2(static_cast<uint16_t>(tries));
+                out.u4(0);
+                out.u4(static_cast<uint32_t>(insns.size()));
+                for (const uint16_t unit : insns)
+                {
+                    out.u2(unit);
+                }
+
+                if (tries > 0)
+                {
+                    if (insns.size() % 2 != 0)
+                    {
+                        out.u2(0);
+                    }
+                    // 指令块均分到各try块，全部指向同一个捕获Exception的处理器
+                    const auto blocks = static_cast<uint32_t>(blockStarts.size());
+                    for (uint32_t t = 0; t < tries; t++)
+                    {
+                        const uint32_t first = blocks * t / tries;
+                        const uint32_t last = blocks * (t + 1) / tries;
+                        const uint32_t start = blockStarts[first];
+                        const uint32_t end = last < blocks ? blockStarts[last] : bodyEnd;
+                        out.u4(start);
+                        out.u2(static_cast<uint16_t>(end - start));
+                        out.u2(1);
+                    }
+                    out.uleb(1);
+                    out.sleb(1);
+                    out.uleb(typeException);
+                    out.uleb(handlerAddr);
+                }
+
+                if (options_.debugInfo)
+                {
+                    // 参数名x，局部变量acc（v2），每个指令块一行
+                    debugPatches.emplace_back(debugPos, static_cast<uint32_t>(debug.size()));
+                    debug.uleb(1);
+                    debug.uleb(1);
+                    debug.uleb(stringIndex["x"] + 1);
+                    debug.u1(kDbgStartLocal);
+                    debug.uleb(2);
+                    debug.uleb(stringIndex["acc"] + 1);
+                    debug.uleb(typeInt + 1);
+                    uint32_t address = 0;
+                    for (const uint32_t start : blockStarts)
+                    {
+                        writePosition(debug, start - address);
+                        address = start;
+                    }
+                    writePosition(debug, bodyEnd - address);
+                    debug.u1(kDbgEndSequence);
+                }
+
+                if (offset() > UINT32_MAX)
+                {
+                    LOGE("生成的文件超过4GB，请减少类数量或指令长度");
+                    return false;
+                }
+            }
+        }
+        const auto codeCount = static_cast<uint32_t>(codeOffsets.size());
+
+        // string_data_item
+        const uint32_t stringDataOff = static_cast<uint32_t>(offset());
+        std::vector<uint32_t> stringOffsets(strings.size());
+        for (size_t i = 0; i < strings.size(); i++)
+        {
+            stringOffsets[i] = static_cast<uint32_t>(offset());
+            out.uleb(utf16Length(strings[i]));
+            out.bytes(strings[i].data(), strings[i].size() + 1);
+        }
+
+        // debug_info_item
+        const uint32_t debugInfoOff = static_cast<uint32_t>(offset());
+        const size_t debugBase = out.size();
+        out.bytes(debugData.data(), debugData.size());
+        for (const auto& [pos, relative] : debugPatches)
+        {
+            out.patchU4(pos, static_cast<uint32_t>(dataOff + debugBase + relative));
+        }
+
+        // class_data_item：成员按索引升序，索引以差值编码
+        const uint32_t classDataOff = static_cast<uint32_t>(offset());
+        std::vector<uint32_t> classDataOffsets(classCount);
+        std::vector<std::pair<uint32_t, uint32_t>> staticFields, instanceFields;
+        std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> directMethods, virtualMethods;
+        for (uint32_t c = 0; c < classCount; c++)
+        {
+            staticFields.clear();
+            instanceFields.clear();
+            directMethods.clear();
+            virtualMethods.clear();
+            for (uint32_t j = 0; j < fieldsPerClass; j++)
+            {
+                const uint32_t field = fieldIndex[c * fieldsPerClass + j];
+                if (j % 2 == 0)
+                {
+                    staticFields.emplace_back(field, ACC_PUBLIC | ACC_STATIC);
+                }
+                else
+                {
+                    instanceFields.emplace_back(field, ACC_PUBLIC);
+                }
+            }
+            for (uint32_t k = 0; k < methodsPerClass; k++)
+            {
+                const uint32_t slot = c * methodsPerClass + k;
+                if (k == 0)
+                {
+                    directMethods.emplace_back(methodIndex[slot], ACC_PUBLIC | ACC_CONSTRUCTOR, codeOffsets[slot]);
+                }
+                else if (k % 2 == 1)
+                {
+                    directMethods.emplace_back(methodIndex[slot], ACC_PUBLIC | ACC_STATIC, codeOffsets[slot]);
+                }
+                else
+                {
+                    virtualMethods.emplace_back(methodIndex[slot], ACC_PUBLIC, codeOffsets[slot]);
+                }
+            }
+            std::sort(staticFields.begin(), staticFields.end());
+            std::sort(instanceFields.begin(), instanceFields.end());
+            std::sort(directMethods.begin(), directMethods.end());
+            std::sort(virtualMethods.begin(), virtualMethods.end());
+
+            classDataOffsets[c] = static_cast<uint32_t>(offset());
+            out.uleb(static_cast<uint32_t>(staticFields.size()));
+            out.uleb(static_cast<uint32_t>(instanceFields.size()));
+            out.uleb(static_cast<uint32_t>(directMethods.size()));
+            out.uleb(static_cast<uint32_t>(virtualMethods.size()));
+            for (const auto* list : {&staticFields, &instanceFields})
+            {
+                uint32_t previous = 0;
+                for (const auto& [field, flags] : *list)
+                {
+                    out.uleb(field - previous);
+                    out.uleb(flags);
+                    previous = field;
+                }
+            }
+            for (const auto* list : {&directMethods, &virtualMethods})
+            {
+                uint32_t previous = 0;
+                for (const auto& [method, flags, code] : *list)
+                {
+                    out.uleb(method - previous);
+                    out.uleb(flags);
+                    out.uleb(code);
+                    previous = method;
+                }
+            }
+        }
+
+        // map_list，按偏移排序
+        out.align4(dataOff);
+        const uint32_t mapOff = static_cast<uint32_t>(offset());
+        struct MapEntry
+        {
+            uint16_t type;
+            uint32_t size;
+            uint32_t offset;
+        };
+        std::vector<MapEntry> map = {
+            {kDexTypeHeaderItem, 1, 0},
+            {kDexTypeStringIdItem, static_cast<uint32_t>(strings.size()), stringIdsOff},
+            {kDexTypeTypeIdItem, static_cast<uint32_t>(types.size()), typeIdsOff},
+            {kDexTypeProtoIdItem, 2, protoIdsOff},
+            {kDexTypeFieldIdItem, static_cast<uint32_t>(fields.size()), fieldIdsOff},
+            {kDexTypeMethodIdItem, static_cast<uint32_t>(methods.size()), methodIdsOff},
+            {kDexTypeClassDefItem, classCount, classDefsOff},
+            {kDexTypeTypeList, 1, typeListOff},
+            {kDexTypeCodeItem, codeCount, codeOff},
+            {kDexTypeStringDataItem, static_cast<uint32_t>(strings.size()), stringDataOff},
+            {kDexTypeDebugInfoItem, static_cast<uint32_t>(debugPatches.size()), debugInfoOff},
+            {kDexTypeClassDataItem, classCount, classDataOff},
+            {kDexTypeMapList, 1, mapOff},
+        };
+        std::erase_if(map, [](const MapEntry& entry) { return entry.size == 0; });
+        out.u4(static_cast<uint32_t>(map.size()));
+        for (const MapEntry& entry : map)
+        {
+            out.u2(entry.type);
+            out.u2(0);
+            out.u4(entry.size);
+            out.u4(entry.offset);
+        }
+        if (offset() > UINT32_MAX)
+        {
+            LOGE("生成的文件超过4GB，请减少类数量或指令长度");
+            return false;
+        }
+        const auto fileSize = static_cast<uint32_t>(offset());
+
+        // header和ID表
+        data.clear();
+        data.reserve(fileSize);
+        ByteWriter file(data);
+        DexHeader header{};
+        memcpy(header.magic, "dex\n035", 8);
+        header.fileSize = fileSize;
+        header.headerSize = sizeof(DexHeader);
+        header.endianTag = 0x12345678;
+        header.mapOff = mapOff;
+        header.stringIdsSize = static_cast<uint32_t>(strings.size());
+        header.stringIdsOff = stringIdsOff;
+        header.typeIdsSize = static_cast<uint32_t>(types.size());
+        header.typeIdsOff = typeIdsOff;
+        header.protoIdsSize = 2;
+        header.protoIdsOff = protoIdsOff;
+        header.fieldIdsSize = static_cast<uint32_t>(fields.size());
+        header.fieldIdsOff = fields.empty() ? 0 : fieldIdsOff;
+        header.methodIdsSize = static_cast<uint32_t>(methods.size());
+        header.methodIdsOff = methodIdsOff;
+        header.classDefsSize = classCount;
+        header.classDefsOff = classDefsOff;
+        header.dataSize = fileSize - dataOff;
+        header.dataOff = dataOff;
+        file.bytes(&header, sizeof(header));
+
+        for (const uint32_t stringOffset : stringOffsets)
+        {
+            file.u4(stringOffset);
+        }
+        for (const uint32_t type : types)
+        {
+            file.u4(type);
+        }
+        // 原型按返回类型排序：(I)I引用参数列表，()V没有参数
+        for (uint32_t p = 0; p < 2; p++)
+        {
+            const bool isInt = p == protoInt;
+            file.u4(stringIndex[isInt ? "II" : "V"]);
+            file.u4(isInt ? typeInt : typeVoid);
+            file.u4(isInt ? typeListOff : 0);
+        }
+        for (const MemberRef& field : fields)
+        {
+            file.u2(static_cast<uint16_t>(field.classIdx));
+            file.u2(static_cast<uint16_t>(field.typeIdx));
+            file.u4(field.nameIdx);
+        }
+        for (const MemberRef& method : methods)
+        {
+            file.u2(static_cast<uint16_t>(method.classIdx));
+            file.u2(static_cast<uint16_t>(method.typeIdx));
+            file.u4(method.nameIdx);
+        }
+        for (uint32_t c = 0; c < classCount; c++)
+        {
+            file.u4(classTypes[c]);
+            file.u4(ACC_PUBLIC);
+            file.u4(typeObject);
+            file.u4(0);
+            file.u4(stringIndex["Generated.java"]);
+            file.u4(0);
+            file.u4(classDataOffsets[c]);
+            file.u4(0);
+        }
+        file.bytes(section.data(), section.size());
+
+        // 签名覆盖偏移32之后的内容，校验和覆盖偏移12之后的内容（包括签名）
+        const Sha1Digest signature = Sha1::hash(data.data() + 32, data.size() - 32);
+        memcpy(data.data() + 12, signature.data(), signature.size());
+        file.patchU4(8, adler32(1, data.data() + 12, data.size() - 12));
+        return true;
+    }
+
+    bool DexGenerator::writeFiles(const std::string& outputDir, std::vector<std::string>& paths) const
+    {
+        if (fileCount_ == 0)
+        {
+            LOGE("生成参数无效");
+            return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(outputDir, ec);
+        if (ec)
+        {
+            LOGE("创建输出目录失败: %s (%s)", outputDir.c_str(), ec.message().c_str());
+            return false;
+        }
+
+        std::vector<uint8_t> data;
+        for (uint32_t i = 0; i < fileCount_; i++)
+        {
+            if (!generate(i, data))
+            {
+                return false;
+            }
+            const std::string path = (std::filesystem::path(outputDir) / fileName(i)).string();
+            FILE* file = fopen(path.c_str(), "wb");
+            if (file == nullptr)
+            {
+                LOGE("创建文件失败: %s", path.c_str());
+                return false;
+            }
+            const bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+            if (fclose(file) != 0 || !written)
+            {
+                LOGE("写入文件失败: %s", path.c_str());
+                return false;
+            }
+            paths.push_back(path);
+        }
+        return true;
+    }
+}
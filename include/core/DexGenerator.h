@@ -0,0 +1,75 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef DEXGENERATOR_H
+#define DEXGENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dex
+{
+    // 合成DEX文件的规模参数，数量均为全部输出文件的总数
+    struct DexGeneratorOptions
+    {
+        uint32_t classes = 1000;            // 类数量
+        uint32_t methodsPerClass = 8;       // 每个类的方法数，包括构造函数
+        uint32_t fieldsPerClass = 4;        // 每个类的字段数，静态与实例字段交替
+        uint32_t strings = 10000;           // 额外的字符串常量数量
+        uint32_t types = 100;               // 额外引用的外部类型数量
+        uint32_t codeUnits = 64;            // 每个方法的大致指令长度（16位码元）
+        uint32_t triesPerMethod = 1;        // 每个方法的try块数量
+        bool debugInfo = true;              // 是否生成调试信息
+        uint32_t maxMethodsPerFile = 65536; // 单个文件的方法ID上限，超出时拆分为多个文件
+        uint32_t seed = 1;                  // 随机种子，相同参数和种子生成相同的文件
+        std::string packageName = "com/example/gen";   // 生成类所在的包
+    };
+
+    /**
+     * DexGenerator - 生成用于规模测试的合成DEX文件
+     * 生成的文件结构完整：各ID表按规范排序，map_list、校验和与签名正确，方法包含字符串、字段、
+     * 调用、分支等常见指令以及try块和调试信息。类超出单个文件的方法或字段上限时按multidex的方式
+     * 拆分为classes.dex、classes2.dex……，调用只引用同一文件中的类。
+     */
+    class DexGenerator
+    {
+    public:
+        explicit DexGenerator(DexGeneratorOptions options);
+
+        // 输出文件数量，参数无效时为0
+        uint32_t getFileCount() const;
+
+        /**
+         * 生成一个文件
+         * @param fileIndex 文件序号
+         * @param data 输出参数，文件内容
+         * @return 参数无效或文件超过4GB时返回false
+         */
+        bool generate(uint32_t fileIndex, std::vector<uint8_t>& data) const;
+
+        /**
+         * 生成全部文件并写入目录
+         * @param outputDir 输出目录，不存在时创建
+         * @param paths 输出参数，写入的文件路径
+         * @return 生成或写入失败时返回false
+         */
+        bool writeFiles(const std::string& outputDir, std::vector<std::string>& paths) const;
+
+        // 文件序号对应的文件名：classes.dex、classes2.dex……
+        static std::string fileName(uint32_t fileIndex);
+
+    private:
+        // 计算文件数量，每个文件的类、字符串和类型数量不超过索引上限
+        void plan();
+
+        // 第fileIndex个文件中[begin, end)范围内的元素，total个元素均分到各文件
+        void share(uint32_t total, uint32_t fileIndex, uint32_t& begin, uint32_t& end) const;
+
+        DexGeneratorOptions options_;
+        uint32_t fileCount_ = 0;
+    };
+}
+
+#endif //DEXGENERATOR_H
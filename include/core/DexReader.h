@@ -0,0 +1,258 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef DEXREADER_H
+#define DEXREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace dex
+{
+    /**
+     * DEX数据读取游标
+     * Checked为true时每次读取前做防溢出的边界检查（只用减法比较，不计算offset + size），
+     * 越界或编码非法时读取器进入失败状态，之后的读取都返回0，调用方在一组读取后检查ok()即可；
+     * Checked为false时不做任何检查，读取直接编译为内存加载，只能用于已验证过的数据
+     * （例如已通过StringPoolParser验证的字符串数据、程序自己生成的编码数据）。
+     */
+    template <bool Checked>
+    class DexReader
+    {
+    public:
+        DexReader() = default;
+
+        /**
+         * 构造函数
+         * @param data 数据起始地址
+         * @param size 数据长度
+         * @param offset 游标初始位置
+         */
+        DexReader(const uint8_t* data, size_t size, size_t offset = 0)
+            : data_(data), size_(size), pos_(offset), failed_(false)
+        {
+            if constexpr (Checked)
+            {
+                failed_ = data == nullptr || offset > size;
+            }
+        }
+
+        // 之前的读取是否全部成功
+        bool ok() const
+        {
+            return !failed_;
+        }
+
+        // 当前游标位置
+        size_t offset() const
+        {
+            return pos_;
+        }
+
+        // 游标之后剩余的字节数
+        size_t remaining() const
+        {
+            return pos_ <= size_ ? size_ - pos_ : 0;
+        }
+
+        // 当前游标处的数据指针
+        const uint8_t* current() const
+        {
+            return data_ + pos_;
+        }
+
+        // 检查[offset, offset + length)是否位于数据范围内，不受Checked影响
+        bool isValidRange(size_t offset, size_t length) const
+        {
+            return data_ != nullptr && offset <= size_ && length <= size_ - offset;
+        }
+
+        // 检查offset处count个T是否位于数据范围内
+        template <typename T>
+        bool isValidArray(size_t offset, size_t count) const
+        {
+            return data_ != nullptr && offset <= size_ && count <= (size_ - offset) / sizeof(T);
+        }
+
+        /**
+         * 获取offset处的结构体指针
+         * @param offset 偏移量
+         * @param length 需要位于范围内的字节数，默认为结构体大小（变长结构体可只检查固定头部）
+         * @return 结构体指针，检查模式下越界返回nullptr
+         */
+        template <typename T>
+        const T* at(size_t offset, size_t length = sizeof(T)) const
+        {
+            if constexpr (Checked)
+            {
+                if (!isValidRange(offset, length))
+                {
+                    return nullptr;
+                }
+            }
+            return reinterpret_cast<const T*>(data_ + offset);
+        }
+
+        /**
+         * 获取offset处count个T组成的数组
+         * @return 数组指针，检查模式下越界返回nullptr
+         */
+        template <typename T>
+        const T* array(size_t offset, size_t count) const
+        {
+            if constexpr (Checked)
+            {
+                if (!isValidArray<T>(offset, count))
+                {
+                    return nullptr;
+                }
+            }
+            return reinterpret_cast<const T*>(data_ + offset);
+        }
+
+        // 移动游标到offset
+        bool seek(size_t offset)
+        {
+            if constexpr (Checked)
+            {
+                if (failed_ || offset > size_)
+                {
+                    return fail();
+                }
+            }
+            pos_ = offset;
+            return true;
+        }
+
+        // 跳过length个字节
+        bool skip(size_t length)
+        {
+            if constexpr (Checked)
+            {
+                if (failed_ || length > remaining())
+                {
+                    return fail();
+                }
+            }
+            pos_ += length;
+            return true;
+        }
+
+        // 读取一个定长小端数值
+        template <typename T>
+        T read()
+        {
+            if constexpr (Checked)
+            {
+                if (failed_ || remaining() < sizeof(T))
+                {
+                    fail();
+                    return T{};
+                }
+            }
+            T value;
+            memcpy(&value, data_ + pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return value;
+        }
+
+        // 读取ULEB128编码的数值（最多5字节）
+        uint32_t readULEB128()
+        {
+            uint32_t result = 0;
+            for (uint32_t i = 0; i < 5; i++)
+            {
+                if constexpr (Checked)
+                {
+                    if (failed_ || pos_ >= size_)
+                    {
+                        fail();
+                        return 0;
+                    }
+                }
+
+                const uint8_t byte = data_[pos_++];
+                result |= static_cast<uint32_t>(byte & 0x7F) << (i * 7);
+                if ((byte & 0x80) == 0)
+                {
+                    return result;
+                }
+            }
+
+            // 第5字节仍有后续标志，编码非法
+            if constexpr (Checked)
+            {
+                fail();
+                return 0;
+            }
+            return result;
+        }
+
+        // 读取ULEB128p1编码的数值（编码值减1，0xFFFFFFFF表示NO_INDEX）
+        uint32_t readULEB128p1()
+        {
+            return readULEB128() - 1;
+        }
+
+        // 读取SLEB128编码的数值（最多5字节）
+        int32_t readSLEB128()
+        {
+            uint32_t result = 0;
+            for (uint32_t i = 0; i < 5; i++)
+            {
+                if constexpr (Checked)
+                {
+                    if (failed_ || pos_ >= size_)
+                    {
+                        fail();
+                        return 0;
+                    }
+                }
+
+                const uint8_t byte = data_[pos_++];
+                result |= static_cast<uint32_t>(byte & 0x7F) << (i * 7);
+                if ((byte & 0x80) == 0)
+                {
+                    // 最高数据位为1时符号扩展
+                    const uint32_t shift = (i + 1) * 7;
+                    if (shift < 32 && (byte & 0x40))
+                    {
+                        result |= ~0u << shift;
+                    }
+                    return static_cast<int32_t>(result);
+                }
+            }
+
+            // 第5字节仍有后续标志，编码非法
+            if constexpr (Checked)
+            {
+                fail();
+                return 0;
+            }
+            return static_cast<int32_t>(result);
+        }
+
+    private:
+        // 进入失败状态
+        bool fail()
+        {
+            failed_ = true;
+            return false;
+        }
+
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+        size_t pos_ = 0;
+        bool failed_ = false;
+    };
+
+    // 带边界检查的读取器，用于未经验证的文件数据
+    using CheckedReader = DexReader<true>;
+
+    // 不做检查的读取器，用于已验证过的数据
+    using UncheckedReader = DexReader<false>;
+}
+
+#endif // DEXREADER_H
@@ -0,0 +1,472 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "Inflate.h"
+
+#include <cstring>
+
+namespace dex
+{
+    namespace
+    {
+        constexpr int kMaxBits = 15;          // 码字最大长度
+        constexpr int kFastBits = 10;         // 快速表索引位数
+        constexpr int kMaxLitLenCodes = 288;  // 字面量/长度码数量（固定霍夫曼码包括两个保留码）
+        constexpr int kMaxDistCodes = 32;     // 距离码数量（固定霍夫曼码包括两个保留码）
+
+        constexpr uint16_t kLengthBase[29] = {
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+        };
+        constexpr uint8_t kLengthExtra[29] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+        };
+        constexpr uint16_t kDistBase[30] = {
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+        };
+        constexpr uint8_t kDistExtra[30] = {
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+            7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+        };
+        // 码长码的码长在流中的顺序
+        constexpr uint8_t kCodeLengthOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+        /**
+         * 按LSB优先读取位流
+         * 补充时一次装入8字节，缓冲区中已计数位之上的内容就是后续字节，重复装入时按位或不会改变它们。
+         * 输入结束后补0，并记录补了多少字节，用于检查是否读过了输入末尾。
+         */
+        class BitReader
+        {
+        public:
+            BitReader(const uint8_t* data, size_t size) : cur_(data), end_(data + size)
+            {
+            }
+
+            // 补充到至少56位
+            void refill()
+            {
+                if (end_ - cur_ >= 8)
+                {
+                    uint64_t word;
+                    memcpy(&word, cur_, sizeof(word));
+                    bits_ |= word << bitCount_;
+                    const int bytes = (63 - bitCount_) >> 3;
+                    cur_ += bytes;
+                    bitCount_ += bytes * 8;
+                    return;
+                }
+                while (bitCount_ <= 56)
+                {
+                    if (cur_ < end_)
+                    {
+                        bits_ |= static_cast<uint64_t>(*cur_++) << bitCount_;
+                    }
+                    else
+                    {
+                        padded_++;
+                    }
+                    bitCount_ += 8;
+                }
+            }
+
+            uint32_t peek(int count) const
+            {
+                return static_cast<uint32_t>(bits_ & ((1ULL << count) - 1));
+            }
+
+            void consume(int count)
+            {
+                bits_ >>= count;
+                bitCount_ -= count;
+            }
+
+            // 读取count位（count不超过缓冲区中的位数）
+            uint32_t bits(int count)
+            {
+                const uint32_t value = peek(count);
+                consume(count);
+                return value;
+            }
+
+            uint64_t buffer() const
+            {
+                return bits_;
+            }
+
+            // 丢弃到字节边界
+            void alignToByte()
+            {
+                consume(bitCount_ & 7);
+            }
+
+            /**
+             * 读取字节对齐的原始数据（存储块）
+             * 先取出缓冲区中的整字节，其余直接从输入复制
+             */
+            bool readBytes(uint8_t* dst, size_t count)
+            {
+                while (count > 0 && bitCount_ >= 8)
+                {
+                    *dst++ = static_cast<uint8_t>(bits(8));
+                    count--;
+                }
+                if (overrun())
+                {
+                    return false;
+                }
+                if (count > 0)
+                {
+                    // 缓冲区已空，cur_正好指向下一个未读字节
+                    bits_ = 0;
+                    if (static_cast<size_t>(end_ - cur_) < count)
+                    {
+                        return false;
+                    }
+                    memcpy(dst, cur_, count);
+                    cur_ += count;
+                }
+                return true;
+            }
+
+            // 是否读到了补充的0（超出输入末尾）
+            bool overrun() const
+            {
+                return padded_ * 8 > bitCount_;
+            }
+
+        private:
+            const uint8_t* cur_;
+            const uint8_t* end_;
+            uint64_t bits_ = 0;
+            int bitCount_ = 0;
+            int padded_ = 0;
+        };
+
+        // 规范霍夫曼码表
+        struct Huffman
+        {
+            // 快速表：以低kFastBits位为索引，值为(符号 << 4) | 码长，码长为0表示码字更长
+            uint16_t fast[1 << kFastBits];
+            // 每种码长的码字数量
+            uint16_t count[kMaxBits + 1];
+            // 按码字顺序排列的符号
+            uint16_t symbol[kMaxLitLenCodes];
+
+            /**
+             * 由码长构建码表
+             * 允许不完整的码（例如只有一个距离码），不允许超额订阅
+             */
+            bool build(const uint8_t* lengths, int n)
+            {
+                memset(count, 0, sizeof(count));
+                for (int i = 0; i < n; i++)
+                {
+                    count[lengths[i]]++;
+                }
+                count[0] = 0;
+
+                int left = 1;
+                for (int len = 1; len <= kMaxBits; len++)
+                {
+                    left <<= 1;
+                    left -= count[len];
+                    if (left < 0)
+                    {
+                        return false;
+                    }
+                }
+
+                uint16_t offsets[kMaxBits + 2];
+                offsets[1] = 0;
+                for (int len = 1; len <= kMaxBits; len++)
+                {
+                    offsets[len + 1] = offsets[len] + count[len];
+                }
+                for (int i = 0; i < n; i++)
+                {
+                    if (lengths[i] != 0)
+                    {
+                        symbol[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+                    }
+                }
+
+                // 码字按MSB优先分配，位流按LSB优先读取，快速表以反转后的码字为索引
+                memset(fast, 0, sizeof(fast));
+                uint32_t nextCode[kMaxBits + 1];
+                uint32_t code = 0;
+                for (int len = 1; len <= kMaxBits; len++)
+                {
+                    code = (code + count[len - 1]) << 1;
+                    nextCode[len] = code;
+                }
+                for (int i = 0; i < n; i++)
+                {
+                    const int len = lengths[i];
+                    if (len == 0 || len > kFastBits)
+                    {
+                        continue;
+                    }
+                    uint32_t reversed = 0;
+                    for (uint32_t c = nextCode[len]++, k = 0; k < static_cast<uint32_t>(len); k++, c >>= 1)
+                    {
+                        reversed = (reversed << 1) | (c & 1);
+                    }
+                    for (uint32_t index = reversed; index < (1U << kFastBits); index += 1U << len)
+                    {
+                        fast[index] = static_cast<uint16_t>((i << 4) | len);
+                    }
+                }
+                return true;
+            }
+
+            // 解码一个符号，调用前缓冲区至少有kMaxBits位，无效码字返回-1
+            int decode(BitReader& in) const
+            {
+                const uint16_t entry = fast[in.peek(kFastBits)];
+                if (entry != 0)
+                {
+                    in.consume(entry & 0xF);
+                    return entry >> 4;
+                }
+
+                // 逐位按规范码解码
+                uint64_t bits = in.buffer();
+                int code = 0;
+                int first = 0;
+                int index = 0;
+                for (int len = 1; len <= kMaxBits; len++)
+                {
+                    code |= static_cast<int>(bits & 1);
+                    bits >>= 1;
+                    const int n = count[len];
+                    if (code - n < first)
+                    {
+                        in.consume(len);
+                        return symbol[index + (code - first)];
+                    }
+                    index += n;
+                    first = (first + n) << 1;
+                    code <<= 1;
+                }
+                return -1;
+            }
+        };
+
+        // 固定霍夫曼码表
+        struct FixedTables
+        {
+            Huffman litLen;
+            Huffman dist;
+
+            FixedTables()
+            {
+                uint8_t lengths[kMaxLitLenCodes];
+                memset(lengths, 8, 144);
+                memset(lengths + 144, 9, 112);
+                memset(lengths + 256, 7, 24);
+                memset(lengths + 280, 8, 8);
+                litLen.build(lengths, kMaxLitLenCodes);
+                memset(lengths, 5, kMaxDistCodes);
+                dist.build(lengths, kMaxDistCodes);
+            }
+        };
+
+        // 读取动态霍夫曼块的码表
+        bool readDynamicTables(BitReader& in, Huffman& litLen, Huffman& dist)
+        {
+            in.refill();
+            const int litCount = static_cast<int>(in.bits(5)) + 257;
+            const int distCount = static_cast<int>(in.bits(5)) + 1;
+            const int codeLengthCount = static_cast<int>(in.bits(4)) + 4;
+            if (litCount > 286 || distCount > 30)
+            {
+                return false;
+            }
+
+            uint8_t lengths[286 + 30] = {};
+            for (int i = 0; i < codeLengthCount; i++)
+            {
+                in.refill();
+                lengths[kCodeLengthOrder[i]] = static_cast<uint8_t>(in.bits(3));
+            }
+            Huffman codeLengths;
+            if (!codeLengths.build(lengths, 19))
+            {
+                return false;
+            }
+
+            // 字面量/长度码和距离码的码长连续编码，重复码可以跨越两者
+            memset(lengths, 0, sizeof(lengths));
+            const int total = litCount + distCount;
+            for (int i = 0; i < total;)
+            {
+                in.refill();
+                const int symbol = codeLengths.decode(in);
+                if (symbol < 0)
+                {
+                    return false;
+                }
+                if (symbol < 16)
+                {
+                    lengths[i++] = static_cast<uint8_t>(symbol);
+                    continue;
+                }
+
+                uint8_t value = 0;
+                int repeat;
+                if (symbol == 16)
+                {
+                    if (i == 0)
+                    {
+                        return false;
+                    }
+                    value = lengths[i - 1];
+                    repeat = 3 + static_cast<int>(in.bits(2));
+                }
+                else if (symbol == 17)
+                {
+                    repeat = 3 + static_cast<int>(in.bits(3));
+                }
+                else
+                {
+                    repeat = 11 + static_cast<int>(in.bits(7));
+                }
+                if (i + repeat > total)
+                {
+                    return false;
+                }
+                memset(lengths + i, value, repeat);
+                i += repeat;
+            }
+
+            // 块必须有结束码
+            if (lengths[256] == 0)
+            {
+                return false;
+            }
+            return litLen.build(lengths, litCount) && dist.build(lengths + litCount, distCount) && !in.overrun();
+        }
+
+        // 解码一个压缩块的数据
+        bool inflateCodes(BitReader& in, const Huffman& litLen, const Huffman& dist,
+                          uint8_t* output, size_t outputSize, size_t& pos)
+        {
+            for (;;)
+            {
+                // 一次补充足够解码一个完整的长度/距离对（最多15+5+15+13位）
+                in.refill();
+                int symbol = litLen.decode(in);
+                if (symbol < 0)
+                {
+                    return false;
+                }
+                if (symbol < 256)
+                {
+                    if (pos >= outputSize)
+                    {
+                        return false;
+                    }
+                    output[pos++] = static_cast<uint8_t>(symbol);
+                    continue;
+                }
+                if (symbol == 256)
+                {
+                    return !in.overrun();
+                }
+
+                symbol -= 257;
+                if (symbol >= 29)
+                {
+                    return false;
+                }
+                const size_t length = kLengthBase[symbol] + in.bits(kLengthExtra[symbol]);
+
+                const int distSymbol = dist.decode(in);
+                if (distSymbol < 0 || distSymbol >= 30)
+                {
+                    return false;
+                }
+                const size_t distance = kDistBase[distSymbol] + in.bits(kDistExtra[distSymbol]);
+                if (distance > pos || length > outputSize - pos)
+                {
+                    return false;
+                }
+
+                // 不重叠时整段复制，重叠时逐字节复制以重复前面的内容
+                uint8_t* dst = output + pos;
+                const uint8_t* src = dst - distance;
+                if (distance >= length)
+                {
+                    memcpy(dst, src, length);
+                }
+                else
+                {
+                    for (size_t i = 0; i < length; i++)
+                    {
+                        dst[i] = src[i];
+                    }
+                }
+                pos += length;
+            }
+        }
+    }
+
+    bool inflate(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize)
+    {
+        static const FixedTables fixedTables;
+
+        BitReader in(input, inputSize);
+        size_t pos = 0;
+        bool last;
+        do
+        {
+            in.refill();
+            last = in.bits(1) != 0;
+            const uint32_t type = in.bits(2);
+
+            if (type == 0)
+            {
+                // 存储块：LEN和NLEN互为反码
+                in.alignToByte();
+                const uint32_t length = in.bits(16);
+                const uint32_t inverted = in.bits(16);
+                if (in.overrun() || length != (~inverted & 0xFFFF) || length > outputSize - pos)
+                {
+                    return false;
+                }
+                if (!in.readBytes(output + pos, length))
+                {
+                    return false;
+                }
+                pos += length;
+            }
+            else if (type == 1)
+            {
+                if (!inflateCodes(in, fixedTables.litLen, fixedTables.dist, output, outputSize, pos))
+                {
+                    return false;
+                }
+            }
+            else if (type == 2)
+            {
+                Huffman litLen;
+                Huffman dist;
+                if (!readDynamicTables(in, litLen, dist) ||
+                    !inflateCodes(in, litLen, dist, output, outputSize, pos))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                return false;
+            }
+        } while (!last);
+
+        return pos == outputSize && !in.overrun();
+    }
+}
@@ -0,0 +1,26 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef INFLATE_H
+#define INFLATE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dex
+{
+    /**
+     * 解压原始DEFLATE数据（RFC 1951，ZIP压缩方法8）
+     * 解压后的大小由调用者给出（来自ZIP目录），输出直接写入调用者的缓冲区，不分配内存。
+     * 霍夫曼码按10位快速表查找，更长的码字按规范码逐位解码。
+     * @param input 压缩数据
+     * @param inputSize 压缩数据长度
+     * @param output 输出缓冲区
+     * @param outputSize 解压后的大小
+     * @return 数据有效且解压结果恰好为outputSize字节时返回true
+     */
+    bool inflate(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize);
+}
+
+#endif // INFLATE_H
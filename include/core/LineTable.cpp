@@ -0,0 +1,221 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "LineTable.h"
+
+#include <algorithm>
+#include <cstdint>
+#include "DexReader.h"
+
+namespace dex
+{
+    // 写入ULEB128编码的数值
+    static void writeULEB128(std::vector<uint8_t>& out, uint32_t value)
+    {
+        do
+        {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            if (value != 0)
+            {
+                byte |= 0x80;
+            }
+            out.push_back(byte);
+        }
+        while (value != 0);
+    }
+
+    // 写入SLEB128编码的数值
+    static void writeSLEB128(std::vector<uint8_t>& out, int32_t value)
+    {
+        bool more = true;
+        while (more)
+        {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            if ((value == 0 && (byte & 0x40) == 0) || (value == -1 && (byte & 0x40) != 0))
+            {
+                more = false;
+            }
+            else
+            {
+                byte |= 0x80;
+            }
+            out.push_back(byte);
+        }
+    }
+
+    LineTable::LineTable(std::vector<PositionInfo> positions)
+    {
+        // 状态机产生的地址单调不减，这里保持同地址条目的原始顺序
+        std::stable_sort(positions.begin(), positions.end(),
+                         [](const PositionInfo& a, const PositionInfo& b) { return a.address < b.address; });
+
+        count_ = static_cast<uint32_t>(positions.size());
+        anchors_.reserve((count_ + kBlockSize - 1) / kBlockSize);
+        deltas_.reserve(count_ * 2);
+
+        for (uint32_t i = 0; i < count_; i++)
+        {
+            const PositionInfo& pos = positions[i];
+            if (i % kBlockSize == 0)
+            {
+                anchors_.push_back({pos.address, pos.lineNum, static_cast<uint32_t>(deltas_.size())});
+                continue;
+            }
+
+            const PositionInfo& prev = positions[i - 1];
+            writeULEB128(deltas_, pos.address - prev.address);
+            writeSLEB128(deltas_, static_cast<int32_t>(pos.lineNum - prev.lineNum));
+        }
+        deltas_.shrink_to_fit();
+
+        // 按(行号, 地址)排序的位置序号，用于行号到pc范围的查询
+        byLine_.resize(count_);
+        for (uint32_t i = 0; i < count_; i++)
+        {
+            byLine_[i] = i;
+        }
+        std::sort(byLine_.begin(), byLine_.end(), [&positions](uint32_t a, uint32_t b) {
+            if (positions[a].lineNum != positions[b].lineNum)
+            {
+                return positions[a].lineNum < positions[b].lineNum;
+            }
+            return a < b;
+        });
+    }
+
+    size_t LineTable::size() const
+    {
+        return count_;
+    }
+
+    bool LineTable::empty() const
+    {
+        return count_ == 0;
+    }
+
+    PositionInfo LineTable::at(uint32_t index) const
+    {
+        const Anchor& anchor = anchors_[index / kBlockSize];
+        PositionInfo pos = {anchor.address, anchor.lineNum};
+
+        UncheckedReader reader(deltas_.data(), deltas_.size(), anchor.byteOffset);
+        for (uint32_t i = index % kBlockSize; i > 0; i--)
+        {
+            pos.address += reader.readULEB128();
+            pos.lineNum += reader.readSLEB128();
+        }
+        return pos;
+    }
+
+    std::vector<PositionInfo> LineTable::decode() const
+    {
+        std::vector<PositionInfo> positions;
+        positions.reserve(count_);
+
+        for (uint32_t block = 0; block < anchors_.size(); block++)
+        {
+            const Anchor& anchor = anchors_[block];
+            PositionInfo pos = {anchor.address, anchor.lineNum};
+            positions.push_back(pos);
+
+            UncheckedReader reader(deltas_.data(), deltas_.size(), anchor.byteOffset);
+            uint32_t blockEnd = std::min(count_, (block + 1) * kBlockSize);
+            for (uint32_t i = block * kBlockSize + 1; i < blockEnd; i++)
+            {
+                pos.address += reader.readULEB128();
+                pos.lineNum += reader.readSLEB128();
+                positions.push_back(pos);
+            }
+        }
+        return positions;
+    }
+
+    bool LineTable::lineForPc(uint32_t pc, uint32_t& line) const
+    {
+        // 找到起始地址不大于pc的最后一个块
+        auto it = std::upper_bound(anchors_.begin(), anchors_.end(), pc,
+                                   [](uint32_t value, const Anchor& anchor) { return value < anchor.address; });
+        if (it == anchors_.begin())
+        {
+            return false;
+        }
+        --it;
+
+        // 块内顺序解码，取地址不大于pc的最后一个位置
+        uint32_t block = static_cast<uint32_t>(it - anchors_.begin());
+        uint32_t blockEnd = std::min(count_, (block + 1) * kBlockSize);
+        uint32_t address = it->address;
+        uint32_t lineNum = it->lineNum;
+
+        UncheckedReader reader(deltas_.data(), deltas_.size(), it->byteOffset);
+        for (uint32_t i = block * kBlockSize + 1; i < blockEnd; i++)
+        {
+            uint32_t nextAddress = address + reader.readULEB128();
+            int32_t lineDelta = reader.readSLEB128();
+            if (nextAddress > pc)
+            {
+                break;
+            }
+            address = nextAddress;
+            lineNum += lineDelta;
+        }
+
+        line = lineNum;
+        return true;
+    }
+
+    size_t LineTable::lowerBoundLine(uint32_t line) const
+    {
+        auto it = std::lower_bound(byLine_.begin(), byLine_.end(), line,
+                                   [this](uint32_t index, uint32_t value) { return at(index).lineNum < value; });
+        return it - byLine_.begin();
+    }
+
+    size_t LineTable::upperBoundLine(uint32_t line) const
+    {
+        auto it = std::upper_bound(byLine_.begin(), byLine_.end(), line,
+                                   [this](uint32_t value, uint32_t index) { return value < at(index).lineNum; });
+        return it - byLine_.begin();
+    }
+
+    std::vector<PcRange> LineTable::pcRangesForLine(uint32_t line) const
+    {
+        std::vector<PcRange> ranges;
+
+        size_t first = lowerBoundLine(line);
+        size_t last = upperBoundLine(line);
+        for (size_t i = first; i < last; i++)
+        {
+            // 位置i覆盖[地址i, 地址i+1)，同地址的后续位置会覆盖它
+            uint32_t index = byLine_[i];
+            uint32_t startPc = at(index).address;
+            uint32_t endPc = index + 1 < count_ ? at(index + 1).address : UINT32_MAX;
+            if (startPc >= endPc)
+            {
+                continue;
+            }
+
+            // byLine_同一行号内按地址排序，相邻范围直接合并
+            if (!ranges.empty() && ranges.back().endPc == startPc)
+            {
+                ranges.back().endPc = endPc;
+            }
+            else
+            {
+                ranges.push_back({startPc, endPc});
+            }
+        }
+        return ranges;
+    }
+
+    size_t LineTable::memoryUsage() const
+    {
+        return sizeof(LineTable) +
+               anchors_.capacity() * sizeof(Anchor) +
+               deltas_.capacity() * sizeof(uint8_t) +
+               byLine_.capacity() * sizeof(uint32_t);
+    }
+}
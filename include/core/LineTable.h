@@ -0,0 +1,110 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef LINETABLE_H
+#define LINETABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dex
+{
+    // 位置信息结构体
+    struct PositionInfo {
+        uint32_t address;             // 指令地址
+        uint32_t lineNum;             // 源代码行号
+    };
+
+    // 指令地址范围 [startPc, endPc)
+    struct PcRange {
+        uint32_t startPc;             // 起始地址(16位字)
+        uint32_t endPc;               // 结束地址(不含)
+    };
+
+    /**
+     * 行号表
+     * 位置按地址升序存放并分块增量压缩：每kBlockSize个位置保存一个绝对值锚点，
+     * 块内其余位置编码为(地址增量ULEB128, 行号增量SLEB128)。
+     * pc查询先二分锚点，再在块内顺序解码；行号查询使用按(行号, 地址)排序的位置序号。
+     * 构建完成后只读，可在多个方法和线程间共享。
+     */
+    class LineTable
+    {
+    public:
+        // 每个锚点覆盖的位置数量
+        static constexpr uint32_t kBlockSize = 16;
+
+        LineTable() = default;
+
+        /**
+         * 从调试信息状态机产生的位置列表构建行号表
+         * @param positions 位置列表
+         */
+        explicit LineTable(std::vector<PositionInfo> positions);
+
+        /**
+         * 获取位置数量
+         */
+        size_t size() const;
+
+        /**
+         * 是否为空
+         */
+        bool empty() const;
+
+        /**
+         * 获取第index个位置（按地址排序）
+         * @param index 位置序号
+         * @return 位置信息
+         */
+        PositionInfo at(uint32_t index) const;
+
+        /**
+         * 解码全部位置
+         * @return 按地址排序的位置列表
+         */
+        std::vector<PositionInfo> decode() const;
+
+        /**
+         * 查找pc所在的源代码行（地址不大于pc的最后一个位置）
+         * @param pc 指令地址(16位字)
+         * @param line 输出行号
+         * @return 是否找到
+         */
+        bool lineForPc(uint32_t pc, uint32_t& line) const;
+
+        /**
+         * 查找某源代码行对应的全部pc范围
+         * 最后一个位置的范围延伸到UINT32_MAX，由调用方按代码长度截断
+         * @param line 源代码行号
+         * @return 按起始地址排序、相邻范围已合并的pc范围列表
+         */
+        std::vector<PcRange> pcRangesForLine(uint32_t line) const;
+
+        /**
+         * 获取占用的内存大小（字节）
+         */
+        size_t memoryUsage() const;
+
+    private:
+        // 块锚点
+        struct Anchor {
+            uint32_t address;         // 块内第一个位置的地址
+            uint32_t lineNum;         // 块内第一个位置的行号
+            uint32_t byteOffset;      // 块内后续增量在deltas_中的起始位置
+        };
+
+        // 二分查找行号等于line的第一个/最后一个之后的位置序号（byLine_中的下标）
+        size_t lowerBoundLine(uint32_t line) const;
+        size_t upperBoundLine(uint32_t line) const;
+
+        std::vector<Anchor> anchors_;     // 块锚点
+        std::vector<uint8_t> deltas_;     // 块内增量编码
+        std::vector<uint32_t> byLine_;    // 按(行号, 地址)排序的位置序号
+        uint32_t count_ = 0;              // 位置数量
+    };
+}
+
+#endif // LINETABLE_H
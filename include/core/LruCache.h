@@ -0,0 +1,106 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace dex
+{
+    /**
+     * SharedLruCache - 按文件偏移量缓存只读的解码结果，记录每个条目的字节数
+     * 值以共享指针返回，条目被淘汰后调用方持有的数据仍然有效。
+     * 不是线程安全的。
+     */
+    template <typename T>
+    class SharedLruCache
+    {
+    public:
+        // 查找条目并标记为最近使用，不存在时返回nullptr
+        std::shared_ptr<const T> find(uint32_t key)
+        {
+            const auto it = index_.find(key);
+            if (it == index_.end())
+            {
+                return nullptr;
+            }
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return it->second->value;
+        }
+
+        // 插入或替换条目，bytes为计入统计的字节数
+        void insert(uint32_t key, std::shared_ptr<const T> value, uint64_t bytes)
+        {
+            erase(key);
+            lru_.push_front({key, std::move(value), bytes});
+            index_.emplace(key, lru_.begin());
+            bytes_ += bytes;
+        }
+
+        // 淘汰最久未使用的条目，缓存为空时返回false
+        bool evictOldest(uint64_t& freed)
+        {
+            if (lru_.empty())
+            {
+                return false;
+            }
+            freed = lru_.back().bytes;
+            bytes_ -= freed;
+            index_.erase(lru_.back().key);
+            lru_.pop_back();
+            return true;
+        }
+
+        // 条目数量
+        size_t size() const
+        {
+            return lru_.size();
+        }
+
+        // 全部条目的字节数
+        uint64_t bytes() const
+        {
+            return bytes_;
+        }
+
+        void clear()
+        {
+            lru_.clear();
+            index_.clear();
+            bytes_ = 0;
+        }
+
+        // 每个条目在值之外的开销：共享指针控制块、链表节点和哈希表节点
+        static constexpr uint64_t kEntryOverhead = 10 * sizeof(void*);
+
+    private:
+        struct Entry
+        {
+            uint32_t key;
+            std::shared_ptr<const T> value;
+            uint64_t bytes;
+        };
+
+        void erase(uint32_t key)
+        {
+            const auto it = index_.find(key);
+            if (it != index_.end())
+            {
+                bytes_ -= it->second->bytes;
+                lru_.erase(it->second);
+                index_.erase(it);
+            }
+        }
+
+        std::list<Entry> lru_;
+        std::unordered_map<uint32_t, typename std::list<Entry>::iterator> index_;
+        uint64_t bytes_ = 0;
+    };
+}
+
+#endif //LRUCACHE_H
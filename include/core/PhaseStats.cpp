@@ -0,0 +1,126 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "PhaseStats.h"
+
+#include <chrono>
+#include <iterator>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <ctime>
+#endif
+
+namespace dex
+{
+    namespace
+    {
+        constexpr const char* kPhaseNames[] = {
+            "map", "header", "map_list", "string_ids", "type_ids", "proto_ids", "field_ids",
+            "method_ids", "class_defs", "string_decode", "class_data", "code_decode", "format", "total",
+        };
+        static_assert(std::size(kPhaseNames) == static_cast<size_t>(Phase::Count));
+
+#ifdef _WIN32
+        // 内核时间与用户时间之和，FILETIME单位为100纳秒
+        uint64_t cpuTimeOf(const FILETIME& kernel, const FILETIME& user)
+        {
+            const auto toNanos = [](const FILETIME& time)
+            {
+                return ((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) * 100;
+            };
+            return toNanos(kernel) + toNanos(user);
+        }
+#else
+        uint64_t clockNanos(clockid_t clock)
+        {
+            timespec time{};
+            clock_gettime(clock, &time);
+            return static_cast<uint64_t>(time.tv_sec) * 1000000000ULL + static_cast<uint64_t>(time.tv_nsec);
+        }
+#endif
+    }
+
+    std::atomic<bool> PhaseStats::enabled_{false};
+    PhaseStats::Counters PhaseStats::counters_[static_cast<size_t>(Phase::Count)];
+
+    void PhaseStats::setEnabled(bool enabled)
+    {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    void PhaseStats::add(Phase phase, uint64_t wallNs, uint64_t cpuNs, uint64_t bytes, uint64_t items)
+    {
+        Counters& counters = counters_[static_cast<size_t>(phase)];
+        counters.calls.fetch_add(1, std::memory_order_relaxed);
+        counters.wallNs.fetch_add(wallNs, std::memory_order_relaxed);
+        counters.cpuNs.fetch_add(cpuNs, std::memory_order_relaxed);
+        counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        counters.items.fetch_add(items, std::memory_order_relaxed);
+    }
+
+    PhaseTotals PhaseStats::get(Phase phase)
+    {
+        const Counters& counters = counters_[static_cast<size_t>(phase)];
+        PhaseTotals totals;
+        totals.calls = counters.calls.load(std::memory_order_relaxed);
+        totals.wallNs = counters.wallNs.load(std::memory_order_relaxed);
+        totals.cpuNs = counters.cpuNs.load(std::memory_order_relaxed);
+        totals.bytes = counters.bytes.load(std::memory_order_relaxed);
+        totals.items = counters.items.load(std::memory_order_relaxed);
+        return totals;
+    }
+
+    const char* PhaseStats::name(Phase phase)
+    {
+        return phase < Phase::Count ? kPhaseNames[static_cast<size_t>(phase)] : "unknown";
+    }
+
+    void PhaseStats::reset()
+    {
+        for (Counters& counters : counters_)
+        {
+            counters.calls = 0;
+            counters.wallNs = 0;
+            counters.cpuNs = 0;
+            counters.bytes = 0;
+            counters.items = 0;
+        }
+    }
+
+    uint64_t PhaseStats::wallNanos()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    uint64_t PhaseStats::threadCpuNanos()
+    {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+        {
+            return 0;
+        }
+        return cpuTimeOf(kernel, user);
+#else
+        return clockNanos(CLOCK_THREAD_CPUTIME_ID);
+#endif
+    }
+
+    uint64_t PhaseStats::processCpuNanos()
+    {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        {
+            return 0;
+        }
+        return cpuTimeOf(kernel, user);
+#else
+        return clockNanos(CLOCK_PROCESS_CPUTIME_ID);
+#endif
+    }
+}
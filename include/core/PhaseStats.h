@@ -0,0 +1,153 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef PHASESTATS_H
+#define PHASESTATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace dex
+{
+    // 计时的处理阶段
+    enum class Phase : uint8_t
+    {
+        Map,            // 映射文件（APK条目包括解压）
+        Header,         // 头部解析与校验和、签名校验
+        MapList,        // map_list
+        StringIds,      // 字符串ID表（包括预加载字符串）
+        TypeIds,        // 类型ID表
+        ProtoIds,       // 方法原型ID表
+        FieldIds,       // 字段ID表
+        MethodIds,      // 方法ID表
+        ClassDefs,      // 类定义表
+        StringDecode,   // MUTF-8字符串解码
+        ClassData,      // 类数据解码
+        CodeDecode,     // 方法指令解码
+        Format,         // 格式化输出
+        Total,          // 整个运行过程
+        Count
+    };
+
+    // 一个阶段的累计数据
+    struct PhaseTotals
+    {
+        uint64_t calls = 0;     // 计时次数
+        uint64_t wallNs = 0;    // 墙钟时间（纳秒）
+        uint64_t cpuNs = 0;     // CPU时间（纳秒）
+        uint64_t bytes = 0;     // 处理的字节数
+        uint64_t items = 0;     // 处理的条目数
+    };
+
+    /**
+     * PhaseStats - 按阶段累计耗时和处理量
+     * 默认关闭，关闭时计时点只有一次原子读取。数据在进程内全局累计，批量处理的多个文件和线程汇总到一起。
+     * 嵌套的阶段（例如格式化期间按需解码的字符串）同时计入外层阶段。
+     */
+    class PhaseStats
+    {
+    public:
+        // 开启或关闭计时
+        static void setEnabled(bool enabled);
+
+        // 是否正在计时
+        static bool isEnabled()
+        {
+            return enabled_.load(std::memory_order_relaxed);
+        }
+
+        // 累加一次计时结果
+        static void add(Phase phase, uint64_t wallNs, uint64_t cpuNs, uint64_t bytes, uint64_t items);
+
+        // 获取阶段的累计数据
+        static PhaseTotals get(Phase phase);
+
+        // 阶段名称，例如string_decode
+        static const char* name(Phase phase);
+
+        // 清空累计数据
+        static void reset();
+
+        // 单调时钟（纳秒）
+        static uint64_t wallNanos();
+
+        // 当前线程的CPU时间（纳秒）
+        static uint64_t threadCpuNanos();
+
+        // 进程所有线程的CPU时间（纳秒）
+        static uint64_t processCpuNanos();
+
+    private:
+        struct Counters
+        {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> wallNs{0};
+            std::atomic<uint64_t> cpuNs{0};
+            std::atomic<uint64_t> bytes{0};
+            std::atomic<uint64_t> items{0};
+        };
+
+        static std::atomic<bool> enabled_;
+        static Counters counters_[static_cast<size_t>(Phase::Count)];
+    };
+
+    /**
+     * PhaseTimer - 在作用域内为一个阶段计时，析构时累加到PhaseStats
+     * 未开启计时时不读取时钟
+     */
+    class PhaseTimer
+    {
+    public:
+        /**
+         * 构造函数
+         * @param phase 阶段
+         * @param processCpu 为true时统计进程所有线程的CPU时间，用于内部并行的阶段
+         */
+        explicit PhaseTimer(Phase phase, bool processCpu = false)
+            : phase_(phase), processCpu_(processCpu), active_(PhaseStats::isEnabled())
+        {
+            if (active_)
+            {
+                wallStart_ = PhaseStats::wallNanos();
+                cpuStart_ = processCpu_ ? PhaseStats::processCpuNanos() : PhaseStats::threadCpuNanos();
+            }
+        }
+
+        ~PhaseTimer()
+        {
+            if (active_)
+            {
+                const uint64_t cpuEnd = processCpu_ ? PhaseStats::processCpuNanos() : PhaseStats::threadCpuNanos();
+                PhaseStats::add(phase_, PhaseStats::wallNanos() - wallStart_, cpuEnd - cpuStart_, bytes_, items_);
+            }
+        }
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+        // 记录处理的字节数
+        void addBytes(uint64_t bytes)
+        {
+            bytes_ += bytes;
+        }
+
+        // 记录处理的条目数
+        void addItems(uint64_t items)
+        {
+            items_ += items;
+        }
+
+    private:
+        Phase phase_;
+        bool processCpu_;
+        bool active_;
+        uint64_t wallStart_ = 0;
+        uint64_t cpuStart_ = 0;
+        uint64_t bytes_ = 0;
+        uint64_t items_ = 0;
+    };
+}
+
+#endif //PHASESTATS_H
@@ -0,0 +1,388 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "Sha1.h"
+
+#include <algorithm>
+#include <cstring>
+#include "CpuFeatures.h"
+
+#if defined(DEX_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+namespace dex
+{
+    static inline uint32_t rotl32(uint32_t value, int shift)
+    {
+        return (value << shift) | (value >> (32 - shift));
+    }
+
+    static inline uint32_t loadBigEndian32(const uint8_t* data)
+    {
+        return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+               (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+    }
+
+    // 标准实现：处理若干个64字节数据块
+    static void sha1BlocksScalar(uint32_t state[5], const uint8_t* data, size_t blocks)
+    {
+        uint32_t w[80];
+        while (blocks-- > 0)
+        {
+            for (int i = 0; i < 16; i++)
+            {
+                w[i] = loadBigEndian32(data + i * 4);
+            }
+            for (int i = 16; i < 80; i++)
+            {
+                w[i] = rotl32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+            }
+
+            uint32_t a = state[0];
+            uint32_t b = state[1];
+            uint32_t c = state[2];
+            uint32_t d = state[3];
+            uint32_t e = state[4];
+
+            for (int i = 0; i < 80; i++)
+            {
+                uint32_t f;
+                uint32_t k;
+                if (i < 20)
+                {
+                    f = (b & c) | (~b & d);
+                    k = 0x5A827999;
+                }
+                else if (i < 40)
+                {
+                    f = b ^ c ^ d;
+                    k = 0x6ED9EBA1;
+                }
+                else if (i < 60)
+                {
+                    f = (b & c) | (b & d) | (c & d);
+                    k = 0x8F1BBCDC;
+                }
+                else
+                {
+                    f = b ^ c ^ d;
+                    k = 0xCA62C1D6;
+                }
+
+                const uint32_t temp = rotl32(a, 5) + f + e + k + w[i];
+                e = d;
+                d = c;
+                c = rotl32(b, 30);
+                b = a;
+                a = temp;
+            }
+
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+            state[4] += e;
+            data += 64;
+        }
+    }
+
+#if defined(DEX_ARCH_X86)
+    /**
+     * SHA-NI实现：每条sha1rnds4执行4轮，sha1msg1/sha1msg2/xor滚动计算消息扩展，
+     * sha1nexte由上一组的A计算本组的E。abcd按(A,B,C,D)从高到低存放。
+     */
+    DEX_TARGET("sha,ssse3,sse4.1") static void sha1BlocksShaNi(uint32_t state[5], const uint8_t* data, size_t blocks)
+    {
+        const __m128i kByteSwap = _mm_set_epi64x(0x0001020304050607LL, 0x08090A0B0C0D0E0FLL);
+
+        __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+        __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+        __m128i e1;
+        __m128i msg0, msg1, msg2, msg3;
+
+        while (blocks-- > 0)
+        {
+            const __m128i abcdSave = abcd;
+            const __m128i e0Save = e0;
+
+            // 第0-3轮
+            msg0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0)), kByteSwap);
+            e0 = _mm_add_epi32(e0, msg0);
+            e1 = abcd;
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+            // 第4-7轮
+            msg1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), kByteSwap);
+            e1 = _mm_sha1nexte_epu32(e1, msg1);
+            e0 = abcd;
+            abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+            msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+            // 第8-11轮
+            msg2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), kByteSwap);
+            e0 = _mm_sha1nexte_epu32(e0, msg2);
+            e1 = abcd;
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+            msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+            msg0 = _mm_xor_si128(msg0, msg2);
+
+            // 第12-15轮
+            msg3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), kByteSwap);
+            e1 = _mm_sha1nexte_epu32(e1, msg3);
+            e0 = abcd;
+            msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+            abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+            msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+            msg1 = _mm_xor_si128(msg1, msg3);
+
+            // 第16-19轮
+            e0 = _mm_sha1nexte_epu32(e0, msg0);
+            e1 = abcd;
+            msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+            msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+            msg2 = _mm_xor_si128(msg2, msg0);
+
+            // 第20-23轮
+            e1 = _mm_sha1nexte_epu32(e1, msg1);
+            e0 = abcd;
+            msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+            abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+            msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+            msg3 = _mm_xor_si128(msg3, msg1);
+
+            // 第24-27轮
+            e0 = _mm_sha1nexte_epu32(e0, msg2);
+            e1 = abcd;
+            msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+            msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+            msg0 = _mm_xor_si128(msg0, msg2);
+
+            // 第28-31轮
+            e1 = _mm_sha1nexte_epu32(e1, msg3);
+            e0 = abcd;
+            msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+            abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+            msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+            msg1 = _mm_xor_si128(msg1, msg3);
+
+            // 第32-35轮
+            e0 = _mm_sha1nexte_epu32(e0, msg0);
+            e1 = abcd;
+            msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+            msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+            msg2 = _mm_xor_si128(msg2, msg0);
+
+            // 第36-39轮
+            e1 = _mm_sha1nexte_epu32(e1, msg1);
+            e0 = abcd;
+            msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+            abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+            msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+            msg3 = _mm_xor_si128(msg3, msg1);
+
+            // 第40-43轮
+            e0 = _mm_sha1nexte_epu32(e0, msg2);
+            e1 = abcd;
+            msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+            msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+            msg0 = _mm_xor_si128(msg0, msg2);
+
+            // 第44-47轮
+            e1 = _mm_sha1nexte_epu32(e1, msg3);
+            e0 = abcd;
+            msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+            abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+            msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+            msg1 = _mm_xor_si128(msg1, msg3);
+
+            // 第48-51轮
+            e0 = _mm_sha1nexte_epu32(e0, msg0);
+            e1 = abcd;
+            msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+            msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+            msg2 = _mm_xor_si128(msg2, msg0);
+
+            // 第52-55轮
+            e1 = _mm_sha1nexte_epu32(e1, msg1);
+            e0 = abcd;
+            msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+            abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+            msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+            msg3 = _mm_xor_si128(msg3, msg1);
+
+            // 第56-59轮
+            e0 = _mm_sha1nexte_epu32(e0, msg2);
+            e1 = abcd;
+            msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+            msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+            msg0 = _mm_xor_si128(msg0, msg2);
+
+            // 第60-63轮
+            e1 = _mm_sha1nexte_epu32(e1, msg3);
+            e0 = abcd;
+            msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+            abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+            msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+            msg1 = _mm_xor_si128(msg1, msg3);
+
+            // 第64-67轮
+            e0 = _mm_sha1nexte_epu32(e0, msg0);
+            e1 = abcd;
+            msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+            msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+            msg2 = _mm_xor_si128(msg2, msg0);
+
+            // 第68-71轮
+            e1 = _mm_sha1nexte_epu32(e1, msg1);
+            e0 = abcd;
+            msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+            abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+            msg3 = _mm_xor_si128(msg3, msg1);
+
+            // 第72-75轮
+            e0 = _mm_sha1nexte_epu32(e0, msg2);
+            e1 = abcd;
+            msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+            // 第76-79轮
+            e1 = _mm_sha1nexte_epu32(e1, msg3);
+            e0 = abcd;
+            abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+            // 累加到链接变量
+            e0 = _mm_sha1nexte_epu32(e0, e0Save);
+            abcd = _mm_add_epi32(abcd, abcdSave);
+
+            data += 64;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+        state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+    }
+#endif
+
+    static void sha1Blocks(uint32_t state[5], const uint8_t* data, size_t blocks)
+    {
+#if defined(DEX_ARCH_X86)
+        if (cpuHasShaNi())
+        {
+            sha1BlocksShaNi(state, data, blocks);
+            return;
+        }
+#endif
+        sha1BlocksScalar(state, data, blocks);
+    }
+
+    Sha1::Sha1()
+    {
+        reset();
+    }
+
+    void Sha1::reset()
+    {
+        state_[0] = 0x67452301;
+        state_[1] = 0xEFCDAB89;
+        state_[2] = 0x98BADCFE;
+        state_[3] = 0x10325476;
+        state_[4] = 0xC3D2E1F0;
+        bufferSize_ = 0;
+        totalSize_ = 0;
+    }
+
+    void Sha1::update(const uint8_t* data, size_t size)
+    {
+        totalSize_ += size;
+
+        // 先补齐缓冲区中的残余数据
+        if (bufferSize_ > 0)
+        {
+            const size_t fill = std::min(size, kBlockSize - bufferSize_);
+            memcpy(buffer_ + bufferSize_, data, fill);
+            bufferSize_ += fill;
+            data += fill;
+            size -= fill;
+
+            if (bufferSize_ < kBlockSize)
+            {
+                return;
+            }
+            sha1Blocks(state_, buffer_, 1);
+            bufferSize_ = 0;
+        }
+
+        // 整块数据直接处理，不经过缓冲区
+        const size_t blocks = size / kBlockSize;
+        if (blocks > 0)
+        {
+            sha1Blocks(state_, data, blocks);
+            data += blocks * kBlockSize;
+            size -= blocks * kBlockSize;
+        }
+
+        if (size > 0)
+        {
+            memcpy(buffer_, data, size);
+            bufferSize_ = size;
+        }
+    }
+
+    Sha1Digest Sha1::finish()
+    {
+        const uint64_t bitLength = totalSize_ * 8;
+
+        // 填充：0x80，补零到56字节(模64)，再追加64位大端长度
+        uint8_t padding[kBlockSize * 2] = {0x80};
+        const size_t padSize = (bufferSize_ < 56 ? 56 : 120) - bufferSize_;
+        uint8_t length[8];
+        for (int i = 0; i < 8; i++)
+        {
+            length[i] = static_cast<uint8_t>(bitLength >> (56 - i * 8));
+        }
+        update(padding, padSize);
+        update(length, sizeof(length));
+
+        Sha1Digest digest;
+        for (int i = 0; i < 5; i++)
+        {
+            digest[i * 4] = static_cast<uint8_t>(state_[i] >> 24);
+            digest[i * 4 + 1] = static_cast<uint8_t>(state_[i] >> 16);
+            digest[i * 4 + 2] = static_cast<uint8_t>(state_[i] >> 8);
+            digest[i * 4 + 3] = static_cast<uint8_t>(state_[i]);
+        }
+        return digest;
+    }
+
+    Sha1Digest Sha1::hash(const uint8_t* data, size_t size)
+    {
+        Sha1 sha1;
+        sha1.update(data, size);
+        return sha1.finish();
+    }
+
+    std::string Sha1::toHex(const Sha1Digest& digest)
+    {
+        static constexpr char kHexDigits[] = "0123456789abcdef";
+        std::string hex(digest.size() * 2, '0');
+        for (size_t i = 0; i < digest.size(); i++)
+        {
+            hex[i * 2] = kHexDigits[digest[i] >> 4];
+            hex[i * 2 + 1] = kHexDigits[digest[i] & 0x0F];
+        }
+        return hex;
+    }
+
+    bool Sha1::isAccelerated()
+    {
+        return cpuHasShaNi();
+    }
+}
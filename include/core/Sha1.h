@@ -0,0 +1,76 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef SHA1_H
+#define SHA1_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dex
+{
+    // SHA-1摘要
+    using Sha1Digest = std::array<uint8_t, 20>;
+
+    /**
+     * 流式SHA-1计算
+     * 支持SHA-NI时使用硬件指令处理数据块，否则使用标准实现
+     */
+    class Sha1
+    {
+    public:
+        Sha1();
+
+        /**
+         * 重置为初始状态
+         */
+        void reset();
+
+        /**
+         * 追加数据
+         * @param data 数据
+         * @param size 数据长度
+         */
+        void update(const uint8_t* data, size_t size);
+
+        /**
+         * 结束计算并输出摘要，之后需要reset才能复用
+         * @return 摘要
+         */
+        Sha1Digest finish();
+
+        /**
+         * 一次性计算数据的SHA-1摘要
+         * @param data 数据
+         * @param size 数据长度
+         * @return 摘要
+         */
+        static Sha1Digest hash(const uint8_t* data, size_t size);
+
+        /**
+         * 摘要转换为小写十六进制字符串
+         * @param digest 摘要
+         * @return 十六进制字符串
+         */
+        static std::string toHex(const Sha1Digest& digest);
+
+        /**
+         * 当前CPU上是否使用SHA-NI实现
+         * @return 是否使用硬件加速
+         */
+        static bool isAccelerated();
+
+    private:
+        static constexpr size_t kBlockSize = 64;
+
+        uint32_t state_[5];             // 链接变量
+        uint8_t buffer_[kBlockSize];    // 未满一块的数据
+        size_t bufferSize_;             // buffer_中的字节数
+        uint64_t totalSize_;            // 已输入的总字节数
+    };
+}
+
+#endif // SHA1_H
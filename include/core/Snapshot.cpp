@@ -0,0 +1,433 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "Snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "Adler32.h"
+#include "log/log.h"
+#include "util.h"
+
+namespace dex
+{
+    namespace
+    {
+        constexpr char kMagic[8] = {'D', 'E', 'X', 'S', 'N', 'A', 'P', '\0'};
+
+        // 写入时的字节序标记，按本机字节序读出不一致时说明快照来自不同字节序的机器
+        constexpr uint32_t kEndianTag = 0x12345678;
+
+        // 段起始偏移量的对齐字节数
+        constexpr size_t kSectionAlignment = 8;
+
+        // 快照直接按本机内存布局读写，布局变化时必须递增kFormatVersion
+        static_assert(std::is_trivially_copyable_v<MapSection> && sizeof(MapSection) == 16);
+        static_assert(std::is_trivially_copyable_v<FieldAccessSite> && sizeof(FieldAccessSite) == 12);
+        static_assert(std::is_trivially_copyable_v<TypeUsageSite> && sizeof(TypeUsageSite) == 12);
+        static_assert(sizeof(SnapshotStringRef) == 8 && sizeof(SnapshotClassData) == 24 && sizeof(SnapshotMember) == 12);
+    }
+
+    Snapshot::Snapshot(uint8_t* data, size_t size)
+        : data_(data), size_(size), header_(reinterpret_cast<const FileHeader*>(data))
+    {
+    }
+
+    Snapshot::~Snapshot()
+    {
+        if (data_ != nullptr)
+        {
+            util::unmapFile(data_);
+        }
+    }
+
+    std::string Snapshot::pathFor(const std::string& dir, const DexHeader& header)
+    {
+        Sha1Digest signature;
+        memcpy(signature.data(), header.signature, signature.size());
+        return (std::filesystem::path(dir) / (Sha1::toHex(signature) + kFileExtension)).string();
+    }
+
+    bool Snapshot::write(const DexContext& context, const std::string& path)
+    {
+        if (!context.isValid())
+        {
+            LOGE("上下文无效，无法写入快照");
+            return false;
+        }
+
+        // 反向索引在写入时构建一次，之后的打开直接使用
+        if (!context.buildFieldXrefs() || !context.buildTypeUsages())
+        {
+            LOGE("构建反向索引失败，无法写入快照");
+            return false;
+        }
+
+        FileHeader header = {};
+        memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kFormatVersion;
+        header.headerSize = sizeof(FileHeader);
+        header.endianTag = kEndianTag;
+        header.sectionCount = SECTION_COUNT;
+        header.dexHeader = context.getHeader();
+
+        std::vector<uint8_t> buffer(sizeof(FileHeader), 0);
+        bool overflow = false;
+        auto appendSection = [&](SectionId id, const void* data, size_t size)
+        {
+            buffer.resize((buffer.size() + kSectionAlignment - 1) & ~(kSectionAlignment - 1), 0);
+            if (buffer.size() + size > std::numeric_limits<uint32_t>::max())
+            {
+                overflow = true;
+                return;
+            }
+            header.sections[id] = {static_cast<uint32_t>(buffer.size()), static_cast<uint32_t>(size)};
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            buffer.insert(buffer.end(), bytes, bytes + size);
+        };
+        auto appendVector = [&](SectionId id, const auto& items)
+        {
+            appendSection(id, items.data(), items.size() * sizeof(items[0]));
+        };
+
+        // 字符串区：先放全部字符串，再放原型字符串
+        std::string arena;
+        auto addString = [&](const std::string& text)
+        {
+            const SnapshotStringRef ref = {static_cast<uint32_t>(arena.size()), static_cast<uint32_t>(text.size())};
+            arena += text;
+            return ref;
+        };
+
+        std::vector<SnapshotStringRef> strings(context.getStringIdsCount());
+        for (uint32_t i = 0; i < strings.size(); i++)
+        {
+            strings[i] = addString(context.getString(i));
+        }
+
+        std::vector<SnapshotStringRef> protos(context.getProtoIdsCount());
+        for (uint32_t i = 0; i < protos.size(); i++)
+        {
+            protos[i] = addString(context.getProtoString(i));
+        }
+
+        if (arena.size() > std::numeric_limits<uint32_t>::max())
+        {
+            LOGE("字符串区过大，无法写入快照");
+            return false;
+        }
+
+        // class_data：成员按类定义顺序连续存放
+        std::vector<SnapshotClassData> classes(context.getClassDefsCount());
+        std::vector<SnapshotMember> members;
+        for (uint32_t i = 0; i < classes.size(); i++)
+        {
+            const ClassDefInfo info = context.getClassDefInfo(i);
+            const auto& classData = info.classData;
+
+            SnapshotClassData& record = classes[i];
+            record.firstMember = static_cast<uint32_t>(members.size());
+            record.isValid = classData.isLoaded || info.classDataOff == 0;
+            if (!classData.isLoaded)
+            {
+                continue;
+            }
+
+            record.staticFieldsSize = static_cast<uint32_t>(classData.staticFields.size());
+            record.instanceFieldsSize = static_cast<uint32_t>(classData.instanceFields.size());
+            record.directMethodsSize = static_cast<uint32_t>(classData.directMethods.size());
+            record.virtualMethodsSize = static_cast<uint32_t>(classData.virtualMethods.size());
+            for (const auto& field : classData.staticFields)
+            {
+                members.push_back({field.fieldIdx, field.accessFlags, 0});
+            }
+            for (const auto& field : classData.instanceFields)
+            {
+                members.push_back({field.fieldIdx, field.accessFlags, 0});
+            }
+            for (const auto& method : classData.directMethods)
+            {
+                members.push_back({method.methodIdx, method.accessFlags, method.codeOff});
+            }
+            for (const auto& method : classData.virtualMethods)
+            {
+                members.push_back({method.methodIdx, method.accessFlags, method.codeOff});
+            }
+        }
+
+        std::vector<uint32_t> methodCodeOffs(context.getMethodIdsCount());
+        for (uint32_t i = 0; i < methodCodeOffs.size(); i++)
+        {
+            methodCodeOffs[i] = context.getMethodCodeOff(i);
+        }
+
+        // 反向索引按CSR布局重新展开
+        const uint32_t fieldCount = context.getFieldIdsCount();
+        std::vector<uint32_t> fieldOffsets(fieldCount + 1, 0);
+        std::vector<FieldAccessSite> fieldSites;
+        std::vector<uint32_t> fieldReaders(fieldCount);
+        std::vector<uint32_t> fieldWriters(fieldCount);
+        for (uint32_t i = 0; i < fieldCount; i++)
+        {
+            const std::span<const FieldAccessSite> sites = context.getFieldAccessors(i);
+            fieldSites.insert(fieldSites.end(), sites.begin(), sites.end());
+            fieldOffsets[i + 1] = static_cast<uint32_t>(fieldSites.size());
+            fieldReaders[i] = context.getFieldReaderCount(i);
+            fieldWriters[i] = context.getFieldWriterCount(i);
+        }
+
+        const uint32_t typeCount = context.getTypeIdsCount();
+        std::vector<uint32_t> typeOffsets(typeCount + 1, 0);
+        std::vector<TypeUsageSite> typeSites;
+        for (uint32_t i = 0; i < typeCount; i++)
+        {
+            const std::span<const TypeUsageSite> sites = context.getTypeUsages(i);
+            typeSites.insert(typeSites.end(), sites.begin(), sites.end());
+            typeOffsets[i + 1] = static_cast<uint32_t>(typeSites.size());
+        }
+
+        appendVector(SECTION_STRINGS, strings);
+        appendVector(SECTION_PROTOS, protos);
+        appendSection(SECTION_ARENA, arena.data(), arena.size());
+        appendVector(SECTION_MAP, context.getMapSections());
+        appendVector(SECTION_CLASSES, classes);
+        appendVector(SECTION_MEMBERS, members);
+        appendVector(SECTION_METHOD_CODE, methodCodeOffs);
+        appendVector(SECTION_FIELD_OFFSETS, fieldOffsets);
+        appendVector(SECTION_FIELD_SITES, fieldSites);
+        appendVector(SECTION_FIELD_READERS, fieldReaders);
+        appendVector(SECTION_FIELD_WRITERS, fieldWriters);
+        appendVector(SECTION_TYPE_OFFSETS, typeOffsets);
+        appendVector(SECTION_TYPE_SITES, typeSites);
+        if (overflow)
+        {
+            LOGE("快照超过4GB，无法写入");
+            return false;
+        }
+        header.bodyChecksum =
+            adler32Parallel(buffer.data() + sizeof(FileHeader), buffer.size() - sizeof(FileHeader), 0);
+        memcpy(buffer.data(), &header, sizeof(header));
+
+        // 先写临时文件再重命名，并发打开的进程只会看到完整的快照
+        std::error_code ec;
+        const std::filesystem::path target(path);
+        if (target.has_parent_path())
+        {
+            std::filesystem::create_directories(target.parent_path(), ec);
+        }
+        // 临时文件名带上线程标识，批量处理中签名相同的文件同时写入时互不覆盖
+        const std::string tempPath =
+            path + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        FILE* file = fopen(tempPath.c_str(), "wb");
+        if (file == nullptr)
+        {
+            LOGE("创建快照文件失败: %s", tempPath.c_str());
+            return false;
+        }
+        const bool written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+        if (fclose(file) != 0 || !written)
+        {
+            LOGE("写入快照文件失败: %s", tempPath.c_str());
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        std::filesystem::rename(tempPath, target, ec);
+        if (ec)
+        {
+            LOGE("重命名快照文件失败: %s", path.c_str());
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        LOGI("写入快照: %s (%zu 字节)", path.c_str(), buffer.size());
+        return true;
+    }
+
+    std::unique_ptr<Snapshot> Snapshot::open(const std::string& path, const DexHeader& header, size_t dexFileSize)
+    {
+        // 快照不存在是正常情况，不报错
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(path, ec))
+        {
+            return nullptr;
+        }
+
+        uint8_t* data = nullptr;
+        size_t size = 0;
+        if (util::mapFile(path.c_str(), &data, &size) != 0)
+        {
+            LOGW("映射快照文件失败: %s", path.c_str());
+            return nullptr;
+        }
+        std::unique_ptr<Snapshot> snapshot(new Snapshot(data, size));
+
+        const FileHeader* fileHeader = snapshot->header_;
+        if (size < sizeof(FileHeader) || memcmp(fileHeader->magic, kMagic, sizeof(kMagic)) != 0 ||
+            fileHeader->version != kFormatVersion || fileHeader->headerSize != sizeof(FileHeader) ||
+            fileHeader->endianTag != kEndianTag || fileHeader->sectionCount != SECTION_COUNT)
+        {
+            LOGW("快照格式不匹配: %s", path.c_str());
+            return nullptr;
+        }
+
+        // 签名相同但头部或大小不同说明文件被改动过
+        if (memcmp(&fileHeader->dexHeader, &header, sizeof(DexHeader)) != 0 || header.fileSize != dexFileSize)
+        {
+            LOGW("快照与DEX文件不匹配: %s", path.c_str());
+            return nullptr;
+        }
+
+        // 快照内容被截断或改动时放弃快照，由调用者重新解析
+        if (adler32Parallel(data + sizeof(FileHeader), size - sizeof(FileHeader), 0) != fileHeader->bodyChecksum)
+        {
+            LOGW("快照校验和不匹配: %s", path.c_str());
+            return nullptr;
+        }
+
+        for (const SectionEntry& entry : fileHeader->sections)
+        {
+            if (entry.offset < sizeof(FileHeader) || entry.offset % kSectionAlignment != 0 ||
+                static_cast<uint64_t>(entry.offset) + entry.size > size)
+            {
+                LOGW("快照段越界: %s", path.c_str());
+                return nullptr;
+            }
+        }
+
+        Snapshot& s = *snapshot;
+        s.strings_ = s.section<SnapshotStringRef>(SECTION_STRINGS);
+        s.protos_ = s.section<SnapshotStringRef>(SECTION_PROTOS);
+        s.arena_ = s.section<char>(SECTION_ARENA);
+        s.mapSections_ = s.section<MapSection>(SECTION_MAP);
+        s.classes_ = s.section<SnapshotClassData>(SECTION_CLASSES);
+        s.members_ = s.section<SnapshotMember>(SECTION_MEMBERS);
+        s.methodCodeOffs_ = s.section<uint32_t>(SECTION_METHOD_CODE);
+        s.fieldOffsets_ = s.section<uint32_t>(SECTION_FIELD_OFFSETS);
+        s.fieldSites_ = s.section<FieldAccessSite>(SECTION_FIELD_SITES);
+        s.fieldReaders_ = s.section<uint32_t>(SECTION_FIELD_READERS);
+        s.fieldWriters_ = s.section<uint32_t>(SECTION_FIELD_WRITERS);
+        s.typeOffsets_ = s.section<uint32_t>(SECTION_TYPE_OFFSETS);
+        s.typeSites_ = s.section<TypeUsageSite>(SECTION_TYPE_SITES);
+
+        // 内容已由校验和保护，这里只检查表的大小，表项在访问时逐个检查
+        if (s.strings_.size() != header.stringIdsSize || s.protos_.size() != header.protoIdsSize ||
+            s.classes_.size() != header.classDefsSize || s.methodCodeOffs_.size() != header.methodIdsSize ||
+            s.fieldOffsets_.size() != static_cast<size_t>(header.fieldIdsSize) + 1 ||
+            s.fieldReaders_.size() != header.fieldIdsSize || s.fieldWriters_.size() != header.fieldIdsSize ||
+            s.typeOffsets_.size() != static_cast<size_t>(header.typeIdsSize) + 1)
+        {
+            LOGW("快照表大小与DEX头部不一致: %s", path.c_str());
+            return nullptr;
+        }
+
+        return snapshot;
+    }
+
+    const DexHeader& Snapshot::getHeader() const
+    {
+        return header_->dexHeader;
+    }
+
+    size_t Snapshot::getSize() const
+    {
+        return size_;
+    }
+
+    std::string_view Snapshot::arenaString(const SnapshotStringRef& ref) const
+    {
+        if (ref.offset > arena_.size() || ref.length > arena_.size() - ref.offset)
+        {
+            return {};
+        }
+        return {arena_.data() + ref.offset, ref.length};
+    }
+
+    std::string_view Snapshot::getString(uint32_t idx) const
+    {
+        return idx < strings_.size() ? arenaString(strings_[idx]) : std::string_view();
+    }
+
+    std::string_view Snapshot::getProtoString(uint32_t protoIdx) const
+    {
+        return protoIdx < protos_.size() ? arenaString(protos_[protoIdx]) : std::string_view();
+    }
+
+    std::span<const MapSection> Snapshot::getMapSections() const
+    {
+        return mapSections_;
+    }
+
+    const SnapshotClassData* Snapshot::getClassData(uint32_t classDefIdx) const
+    {
+        return classDefIdx < classes_.size() ? &classes_[classDefIdx] : nullptr;
+    }
+
+    std::span<const SnapshotMember> Snapshot::getMembers(const SnapshotClassData& classData) const
+    {
+        const uint64_t count = static_cast<uint64_t>(classData.staticFieldsSize) + classData.instanceFieldsSize +
+                               classData.directMethodsSize + classData.virtualMethodsSize;
+        if (classData.firstMember > members_.size() || count > members_.size() - classData.firstMember)
+        {
+            return {};
+        }
+        return members_.subspan(classData.firstMember, count);
+    }
+
+    uint32_t Snapshot::getMethodCodeOff(uint32_t methodIdx) const
+    {
+        return methodIdx < methodCodeOffs_.size() ? methodCodeOffs_[methodIdx] : 0;
+    }
+
+    bool Snapshot::csrRange(std::span<const uint32_t> offsets, uint32_t idx, size_t siteCount,
+                            uint32_t& begin, uint32_t& end)
+    {
+        if (static_cast<size_t>(idx) + 1 >= offsets.size())
+        {
+            return false;
+        }
+        begin = offsets[idx];
+        end = offsets[idx + 1];
+        return begin <= end && end <= siteCount;
+    }
+
+    std::span<const FieldAccessSite> Snapshot::getFieldAccessors(uint32_t fieldIdx) const
+    {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        if (!csrRange(fieldOffsets_, fieldIdx, fieldSites_.size(), begin, end))
+        {
+            return {};
+        }
+        return fieldSites_.subspan(begin, end - begin);
+    }
+
+    uint32_t Snapshot::getFieldReaderCount(uint32_t fieldIdx) const
+    {
+        return fieldIdx < fieldReaders_.size() ? fieldReaders_[fieldIdx] : 0;
+    }
+
+    uint32_t Snapshot::getFieldWriterCount(uint32_t fieldIdx) const
+    {
+        return fieldIdx < fieldWriters_.size() ? fieldWriters_[fieldIdx] : 0;
+    }
+
+    std::span<const TypeUsageSite> Snapshot::getTypeUsages(uint32_t typeIdx) const
+    {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        if (!csrRange(typeOffsets_, typeIdx, typeSites_.size(), begin, end))
+        {
+            return {};
+        }
+        return typeSites_.subspan(begin, end - begin);
+    }
+}
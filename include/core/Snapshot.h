@@ -0,0 +1,210 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include "DexContext.h"
+#include "DexFile.h"
+
+namespace dex
+{
+    // 快照字符串区中的字符串引用
+    struct SnapshotStringRef {
+        uint32_t offset;              // 在字符串区中的偏移量
+        uint32_t length;              // 字节长度
+    };
+
+    // 快照中一个类的class_data记录
+    struct SnapshotClassData {
+        uint32_t staticFieldsSize;    // 静态字段数量
+        uint32_t instanceFieldsSize;  // 实例字段数量
+        uint32_t directMethodsSize;   // 直接方法数量
+        uint32_t virtualMethodsSize;  // 虚拟方法数量
+        uint32_t firstMember;         // 第一个成员在成员表中的下标，依次为静态字段、实例字段、直接方法、虚拟方法
+        uint32_t isValid;             // class_data是否解码成功
+    };
+
+    // 快照中的类成员（encoded_field/encoded_method，索引已还原为绝对值）
+    struct SnapshotMember {
+        uint32_t idx;                 // 字段或方法索引
+        uint32_t accessFlags;         // 访问标志
+        uint32_t codeOff;             // 代码偏移量，字段为0
+    };
+
+    /**
+     * Snapshot - 解析快照
+     * 把一次完整解析的结果（解码后的字符串区、原型字符串、map_list段表、class_data、
+     * 方法代码偏移量索引、字段交叉引用和类型使用索引）按本机字节序平铺写入文件。
+     * 再次打开同一个DEX文件时直接映射快照文件，所有查询都是对映射内存的直接访问，不做反序列化。
+     *
+     * 快照以DEX头部的SHA-1签名命名，打开时要求格式版本、文件大小和整个DEX头部（包括校验和与签名）
+     * 与写入时一致。写入前已确认签名与文件内容一致；快照本身不读取DEX内容，由DexDump在使用快照前
+     * 按校验选项重新计算校验和与签名，头部完好而内容被改动的文件不会使用快照。
+     * 快照自身的数据由文件头部中的Adler-32校验和保护，打开时校验失败则放弃快照，重新解析DEX文件。
+     */
+    class Snapshot
+    {
+    public:
+        // 快照格式版本，布局变化时递增
+        static constexpr uint32_t kFormatVersion = 2;
+
+        // 快照文件扩展名
+        static constexpr const char* kFileExtension = ".dexsnap";
+
+        ~Snapshot();
+
+        // 禁止拷贝和赋值
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        /**
+         * 获取DEX文件对应的快照路径
+         * @param dir 快照目录
+         * @param header DEX头部
+         * @return <dir>/<签名十六进制>.dexsnap
+         */
+        static std::string pathFor(const std::string& dir, const DexHeader& header);
+
+        /**
+         * 把上下文中的解析结果写入快照文件
+         * 会先构建字段交叉引用和类型使用索引；先写临时文件再重命名，不会留下不完整的快照
+         * @param context 已完整解析的上下文
+         * @param path 快照路径
+         * @return 写入成功返回true
+         */
+        static bool write(const DexContext& context, const std::string& path);
+
+        /**
+         * 映射并校验快照文件
+         * @param path 快照路径
+         * @param header 当前DEX文件的头部
+         * @param dexFileSize 当前DEX文件大小
+         * @return 快照不存在、已损坏或与文件不匹配时返回nullptr
+         */
+        static std::unique_ptr<Snapshot> open(const std::string& path, const DexHeader& header, size_t dexFileSize);
+
+        // 获取写入快照时的DEX头部
+        const DexHeader& getHeader() const;
+
+        // 获取快照文件大小
+        size_t getSize() const;
+
+        // 获取解码后的字符串，索引无效时返回空
+        std::string_view getString(uint32_t idx) const;
+
+        // 获取原型的显示字符串（"返回类型 (参数, ...)"），索引无效时返回空
+        std::string_view getProtoString(uint32_t protoIdx) const;
+
+        // 获取按偏移量排序的map_list段表
+        std::span<const MapSection> getMapSections() const;
+
+        // 获取类的class_data记录，索引无效时返回nullptr
+        const SnapshotClassData* getClassData(uint32_t classDefIdx) const;
+
+        // 获取class_data记录中的全部成员，记录越界时返回空
+        std::span<const SnapshotMember> getMembers(const SnapshotClassData& classData) const;
+
+        // 获取方法的代码偏移量，没有代码时返回0
+        uint32_t getMethodCodeOff(uint32_t methodIdx) const;
+
+        // 获取访问指定字段的全部指令位置
+        std::span<const FieldAccessSite> getFieldAccessors(uint32_t fieldIdx) const;
+
+        // 获取读取指定字段的方法数量
+        uint32_t getFieldReaderCount(uint32_t fieldIdx) const;
+
+        // 获取写入指定字段的方法数量
+        uint32_t getFieldWriterCount(uint32_t fieldIdx) const;
+
+        // 获取使用指定类型的全部位置
+        std::span<const TypeUsageSite> getTypeUsages(uint32_t typeIdx) const;
+
+    private:
+        // 快照中的段
+        enum SectionId : uint32_t {
+            SECTION_STRINGS = 0,        // SnapshotStringRef[字符串数]
+            SECTION_PROTOS,             // SnapshotStringRef[原型数]
+            SECTION_ARENA,              // 字符串区
+            SECTION_MAP,                // MapSection[]
+            SECTION_CLASSES,            // SnapshotClassData[类定义数]
+            SECTION_MEMBERS,            // SnapshotMember[]
+            SECTION_METHOD_CODE,        // uint32_t[方法数]
+            SECTION_FIELD_OFFSETS,      // uint32_t[字段数+1]
+            SECTION_FIELD_SITES,        // FieldAccessSite[]
+            SECTION_FIELD_READERS,      // uint32_t[字段数]
+            SECTION_FIELD_WRITERS,      // uint32_t[字段数]
+            SECTION_TYPE_OFFSETS,       // uint32_t[类型数+1]
+            SECTION_TYPE_SITES,         // TypeUsageSite[]
+            SECTION_COUNT
+        };
+
+        // 快照中的段位置
+        struct SectionEntry {
+            uint32_t offset;          // 段起始偏移量
+            uint32_t size;            // 段字节数
+        };
+
+        // 快照文件头部
+        struct FileHeader {
+            char magic[8];            // "DEXSNAP\0"
+            uint32_t version;         // 格式版本
+            uint32_t headerSize;      // 文件头部大小
+            uint32_t endianTag;       // 写入时的字节序
+            uint32_t sectionCount;    // 段数量
+            uint32_t bodyChecksum;    // 头部之后全部数据的Adler-32校验和
+            DexHeader dexHeader;      // 写入时的DEX头部
+            SectionEntry sections[SECTION_COUNT];
+        };
+
+        Snapshot(uint8_t* data, size_t size);
+
+        // 获取段的数组视图
+        template <typename T>
+        std::span<const T> section(SectionId id) const
+        {
+            const SectionEntry& entry = header_->sections[id];
+            return {reinterpret_cast<const T*>(data_ + entry.offset), entry.size / sizeof(T)};
+        }
+
+        // 获取字符串区中的字符串
+        std::string_view arenaString(const SnapshotStringRef& ref) const;
+
+        // 获取CSR索引中一组的范围，越界时返回false
+        static bool csrRange(std::span<const uint32_t> offsets, uint32_t idx, size_t siteCount,
+                             uint32_t& begin, uint32_t& end);
+
+        // 映射的快照数据
+        uint8_t* data_;
+
+        // 快照文件大小
+        size_t size_;
+
+        // 快照文件头部
+        const FileHeader* header_;
+
+        // 常用段
+        std::span<const SnapshotStringRef> strings_;
+        std::span<const SnapshotStringRef> protos_;
+        std::span<const char> arena_;
+        std::span<const MapSection> mapSections_;
+        std::span<const SnapshotClassData> classes_;
+        std::span<const SnapshotMember> members_;
+        std::span<const uint32_t> methodCodeOffs_;
+        std::span<const uint32_t> fieldOffsets_;
+        std::span<const FieldAccessSite> fieldSites_;
+        std::span<const uint32_t> fieldReaders_;
+        std::span<const uint32_t> fieldWriters_;
+        std::span<const uint32_t> typeOffsets_;
+        std::span<const TypeUsageSite> typeSites_;
+    };
+}
+
+#endif //SNAPSHOT_H
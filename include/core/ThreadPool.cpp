@@ -0,0 +1,65 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace dex
+{
+    uint32_t getDefaultThreadCount()
+    {
+        const uint32_t count = std::thread::hardware_concurrency();
+        return count == 0 ? 1 : count;
+    }
+
+    void parallelFor(size_t count, size_t grain, uint32_t threadCount,
+                     const std::function<void(size_t chunk, size_t begin, size_t end)>& fn)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (grain == 0)
+        {
+            grain = 1;
+        }
+
+        const size_t chunkCount = (count + grain - 1) / grain;
+        if (threadCount == 0)
+        {
+            threadCount = getDefaultThreadCount();
+        }
+        const size_t workerCount = std::min<size_t>(threadCount, chunkCount);
+
+        // 各线程从共享计数器领取下一个块
+        std::atomic<size_t> nextChunk{0};
+        auto worker = [&]()
+        {
+            for (size_t chunk = nextChunk.fetch_add(1); chunk < chunkCount; chunk = nextChunk.fetch_add(1))
+            {
+                const size_t begin = chunk * grain;
+                fn(chunk, begin, std::min(begin + grain, count));
+            }
+        };
+
+        // 调用线程也参与处理
+        std::vector<std::thread> threads;
+        threads.reserve(workerCount - 1);
+        for (size_t i = 1; i < workerCount; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
@@ -0,0 +1,33 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace dex
+{
+    /**
+     * 获取默认线程数（硬件线程数，至少为1）
+     * @return 线程数
+     */
+    uint32_t getDefaultThreadCount();
+
+    /**
+     * 并行处理区间[0, count)
+     * 区间按grain切分为连续的块，由最多threadCount个线程（包括调用线程）依次领取执行。
+     * 块序号与区间位置一一对应，调用方可按块序号存放结果以保证输出顺序确定。
+     * @param count 元素数量
+     * @param grain 每块元素数量
+     * @param threadCount 线程数，0表示使用默认线程数
+     * @param fn 块处理函数 fn(块序号, 起始, 结束)
+     */
+    void parallelFor(size_t count, size_t grain, uint32_t threadCount,
+                     const std::function<void(size_t chunk, size_t begin, size_t end)>& fn);
+}
+
+#endif // THREADPOOL_H
@@ -0,0 +1,319 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "ZipArchive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include "Inflate.h"
+#include "log/log.h"
+
+namespace dex
+{
+    namespace
+    {
+        constexpr uint32_t kLocalHeaderSignature = 0x04034b50;
+        constexpr uint32_t kCentralHeaderSignature = 0x02014b50;
+        constexpr uint32_t kEndOfCentralDirSignature = 0x06054b50;
+
+        constexpr size_t kLocalHeaderSize = 30;
+        constexpr size_t kCentralHeaderSize = 46;
+        constexpr size_t kEndOfCentralDirSize = 22;
+        constexpr size_t kMaxCommentSize = 0xFFFF;
+
+        constexpr uint16_t kMethodStored = 0;
+        constexpr uint16_t kMethodDeflated = 8;
+        constexpr uint16_t kFlagEncrypted = 0x0001;
+
+        // 解压后大小的上限：单个DEX受64K方法数限制，实际不超过几十MB
+        constexpr uint64_t kMaxUncompressedSize = 256u << 20;
+
+        // DEFLATE的最大压缩比约为1032:1，声明的原始大小超过这个比例的条目不可能是合法数据
+        constexpr uint64_t kMaxDeflateRatio = 1032;
+
+        // APK路径和条目名称之间的分隔符
+        constexpr char kEntrySeparator = '!';
+
+        uint16_t readU2(const uint8_t* p)
+        {
+            return static_cast<uint16_t>(p[0] | (p[1] << 8));
+        }
+
+        uint32_t readU4(const uint8_t* p)
+        {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+    }
+
+    bool ZipArchive::open(const uint8_t* data, size_t size)
+    {
+        data_ = data;
+        size_ = size;
+        entries_.clear();
+
+        if (size < kEndOfCentralDirSize)
+        {
+            LOGE("ZIP文件过小: %zu 字节", size);
+            return false;
+        }
+
+        // 从文件末尾向前查找中央目录结束记录（其后最多有65535字节的注释）
+        const size_t lowest = size > kEndOfCentralDirSize + kMaxCommentSize ? size - kEndOfCentralDirSize - kMaxCommentSize : 0;
+        const uint8_t* eocd = nullptr;
+        for (size_t pos = size - kEndOfCentralDirSize + 1; pos-- > lowest;)
+        {
+            if (readU4(data + pos) == kEndOfCentralDirSignature &&
+                pos + kEndOfCentralDirSize + readU2(data + pos + 20) == size)
+            {
+                eocd = data + pos;
+                break;
+            }
+        }
+        if (eocd == nullptr)
+        {
+            LOGE("找不到ZIP中央目录结束记录");
+            return false;
+        }
+
+        const uint16_t diskNumber = readU2(eocd + 4);
+        const uint16_t centralDirDisk = readU2(eocd + 6);
+        const uint16_t entryCount = readU2(eocd + 10);
+        const uint32_t centralDirSize = readU4(eocd + 12);
+        const uint32_t centralDirOffset = readU4(eocd + 16);
+        if (diskNumber != 0 || centralDirDisk != 0)
+        {
+            LOGE("不支持分卷ZIP文件");
+            return false;
+        }
+        if (entryCount == 0xFFFF || centralDirSize == 0xFFFFFFFF || centralDirOffset == 0xFFFFFFFF)
+        {
+            LOGE("不支持ZIP64文件");
+            return false;
+        }
+        if (static_cast<size_t>(centralDirOffset) + centralDirSize > static_cast<size_t>(eocd - data))
+        {
+            LOGE("ZIP中央目录越界: 偏移量 0x%X, 大小 %u", centralDirOffset, centralDirSize);
+            return false;
+        }
+
+        entries_.reserve(entryCount);
+        const uint8_t* cur = data + centralDirOffset;
+        const uint8_t* const end = cur + centralDirSize;
+        for (uint32_t i = 0; i < entryCount; i++)
+        {
+            if (static_cast<size_t>(end - cur) < kCentralHeaderSize || readU4(cur) != kCentralHeaderSignature)
+            {
+                LOGE("ZIP中央目录条目 %u 无效", i);
+                entries_.clear();
+                return false;
+            }
+            const uint16_t nameLength = readU2(cur + 28);
+            const uint16_t extraLength = readU2(cur + 30);
+            const uint16_t commentLength = readU2(cur + 32);
+            const size_t recordSize = kCentralHeaderSize + nameLength + extraLength + commentLength;
+            if (static_cast<size_t>(end - cur) < recordSize)
+            {
+                LOGE("ZIP中央目录条目 %u 越界", i);
+                entries_.clear();
+                return false;
+            }
+
+            ZipEntry entry;
+            entry.flags = readU2(cur + 8);
+            entry.method = readU2(cur + 10);
+            entry.compressedSize = readU4(cur + 20);
+            entry.uncompressedSize = readU4(cur + 24);
+            entry.localHeaderOffset = readU4(cur + 42);
+            entry.name.assign(reinterpret_cast<const char*>(cur + kCentralHeaderSize), nameLength);
+            entries_.push_back(std::move(entry));
+
+            cur += recordSize;
+        }
+
+        return true;
+    }
+
+    const std::vector<ZipEntry>& ZipArchive::getEntries() const
+    {
+        return entries_;
+    }
+
+    const ZipEntry* ZipArchive::findEntry(std::string_view name) const
+    {
+        const auto it = std::find_if(entries_.begin(), entries_.end(),
+                                     [name](const ZipEntry& entry) { return entry.name == name; });
+        return it != entries_.end() ? &*it : nullptr;
+    }
+
+    std::vector<const ZipEntry*> ZipArchive::getDexEntries() const
+    {
+        std::vector<std::pair<uint32_t, const ZipEntry*>> numbered;
+        for (const ZipEntry& entry : entries_)
+        {
+            uint32_t number = 0;
+            if (isDexEntryName(entry.name, &number))
+            {
+                numbered.emplace_back(number, &entry);
+            }
+        }
+        std::sort(numbered.begin(), numbered.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::vector<const ZipEntry*> result;
+        result.reserve(numbered.size());
+        for (const auto& [number, entry] : numbered)
+        {
+            result.push_back(entry);
+        }
+        return result;
+    }
+
+    bool ZipArchive::read(const ZipEntry& entry, std::vector<uint8_t>& buffer, std::span<const uint8_t>& data) const
+    {
+        if (entry.flags & kFlagEncrypted)
+        {
+            LOGE("不支持加密的ZIP条目: %s", entry.name.c_str());
+            return false;
+        }
+
+        // 本地文件头的扩展字段长度可能与中央目录不同，数据位置以本地文件头为准
+        const size_t headerOffset = entry.localHeaderOffset;
+        if (headerOffset > size_ || size_ - headerOffset < kLocalHeaderSize ||
+            readU4(data_ + headerOffset) != kLocalHeaderSignature)
+        {
+            LOGE("ZIP本地文件头无效: %s", entry.name.c_str());
+            return false;
+        }
+        const size_t dataOffset = headerOffset + kLocalHeaderSize + readU2(data_ + headerOffset + 26) +
+                                  readU2(data_ + headerOffset + 28);
+        if (dataOffset > size_ || size_ - dataOffset < entry.compressedSize)
+        {
+            LOGE("ZIP条目数据越界: %s", entry.name.c_str());
+            return false;
+        }
+        const uint8_t* compressed = data_ + dataOffset;
+
+        if (entry.method == kMethodStored)
+        {
+            if (entry.compressedSize != entry.uncompressedSize)
+            {
+                LOGE("存储的ZIP条目大小不一致: %s", entry.name.c_str());
+                return false;
+            }
+            // DEX结构按4字节对齐访问，zipalign过的APK可以直接使用映射的数据
+            if (reinterpret_cast<uintptr_t>(compressed) % 4 == 0)
+            {
+                data = {compressed, entry.uncompressedSize};
+                return true;
+            }
+            buffer.resize(entry.uncompressedSize);
+            memcpy(buffer.data(), compressed, entry.uncompressedSize);
+            data = {buffer.data(), buffer.size()};
+            return true;
+        }
+
+        if (entry.method != kMethodDeflated)
+        {
+            LOGE("不支持的ZIP压缩方法 %u: %s", entry.method, entry.name.c_str());
+            return false;
+        }
+
+        // 原始大小来自中央目录，不可信，超过上限时拒绝而不是按声明的大小分配缓冲区
+        if (entry.uncompressedSize > kMaxUncompressedSize ||
+            entry.uncompressedSize > static_cast<uint64_t>(entry.compressedSize) * kMaxDeflateRatio)
+        {
+            LOGE("ZIP条目原始大小异常: %s (压缩后 %u 字节, 原始 %u 字节)", entry.name.c_str(), entry.compressedSize,
+                 entry.uncompressedSize);
+            return false;
+        }
+
+        buffer.resize(entry.uncompressedSize);
+        if (!inflate(compressed, entry.compressedSize, buffer.data(), buffer.size()))
+        {
+            LOGE("解压ZIP条目失败: %s", entry.name.c_str());
+            return false;
+        }
+        data = {buffer.data(), buffer.size()};
+        return true;
+    }
+
+    bool ZipArchive::isZip(const uint8_t* data, size_t size)
+    {
+        return size >= 4 && readU4(data) == kLocalHeaderSignature;
+    }
+
+    bool ZipArchive::isDexEntryName(std::string_view name, uint32_t* number)
+    {
+        if (!name.starts_with("classes") || !name.ends_with(".dex"))
+        {
+            return false;
+        }
+        const std::string_view digits = name.substr(7, name.size() - 7 - 4);
+        if (digits.empty())
+        {
+            if (number != nullptr)
+            {
+                *number = 1;
+            }
+            return true;
+        }
+
+        // classesN.dex的编号从2开始，不带前导0
+        if (digits.size() > 9 || digits.front() == '0' ||
+            !std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; }))
+        {
+            return false;
+        }
+        uint32_t value = 0;
+        for (const char c : digits)
+        {
+            value = value * 10 + static_cast<uint32_t>(c - '0');
+        }
+        if (value < 2)
+        {
+            return false;
+        }
+        if (number != nullptr)
+        {
+            *number = value;
+        }
+        return true;
+    }
+
+    std::string ZipArchive::entryPath(std::string_view archivePath, std::string_view entryName)
+    {
+        std::string path;
+        path.reserve(archivePath.size() + 1 + entryName.size());
+        path.append(archivePath).push_back(kEntrySeparator);
+        path.append(entryName);
+        return path;
+    }
+
+    bool ZipArchive::splitEntryPath(std::string_view path, std::string& archivePath, std::string& entryName)
+    {
+        const size_t separator = path.rfind(kEntrySeparator);
+        if (separator == std::string_view::npos || separator == 0 || separator + 1 == path.size())
+        {
+            return false;
+        }
+
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(std::filesystem::path(path), ec))
+        {
+            return false;
+        }
+        const std::string_view archive = path.substr(0, separator);
+        if (!std::filesystem::is_regular_file(std::filesystem::path(archive), ec))
+        {
+            return false;
+        }
+
+        archivePath.assign(archive);
+        entryName.assign(path.substr(separator + 1));
+        return true;
+    }
+}
@@ -0,0 +1,93 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef ZIPARCHIVE_H
+#define ZIPARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dex
+{
+    // ZIP中央目录中的条目
+    struct ZipEntry
+    {
+        std::string name;              // 条目名称
+        uint16_t method;               // 压缩方法，0为存储，8为DEFLATE
+        uint16_t flags;                // 通用标志位
+        uint32_t compressedSize;       // 压缩后大小
+        uint32_t uncompressedSize;     // 原始大小
+        uint32_t localHeaderOffset;    // 本地文件头偏移量
+    };
+
+    /**
+     * ZipArchive - 只读的ZIP/APK中央目录读取器
+     * 在映射的文件上直接解析中央目录，不复制文件数据。
+     * 存储的条目直接指向映射的数据；压缩的条目用内置的DEFLATE解压器解压到调用者的缓冲区。
+     * 不支持ZIP64、分卷和加密条目。条目数据不校验CRC-32，DEX的完整性由头部的校验和与签名保证。
+     */
+    class ZipArchive
+    {
+    public:
+        /**
+         * 解析中央目录
+         * @param data 映射的ZIP文件数据，生命周期需覆盖ZipArchive的使用期间
+         * @param size 数据长度
+         * @return 不是有效的ZIP文件时返回false
+         */
+        bool open(const uint8_t* data, size_t size);
+
+        // 获取全部条目
+        const std::vector<ZipEntry>& getEntries() const;
+
+        // 按名称查找条目，不存在时返回nullptr
+        const ZipEntry* findEntry(std::string_view name) const;
+
+        // 获取根目录下的classes.dex、classes2.dex...条目，按编号排序
+        std::vector<const ZipEntry*> getDexEntries() const;
+
+        /**
+         * 读取条目数据
+         * 存储且4字节对齐的条目直接返回映射的数据；压缩或未对齐的条目解压或复制到buffer，
+         * buffer可在多次读取之间复用，只在容量不足时重新分配
+         * @param entry 条目
+         * @param buffer 解压缓冲区
+         * @param data 输出参数，条目数据
+         * @return 条目无效、声明的原始大小超过上限（256MB或压缩后大小的1032倍）或解压失败时返回false
+         */
+        bool read(const ZipEntry& entry, std::vector<uint8_t>& buffer, std::span<const uint8_t>& data) const;
+
+        // 检查数据是否以ZIP本地文件头开头
+        static bool isZip(const uint8_t* data, size_t size);
+
+        // 检查条目名称是否为classes.dex或classesN.dex，是时输出编号（classes.dex为1）
+        static bool isDexEntryName(std::string_view name, uint32_t* number = nullptr);
+
+        // 生成APK条目路径，例如app.apk!classes2.dex
+        static std::string entryPath(std::string_view archivePath, std::string_view entryName);
+
+        /**
+         * 拆分APK条目路径
+         * 路径本身是存在的文件时不拆分；否则按最后一个!拆分，!之前必须是存在的文件
+         * @return 是APK条目路径时返回true
+         */
+        static bool splitEntryPath(std::string_view path, std::string& archivePath, std::string& entryName);
+
+    private:
+        // 映射的文件数据
+        const uint8_t* data_ = nullptr;
+
+        // 数据长度
+        size_t size_ = 0;
+
+        // 中央目录条目
+        std::vector<ZipEntry> entries_;
+    };
+}
+
+#endif // ZIPARCHIVE_H
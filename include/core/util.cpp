@@ -4,8 +4,12 @@
 
 #include "util.h"
 
+#include <cerrno>
 #include <cstdio>
 #include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -18,6 +22,13 @@
 
 #include "log/log.h"
 
+namespace
+{
+    // 存储所有活动的文件映射，键为数据指针；批量处理时多个线程同时映射文件，访问需要加锁
+    std::unordered_map<uint8_t*, util::FileMapping> fileMappings;
+    std::mutex fileMappingsMutex;
+}
+
 /**
  * 使用内存映射方式处理文件
  * @param fileName 文件路径
@@ -33,6 +44,7 @@ int32_t util::mapFile(const char* fileName, uint8_t** fileData, size_t* fileSize
         return -1;
     }
 
+#ifdef _WIN32
     // Windows实现
     HANDLE hFile = CreateFileA(
         fileName,
@@ -149,7 +161,58 @@ int32_t util::mapFile(const char* fileName, uint8_t** fileData, size_t* fileSize
     mapping.fileHandle = hFile;
     mapping.mappingHandle = hFileMapping;
     mapping.data = *fileData;
-    util::fileMappings[*fileData] = mapping;
+    {
+        std::lock_guard lock(fileMappingsMutex);
+        fileMappings[*fileData] = mapping;
+    }
+
+#else
+    // POSIX实现
+    const int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+        LOGE("打开文件失败: %s (错误码: %d)", strerror(errno), errno);
+        return -2;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0)
+    {
+        LOGE("获取文件大小失败: %s (错误码: %d)", strerror(errno), errno);
+        close(fd);
+        return -3;
+    }
+
+    // 空文件不能映射
+    const auto size = static_cast<size_t>(st.st_size);
+    if (size == 0)
+    {
+        LOGE("文件为空: %s", fileName);
+        close(fd);
+        return -3;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后即可关闭文件描述符
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        LOGE("映射文件视图失败: %s (错误码: %d)", strerror(errno), errno);
+        return -5;
+    }
+
+    *fileData = static_cast<uint8_t*>(data);
+    *fileSize = size;
+    LOGI("成功映射文件: %s, Size: %zu 字节", fileName, *fileSize);
+
+    util::FileMapping mapping{};
+    mapping.size = size;
+    mapping.data = *fileData;
+    {
+        std::lock_guard lock(fileMappingsMutex);
+        fileMappings[*fileData] = mapping;
+    }
+#endif
 
     return 0;
 }
@@ -167,15 +230,22 @@ int32_t util::unmapFile(uint8_t* fileData)
         return -1;
     }
 
-    // 查找映射信息
-    auto it = util::fileMappings.find(fileData);
-    if (it == util::fileMappings.end())
+    // 取出映射信息
+    util::FileMapping mapping{};
     {
-        LOGE("找不到指定的文件映射信息");
-        return -2;
+        std::lock_guard lock(fileMappingsMutex);
+        const auto it = fileMappings.find(fileData);
+        if (it == fileMappings.end())
+        {
+            LOGE("找不到指定的文件映射信息");
+            return -2;
+        }
+        mapping = it->second;
+        fileMappings.erase(it);
     }
 
 
+#ifdef _WIN32
     // Windows实现
     if (!UnmapViewOfFile(fileData))
     {
@@ -195,7 +265,7 @@ int32_t util::unmapFile(uint8_t* fileData)
     }
 
     // 关闭映射句柄
-    if (!CloseHandle(it->second.mappingHandle))
+    if (!CloseHandle(mapping.mappingHandle))
     {
         DWORD error = GetLastError();
         char errorMsg[1024];
@@ -213,7 +283,7 @@ int32_t util::unmapFile(uint8_t* fileData)
     }
 
     // 关闭文件句柄
-    if (!CloseHandle(it->second.fileHandle))
+    if (!CloseHandle(mapping.fileHandle))
     {
         DWORD error = GetLastError();
         char errorMsg[1024];
@@ -229,8 +299,15 @@ int32_t util::unmapFile(uint8_t* fileData)
         LOGE("关闭文件句柄失败: %s (错误码: %lu)", errorMsg, error);
         return -5;
     }
-    // 从映射表中移除
-    util::fileMappings.erase(it);
+#else
+    // POSIX实现
+    if (munmap(fileData, mapping.size) != 0)
+    {
+        LOGE("解除文件映射失败: %s (错误码: %d)", strerror(errno), errno);
+        return -3;
+    }
+#endif
+
     LOGI("成功解除文件映射");
 
     return 0;
@@ -7,7 +7,6 @@
 
 #include <cstdint>
 #include <cstddef>
-#include <unordered_map>
 
 namespace util {
 
@@ -24,9 +23,6 @@ namespace util {
         uint8_t* data;         // 映射数据指针
     };
 
-    // 存储所有活动的文件映射，键为数据指针
-    static std::unordered_map<uint8_t*, FileMapping> fileMappings;
-
     /**
      * 处理文件的主函数
      * @param fileName 文件路径
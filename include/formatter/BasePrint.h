@@ -6,6 +6,7 @@
 #define BASEPRINT_H
 
 #include "core/DexContext.h"
+#include "OutputSink.h"
 
 namespace dex::print
 {
@@ -18,6 +19,12 @@ namespace dex::print
     protected:
         // 获取全局上下文
         static DexContext& getContext();
+
+        // 获取输出目标
+        OutputSink& getSink() const
+        {
+            return *sink_;
+        }
         
     public:
         // 构造函数
@@ -28,6 +35,16 @@ namespace dex::print
 
         // 打印函数，子类必须实现
         virtual void print() = 0;
+
+        // 设置输出目标，默认输出到标准输出
+        void setSink(OutputSink& sink)
+        {
+            sink_ = &sink;
+        }
+
+    private:
+        // 输出目标
+        OutputSink* sink_ = &OutputSink::stdoutSink();
     };
 }
 
@@ -10,11 +10,21 @@
 #include "log/log.h"
 #include "core/DexContext.h"
 #include "FormatUtil.h"
+#include "OrderedRender.h"
 
 namespace dex::print
 {
+    namespace
+    {
+        // 并行渲染时每块包含的表格行数
+        constexpr size_t kRowsPerChunk = 256;
+
+        // 并行渲染时每块包含的类数量
+        constexpr size_t kClassesPerChunk = 16;
+    }
+
     // 打印方法信息的辅助函数
-    void printMethodInfo(const dex::DexContext& context, const dex::ClassDefInfo::ClassDataInfo::EncodedMethodInfo& method, uint32_t index)
+    void printMethodInfo(OutputSink& out, const dex::DexContext& context, const dex::ClassDefInfo::ClassDataInfo::EncodedMethodInfo& method, uint32_t index)
     {
         // 从方法索引获取完整方法信息
         if (method.methodIdx < context.getMethodIdsCount())
@@ -27,7 +37,7 @@ namespace dex::print
             // 简化返回类型显示
             std::string returnType = simplifyTypeName(methodInfo.returnType);
             
-            printf("      [%u] %s %s (访问标志: %s, 代码偏移量: 0x%08X)\n", 
+            out.printf("      [%u] %s %s (访问标志: %s, 代码偏移量: 0x%08X)\n", 
                    index, returnType.c_str(), signature.c_str(), 
                    dex::DexContext::getAccessFlagsString(method.accessFlags).c_str(),
                    method.codeOff);
@@ -35,176 +45,216 @@ namespace dex::print
             // 打印详细的参数信息（如果有）
             if (methodInfo.hasParameterList && !methodInfo.parameterTypes.empty())
             {
-                printf("          参数列表(%zu):\n", methodInfo.parameterTypes.size());
+                out.printf("          参数列表(%zu):\n", methodInfo.parameterTypes.size());
                 for (size_t i = 0; i < methodInfo.parameterTypes.size(); i++)
                 {
-                    printf("            [%zu] %s\n", i, methodInfo.parameterTypes[i].c_str());
+                    out.printf("            [%zu] %s\n", i, methodInfo.parameterTypes[i].c_str());
                 }
             }
         }
         else
         {
-            printf("      [%u] 方法索引无效: %u (访问标志: %s, 代码偏移量: 0x%08X)\n", 
+            out.printf("      [%u] 方法索引无效: %u (访问标志: %s, 代码偏移量: 0x%08X)\n", 
                    index, method.methodIdx, 
                    dex::DexContext::getAccessFlagsString(method.accessFlags).c_str(),
                    method.codeOff);
         }
     }
 
-    void ClassPrint::print()
+    // 打印Class表中的第i行（类定义索引为classDefIdx），每15行重复一次表头
+    static void printClassRow(OutputSink& out, const dex::DexContext& context, uint32_t i, uint32_t classDefIdx,
+                              uint32_t classCount)
     {
-        // 获取上下文
-        const dex::DexContext& context = getContext();
+        // 获取Class信息
+        dex::ClassDefInfo classInfo = context.getClassDefInfo(classDefIdx);
         
-        // 检查是否有效
-        if (!context.isValid())
+        // 简化类名显示（只保留最后一部分）
+        std::string className = simplifyTypeName(classInfo.className);
+        if (className.length() > 18)
         {
-            LOGE("DEX解析未完成或无效，无法打印Class表");
-            return;
+            className = className.substr(0, 15) + "...";
         }
         
-        // 获取Class数量
-        const uint32_t classCount = context.getClassDefsCount();
-        if (classCount == 0)
+        // 简化父类名显示
+        std::string superClassName = classInfo.superClassName.empty() ? "(无)" : simplifyTypeName(classInfo.superClassName);
+        if (superClassName.length() > 18)
         {
-            printf("Class表为空\n");
-            return;
+            superClassName = superClassName.substr(0, 15) + "...";
+        }
+        
+        // 获取访问标志字符串
+        std::string accessFlags = dex::DexContext::getAccessFlagsString(classInfo.accessFlags);
+        if (accessFlags.length() > 20)
+        {
+            accessFlags = accessFlags.substr(0, 17) + "...";
         }
         
-        printf("\n/-------------------------------------------------------------------------\\\n");
-        printf("|                           DEX Class Table                              |\n");
-        printf("+------+--------------------+--------------------+----------------------+\n");
-        printf("| %-4s | %-18s | %-18s | %-20s |\n", "索引", "类名", "父类", "访问标志");
-        printf("+------+--------------------+--------------------+----------------------+\n");
+        // 打印行
+        out.write("| ");
+        out.writeDec(classDefIdx, 4);
+        out.write(" | ");
+        out.writePadded(className, 18);
+        out.write(" | ");
+        out.writePadded(superClassName, 18);
+        out.write(" | ");
+        out.writePadded(accessFlags, 20);
+        out.write(" |\n");
         
-        // 打印Class表
-        for (uint32_t i = 0; i < classCount; i++)
+        // 每15行打印一次表头
+        if ((i + 1) % 15 == 0 && i + 1 < classCount)
         {
-            // 获取Class信息
-            dex::ClassDefInfo classInfo = context.getClassDefInfo(i);
-            
-            // 简化类名显示（只保留最后一部分）
-            std::string className = simplifyTypeName(classInfo.className);
-            if (className.length() > 18)
-            {
-                className = className.substr(0, 15) + "...";
-            }
-            
-            // 简化父类名显示
-            std::string superClassName = classInfo.superClassName.empty() ? "(无)" : simplifyTypeName(classInfo.superClassName);
-            if (superClassName.length() > 18)
-            {
-                superClassName = superClassName.substr(0, 15) + "...";
-            }
-            
-            // 获取访问标志字符串
-            std::string accessFlags = dex::DexContext::getAccessFlagsString(classInfo.accessFlags);
-            if (accessFlags.length() > 20)
-            {
-                accessFlags = accessFlags.substr(0, 17) + "...";
-            }
-            
-            // 打印行
-            printf("| %4u | %-18s | %-18s | %-20s |\n", 
-                   i, className.c_str(), superClassName.c_str(), accessFlags.c_str());
-            
-            // 每15行打印一次表头
-            if ((i + 1) % 15 == 0 && i + 1 < classCount)
-            {
-                printf("+------+--------------------+--------------------+----------------------+\n");
-                printf("| %-4s | %-18s | %-18s | %-20s |\n", "索引", "类名", "父类", "访问标志");
-                printf("+------+--------------------+--------------------+----------------------+\n");
-            }
+            out.write("+------+--------------------+--------------------+----------------------+\n");
+            out.printf("| %-4s | %-18s | %-18s | %-20s |\n", "索引", "类名", "父类", "访问标志");
+            out.write("+------+--------------------+--------------------+----------------------+\n");
         }
+    }
+
+    // 打印第i个类（类定义索引为classDefIdx）的详细信息，每3个类后添加分隔线
+    static void printClassDetail(OutputSink& out, const dex::DexContext& context, uint32_t i, uint32_t classDefIdx,
+                                 uint32_t classCount)
+    {
+        dex::ClassDefInfo classInfo = context.getClassDefInfo(classDefIdx);
         
-        printf("+------+--------------------+--------------------+----------------------+\n");
+        out.printf("\n[%u] %s\n", classDefIdx, classInfo.className.c_str());
+        out.printf("  访问标志: %s\n", dex::DexContext::getAccessFlagsString(classInfo.accessFlags).c_str());
+        out.printf("  父类: %s\n", classInfo.superClassName.empty() ? "(无)" : classInfo.superClassName.c_str());
+        out.printf("  源文件: %s\n", classInfo.sourceFileName.empty() ? "(未知)" : classInfo.sourceFileName.c_str());
         
-        // 打印接口和源文件信息
-        printf("\n详细信息:\n");
-        for (uint32_t i = 0; i < classCount; i++)
+        // 显示类数据偏移量信息
+        out.printf("  类数据偏移量: 0x%08X\n", classInfo.classDataOff);
+        
+        // 显示类数据内容
+        if (classInfo.classDataOff != 0 && classInfo.classData.isLoaded)
         {
-            dex::ClassDefInfo classInfo = context.getClassDefInfo(i);
+            out.write("  类数据:\n");
+            out.printf("    静态字段: %u\n", classInfo.classData.staticFieldsSize);
+            out.printf("    实例字段: %u\n", classInfo.classData.instanceFieldsSize);
+            out.printf("    直接方法: %u\n", classInfo.classData.directMethodsSize);
+            out.printf("    虚拟方法: %u\n", classInfo.classData.virtualMethodsSize);
             
-            printf("\n[%u] %s\n", i, classInfo.className.c_str());
-            printf("  访问标志: %s\n", dex::DexContext::getAccessFlagsString(classInfo.accessFlags).c_str());
-            printf("  父类: %s\n", classInfo.superClassName.empty() ? "(无)" : classInfo.superClassName.c_str());
-            printf("  源文件: %s\n", classInfo.sourceFileName.empty() ? "(未知)" : classInfo.sourceFileName.c_str());
-            
-            // 显示类数据偏移量信息
-            printf("  类数据偏移量: 0x%08X\n", classInfo.classDataOff);
-            
-            // 显示类数据内容
-            if (classInfo.classDataOff != 0 && classInfo.classData.isLoaded)
+            // 打印静态字段
+            if (classInfo.classData.staticFieldsSize > 0)
             {
-                printf("  类数据:\n");
-                printf("    静态字段: %u\n", classInfo.classData.staticFieldsSize);
-                printf("    实例字段: %u\n", classInfo.classData.instanceFieldsSize);
-                printf("    直接方法: %u\n", classInfo.classData.directMethodsSize);
-                printf("    虚拟方法: %u\n", classInfo.classData.virtualMethodsSize);
-                
-                // 打印静态字段
-                if (classInfo.classData.staticFieldsSize > 0)
+                out.write("    静态字段列表:\n");
+                for (uint32_t j = 0; j < classInfo.classData.staticFields.size(); j++)
                 {
-                    printf("    静态字段列表:\n");
-                    for (uint32_t j = 0; j < classInfo.classData.staticFields.size(); j++)
-                    {
-                        const auto& field = classInfo.classData.staticFields[j];
-                        printf("      [%u] %s %s (访问标志: %s)\n", 
-                               j, field.type.c_str(), field.name.c_str(), 
-                               dex::DexContext::getAccessFlagsString(field.accessFlags).c_str());
-                    }
+                    const auto& field = classInfo.classData.staticFields[j];
+                    out.printf("      [%u] %s %s (访问标志: %s)\n", 
+                           j, field.type.c_str(), field.name.c_str(), 
+                           dex::DexContext::getAccessFlagsString(field.accessFlags).c_str());
                 }
-                
-                // 打印实例字段
-                if (classInfo.classData.instanceFieldsSize > 0)
-                {
-                    printf("    实例字段列表:\n");
-                    for (uint32_t j = 0; j < classInfo.classData.instanceFields.size(); j++)
-                    {
-                        const auto& field = classInfo.classData.instanceFields[j];
-                        printf("      [%u] %s %s (访问标志: %s)\n", 
-                               j, field.type.c_str(), field.name.c_str(), 
-                               dex::DexContext::getAccessFlagsString(field.accessFlags).c_str());
-                    }
-                }
-                
-                // 打印直接方法
-                if (classInfo.classData.directMethodsSize > 0)
+            }
+            
+            // 打印实例字段
+            if (classInfo.classData.instanceFieldsSize > 0)
+            {
+                out.write("    实例字段列表:\n");
+                for (uint32_t j = 0; j < classInfo.classData.instanceFields.size(); j++)
                 {
-                    printf("    直接方法列表:\n");
-                    for (uint32_t j = 0; j < classInfo.classData.directMethods.size(); j++)
-                    {
-                        printMethodInfo(context, classInfo.classData.directMethods[j], j);
-                    }
+                    const auto& field = classInfo.classData.instanceFields[j];
+                    out.printf("      [%u] %s %s (访问标志: %s)\n", 
+                           j, field.type.c_str(), field.name.c_str(), 
+                           dex::DexContext::getAccessFlagsString(field.accessFlags).c_str());
                 }
-                
-                // 打印虚拟方法
-                if (classInfo.classData.virtualMethodsSize > 0)
+            }
+            
+            // 打印直接方法
+            if (classInfo.classData.directMethodsSize > 0)
+            {
+                out.write("    直接方法列表:\n");
+                for (uint32_t j = 0; j < classInfo.classData.directMethods.size(); j++)
                 {
-                    printf("    虚拟方法列表:\n");
-                    for (uint32_t j = 0; j < classInfo.classData.virtualMethods.size(); j++)
-                    {
-                        printMethodInfo(context, classInfo.classData.virtualMethods[j], j);
-                    }
+                    printMethodInfo(out, context, classInfo.classData.directMethods[j], j);
                 }
             }
             
-            if (!classInfo.interfaces.empty())
+            // 打印虚拟方法
+            if (classInfo.classData.virtualMethodsSize > 0)
             {
-                printf("  实现接口:\n");
-                for (uint32_t j = 0; j < classInfo.interfaces.size(); j++)
+                out.write("    虚拟方法列表:\n");
+                for (uint32_t j = 0; j < classInfo.classData.virtualMethods.size(); j++)
                 {
-                    printf("    - %s\n", classInfo.interfaces[j].c_str());
+                    printMethodInfo(out, context, classInfo.classData.virtualMethods[j], j);
                 }
             }
-            
-            // 每3个类后添加分隔线
-            if ((i + 1) % 3 == 0 && i + 1 < classCount)
+        }
+        
+        if (!classInfo.interfaces.empty())
+        {
+            out.write("  实现接口:\n");
+            for (uint32_t j = 0; j < classInfo.interfaces.size(); j++)
             {
-                printf("\n-------------------------------------------------------------\n");
+                out.printf("    - %s\n", classInfo.interfaces[j].c_str());
             }
         }
         
-        printf("\n共计: %u 个类定义\n", classCount);
+        // 每3个类后添加分隔线
+        if ((i + 1) % 3 == 0 && i + 1 < classCount)
+        {
+            out.write("\n-------------------------------------------------------------\n");
+        }
+    }
+
+    void ClassPrint::print()
+    {
+        OutputSink& out = getSink();
+
+        // 获取上下文
+        const dex::DexContext& context = getContext();
+        
+        // 检查是否有效
+        if (!context.isValid())
+        {
+            LOGE("DEX解析未完成或无效，无法打印Class表");
+            return;
+        }
+        
+        // 获取Class数量（设置了类过滤器时只输出选中的类）
+        const std::span<const uint32_t> selected = context.getSelectedClassDefs();
+        const uint32_t classCount = static_cast<uint32_t>(selected.size());
+        if (classCount == 0)
+        {
+            out.write("Class表为空\n");
+            out.flush();
+            return;
+        }
+
+        // 并行渲染时各线程只读取缓存，先加载全部类定义和方法信息
+        context.loadAllClassDefs();
+        context.loadAllMethods();
+        const uint32_t threadCount = context.getThreadCount();
+        
+        out.write("\n/-------------------------------------------------------------------------\\\n");
+        out.write("|                           DEX Class Table                              |\n");
+        out.write("+------+--------------------+--------------------+----------------------+\n");
+        out.printf("| %-4s | %-18s | %-18s | %-20s |\n", "索引", "类名", "父类", "访问标志");
+        out.write("+------+--------------------+--------------------+----------------------+\n");
+        
+        // 打印Class表
+        renderOrdered(out, classCount, kRowsPerChunk, threadCount,
+                      [&](OutputSink& sink, size_t, size_t begin, size_t end)
+                      {
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              printClassRow(sink, context, static_cast<uint32_t>(i), selected[i], classCount);
+                          }
+                      });
+        
+        out.write("+------+--------------------+--------------------+----------------------+\n");
+        
+        // 打印接口和源文件信息
+        out.write("\n详细信息:\n");
+        renderOrdered(out, classCount, kClassesPerChunk, threadCount,
+                      [&](OutputSink& sink, size_t, size_t begin, size_t end)
+                      {
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              printClassDetail(sink, context, static_cast<uint32_t>(i), selected[i], classCount);
+                          }
+                      });
+        
+        out.printf("\n共计: %u 个类定义\n", classCount);
+
+        out.flush();
     }
-} 
\ No newline at end of file
+}
\ No newline at end of file
@@ -47,18 +47,11 @@ namespace dex::print
     private:
         /**
          * 打印特定指令的详细信息
+         * @param codeInfo 指令所属的代码区段，操作数文本存放在这里
          * @param instruction 指令信息
-         * @param baseOffset 基础偏移量（用于计算绝对地址）
          */
-        void printInstruction(const dex::parser::InstructionInfo& instruction, uint32_t baseOffset);
-        
-        /**
-         * 获取指令的操作数描述
-         * @param opcode 操作码
-         * @param operands 操作数原始字符串
-         * @return 格式化后的操作数描述
-         */
-        std::string getOperandDescription(uint16_t opcode, const std::string& operands);
+        void printInstruction(const dex::parser::CodeSectionInfo& codeInfo,
+                              const dex::parser::InstructionInfo& instruction);
     };
 }
 
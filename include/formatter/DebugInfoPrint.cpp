@@ -12,6 +12,8 @@ namespace dex::print
 {
     void DebugInfoPrint::printMethodDebugInfo(uint32_t methodIdx)
     {
+        OutputSink& out = getSink();
+
         const dex::DexContext& context = getContext();
 
         // 检查方法索引是否有效
@@ -25,126 +27,74 @@ namespace dex::print
         dex::MethodInfo methodInfo = context.getMethodInfo(methodIdx);
         std::string signature = formatMethodSignature(methodInfo);
 
-        printf("\n方法调试信息: %s\n", signature.c_str());
-        printf("类: %s\n", methodInfo.className.c_str());
+        out.printf("\n方法调试信息: %s\n", signature.c_str());
+        out.printf("类: %s\n", methodInfo.className.c_str());
 
-        // 查找方法代码偏移量和调试信息
-        bool foundDebugInfo = false;
+        // 查找方法代码段和调试信息
+        const DexCode* dexCode = context.getCodeItem(context.getMethodCodeOff(methodIdx));
 
-        // 遍历所有类定义
-        for (uint32_t i = 0; i < context.getClassDefsCount(); i++)
+        if (dexCode == nullptr)
         {
-            dex::ClassDefInfo classInfo = context.getClassDefInfo(i);
-
-            // 检查是否有类数据
-            if (classInfo.classDataOff != 0 && classInfo.classData.isLoaded)
-            {
-                // 查找直接方法
-                for (const auto& method : classInfo.classData.directMethods)
-                {
-                    if (method.methodIdx == methodIdx)
-                    {
-                        if (method.codeOff == 0)
-                        {
-                            printf("\n该方法没有代码段（可能是抽象方法、接口方法或本地方法）\n");
-                            return;
-                        }
-
-                        // 确保方法代码已解析
-                        if (!method.codeInfo.isLoaded)
-                        {
-                            context.parseMethodCode(methodIdx);
-                        }
-
-                        if (method.codeInfo.debugInfoOff == 0)
-                        {
-                            printf("\n该方法没有调试信息\n");
-                            return;
-                        }
+            out.write("\n该方法没有代码段（可能是抽象方法、接口方法或本地方法）\n");
+            out.flush();
+            return;
+        }
 
-                        printDebugInfo(method.codeInfo.debugInfoOff);
-                        foundDebugInfo = true;
-                        break;
-                    }
-                }
+        if (dexCode->debug_info_off == 0)
+        {
+            out.write("\n该方法没有调试信息\n");
+            out.flush();
+            return;
+        }
 
-                // 如果在直接方法中没找到，查找虚拟方法
-                if (!foundDebugInfo)
-                {
-                    for (const auto& method : classInfo.classData.virtualMethods)
-                    {
-                        if (method.methodIdx == methodIdx)
-                        {
-                            if (method.codeOff == 0)
-                            {
-                                printf("\n该方法没有代码段（可能是抽象方法、接口方法或本地方法）\n");
-                                return;
-                            }
-
-                            // 确保方法代码已解析
-                            if (!method.codeInfo.isLoaded)
-                            {
-                                context.parseMethodCode(methodIdx);
-                            }
-
-                            if (method.codeInfo.debugInfoOff == 0)
-                            {
-                                printf("\n该方法没有调试信息\n");
-                                return;
-                            }
-
-                            printDebugInfo(method.codeInfo.debugInfoOff);
-                            foundDebugInfo = true;
-                            break;
-                        }
-                    }
-                }
+        printDebugInfo(dexCode->debug_info_off);
 
-                if (foundDebugInfo)
-                {
-                    break;
-                }
+        // 打印Try/Catch信息
+        if (dexCode->tries_size > 0)
+        {
+            std::shared_ptr<const dex::CodeInfo> codeInfo = context.getTryCatchInfo(context.getMethodCodeOff(methodIdx));
+            if (codeInfo != nullptr)
+            {
+                printTryCatchBlocks(*codeInfo);
             }
         }
 
-        if (!foundDebugInfo)
-        {
-            printf("\n未找到该方法的调试信息\n");
-        }
+        out.flush();
     }
 
     void DebugInfoPrint::printDebugInfo(uint32_t debugInfoOff)
     {
-        const dex::DexContext& context = getContext();
+        OutputSink& out = getSink();
 
-        // 创建调试信息数据结构
-        dex::DebugInfoData debugInfo;
+        const dex::DexContext& context = getContext();
 
-        // 解析调试信息
-        if (!context.parseDebugInfo(debugInfoOff, debugInfo))
+        // 获取共享的调试信息
+        std::shared_ptr<const dex::DebugInfoData> pDebugInfo = context.getDebugInfo(debugInfoOff);
+        if (pDebugInfo == nullptr)
         {
             LOGE("解析调试信息失败: 0x%08X", debugInfoOff);
             return;
         }
+        const dex::DebugInfoData& debugInfo = *pDebugInfo;
 
         // 打印调试信息概览
-        printf("\n调试信息概览:\n");
-        printf("  调试信息偏移量: 0x%08X\n", debugInfo.debugInfoOff);
-        printf("  起始行号: %u\n", debugInfo.lineStart);
+        out.write("\n调试信息概览:\n");
+        out.printf("  调试信息偏移量: 0x%08X\n", debugInfo.debugInfoOff);
+        out.printf("  起始行号: %u\n", debugInfo.lineStart);
 
         // 打印参数名称
         if (debugInfo.parametersSize > 0)
         {
-            printf("\n参数名称(%u):\n", debugInfo.parametersSize);
+            out.printf("\n参数名称(%u):\n", debugInfo.parametersSize);
             for (uint32_t i = 0; i < debugInfo.parameterNames.size(); i++)
             {
                 if (!debugInfo.parameterNames[i].empty())
                 {
-                    printf("  [%u] %s\n", i, debugInfo.parameterNames[i].c_str());
+                    out.printf("  [%u] %s\n", i, debugInfo.parameterNames[i].c_str());
                 }
                 else
                 {
-                    printf("  [%u] <未命名>\n", i);
+                    out.printf("  [%u] <未命名>\n", i);
                 }
             }
         }
@@ -156,14 +106,18 @@ namespace dex::print
         }
 
         // 打印位置信息（行号映射）
-        if (!debugInfo.positions.empty())
+        if (!debugInfo.lines.empty())
         {
-            printPositions(debugInfo.positions);
+            printPositions(debugInfo.lines);
         }
+
+        out.flush();
     }
 
     void DebugInfoPrint::print()
     {
+        OutputSink& out = getSink();
+
         const dex::DexContext& context = getContext();
 
         // 检查是否有效
@@ -173,23 +127,25 @@ namespace dex::print
             return;
         }
 
-        // 获取类数量
-        const uint32_t classCount = context.getClassDefsCount();
+        // 获取类数量（设置了类过滤器时只输出选中的类）
+        const std::span<const uint32_t> selected = context.getSelectedClassDefs();
+        const uint32_t classCount = static_cast<uint32_t>(selected.size());
         if (classCount == 0)
         {
-            printf("没有发现类定义\n");
+            out.write("没有发现类定义\n");
+            out.flush();
             return;
         }
 
-        printf("\n/--------------------------------------------------------------------\\\n");
-        printf("|                       DEX 方法调试信息概览                         |\n");
-        printf("\\--------------------------------------------------------------------/\n");
+        out.write("\n/--------------------------------------------------------------------\\\n");
+        out.write("|                       DEX 方法调试信息概览                         |\n");
+        out.write("\\--------------------------------------------------------------------/\n");
 
         // 遍历所有类
         int methodWithDebugCount = 0;
         for (uint32_t i = 0; i < classCount; i++)
         {
-            dex::ClassDefInfo classInfo = context.getClassDefInfo(i);
+            dex::ClassDefInfo classInfo = context.getClassDefInfo(selected[i]);
 
             if (classInfo.classDataOff != 0 && classInfo.classData.isLoaded)
             {
@@ -198,7 +154,7 @@ namespace dex::print
                 // 检查是否有任何方法具有调试信息
                 for (const auto& method : classInfo.classData.directMethods)
                 {
-                    if (method.codeOff != 0 && method.codeInfo.isLoaded && method.codeInfo.debugInfoOff != 0)
+                    if (method.codeOff != 0 && context.getMethodDebugInfo(method.methodIdx) != nullptr)
                     {
                         hasDebugInfo = true;
                         break;
@@ -209,7 +165,7 @@ namespace dex::print
                 {
                     for (const auto& method : classInfo.classData.virtualMethods)
                     {
-                        if (method.codeOff != 0 && method.codeInfo.isLoaded && method.codeInfo.debugInfoOff != 0)
+                        if (method.codeOff != 0 && context.getMethodDebugInfo(method.methodIdx) != nullptr)
                         {
                             hasDebugInfo = true;
                             break;
@@ -220,132 +176,161 @@ namespace dex::print
                 // 如果有调试信息，才打印类信息
                 if (hasDebugInfo)
                 {
-                    printf("\n类: %s\n", classInfo.className.c_str());
-                    printf("===========================================================\n");
+                    out.printf("\n类: %s\n", classInfo.className.c_str());
+                    out.write("===========================================================\n");
 
                     // 打印直接方法的调试信息
                     for (const auto& method : classInfo.classData.directMethods)
                     {
-                        if (method.codeOff != 0 && method.codeInfo.isLoaded && method.codeInfo.debugInfoOff != 0)
+                        // 持有共享指针，缓存按预算淘汰该条目时数据仍然有效
+                        const std::shared_ptr<const dex::DebugInfoData> debugInfo =
+                            method.codeOff != 0 ? context.getMethodDebugInfo(method.methodIdx) : nullptr;
+                        if (debugInfo != nullptr)
                         {
                             dex::MethodInfo methodInfo = context.getMethodInfo(method.methodIdx);
                             std::string signature = formatMethodSignature(methodInfo);
 
-                            printf("\n[%d] 方法: %s (直接方法)\n", ++methodWithDebugCount, signature.c_str());
+                            out.printf("\n[%d] 方法: %s (直接方法)\n", ++methodWithDebugCount, signature.c_str());
 
                             // 打印调试信息概览
-                            const dex::DebugInfoData& debugInfo = method.codeInfo.debugInfo;
-                            printf("  调试信息偏移量: 0x%08X\n", debugInfo.debugInfoOff);
-                            printf("  起始行号: %u\n", debugInfo.lineStart);
-                            printf("  局部变量数量: %zu\n", debugInfo.localVars.size());
-                            printf("  位置映射数量: %zu\n", debugInfo.positions.size());
+                            out.printf("  调试信息偏移量: 0x%08X\n", debugInfo->debugInfoOff);
+                            out.printf("  起始行号: %u\n", debugInfo->lineStart);
+                            out.printf("  局部变量数量: %zu\n", debugInfo->localVars.size());
+                            out.printf("  位置映射数量: %zu\n", debugInfo->lines.size());
 
-                            printf("---------------------------------------------------------\n");
+                            out.write("---------------------------------------------------------\n");
                         }
                     }
 
                     // 打印虚拟方法的调试信息
                     for (const auto& method : classInfo.classData.virtualMethods)
                     {
-                        if (method.codeOff != 0 && method.codeInfo.isLoaded && method.codeInfo.debugInfoOff != 0)
+                        // 持有共享指针，缓存按预算淘汰该条目时数据仍然有效
+                        const std::shared_ptr<const dex::DebugInfoData> debugInfo =
+                            method.codeOff != 0 ? context.getMethodDebugInfo(method.methodIdx) : nullptr;
+                        if (debugInfo != nullptr)
                         {
                             dex::MethodInfo methodInfo = context.getMethodInfo(method.methodIdx);
                             std::string signature = formatMethodSignature(methodInfo);
 
-                            printf("\n[%d] 方法: %s (虚拟方法)\n", ++methodWithDebugCount, signature.c_str());
+                            out.printf("\n[%d] 方法: %s (虚拟方法)\n", ++methodWithDebugCount, signature.c_str());
 
                             // 打印调试信息概览
-                            const dex::DebugInfoData& debugInfo = method.codeInfo.debugInfo;
-                            printf("  调试信息偏移量: 0x%08X\n", debugInfo.debugInfoOff);
-                            printf("  起始行号: %u\n", debugInfo.lineStart);
-                            printf("  局部变量数量: %zu\n", debugInfo.localVars.size());
-                            printf("  位置映射数量: %zu\n", debugInfo.positions.size());
+                            out.printf("  调试信息偏移量: 0x%08X\n", debugInfo->debugInfoOff);
+                            out.printf("  起始行号: %u\n", debugInfo->lineStart);
+                            out.printf("  局部变量数量: %zu\n", debugInfo->localVars.size());
+                            out.printf("  位置映射数量: %zu\n", debugInfo->lines.size());
 
-                            printf("---------------------------------------------------------\n");
+                            out.write("---------------------------------------------------------\n");
                         }
                     }
                 }
             }
+
+            // 逐类顺序输出，上一个类的数据已复制出来，这里可以按预算淘汰冷缓存
+            context.trimCaches();
         }
 
-        printf("\n总计: %d 个方法含有调试信息\n", methodWithDebugCount);
+        out.printf("\n总计: %d 个方法含有调试信息\n", methodWithDebugCount);
+
+        out.flush();
     }
 
     void DebugInfoPrint::printLocalVariables(const std::vector<dex::LocalVarInfo>& localVars)
     {
+        OutputSink& out = getSink();
+
         if (localVars.empty())
         {
             return;
         }
 
-        printf("\n局部变量信息(%zu):\n", localVars.size());
-        printf("+------+------------------+------------------+------------------+\n");
-        printf("| %-4s | %-16s | %-16s | %-16s |\n", "寄存器", "变量名", "类型", "类型签名");
-        printf("+------+------------------+------------------+------------------+\n");
+        out.printf("\n局部变量信息(%zu):\n", localVars.size());
+        out.write("+------+------------------+------------------+------------------+\n");
+        out.printf("| %-4s | %-16s | %-16s | %-16s |\n", "寄存器", "变量名", "类型", "类型签名");
+        out.write("+------+------------------+------------------+------------------+\n");
 
         for (const auto& var : localVars)
         {
-            printf("| v%-4u | %-16s | %-16s | %-16s |\n",
-                   var.registerNum,
-                   var.name.empty() ? "<未命名>" : var.name.c_str(),
-                   var.type.empty() ? "<未知>" : simplifyTypeName(var.type).c_str(),
-                   var.signature.empty() ? "-" : var.signature.c_str());
+            out.write("| v");
+            out.writeDec(var.registerNum, -4);
+            out.write(" | ");
+            out.writePadded(var.name.empty() ? "<未命名>" : var.name, 16);
+            out.write(" | ");
+            out.writePadded(var.type.empty() ? "<未知>" : simplifyTypeName(var.type), 16);
+            out.write(" | ");
+            out.writePadded(var.signature.empty() ? "-" : var.signature, 16);
+            out.write(" |\n");
         }
 
-        printf("+------+------------------+------------------+------------------+\n");
+        out.write("+------+------------------+------------------+------------------+\n");
     }
 
-    void DebugInfoPrint::printPositions(const std::vector<dex::PositionInfo>& positions)
+    void DebugInfoPrint::printPositions(const dex::LineTable& lines)
     {
-        if (positions.empty())
+        OutputSink& out = getSink();
+
+        if (lines.empty())
         {
             return;
         }
 
-        printf("\n位置信息(%zu):\n", positions.size());
-        printf("+--------+--------+\n");
-        printf("| %-6s | %-6s |\n", "地址", "行号");
-        printf("+--------+--------+\n");
+        std::vector<dex::PositionInfo> positions = lines.decode();
+
+        out.printf("\n位置信息(%zu):\n", positions.size());
+        out.write("+--------+--------+\n");
+        out.printf("| %-6s | %-6s |\n", "地址", "行号");
+        out.write("+--------+--------+\n");
 
         for (const auto& pos : positions)
         {
-            printf("| 0x%04X | %-6u |\n", pos.address, pos.lineNum);
+            out.write("| 0x");
+            out.writeHex(pos.address, 4);
+            out.write(" | ");
+            out.writeDec(pos.lineNum, -6);
+            out.write(" |\n");
         }
 
-        printf("+--------+--------+\n");
+        out.write("+--------+--------+\n");
     }
 
-    void DebugInfoPrint::printTryCatchBlocks(const std::vector<dex::TryBlockInfo>& tries)
+    void DebugInfoPrint::printTryCatchBlocks(const dex::CodeInfo& codeInfo)
     {
+        OutputSink& out = getSink();
+
+        const dex::DexContext& context = getContext();
+        const auto& tries = codeInfo.tries;
         if (tries.empty())
         {
             return;
         }
 
-        printf("\nTry/Catch块(%zu):\n", tries.size());
+        out.printf("\nTry/Catch块(%zu):\n", tries.size());
 
         for (size_t i = 0; i < tries.size(); i++)
         {
             const auto& tryBlock = tries[i];
+            const auto& handler = codeInfo.handlers[tryBlock.handlerIdx];
 
-            printf("\n[%zu] Try块: 0x%04X - 0x%04X (长度: %u)\n",
+            out.printf("\n[%zu] Try块: 0x%04X - 0x%04X (长度: %u)\n",
                    i, tryBlock.startAddr, tryBlock.startAddr + tryBlock.insnCount - 1, tryBlock.insnCount);
 
-            if (!tryBlock.catches.empty())
+            if (!handler.catches.empty())
             {
-                printf("  Catch处理器:\n");
-                for (const auto& catchInfo : tryBlock.catches)
+                out.write("  Catch处理器:\n");
+                for (const auto& catchInfo : handler.catches)
                 {
-                    printf("    类型: %-30s  处理器地址: 0x%04X\n",
-                           catchInfo.typeName.empty() ? "<未知>" : simplifyTypeName(catchInfo.typeName).c_str(),
+                    std::string typeName = catchInfo.typeIdx < context.getTypeIdsCount() ? context.getType(catchInfo.typeIdx) : "";
+                    out.printf("    类型: %-30s  处理器地址: 0x%04X\n",
+                           typeName.empty() ? "<未知>" : simplifyTypeName(typeName).c_str(),
                            catchInfo.address);
                 }
             }
 
-            if (tryBlock.hasCatchAll)
+            if (handler.hasCatchAll)
             {
-                printf("  Catch-All处理器: 0x%04X\n", tryBlock.catchAllAddr);
+                out.printf("  Catch-All处理器: 0x%04X\n", handler.catchAllAddr);
             }
         }
     }
-}
\ No newline at end of file
+}
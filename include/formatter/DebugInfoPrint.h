@@ -52,15 +52,15 @@ namespace dex::print
 
         /**
          * 打印位置信息
-         * @param positions 位置列表
+         * @param lines 行号表
          */
-        void printPositions(const std::vector<dex::PositionInfo>& positions);
+        void printPositions(const dex::LineTable& lines);
 
         /**
          * 打印Try/Catch信息
-         * @param tries Try块列表
+         * @param codeInfo 代码信息（try块列表和处理器表）
          */
-        void printTryCatchBlocks(const std::vector<dex::TryBlockInfo>& tries);
+        void printTryCatchBlocks(const dex::CodeInfo& codeInfo);
     };
 }
 
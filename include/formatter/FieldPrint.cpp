@@ -6,12 +6,37 @@
 #include <cstdio>
 #include <cstring>
 #include <string>
+#include <vector>
 #include "log/log.h"
 
 namespace dex::print
 {
+    FieldPrint::FieldPrint(bool showAccessCounts) : showAccessCounts_(showAccessCounts)
+    {
+    }
+
+    void FieldPrint::printTableHeader() const
+    {
+        OutputSink& out = getSink();
+
+        if (showAccessCounts_)
+        {
+            out.write("+------+----------------+----------------+----------------+------+------+\n");
+            out.printf("| %-4s | %-14s | %-14s | %-14s | %-4s | %-4s |\n", "索引", "类名", "类型", "名称", "读取", "写入");
+            out.write("+------+----------------+----------------+----------------+------+------+\n");
+        }
+        else
+        {
+            out.write("+------+----------------+----------------+----------------+\n");
+            out.printf("| %-4s | %-14s | %-14s | %-14s |\n", "索引", "类名", "类型", "名称");
+            out.write("+------+----------------+----------------+----------------+\n");
+        }
+    }
+
     void FieldPrint::print()
     {
+        OutputSink& out = getSink();
+
         // 获取上下文
         const dex::DexContext& context = getContext();
         
@@ -22,23 +47,41 @@ namespace dex::print
             return;
         }
         
-        // 获取Field数量
-        const uint32_t fieldCount = context.getFieldIdsCount();
+        // 获取要输出的Field（设置了类过滤器时只输出选中的类的字段）
+        std::vector<uint32_t> fieldIdxs;
+        const std::span<const DexFieldId> fieldIds = context.getFieldIds();
+        fieldIdxs.reserve(fieldIds.size());
+        for (uint32_t i = 0; i < fieldIds.size(); i++)
+        {
+            if (context.isTypeSelected(fieldIds[i].classIdx))
+            {
+                fieldIdxs.push_back(i);
+            }
+        }
+        const uint32_t fieldCount = static_cast<uint32_t>(fieldIdxs.size());
         if (fieldCount == 0)
         {
-            printf("Field表为空\n");
+            out.write("Field表为空\n");
+            out.flush();
             return;
         }
         
-        printf("\n/----------------------------------------------------------\\\n");
-        printf("|                     DEX Field Table                     |\n");
-        printf("+------+----------------+----------------+----------------+\n");
-        printf("| %-4s | %-14s | %-14s | %-14s |\n", "索引", "类名", "类型", "名称");
-        printf("+------+----------------+----------------+----------------+\n");
+        // 读写数量来自一次性构建的交叉引用索引，打印时无需再次扫描代码
+        if (showAccessCounts_ && !context.buildFieldXrefs())
+        {
+            LOGW("构建字段交叉引用失败，不显示读写数量");
+            showAccessCounts_ = false;
+        }
+
+        out.write("\n/----------------------------------------------------------\\\n");
+        out.write("|                     DEX Field Table                     |\n");
+        printTableHeader();
         
         // 打印Field表
-        for (uint32_t i = 0; i < fieldCount; i++)
+        for (uint32_t row = 0; row < fieldCount; row++)
         {
+            const uint32_t i = fieldIdxs[row];
+
             // 获取Field信息
             dex::FieldInfo fieldInfo = context.getFieldInfo(i);
             
@@ -74,20 +117,41 @@ namespace dex::print
             }
             
             // 打印行
-            printf("| %4u | %-14s | %-14s | %-14s |\n", 
-                i, className.c_str(), typeName.c_str(), fieldName.c_str());
+            out.write("| ");
+            out.writeDec(i, 4);
+            out.write(" | ");
+            out.writePadded(className, 14);
+            out.write(" | ");
+            out.writePadded(typeName, 14);
+            out.write(" | ");
+            out.writePadded(fieldName, 14);
+            if (showAccessCounts_)
+            {
+                out.write(" | ");
+                out.writeDec(context.getFieldReaderCount(i), 4);
+                out.write(" | ");
+                out.writeDec(context.getFieldWriterCount(i), 4);
+            }
+            out.write(" |\n");
             
             // 每20行打印一次表头
-            if ((i + 1) % 20 == 0 && i + 1 < fieldCount)
+            if ((row + 1) % 20 == 0 && row + 1 < fieldCount)
             {
-                printf("+------+----------------+----------------+----------------+\n");
-                printf("| %-4s | %-14s | %-14s | %-14s |\n", "索引", "类名", "类型", "名称");
-                printf("+------+----------------+----------------+----------------+\n");
+                printTableHeader();
             }
         }
         
-        printf("+------+----------------+----------------+----------------+\n");
-        printf("| 共计: %-42u |\n", fieldCount);
-        printf("\\----------------------------------------------------------/\n");
+        if (showAccessCounts_)
+        {
+            out.write("+------+----------------+----------------+----------------+------+------+\n");
+        }
+        else
+        {
+            out.write("+------+----------------+----------------+----------------+\n");
+        }
+        out.printf("| 共计: %-42u |\n", fieldCount);
+        out.write("\\----------------------------------------------------------/\n");
+
+        out.flush();
     }
 } 
\ No newline at end of file
@@ -19,6 +19,12 @@ namespace dex::print
          * 构造函数
          */
         FieldPrint() = default;
+
+        /**
+         * 构造函数
+         * @param showAccessCounts 是否标注每个字段的读取/写入方法数量（使用字段交叉引用索引）
+         */
+        explicit FieldPrint(bool showAccessCounts);
         
         /**
          * 析构函数
@@ -29,6 +35,13 @@ namespace dex::print
          * 打印Field表
          */
         void print() override;
+
+    private:
+        // 打印表头
+        void printTableHeader() const;
+
+        // 是否标注读写数量
+        bool showAccessCounts_ = false;
     };
 }
 
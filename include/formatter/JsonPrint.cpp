@@ -0,0 +1,467 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "JsonPrint.h"
+
+#include <cstddef>
+#include "log/log.h"
+
+namespace dex::print
+{
+    namespace
+    {
+        // 按类定义顺序遍历选中的类中所有有代码的方法（先直接方法，后虚拟方法）
+        template <typename Fn>
+        void forEachMethodWithCode(const DexContext& context, Fn&& fn)
+        {
+            for (const uint32_t classDefIdx : context.getSelectedClassDefs())
+            {
+                const ClassDefInfo classInfo = context.getClassDefInfo(classDefIdx);
+                if (classInfo.classDataOff == 0 || !classInfo.classData.isLoaded)
+                {
+                    continue;
+                }
+                for (const auto& method : classInfo.classData.directMethods)
+                {
+                    if (method.codeOff != 0)
+                    {
+                        fn(method.methodIdx, method.codeOff);
+                    }
+                }
+                for (const auto& method : classInfo.classData.virtualMethods)
+                {
+                    if (method.codeOff != 0)
+                    {
+                        fn(method.methodIdx, method.codeOff);
+                    }
+                }
+
+                // 逐类顺序输出，类信息已复制出来，这里可以按预算淘汰冷缓存
+                context.trimCaches();
+            }
+        }
+
+        // 写入类数据中的字段列表
+        void writeFields(JsonWriter& json, std::string_view key,
+                         const std::vector<ClassDefInfo::ClassDataInfo::EncodedFieldInfo>& fields)
+        {
+            json.beginArray(key);
+            for (const auto& field : fields)
+            {
+                json.beginObject();
+                json.field("fieldIdx", field.fieldIdx);
+                json.field("accessFlags", field.accessFlags);
+                json.endObject();
+            }
+            json.endArray();
+        }
+
+        // 写入类数据中的方法列表
+        void writeMethods(JsonWriter& json, std::string_view key,
+                          const std::vector<ClassDefInfo::ClassDataInfo::EncodedMethodInfo>& methods)
+        {
+            json.beginArray(key);
+            for (const auto& method : methods)
+            {
+                json.beginObject();
+                json.field("methodIdx", method.methodIdx);
+                json.field("accessFlags", method.accessFlags);
+                json.field("codeOff", method.codeOff);
+                json.endObject();
+            }
+            json.endArray();
+        }
+    }
+
+    void JsonPrint::stringField(JsonWriter& json, std::string_view key, uint32_t stringIdx)
+    {
+        const DexContext& context = getContext();
+        json.key(key);
+        if (stringIdx < context.getStringIdsCount())
+        {
+            json.mutf8(context.getStringData(stringIdx));
+        }
+        else
+        {
+            json.null();
+        }
+    }
+
+    void JsonPrint::typeValue(JsonWriter& json, uint32_t typeIdx)
+    {
+        const DexContext& context = getContext();
+        if (typeIdx < context.getTypeIdsCount())
+        {
+            json.mutf8(context.getStringData(context.getTypeIds()[typeIdx].descriptor_idx));
+        }
+        else
+        {
+            json.null();
+        }
+    }
+
+    void JsonPrint::typeField(JsonWriter& json, std::string_view key, uint32_t typeIdx)
+    {
+        json.key(key);
+        typeValue(json, typeIdx);
+    }
+
+    void JsonPrint::print()
+    {
+        if (!getContext().isValid())
+        {
+            LOGE("DEX解析未完成或无效，无法输出JSON");
+            return;
+        }
+
+        printHeader();
+        printStrings();
+        printTypes();
+        printProtos();
+        printFields();
+        printMethods();
+        printClasses();
+        printCode();
+        printDebugInfo();
+    }
+
+    void JsonPrint::printHeader()
+    {
+        OutputSink& out = getSink();
+        JsonWriter json(out);
+
+        const DexHeader& header = getContext().getHeader();
+
+        json.beginObject();
+        json.field("kind", "header");
+        json.field("magic", std::string_view(reinterpret_cast<const char*>(header.magic), 3));
+        json.field("version", std::string_view(reinterpret_cast<const char*>(header.magic) + 4, 3));
+        json.field("checksum", header.checksum);
+
+        // 签名以十六进制字符串输出
+        char signature[kSHA1DigestLen * 2];
+        for (int i = 0; i < kSHA1DigestLen; i++)
+        {
+            signature[i * 2] = "0123456789abcdef"[header.signature[i] >> 4];
+            signature[i * 2 + 1] = "0123456789abcdef"[header.signature[i] & 0xF];
+        }
+        json.field("signature", std::string_view(signature, sizeof(signature)));
+
+        json.field("fileSize", header.fileSize);
+        json.field("headerSize", header.headerSize);
+        json.field("endianTag", header.endianTag);
+        json.field("linkSize", header.linkSize);
+        json.field("linkOff", header.linkOff);
+        json.field("mapOff", header.mapOff);
+        json.field("stringIdsSize", header.stringIdsSize);
+        json.field("stringIdsOff", header.stringIdsOff);
+        json.field("typeIdsSize", header.typeIdsSize);
+        json.field("typeIdsOff", header.typeIdsOff);
+        json.field("protoIdsSize", header.protoIdsSize);
+        json.field("protoIdsOff", header.protoIdsOff);
+        json.field("fieldIdsSize", header.fieldIdsSize);
+        json.field("fieldIdsOff", header.fieldIdsOff);
+        json.field("methodIdsSize", header.methodIdsSize);
+        json.field("methodIdsOff", header.methodIdsOff);
+        json.field("classDefsSize", header.classDefsSize);
+        json.field("classDefsOff", header.classDefsOff);
+        json.field("dataSize", header.dataSize);
+        json.field("dataOff", header.dataOff);
+        json.endObject();
+
+        out.flush();
+    }
+
+    void JsonPrint::printStrings()
+    {
+        OutputSink& out = getSink();
+        JsonWriter json(out);
+
+        const DexContext& context = getContext();
+        std::span<const DexStringId> stringIds = context.getStringIds();
+        for (uint32_t i = 0; i < stringIds.size(); i++)
+        {
+            json.beginObject();
+            json.field("kind", "string");
+            json.field("index", i);
+            json.field("offset", stringIds[i].stringDataOff);
+            json.key("value");
+            json.mutf8(context.getStringData(i));
+            json.endObject();
+        }
+
+        out.flush();
+    }
+
+    void JsonPrint::printTypes()
+    {
+        OutputSink& out = getSink();
+        JsonWriter json(out);
+
+        const DexContext& context = getContext();
+        std::span<const DexTypeId> typeIds = context.getTypeIds();
+        for (uint32_t i = 0; i < typeIds.size(); i++)
+        {
+            json.beginObject();
+            json.field("kind", "type");
+            json.field("index", i);
+            json.field("descriptorIdx", typeIds[i].descriptor_idx);
+            stringField(json, "descriptor", typeIds[i].descriptor_idx);
+            json.endObject();
+        }
+
+        out.flush();
+    }
+
+    void JsonPrint::printProtos()
+    {
+        OutputSink& out = getSink();
+        JsonWriter json(out);
+
+        const DexContext& context = getContext();
+        std::span<const DexProtoId> protoIds = context.getProtoIds();
+        for (uint32_t i = 0; i < protoIds.size(); i++)
+        {
+            json.beginObject();
+            json.field("kind", "proto");
+            json.field("index", i);
+            stringField(json, "shorty", protoIds[i].shorty_idx);
+            typeField(json, "returnType", protoIds[i].return_type_idx);
+            json.beginArray("parameters");
+            if (const TypeListData* parameters = context.getProtoParameters(i))
+            {
+                for (const DexTypeItem& item : parameters->items)
+                {
+                    typeValue(json, item.typeIdx);
+                }
+            }
+            json.endArray();
+            json.endObject();
+        }
+
+        out.flush();
+    }
+
+    void JsonPrint::printFields()
+    {
+        OutputSink& out = getSink();
+        JsonWriter json(out);
+
+        const DexContext& context = getContext();
+        std::span<const DexFieldId> fieldIds = context.getFieldIds();
+        for (uint32_t i = 0; i < fieldIds.size(); i++)
+        {
+            if (!context.isTypeSelected(fieldIds[i].classIdx))
+            {
+                continue;
+            }
+
+            json.beginObject();
+            json.field("kind", "field");
+            json.field("index", i);
+            typeField(json, "class", fieldIds[i].classIdx);
+            typeField(json, "type", fieldIds[i].typeIdx);
+            stringField(json, "name", fieldIds[i].nameIdx);
+            json.endObject();
+        }
+
+        out.flush();
+    }
+
+    void JsonPrint::printMethods()
+    {
+        OutputSink& out = getSink();
+        JsonWriter json(out);
+
+        const DexContext& context = getContext();
+        std::span<const DexMethodId> methodIds = context.getMethodIds();
+        std::span<const DexProtoId> protoIds = context.getProtoIds();
+        for (uint32_t i = 0; i < methodIds.size(); i++)
+        {
+            const DexMethodId& methodId = methodIds[i];
+            if (!context.isTypeSelected(methodId.classIdx))
+            {
+                continue;
+            }
+
+            json.beginObject();
+            json.field("kind", "method");
+            json.field("index", i);
+            typeField(json, "class", methodId.classIdx);
+            stringField(json, "name", methodId.nameIdx);
+            json.field("protoIdx", methodId.protoIdx);
+            if (methodId.protoIdx < protoIds.size())
+            {
+                typeField(json, "returnType", protoIds[methodId.protoIdx].return_type_idx);
+                json.beginArray("parameters");
+                if (const TypeListData* parameters = context.getProtoParameters(methodId.protoIdx))
+                {
+                    for (const DexTypeItem& item : parameters->items)
+                    {
+                        typeValue(json, item.typeIdx);
+                    }
+                }
+                json.endArray();
+            }
+            json.endObject();
+        }
+
+        out.flush();
+    }
+
+    void JsonPrint::printClasses()
+    {
+        OutputSink& out = getSink();
+        JsonWriter json(out);
+
+        const DexContext& context = getContext();
+        for (const uint32_t i : context.getSelectedClassDefs())
+        {
+            const ClassDefInfo classInfo = context.getClassDefInfo(i);
+
+            json.beginObject();
+            json.field("kind", "class");
+            json.field("index", i);
+            typeField(json, "name", classInfo.classIdx);
+            json.field("accessFlags", classInfo.accessFlags);
+            typeField(json, "superclass", classInfo.superclassIdx);
+            stringField(json, "sourceFile", classInfo.sourceFileIdx);
+
+            json.beginArray("interfaces");
+            if (classInfo.interfacesOff != 0)
+            {
+                if (const TypeListData* interfaces = context.parseTypeList(classInfo.interfacesOff))
+                {
+                    for (const DexTypeItem& item : interfaces->items)
+                    {
+                        typeValue(json, item.typeIdx);
+                    }
+                }
+            }
+            json.endArray();
+
+            json.field("classDataOff", classInfo.classDataOff);
+            if (classInfo.classDataOff != 0 && classInfo.classData.isLoaded)
+            {
+                writeFields(json, "staticFields", classInfo.classData.staticFields);
+                writeFields(json, "instanceFields", classInfo.classData.instanceFields);
+                writeMethods(json, "directMethods", classInfo.classData.directMethods);
+                writeMethods(json, "virtualMethods", classInfo.classData.virtualMethods);
+            }
+            json.endObject();
+        }
+
+        out.flush();
+    }
+
+    void JsonPrint::printCode()
+    {
+        OutputSink& out = getSink();
+        JsonWriter json(out);
+
+        const DexContext& context = getContext();
+        parser::CodeParser codeParser(context.getFileData(), context.getFileSize());
+        forEachMethodWithCode(context, [&](uint32_t methodIdx, uint32_t codeOff)
+        {
+            printMethodCode(json, codeParser, methodIdx, codeOff);
+        });
+
+        out.flush();
+    }
+
+    void JsonPrint::printMethodCode(JsonWriter& json, parser::CodeParser& codeParser, uint32_t methodIdx, uint32_t codeOff)
+    {
+        const parser::CodeSectionInfo codeInfo = codeParser.parseCode(codeOff);
+
+        json.beginObject();
+        json.field("kind", "code");
+        json.field("methodIdx", methodIdx);
+        json.field("codeOff", codeOff);
+        json.field("registers", codeInfo.registersSize);
+        json.field("ins", codeInfo.insSize);
+        json.field("outs", codeInfo.outsSize);
+        json.field("tries", codeInfo.triesSize);
+        json.field("debugInfoOff", codeInfo.debugInfoOff);
+        json.field("insnsSize", codeInfo.insnsSize);
+        json.beginArray("instructions");
+        for (const parser::InstructionInfo& instruction : codeInfo.instructions)
+        {
+            json.beginObject();
+            json.field("offset", instruction.offset);
+            json.field("length", instruction.length);
+            json.field("opcode", instruction.opcode);
+            json.field("mnemonic", instruction.mnemonic);
+            json.field("operands", codeInfo.operands(instruction));
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+    }
+
+    void JsonPrint::printDebugInfo()
+    {
+        OutputSink& out = getSink();
+        JsonWriter json(out);
+
+        forEachMethodWithCode(getContext(), [&](uint32_t methodIdx, uint32_t codeOff)
+        {
+            printMethodDebugInfo(json, methodIdx, codeOff);
+        });
+
+        out.flush();
+    }
+
+    void JsonPrint::printMethodDebugInfo(JsonWriter& json, uint32_t methodIdx, uint32_t codeOff)
+    {
+        const DexContext& context = getContext();
+        const DexCode* dexCode = context.getCodeItem(codeOff);
+        if (dexCode == nullptr || dexCode->debug_info_off == 0)
+        {
+            return;
+        }
+
+        std::shared_ptr<const DebugInfoData> debugInfo = context.getDebugInfo(dexCode->debug_info_off);
+        if (debugInfo == nullptr)
+        {
+            return;
+        }
+
+        json.beginObject();
+        json.field("kind", "debug");
+        json.field("methodIdx", methodIdx);
+        json.field("debugInfoOff", debugInfo->debugInfoOff);
+        json.field("lineStart", debugInfo->lineStart);
+
+        json.beginArray("parameterNames");
+        for (const std::string& name : debugInfo->parameterNames)
+        {
+            json.string(name);
+        }
+        json.endArray();
+
+        // 位置以[地址, 行号]数组输出
+        json.beginArray("positions");
+        for (const PositionInfo& position : debugInfo->lines.decode())
+        {
+            json.beginArray();
+            json.value(static_cast<uint64_t>(position.address));
+            json.value(static_cast<uint64_t>(position.lineNum));
+            json.endArray();
+        }
+        json.endArray();
+
+        json.beginArray("locals");
+        for (const LocalVarInfo& local : debugInfo->localVars)
+        {
+            json.beginObject();
+            json.field("register", local.registerNum);
+            stringField(json, "name", local.nameIdx);
+            typeField(json, "type", local.typeIdx);
+            stringField(json, "signature", local.sigIdx);
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+    }
+}
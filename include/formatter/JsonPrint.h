@@ -0,0 +1,83 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef JSONPRINT_H
+#define JSONPRINT_H
+
+#include "BasePrint.h"
+#include "JsonWriter.h"
+#include "parser/CodeParser.h"
+
+namespace dex::print
+{
+    /**
+     * JSON Lines格式输出类
+     * 每条记录一行，通过"kind"字段区分记录类型：
+     * header、string、type、proto、field、method、class、code、debug。
+     * 字符串不截断，直接从文件中的MUTF-8数据转义输出；记录逐条写入输出目标，不在内存中累积。
+     */
+    class JsonPrint final : public BasePrint
+    {
+    public:
+        /**
+         * 构造函数
+         */
+        JsonPrint() = default;
+
+        /**
+         * 析构函数
+         */
+        ~JsonPrint() override = default;
+
+        /**
+         * 按顺序输出全部记录
+         */
+        void print() override;
+
+        // 输出头部记录
+        void printHeader();
+
+        // 输出字符串记录
+        void printStrings();
+
+        // 输出类型记录
+        void printTypes();
+
+        // 输出原型记录
+        void printProtos();
+
+        // 输出字段记录
+        void printFields();
+
+        // 输出方法记录
+        void printMethods();
+
+        // 输出类记录（包含class_data中的字段和方法）
+        void printClasses();
+
+        // 输出代码记录（每个有代码的方法一条，包含指令列表）
+        void printCode();
+
+        // 输出调试信息记录（每个有调试信息的方法一条）
+        void printDebugInfo();
+
+    private:
+        // 写入键和字符串表中的字符串，索引无效时写入null
+        static void stringField(JsonWriter& json, std::string_view key, uint32_t stringIdx);
+
+        // 写入键和类型描述符，索引无效时写入null
+        static void typeField(JsonWriter& json, std::string_view key, uint32_t typeIdx);
+
+        // 写入类型描述符（数组元素）
+        static void typeValue(JsonWriter& json, uint32_t typeIdx);
+
+        // 输出一个方法的代码记录
+        void printMethodCode(JsonWriter& json, parser::CodeParser& codeParser, uint32_t methodIdx, uint32_t codeOff);
+
+        // 输出一个方法的调试信息记录
+        void printMethodDebugInfo(JsonWriter& json, uint32_t methodIdx, uint32_t codeOff);
+    };
+}
+
+#endif //JSONPRINT_H
@@ -0,0 +1,346 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "JsonWriter.h"
+
+#include <bit>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DEX_JSON_SSE2 1
+#endif
+
+namespace dex::print
+{
+    namespace
+    {
+        constexpr char kHexDigits[] = "0123456789abcdef";
+    }
+
+    JsonWriter::JsonWriter(OutputSink& out)
+        : out_(out)
+    {
+    }
+
+    void JsonWriter::separate()
+    {
+        if (afterKey_)
+        {
+            afterKey_ = false;
+            return;
+        }
+        if (depth_ > 0 && depth_ <= kMaxDepth)
+        {
+            if (hasElement_[depth_ - 1])
+            {
+                out_.put(',');
+            }
+            hasElement_[depth_ - 1] = true;
+        }
+    }
+
+    void JsonWriter::beginObject()
+    {
+        separate();
+        out_.put('{');
+        if (depth_ < kMaxDepth)
+        {
+            hasElement_[depth_] = false;
+        }
+        depth_++;
+    }
+
+    void JsonWriter::beginObject(std::string_view name)
+    {
+        key(name);
+        beginObject();
+    }
+
+    void JsonWriter::endObject()
+    {
+        depth_--;
+        out_.put('}');
+        if (depth_ == 0)
+        {
+            out_.put('\n');
+        }
+    }
+
+    void JsonWriter::beginArray()
+    {
+        separate();
+        out_.put('[');
+        if (depth_ < kMaxDepth)
+        {
+            hasElement_[depth_] = false;
+        }
+        depth_++;
+    }
+
+    void JsonWriter::beginArray(std::string_view name)
+    {
+        key(name);
+        beginArray();
+    }
+
+    void JsonWriter::endArray()
+    {
+        depth_--;
+        out_.put(']');
+    }
+
+    void JsonWriter::key(std::string_view name)
+    {
+        separate();
+        out_.put('"');
+        out_.write(name);
+        out_.write("\":");
+        afterKey_ = true;
+    }
+
+    void JsonWriter::value(uint64_t number)
+    {
+        separate();
+        out_.writeDec(number);
+    }
+
+    void JsonWriter::valueSigned(int64_t number)
+    {
+        separate();
+        out_.writeSigned(number);
+    }
+
+    void JsonWriter::valueDouble(double number)
+    {
+        separate();
+        if (!std::isfinite(number))
+        {
+            out_.write("null");
+            return;
+        }
+        out_.printf("%.9g", number);
+    }
+
+    void JsonWriter::value(bool flag)
+    {
+        separate();
+        out_.write(flag ? "true" : "false");
+    }
+
+    void JsonWriter::null()
+    {
+        separate();
+        out_.write("null");
+    }
+
+    size_t JsonWriter::scanPlain(const char* data, size_t size)
+    {
+        size_t i = 0;
+
+#if defined(DEX_JSON_SSE2)
+        // 有符号比较小于0x20同时命中控制字符和0x80以上的字节
+        const __m128i space = _mm_set1_epi8(0x20);
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const __m128i special = _mm_or_si128(_mm_cmplt_epi8(chunk, space),
+                                                 _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                                              _mm_cmpeq_epi8(chunk, backslash)));
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return i + std::countr_zero(mask);
+            }
+        }
+#endif
+
+        for (; i < size; i++)
+        {
+            const unsigned char c = static_cast<unsigned char>(data[i]);
+            if (c < 0x20 || c >= 0x80 || c == '"' || c == '\\')
+            {
+                break;
+            }
+        }
+        return i;
+    }
+
+    void JsonWriter::escapeAscii(unsigned char c)
+    {
+        switch (c)
+        {
+            case '"': out_.write("\\\""); break;
+            case '\\': out_.write("\\\\"); break;
+            case '\n': out_.write("\\n"); break;
+            case '\r': out_.write("\\r"); break;
+            case '\t': out_.write("\\t"); break;
+            case '\b': out_.write("\\b"); break;
+            case '\f': out_.write("\\f"); break;
+            default:
+                if (c < 0x20)
+                {
+                    escapeUnit(c);
+                }
+                else
+                {
+                    out_.put(static_cast<char>(c));
+                }
+                break;
+        }
+    }
+
+    void JsonWriter::escapeUnit(uint32_t unit)
+    {
+        const char text[6] = {
+            '\\', 'u',
+            kHexDigits[(unit >> 12) & 0xF], kHexDigits[(unit >> 8) & 0xF],
+            kHexDigits[(unit >> 4) & 0xF], kHexDigits[unit & 0xF],
+        };
+        out_.write(std::string_view(text, sizeof(text)));
+    }
+
+    size_t JsonWriter::utf8SequenceLength(const unsigned char* data, size_t size)
+    {
+        const unsigned char c = data[0];
+        size_t length;
+        unsigned char min = 0x80;
+        unsigned char max = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF)
+        {
+            length = 2;
+        }
+        else if (c >= 0xE0 && c <= 0xEF)
+        {
+            // 排除非最短编码和代理码点
+            length = 3;
+            min = c == 0xE0 ? 0xA0 : 0x80;
+            max = c == 0xED ? 0x9F : 0xBF;
+        }
+        else if (c >= 0xF0 && c <= 0xF4)
+        {
+            length = 4;
+            min = c == 0xF0 ? 0x90 : 0x80;
+            max = c == 0xF4 ? 0x8F : 0xBF;
+        }
+        else
+        {
+            return 0;
+        }
+
+        if (size < length || data[1] < min || data[1] > max)
+        {
+            return 0;
+        }
+        for (size_t i = 2; i < length; i++)
+        {
+            if ((data[i] & 0xC0) != 0x80)
+            {
+                return 0;
+            }
+        }
+        return length;
+    }
+
+    void JsonWriter::string(std::string_view text)
+    {
+        separate();
+        out_.put('"');
+
+        const char* data = text.data();
+        size_t size = text.size();
+        while (size > 0)
+        {
+            // 不需要转义的部分整段写入
+            const size_t plain = scanPlain(data, size);
+            out_.write(std::string_view(data, plain));
+            data += plain;
+            size -= plain;
+            if (size == 0)
+            {
+                break;
+            }
+
+            const unsigned char c = static_cast<unsigned char>(*data);
+            if (c < 0x80)
+            {
+                escapeAscii(c);
+                data++;
+                size--;
+                continue;
+            }
+
+            const size_t length = utf8SequenceLength(reinterpret_cast<const unsigned char*>(data), size);
+            if (length == 0)
+            {
+                escapeUnit(c);
+                data++;
+                size--;
+                continue;
+            }
+            out_.write(std::string_view(data, length));
+            data += length;
+            size -= length;
+        }
+
+        out_.put('"');
+    }
+
+    void JsonWriter::mutf8(std::string_view text)
+    {
+        separate();
+        out_.put('"');
+
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+        const unsigned char* end = data + text.size();
+        while (data < end)
+        {
+            const size_t plain = scanPlain(reinterpret_cast<const char*>(data), end - data);
+            out_.write(std::string_view(reinterpret_cast<const char*>(data), plain));
+            data += plain;
+            if (data == end)
+            {
+                break;
+            }
+
+            const unsigned char c = *data;
+            if (c < 0x80)
+            {
+                escapeAscii(c);
+                data++;
+                continue;
+            }
+
+            // MUTF-8的多字节序列最多3字节，每个序列编码一个UTF-16码元
+            uint32_t unit = 0xFFFD;
+            size_t length = 1;
+            if ((c & 0xE0) == 0xC0 && end - data >= 2 && (data[1] & 0xC0) == 0x80)
+            {
+                unit = ((c & 0x1F) << 6) | (data[1] & 0x3F);
+                length = 2;
+            }
+            else if ((c & 0xF0) == 0xE0 && end - data >= 3 &&
+                     (data[1] & 0xC0) == 0x80 && (data[2] & 0xC0) == 0x80)
+            {
+                unit = ((c & 0x0F) << 12) | ((data[1] & 0x3F) << 6) | (data[2] & 0x3F);
+                length = 3;
+            }
+
+            if (unit < 0x80)
+            {
+                // 非最短编码（例如表示U+0000的C0 80）
+                escapeAscii(static_cast<unsigned char>(unit));
+            }
+            else
+            {
+                escapeUnit(unit);
+            }
+            data += length;
+        }
+
+        out_.put('"');
+    }
+}
@@ -0,0 +1,125 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "OutputSink.h"
+
+namespace dex::print
+{
+    /**
+     * 流式JSON写入器
+     * 直接把JSON文本写入OutputSink，不构建任何文档树；每个顶层对象结束时输出换行，
+     * 即JSON Lines格式的一条记录。只记录每层是否需要逗号，内存占用与输出大小无关。
+     */
+    class JsonWriter
+    {
+    public:
+        // 最大嵌套深度
+        static constexpr int kMaxDepth = 16;
+
+        explicit JsonWriter(OutputSink& out);
+
+        // 开始对象（数组元素或顶层记录）
+        void beginObject();
+
+        // 开始对象（作为键值）
+        void beginObject(std::string_view key);
+
+        // 结束对象，顶层对象结束时输出换行
+        void endObject();
+
+        // 开始数组（数组元素）
+        void beginArray();
+
+        // 开始数组（作为键值）
+        void beginArray(std::string_view key);
+
+        // 结束数组
+        void endArray();
+
+        // 写入键，键名必须是不需要转义的ASCII
+        void key(std::string_view name);
+
+        // 写入无符号整数
+        void value(uint64_t number);
+
+        // 写入有符号整数
+        void valueSigned(int64_t number);
+
+        // 写入浮点数，非有限值写入null
+        void valueDouble(double number);
+
+        // 写入布尔值
+        void value(bool flag);
+
+        // 写入null
+        void null();
+
+        /**
+         * 写入字符串（程序内部生成的UTF-8文本或DexContext解码后的字符串）
+         * 合法的UTF-8序列原样输出；DexContext::decodeMUTF8把U+0080到U+00FF的字符保存为单字节，
+         * 这类不构成UTF-8序列的字节按Latin-1码点转义为\u00XX，保证输出始终是合法的JSON
+         */
+        void string(std::string_view text);
+
+        /**
+         * 写入字符串（文件中的原始MUTF-8数据）
+         * 多字节序列按UTF-16码元转义为\uXXXX（代理对原样成对输出），非法序列输出U+FFFD
+         */
+        void mutf8(std::string_view data);
+
+        // 写入键和无符号整数
+        void field(std::string_view name, uint64_t number)
+        {
+            key(name);
+            value(number);
+        }
+
+        // 写入键和字符串
+        void field(std::string_view name, std::string_view text)
+        {
+            key(name);
+            string(text);
+        }
+
+        // 写入键和字符串（避免const char*被转换为bool）
+        void field(std::string_view name, const char* text)
+        {
+            key(name);
+            string(text);
+        }
+
+        /**
+         * 查找第一个需要转义的字节（控制字符、引号、反斜杠或0x80以上的字节）
+         * x86-64上使用SSE2每次检查16字节
+         * @return 不需要转义的前缀长度
+         */
+        static size_t scanPlain(const char* data, size_t size);
+
+    private:
+        // 在同一层的第二个及之后的元素前写入逗号
+        void separate();
+
+        // 写入一个需要转义的ASCII字符
+        void escapeAscii(unsigned char c);
+
+        // 写入\uXXXX
+        void escapeUnit(uint32_t unit);
+
+        // 获取data处合法UTF-8序列的长度，不是合法序列时返回0
+        static size_t utf8SequenceLength(const unsigned char* data, size_t size);
+
+        OutputSink& out_;
+        int depth_ = 0;
+        bool afterKey_ = false;
+        bool hasElement_[kMaxDepth] = {};
+    };
+}
+
+#endif //JSONWRITER_H
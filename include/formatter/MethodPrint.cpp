@@ -7,6 +7,7 @@
 #include <cstring>
 #include <string>
 #include <sstream>
+#include <vector>
 #include "log/log.h"
 #include "core/DexContext.h"
 #include "FormatUtil.h"
@@ -15,6 +16,8 @@ namespace dex::print
 {
     void MethodPrint::print()
     {
+        OutputSink& out = getSink();
+
         // 获取上下文
         const dex::DexContext& context = getContext();
         
@@ -25,23 +28,36 @@ namespace dex::print
             return;
         }
         
-        // 获取Method数量
-        const uint32_t methodCount = context.getMethodIdsCount();
+        // 获取要输出的Method（设置了类过滤器时只输出选中的类的方法）
+        std::vector<uint32_t> methodIdxs;
+        const std::span<const DexMethodId> methodIds = context.getMethodIds();
+        methodIdxs.reserve(methodIds.size());
+        for (uint32_t i = 0; i < methodIds.size(); i++)
+        {
+            if (context.isTypeSelected(methodIds[i].classIdx))
+            {
+                methodIdxs.push_back(i);
+            }
+        }
+        const uint32_t methodCount = static_cast<uint32_t>(methodIdxs.size());
         if (methodCount == 0)
         {
-            printf("Method表为空\n");
+            out.write("Method表为空\n");
+            out.flush();
             return;
         }
         
-        printf("\n/---------------------------------------------------------------------\\\n");
-        printf("|                         DEX Method Table                           |\n");
-        printf("+------+----------------+----------------+----------------+----------+\n");
-        printf("| %-4s | %-14s | %-14s | %-14s | %-8s |\n", "索引", "类名", "返回类型", "方法名", "参数数量");
-        printf("+------+----------------+----------------+----------------+----------+\n");
+        out.write("\n/---------------------------------------------------------------------\\\n");
+        out.write("|                         DEX Method Table                           |\n");
+        out.write("+------+----------------+----------------+----------------+----------+\n");
+        out.printf("| %-4s | %-14s | %-14s | %-14s | %-8s |\n", "索引", "类名", "返回类型", "方法名", "参数数量");
+        out.write("+------+----------------+----------------+----------------+----------+\n");
         
         // 打印Method表
-        for (uint32_t i = 0; i < methodCount; i++)
+        for (uint32_t row = 0; row < methodCount; row++)
         {
+            const uint32_t i = methodIdxs[row];
+
             // 获取Method信息
             dex::MethodInfo methodInfo = context.getMethodInfo(i);
             
@@ -70,57 +86,69 @@ namespace dex::print
             int paramCount = methodInfo.parameterTypes.size();
             
             // 打印行
-            printf("| %4u | %-14s | %-14s | %-14s | %8d |\n", 
-                i, className.c_str(), returnType.c_str(), methodName.c_str(), paramCount);
+            out.write("| ");
+            out.writeDec(i, 4);
+            out.write(" | ");
+            out.writePadded(className, 14);
+            out.write(" | ");
+            out.writePadded(returnType, 14);
+            out.write(" | ");
+            out.writePadded(methodName, 14);
+            out.write(" | ");
+            out.writeSigned(paramCount, 8);
+            out.write(" |\n");
             
             // 每20行打印一次表头
-            if ((i + 1) % 20 == 0 && i + 1 < methodCount)
+            if ((row + 1) % 20 == 0 && row + 1 < methodCount)
             {
-                printf("+------+----------------+----------------+----------------+----------+\n");
-                printf("| %-4s | %-14s | %-14s | %-14s | %-8s |\n", "索引", "类名", "返回类型", "方法名", "参数数量");
-                printf("+------+----------------+----------------+----------------+----------+\n");
+                out.write("+------+----------------+----------------+----------------+----------+\n");
+                out.printf("| %-4s | %-14s | %-14s | %-14s | %-8s |\n", "索引", "类名", "返回类型", "方法名", "参数数量");
+                out.write("+------+----------------+----------------+----------------+----------+\n");
             }
         }
         
-        printf("+------+----------------+----------------+----------------+----------+\n");
-        printf("| 共计: %-54u |\n", methodCount);
-        printf("\\---------------------------------------------------------------------/\n");
+        out.write("+------+----------------+----------------+----------------+----------+\n");
+        out.printf("| 共计: %-54u |\n", methodCount);
+        out.write("\\---------------------------------------------------------------------/\n");
         
         // 打印详细的方法信息
-        printf("\n方法详细信息:\n");
-        printf("==========================================\n");
+        out.write("\n方法详细信息:\n");
+        out.write("==========================================\n");
         
-        for (uint32_t i = 0; i < methodCount; i++)
+        for (uint32_t row = 0; row < methodCount; row++)
         {
+            const uint32_t i = methodIdxs[row];
             dex::MethodInfo methodInfo = context.getMethodInfo(i);
             
             // 格式化方法签名
             std::string signature = formatMethodSignature(methodInfo);
             
-            printf("[%u] %s\n", i, signature.c_str());
-            printf("  类名: %s\n", methodInfo.className.c_str());
+            out.printf("[%u] %s\n", i, signature.c_str());
+            out.printf("  类名: %s\n", methodInfo.className.c_str());
             
             // 打印参数列表
             if (methodInfo.hasParameterList && !methodInfo.parameterTypes.empty())
             {
-                printf("  参数列表(%zu):\n", methodInfo.parameterTypes.size());
+                out.printf("  参数列表(%zu):\n", methodInfo.parameterTypes.size());
                 for (size_t j = 0; j < methodInfo.parameterTypes.size(); j++)
                 {
-                    printf("    [%zu] %s\n", j, methodInfo.parameterTypes[j].c_str());
+                    out.printf("    [%zu] %s\n", j, methodInfo.parameterTypes[j].c_str());
                 }
             }
             else
             {
-                printf("  参数列表: 无\n");
+                out.write("  参数列表: 无\n");
             }
             
             // 每10个方法后添加分隔线
-            if ((i + 1) % 10 == 0 && i + 1 < methodCount)
+            if ((row + 1) % 10 == 0 && row + 1 < methodCount)
             {
-                printf("------------------------------------------\n");
+                out.write("------------------------------------------\n");
             }
         }
         
-        printf("==========================================\n");
+        out.write("==========================================\n");
+
+        out.flush();
     }
 } 
\ No newline at end of file
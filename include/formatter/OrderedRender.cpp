@@ -0,0 +1,142 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "OrderedRender.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/ThreadPool.h"
+
+namespace dex::print
+{
+    namespace
+    {
+        // 每个线程允许领先提交位置的块数
+        constexpr size_t kChunksPerWorker = 4;
+    }
+
+    void renderOrdered(OutputSink& out, size_t count, size_t grain, uint32_t threadCount,
+                       const std::function<void(OutputSink& sink, size_t chunk, size_t begin, size_t end)>& render)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (grain == 0)
+        {
+            grain = 1;
+        }
+
+        const size_t chunkCount = (count + grain - 1) / grain;
+        if (threadCount == 0)
+        {
+            threadCount = getDefaultThreadCount();
+        }
+        const size_t workerCount = std::min<size_t>(threadCount, chunkCount);
+
+        // 单线程直接写入输出目标
+        if (workerCount <= 1)
+        {
+            for (size_t chunk = 0; chunk < chunkCount; chunk++)
+            {
+                const size_t begin = chunk * grain;
+                render(out, chunk, begin, std::min(begin + grain, count));
+            }
+            return;
+        }
+
+        const size_t window = workerCount * kChunksPerWorker;
+        std::vector<std::string> pending(chunkCount);
+        std::vector<uint8_t> ready(chunkCount, 0);
+        std::mutex mutex;
+        std::condition_variable canClaim;
+        size_t nextChunk = 0;
+        size_t nextCommit = 0;
+        bool committing = false;
+
+        auto worker = [&]()
+        {
+            MemorySink sink;
+            std::vector<std::string> batch;
+            for (;;)
+            {
+                // 领取下一块，领先提交位置太多时等待
+                size_t chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    canClaim.wait(lock, [&]()
+                    {
+                        return nextChunk >= chunkCount || nextChunk < nextCommit + window;
+                    });
+                    if (nextChunk >= chunkCount)
+                    {
+                        return;
+                    }
+                    chunk = nextChunk++;
+                }
+
+                const size_t begin = chunk * grain;
+                render(sink, chunk, begin, std::min(begin + grain, count));
+                std::string text = sink.take();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    pending[chunk] = std::move(text);
+                    ready[chunk] = 1;
+
+                    // 同一时间只有一个提交者，其他线程完成的块由它顺带提交
+                    if (committing)
+                    {
+                        continue;
+                    }
+                    committing = true;
+                }
+
+                // 提交从nextCommit开始连续完成的块，写入时不持有锁
+                for (;;)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        while (nextCommit < chunkCount && ready[nextCommit])
+                        {
+                            batch.push_back(std::move(pending[nextCommit]));
+                            nextCommit++;
+                        }
+                        if (batch.empty())
+                        {
+                            committing = false;
+                            break;
+                        }
+                    }
+                    canClaim.notify_all();
+
+                    for (const std::string& item : batch)
+                    {
+                        out.write(item);
+                    }
+                    batch.clear();
+                }
+            }
+        };
+
+        // 调用线程也参与渲染
+        std::vector<std::thread> threads;
+        threads.reserve(workerCount - 1);
+        for (size_t i = 1; i < workerCount; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
@@ -0,0 +1,32 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef ORDEREDRENDER_H
+#define ORDEREDRENDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "OutputSink.h"
+
+namespace dex::print
+{
+    /**
+     * 并行渲染区间[0, count)并按顺序输出
+     * 区间按grain切分为块，每个工作线程把领取的块渲染到自己的缓冲区，
+     * 提交者按块序号把已完成的块依次写入out，输出与单线程逐块渲染完全相同。
+     * 已渲染未提交的块数量有上限，某一块耗时较长时其余线程会等待，内存占用不随输出大小增长。
+     * 线程数为1或只有一块时直接渲染到out。
+     * render中只能调用线程安全的只读接口。
+     * @param out 输出目标
+     * @param count 元素数量
+     * @param grain 每块元素数量
+     * @param threadCount 线程数，0表示使用默认线程数
+     * @param render 块渲染函数 render(输出目标, 块序号, 起始, 结束)
+     */
+    void renderOrdered(OutputSink& out, size_t count, size_t grain, uint32_t threadCount,
+                       const std::function<void(OutputSink& sink, size_t chunk, size_t begin, size_t end)>& render);
+}
+
+#endif //ORDEREDRENDER_H
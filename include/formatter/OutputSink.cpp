@@ -0,0 +1,263 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "OutputSink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace dex::print
+{
+    namespace
+    {
+        constexpr char kHexDigits[] = "0123456789ABCDEF";
+    }
+
+    OutputSink::OutputSink(size_t bufferSize)
+        : buffer_(std::max<size_t>(bufferSize, 256))
+    {
+    }
+
+    void OutputSink::writeSlow(const char* data, size_t size)
+    {
+        flush();
+
+        // 超过缓冲区大小的数据直接输出，不再拷贝
+        if (size >= capacity())
+        {
+            emit(data, size);
+            emitted_ += size;
+            return;
+        }
+        memcpy(buffer_.data(), data, size);
+        used_ = size;
+    }
+
+    void OutputSink::fill(char c, size_t count)
+    {
+        while (count > 0)
+        {
+            if (used_ == capacity())
+            {
+                flush();
+            }
+            const size_t n = std::min(count, capacity() - used_);
+            memset(buffer_.data() + used_, c, n);
+            used_ += n;
+            count -= n;
+        }
+    }
+
+    void OutputSink::writeDec(uint64_t value, int width)
+    {
+        // 从后往前生成数字
+        char digits[20];
+        char* end = digits + sizeof(digits);
+        char* p = end;
+        do
+        {
+            *--p = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+
+        const int length = static_cast<int>(end - p);
+        if (width < 0)
+        {
+            write(std::string_view(p, length));
+            if (-width > length)
+            {
+                fill(' ', -width - length);
+            }
+            return;
+        }
+        if (width > length)
+        {
+            fill(' ', width - length);
+        }
+        write(std::string_view(p, length));
+    }
+
+    void OutputSink::writeSigned(int64_t value, int width)
+    {
+        if (value >= 0)
+        {
+            writeDec(static_cast<uint64_t>(value), width);
+            return;
+        }
+
+        // 负号计入宽度，位于填充空格之后
+        const uint64_t magnitude = 0 - static_cast<uint64_t>(value);
+        int length = 1;
+        for (uint64_t v = magnitude; v != 0; v /= 10)
+        {
+            length++;
+        }
+        if (width > length)
+        {
+            fill(' ', width - length);
+        }
+        put('-');
+        writeDec(magnitude);
+    }
+
+    void OutputSink::writeHex(uint64_t value, int width, char padChar)
+    {
+        char digits[16];
+        char* end = digits + sizeof(digits);
+        char* p = end;
+        do
+        {
+            *--p = kHexDigits[value & 0xF];
+            value >>= 4;
+        } while (value != 0);
+
+        const int length = static_cast<int>(end - p);
+        if (width > length)
+        {
+            fill(padChar, width - length);
+        }
+        write(std::string_view(p, length));
+    }
+
+    void OutputSink::writePadded(std::string_view text, int width)
+    {
+        write(text);
+        if (width > static_cast<int>(text.size()))
+        {
+            fill(' ', width - text.size());
+        }
+    }
+
+    void OutputSink::printf(const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+    }
+
+    void OutputSink::vprintf(const char* format, va_list args)
+    {
+        // 先尝试直接格式化到缓冲区剩余空间
+        va_list copy;
+        va_copy(copy, args);
+        const size_t space = capacity() - used_;
+        const int length = vsnprintf(buffer_.data() + used_, space, format, copy);
+        va_end(copy);
+        if (length < 0)
+        {
+            return;
+        }
+        if (static_cast<size_t>(length) < space)
+        {
+            used_ += length;
+            return;
+        }
+
+        // 剩余空间不足：清空缓冲区后重试，仍放不下时使用临时缓冲区
+        flush();
+        if (static_cast<size_t>(length) < capacity())
+        {
+            vsnprintf(buffer_.data(), capacity(), format, args);
+            used_ = length;
+            return;
+        }
+        std::string text(length + 1, '\0');
+        vsnprintf(text.data(), text.size(), format, args);
+        emit(text.data(), length);
+        emitted_ += length;
+    }
+
+    void OutputSink::flush()
+    {
+        if (used_ > 0)
+        {
+            emit(buffer_.data(), used_);
+            emitted_ += used_;
+            used_ = 0;
+        }
+    }
+
+    bool OutputSink::finish()
+    {
+        flush();
+        sync();
+        return writeError_ == 0;
+    }
+
+    void OutputSink::setWriteError(int error)
+    {
+        if (writeError_ == 0)
+        {
+            writeError_ = error != 0 ? error : EIO;
+        }
+    }
+
+    OutputSink& OutputSink::stdoutSink()
+    {
+        static FileSink sink(stdout);
+        return sink;
+    }
+
+    FileSink::FileSink(FILE* file, bool ownsFile, size_t bufferSize)
+        : OutputSink(bufferSize), file_(file), ownsFile_(ownsFile)
+    {
+    }
+
+    FileSink::~FileSink()
+    {
+        flush();
+        if (ownsFile_ && file_ != nullptr)
+        {
+            // 析构时已无法报告错误，需要检查的调用方应先调用finish()
+            fclose(file_);
+        }
+        else if (file_ != nullptr)
+        {
+            fflush(file_);
+        }
+    }
+
+    std::unique_ptr<FileSink> FileSink::open(const char* path)
+    {
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr)
+        {
+            return nullptr;
+        }
+        return std::make_unique<FileSink>(file, true);
+    }
+
+    void FileSink::emit(const char* data, size_t size)
+    {
+        if (file_ == nullptr)
+        {
+            return;
+        }
+
+        // 与其他直接写stdout的代码交替输出时保持先后顺序
+        if (file_ != stdout)
+        {
+            if (fwrite(data, 1, size, file_) != size)
+            {
+                setWriteError(errno);
+            }
+            return;
+        }
+        fflush(stdout);
+        if (fwrite(data, 1, size, stdout) != size || fflush(stdout) != 0)
+        {
+            setWriteError(errno);
+        }
+    }
+
+    void FileSink::sync()
+    {
+        if (file_ != nullptr && fflush(file_) != 0)
+        {
+            setWriteError(errno);
+        }
+    }
+}
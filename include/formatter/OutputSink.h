@@ -0,0 +1,232 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace dex::print
+{
+    /**
+     * 格式化输出目标
+     * 格式化器把每一行写入一块可复用的大缓冲区，缓冲区满或调用flush()时才整块交给emit()输出，
+     * 代替逐行printf（每次调用都要解析格式串并获取stdio锁）。
+     * 整数和十六进制提供不经过格式串的快速写入函数，输出与对应的printf格式逐字节一致。
+     */
+    class OutputSink
+    {
+    public:
+        // 默认缓冲区大小
+        static constexpr size_t kDefaultBufferSize = 256 * 1024;
+
+        explicit OutputSink(size_t bufferSize = kDefaultBufferSize);
+
+        virtual ~OutputSink() = default;
+
+        OutputSink(const OutputSink&) = delete;
+        OutputSink& operator=(const OutputSink&) = delete;
+
+        // 写入一段文本
+        void write(std::string_view text)
+        {
+            if (text.size() > capacity() - used_)
+            {
+                writeSlow(text.data(), text.size());
+                return;
+            }
+            memcpy(buffer_.data() + used_, text.data(), text.size());
+            used_ += text.size();
+        }
+
+        // 写入一个字符
+        void put(char c)
+        {
+            if (used_ == capacity())
+            {
+                flush();
+            }
+            buffer_[used_++] = c;
+        }
+
+        // 写入count个相同字符
+        void fill(char c, size_t count);
+
+        /**
+         * 写入十进制无符号整数，等价于printf("%*u", width, value)
+         * @param value 数值
+         * @param width 最小宽度，不足时左侧补空格；与printf相同，负数表示左对齐（右侧补空格）
+         */
+        void writeDec(uint64_t value, int width = 0);
+
+        /**
+         * 写入十进制有符号整数，等价于printf("%*d", width, value)
+         */
+        void writeSigned(int64_t value, int width = 0);
+
+        /**
+         * 写入大写十六进制整数，等价于printf("%0*X", width, value)或printf("%*X", width, value)
+         * @param value 数值
+         * @param width 最小宽度
+         * @param padChar 填充字符，'0'或' '
+         */
+        void writeHex(uint64_t value, int width = 0, char padChar = '0');
+
+        /**
+         * 写入左对齐文本，等价于printf("%-*s", width, text)（宽度按字节计算）
+         */
+        void writePadded(std::string_view text, int width);
+
+        /**
+         * 格式化写入，直接格式化到缓冲区中，用于不在热路径上的标题和摘要行
+         */
+        void printf(const char* format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+            __attribute__((format(printf, 2, 3)))
+#endif
+            ;
+
+        // 格式化写入（va_list版本）
+        void vprintf(const char* format, va_list args);
+
+        // 将缓冲区中的数据全部输出
+        void flush();
+
+        /**
+         * 输出缓冲区中的数据，并把目标文件自身的缓冲写到系统
+         * @return 到目前为止的全部写入是否成功
+         */
+        bool finish();
+
+        // 第一次写入失败时的错误码(errno)，0表示没有失败
+        int getWriteError() const
+        {
+            return writeError_;
+        }
+
+        // 已写入的总字节数（包括缓冲区中尚未输出的部分）
+        uint64_t bytesWritten() const
+        {
+            return emitted_ + used_;
+        }
+
+        // 标准输出目标（进程内共享的单例）
+        static OutputSink& stdoutSink();
+
+    protected:
+        /**
+         * 输出一块数据，由子类实现
+         * @param data 数据
+         * @param size 数据长度
+         */
+        virtual void emit(const char* data, size_t size) = 0;
+
+        // 把目标文件自身的缓冲写到系统，默认没有缓冲
+        virtual void sync()
+        {
+        }
+
+        // 记录写入错误，只保留第一次的错误码
+        void setWriteError(int error);
+
+    private:
+        size_t capacity() const
+        {
+            return buffer_.size();
+        }
+
+        // 缓冲区放不下时的写入路径
+        void writeSlow(const char* data, size_t size);
+
+        std::vector<char> buffer_;
+        size_t used_ = 0;
+        uint64_t emitted_ = 0;
+        int writeError_ = 0;
+    };
+
+    /**
+     * 输出到FILE*（标准输出或文件）
+     * fwrite/fflush失败时记录第一次的错误码，由调用方在结束时通过finish()检查
+     */
+    class FileSink final : public OutputSink
+    {
+    public:
+        /**
+         * 构造函数
+         * @param file 目标文件
+         * @param ownsFile 析构时是否关闭文件
+         */
+        explicit FileSink(FILE* file, bool ownsFile = false, size_t bufferSize = kDefaultBufferSize);
+
+        ~FileSink() override;
+
+        /**
+         * 以写方式打开文件
+         * @param path 文件路径
+         * @return 输出目标，打开失败返回nullptr
+         */
+        static std::unique_ptr<FileSink> open(const char* path);
+
+    protected:
+        void emit(const char* data, size_t size) override;
+
+        void sync() override;
+
+    private:
+        FILE* file_;
+        bool ownsFile_;
+    };
+
+    /**
+     * 输出到内存
+     */
+    class MemorySink final : public OutputSink
+    {
+    public:
+        using OutputSink::OutputSink;
+
+        // 获取全部输出内容
+        const std::string& str()
+        {
+            flush();
+            return data_;
+        }
+
+        // 清空已输出的内容
+        void clear()
+        {
+            flush();
+            data_.clear();
+        }
+
+        // 取出全部输出内容并清空，不复制数据
+        std::string take()
+        {
+            flush();
+            std::string text = std::move(data_);
+            data_.clear();
+            return text;
+        }
+
+    protected:
+        void emit(const char* data, size_t size) override
+        {
+            data_.append(data, size);
+        }
+
+    private:
+        std::string data_;
+    };
+}
+
+#endif //OUTPUTSINK_H
@@ -0,0 +1,87 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "PhaseStatsPrint.h"
+#include "JsonWriter.h"
+#include "core/PhaseStats.h"
+
+namespace dex::print
+{
+    namespace
+    {
+        // 每秒处理量，耗时为0时返回0
+        double perSecond(uint64_t amount, uint64_t wallNs)
+        {
+            return wallNs > 0 ? static_cast<double>(amount) * 1e9 / static_cast<double>(wallNs) : 0;
+        }
+    }
+
+    PhaseStatsPrint::PhaseStatsPrint(bool json) : json_(json)
+    {
+    }
+
+    void PhaseStatsPrint::print()
+    {
+        OutputSink& out = getSink();
+
+        if (json_)
+        {
+            JsonWriter json(out);
+            json.beginObject();
+            json.field("kind", "timing");
+            json.beginArray("phases");
+            for (size_t i = 0; i < static_cast<size_t>(Phase::Count); i++)
+            {
+                const Phase phase = static_cast<Phase>(i);
+                const PhaseTotals totals = PhaseStats::get(phase);
+                if (totals.calls == 0)
+                {
+                    continue;
+                }
+                json.beginObject();
+                json.field("phase", PhaseStats::name(phase));
+                json.field("calls", totals.calls);
+                json.field("wallNs", totals.wallNs);
+                json.field("cpuNs", totals.cpuNs);
+                json.field("bytes", totals.bytes);
+                json.field("items", totals.items);
+                json.field("bytesPerSecond", static_cast<uint64_t>(perSecond(totals.bytes, totals.wallNs)));
+                json.field("itemsPerSecond", static_cast<uint64_t>(perSecond(totals.items, totals.wallNs)));
+                json.endObject();
+            }
+            json.endArray();
+            json.endObject();
+            out.flush();
+            return;
+        }
+
+        out.write("/--------------------------------------------------------------------------------------------------------\\\n");
+        out.write("|                                              Phase Timing                                              |\n");
+        out.write("+---------------+----------+------------+------------+--------------+------------+----------+------------+\n");
+        out.printf("| %-13s | %8s | %10s | %10s | %12s | %10s | %8s | %10s |\n",
+                   "Phase", "Calls", "Wall(ms)", "CPU(ms)", "Bytes", "Items", "MB/s", "Items/s");
+        out.write("+---------------+----------+------------+------------+--------------+------------+----------+------------+\n");
+        for (size_t i = 0; i < static_cast<size_t>(Phase::Count); i++)
+        {
+            const Phase phase = static_cast<Phase>(i);
+            const PhaseTotals totals = PhaseStats::get(phase);
+            if (totals.calls == 0)
+            {
+                continue;
+            }
+            if (phase == Phase::Total)
+            {
+                out.write("+---------------+----------+------------+------------+--------------+------------+----------+------------+\n");
+            }
+            out.printf("| %-13s | %8llu | %10.3f | %10.3f | %12llu | %10llu | %8.1f | %10.0f |\n",
+                       PhaseStats::name(phase), static_cast<unsigned long long>(totals.calls),
+                       static_cast<double>(totals.wallNs) / 1e6, static_cast<double>(totals.cpuNs) / 1e6,
+                       static_cast<unsigned long long>(totals.bytes), static_cast<unsigned long long>(totals.items),
+                       perSecond(totals.bytes, totals.wallNs) / (1024.0 * 1024.0),
+                       perSecond(totals.items, totals.wallNs));
+        }
+        out.write("\\--------------------------------------------------------------------------------------------------------/\n");
+        out.flush();
+    }
+}
@@ -0,0 +1,47 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef PHASESTATSPRINT_H
+#define PHASESTATSPRINT_H
+
+#include "BasePrint.h"
+
+namespace dex::print
+{
+    /**
+     * 阶段耗时输出类
+     * 输出PhaseStats累计的各阶段墙钟时间、CPU时间、处理的字节数和条目数以及吞吐量，
+     * 只输出计过时的阶段。嵌套的阶段同时计入外层阶段，各行之和不等于总计。
+     */
+    class PhaseStatsPrint final : public BasePrint
+    {
+    public:
+        /**
+         * 构造函数
+         */
+        PhaseStatsPrint() = default;
+
+        /**
+         * 构造函数
+         * @param json 是否输出一条JSON记录（kind为timing）而不是表格
+         */
+        explicit PhaseStatsPrint(bool json);
+
+        /**
+         * 析构函数
+         */
+        ~PhaseStatsPrint() override = default;
+
+        /**
+         * 打印各阶段耗时
+         */
+        void print() override;
+
+    private:
+        // 是否输出JSON
+        bool json_ = false;
+    };
+}
+
+#endif //PHASESTATSPRINT_H
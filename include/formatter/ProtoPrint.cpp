@@ -11,6 +11,8 @@ namespace dex::print
 {
     void ProtoPrint::print()
     {
+        OutputSink& out = getSink();
+
         // 获取上下文
         const dex::DexContext& context = getContext();
 
@@ -25,18 +27,19 @@ namespace dex::print
         const uint32_t protoCount = context.getProtoIdsCount();
         if (protoCount == 0)
         {
-            printf("Proto表为空\n");
+            out.write("Proto表为空\n");
+            out.flush();
             return;
         }
 
-        printf("\n/----------------------------------------------------------\\\n");
-        printf("|                     DEX Proto Table                     |\n");
-        printf("+------+----------------+----------------+----------------+\n");
-        printf("| %-4s | %-14s | %-14s | %-14s |\n", "索引", "Shorty", "返回类型", "参数");
-        printf("+------+----------------+----------------+----------------+\n");
+        out.write("\n/----------------------------------------------------------\\\n");
+        out.write("|                     DEX Proto Table                     |\n");
+        out.write("+------+----------------+----------------+----------------+\n");
+        out.printf("| %-4s | %-14s | %-14s | %-14s |\n", "索引", "Shorty", "返回类型", "参数");
+        out.write("+------+----------------+----------------+----------------+\n");
 
         // 获取Proto表
-        const std::vector<DexProtoId>& protoIds = context.getProtoIds();
+        std::span<const DexProtoId> protoIds = context.getProtoIds();
 
         // 打印Proto表
         for (uint32_t i = 0; i < protoCount; i++)
@@ -93,20 +96,29 @@ namespace dex::print
             }
 
             // 打印行
-            printf("| %4u | %-14s | %-14s | %-14s |\n",
-                   i, shorty.c_str(), returnType.c_str(), paramStr.c_str());
+            out.write("| ");
+            out.writeDec(i, 4);
+            out.write(" | ");
+            out.writePadded(shorty, 14);
+            out.write(" | ");
+            out.writePadded(returnType, 14);
+            out.write(" | ");
+            out.writePadded(paramStr, 14);
+            out.write(" |\n");
 
             // 每20行打印一次表头
             if ((i + 1) % 20 == 0 && i + 1 < protoCount)
             {
-                printf("+------+----------------+----------------+----------------+\n");
-                printf("| %-4s | %-14s | %-14s | %-14s |\n", "索引", "Shorty", "返回类型", "参数");
-                printf("+------+----------------+----------------+----------------+\n");
+                out.write("+------+----------------+----------------+----------------+\n");
+                out.printf("| %-4s | %-14s | %-14s | %-14s |\n", "索引", "Shorty", "返回类型", "参数");
+                out.write("+------+----------------+----------------+----------------+\n");
             }
         }
 
-        printf("+------+----------------+----------------+----------------+\n");
-        printf("| 共计: %-42u |\n", protoCount);
-        printf("\\----------------------------------------------------------/\n");
+        out.write("+------+----------------+----------------+----------------+\n");
+        out.printf("| 共计: %-42u |\n", protoCount);
+        out.write("\\----------------------------------------------------------/\n");
+
+        out.flush();
     }
 }
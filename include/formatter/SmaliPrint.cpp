@@ -0,0 +1,1527 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "SmaliPrint.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "log/log.h"
+#include "core/DexContext.h"
+#include "core/DexReader.h"
+#include "core/ThreadPool.h"
+#include "parser/CodeParser.h"
+
+namespace dex::print
+{
+    using dex::parser::CodeParser;
+    using dex::parser::DecodedInstruction;
+    using dex::parser::IndexType;
+
+    namespace
+    {
+        // 并行输出时每块包含的类数量
+        constexpr size_t kClassesPerChunk = 8;
+
+        // 无效索引
+        constexpr uint32_t kNoIndex = 0xFFFFFFFF;
+
+        // encoded_value的最大嵌套深度
+        constexpr int kMaxValueDepth = 8;
+
+        constexpr char kHexDigits[] = "0123456789abcdef";
+
+        // 访问标志及其smali关键字
+        struct FlagName {
+            uint32_t flag;
+            const char* name;
+        };
+
+        constexpr FlagName kClassFlags[] = {
+            {ACC_PUBLIC, "public"}, {ACC_PRIVATE, "private"}, {ACC_PROTECTED, "protected"},
+            {ACC_STATIC, "static"}, {ACC_FINAL, "final"}, {ACC_INTERFACE, "interface"},
+            {ACC_ABSTRACT, "abstract"}, {ACC_SYNTHETIC, "synthetic"}, {ACC_ANNOTATION, "annotation"},
+            {ACC_ENUM, "enum"},
+        };
+
+        constexpr FlagName kFieldFlags[] = {
+            {ACC_PUBLIC, "public"}, {ACC_PRIVATE, "private"}, {ACC_PROTECTED, "protected"},
+            {ACC_STATIC, "static"}, {ACC_FINAL, "final"}, {ACC_VOLATILE, "volatile"},
+            {ACC_TRANSIENT, "transient"}, {ACC_SYNTHETIC, "synthetic"}, {ACC_ENUM, "enum"},
+        };
+
+        constexpr FlagName kMethodFlags[] = {
+            {ACC_PUBLIC, "public"}, {ACC_PRIVATE, "private"}, {ACC_PROTECTED, "protected"},
+            {ACC_STATIC, "static"}, {ACC_FINAL, "final"}, {ACC_SYNCHRONIZED, "synchronized"},
+            {ACC_BRIDGE, "bridge"}, {ACC_VARARGS, "varargs"}, {ACC_NATIVE, "native"},
+            {ACC_ABSTRACT, "abstract"}, {ACC_STRICT, "strictfp"}, {ACC_SYNTHETIC, "synthetic"},
+            {ACC_CONSTRUCTOR, "constructor"}, {ACC_DECLARED_SYNCHRONIZED, "declared-synchronized"},
+        };
+
+        // 标签种类，同一地址上的标签按位序输出
+        enum LabelKind : uint16_t {
+            LABEL_TRY_START = 1 << 0,
+            LABEL_CATCH = 1 << 1,
+            LABEL_CATCHALL = 1 << 2,
+            LABEL_GOTO = 1 << 3,
+            LABEL_COND = 1 << 4,
+            LABEL_PSWITCH = 1 << 5,
+            LABEL_SSWITCH = 1 << 6,
+            LABEL_PSWITCH_DATA = 1 << 7,
+            LABEL_SSWITCH_DATA = 1 << 8,
+            LABEL_ARRAY = 1 << 9,
+        };
+
+        // 标签名称，下标为标签种类的位序
+        constexpr const char* kLabelNames[] = {
+            "try_start", "catch", "catchall", "goto", "cond",
+            "pswitch", "sswitch", "pswitch_data", "sswitch_data", "array",
+        };
+
+        // 操作码
+        constexpr uint16_t kOpNop = 0x00;
+        constexpr uint16_t kOpReturnVoid = 0x0e;
+        constexpr uint16_t kOpConstWide16 = 0x16;
+        constexpr uint16_t kOpConstWideHigh16 = 0x19;
+        constexpr uint16_t kOpFillArrayData = 0x26;
+        constexpr uint16_t kOpPackedSwitch = 0x2b;
+        constexpr uint16_t kOpSparseSwitch = 0x2c;
+
+        // 数据伪指令ident
+        constexpr uint16_t kPackedSwitchPayload = 0x0100;
+        constexpr uint16_t kSparseSwitchPayload = 0x0200;
+        constexpr uint16_t kFillArrayDataPayload = 0x0300;
+
+        // encoded_value类型
+        enum EncodedValueType : uint8_t {
+            VALUE_BYTE = 0x00,
+            VALUE_SHORT = 0x02,
+            VALUE_CHAR = 0x03,
+            VALUE_INT = 0x04,
+            VALUE_LONG = 0x06,
+            VALUE_FLOAT = 0x10,
+            VALUE_DOUBLE = 0x11,
+            VALUE_METHOD_TYPE = 0x15,
+            VALUE_METHOD_HANDLE = 0x16,
+            VALUE_STRING = 0x17,
+            VALUE_TYPE = 0x18,
+            VALUE_FIELD = 0x19,
+            VALUE_METHOD = 0x1a,
+            VALUE_ENUM = 0x1b,
+            VALUE_ARRAY = 0x1c,
+            VALUE_ANNOTATION = 0x1d,
+            VALUE_NULL = 0x1e,
+            VALUE_BOOLEAN = 0x1f,
+        };
+
+        // 方法内的寄存器布局，参数寄存器位于末尾
+        struct RegisterLayout {
+            uint32_t registersSize;   // 寄存器数量
+            uint32_t firstParam;      // 第一个参数寄存器
+        };
+
+        // 方法内的标签，按地址(16位字)索引
+        struct MethodLabels {
+            std::vector<uint16_t> kinds;               // 地址 -> 标签种类位集，大小为指令数+1
+            std::map<uint32_t, uint32_t> payloadOwners; // 数据伪指令地址 -> 引用它的switch指令地址
+        };
+    }
+
+    // 写入小写十六进制数
+    static void writeHex(OutputSink& out, uint64_t value)
+    {
+        char digits[16];
+        char* end = digits + sizeof(digits);
+        char* p = end;
+        do
+        {
+            *--p = kHexDigits[value & 0xF];
+            value >>= 4;
+        } while (value != 0);
+        out.write(std::string_view(p, end - p));
+    }
+
+    // 写入smali整数字面量（0x1、-0x1）
+    static void writeLiteral(OutputSink& out, int64_t value)
+    {
+        uint64_t magnitude = static_cast<uint64_t>(value);
+        if (value < 0)
+        {
+            out.put('-');
+            magnitude = 0 - magnitude;
+        }
+        out.write("0x");
+        writeHex(out, magnitude);
+    }
+
+    // 写入浮点字面量，float带f后缀
+    static void writeFloat(OutputSink& out, double value, bool isFloat)
+    {
+        if (std::isnan(value))
+        {
+            out.write("NaN");
+        }
+        else if (std::isinf(value))
+        {
+            out.write(value < 0 ? "-Infinity" : "Infinity");
+        }
+        else
+        {
+            // 最短往返表示，保证有小数点，便于与整数区分
+            char buffer[64];
+            const std::to_chars_result result = isFloat
+                ? std::to_chars(buffer, buffer + sizeof(buffer), static_cast<float>(value))
+                : std::to_chars(buffer, buffer + sizeof(buffer), value);
+            const std::string_view text(buffer, result.ptr - buffer);
+            const size_t exponent = text.find('e');
+            if (text.find('.') == std::string_view::npos)
+            {
+                out.write(text.substr(0, exponent));
+                out.write(".0");
+                if (exponent != std::string_view::npos)
+                {
+                    out.write(text.substr(exponent));
+                }
+            }
+            else
+            {
+                out.write(text);
+            }
+        }
+
+        if (isFloat)
+        {
+            out.put('f');
+        }
+    }
+
+    // 写入一个转义后的UTF-16码元，可打印ASCII以外的字符写为\uXXXX
+    static void writeEscapedUnit(OutputSink& out, uint32_t unit, char quote)
+    {
+        switch (unit)
+        {
+            case '\n': out.write("\\n"); return;
+            case '\r': out.write("\\r"); return;
+            case '\t': out.write("\\t"); return;
+            case '\\': out.write("\\\\"); return;
+            default: break;
+        }
+
+        if (unit == static_cast<uint32_t>(quote))
+        {
+            out.put('\\');
+            out.put(quote);
+        }
+        else if (unit >= 0x20 && unit < 0x7F)
+        {
+            out.put(static_cast<char>(unit));
+        }
+        else
+        {
+            const char text[6] = {
+                '\\', 'u',
+                kHexDigits[(unit >> 12) & 0xF], kHexDigits[(unit >> 8) & 0xF],
+                kHexDigits[(unit >> 4) & 0xF], kHexDigits[unit & 0xF],
+            };
+            out.write(std::string_view(text, sizeof(text)));
+        }
+    }
+
+    // 写入带引号的字符串字面量，data为文件中的原始MUTF-8数据
+    static void writeString(OutputSink& out, std::string_view data)
+    {
+        out.put('"');
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data());
+        const unsigned char* end = p + data.size();
+        while (p < end)
+        {
+            // MUTF-8的多字节序列最多3字节，每个序列编码一个UTF-16码元
+            const unsigned char c = *p;
+            uint32_t unit = c;
+            size_t length = 1;
+            if (c >= 0x80)
+            {
+                unit = 0xFFFD;
+                if ((c & 0xE0) == 0xC0 && end - p >= 2 && (p[1] & 0xC0) == 0x80)
+                {
+                    unit = ((c & 0x1F) << 6) | (p[1] & 0x3F);
+                    length = 2;
+                }
+                else if ((c & 0xF0) == 0xE0 && end - p >= 3 && (p[1] & 0xC0) == 0x80 && (p[2] & 0xC0) == 0x80)
+                {
+                    unit = ((c & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+                    length = 3;
+                }
+            }
+            writeEscapedUnit(out, unit, '"');
+            p += length;
+        }
+        out.put('"');
+    }
+
+    // 写入访问标志关键字，每个关键字后跟一个空格
+    static void writeAccessFlags(OutputSink& out, uint32_t flags, std::span<const FlagName> names)
+    {
+        for (const FlagName& name : names)
+        {
+            if ((flags & name.flag) != 0)
+            {
+                out.write(name.name);
+                out.put(' ');
+            }
+        }
+    }
+
+    // 获取字符串的原始数据，索引无效时返回空字符串
+    static std::string_view stringData(const DexContext& context, uint32_t stringIdx)
+    {
+        const std::string_view data = context.getStringData(stringIdx);
+        return data.data() != nullptr ? data : std::string_view("");
+    }
+
+    // 获取类型描述符的原始数据，索引无效时返回空字符串
+    static std::string_view typeDescriptor(const DexContext& context, uint32_t typeIdx)
+    {
+        const std::span<const DexTypeId> typeIds = context.getTypeIds();
+        if (typeIdx >= typeIds.size())
+        {
+            return "";
+        }
+        return stringData(context, typeIds[typeIdx].descriptor_idx);
+    }
+
+    // 读取文件中的type_list，不在type_list段内或未按4字节对齐时返回空
+    static std::span<const DexTypeItem> typeList(const DexContext& context, uint32_t offset)
+    {
+        if (offset == 0 || offset % 4 != 0 || !context.isInSection(kDexTypeTypeList, offset, sizeof(uint32_t)))
+        {
+            return {};
+        }
+
+        const auto* list = reinterpret_cast<const DexTypeList*>(context.getFileData() + offset);
+        if (!context.isInSection(kDexTypeTypeList, offset,
+                                 sizeof(uint32_t) + static_cast<uint64_t>(list->size) * sizeof(DexTypeItem)))
+        {
+            return {};
+        }
+        return {list->list, list->size};
+    }
+
+    // 写入方法原型描述符 (参数)返回类型
+    static void writeProto(OutputSink& out, const DexContext& context, uint32_t protoIdx)
+    {
+        const std::span<const DexProtoId> protoIds = context.getProtoIds();
+        if (protoIdx >= protoIds.size())
+        {
+            out.write("()V");
+            return;
+        }
+
+        const DexProtoId& proto = protoIds[protoIdx];
+        out.put('(');
+        for (const DexTypeItem& item : typeList(context, proto.parameters_off))
+        {
+            out.write(typeDescriptor(context, item.typeIdx));
+        }
+        out.put(')');
+        out.write(typeDescriptor(context, proto.return_type_idx));
+    }
+
+    // 写入字段引用 Lclass;->name:Type
+    static void writeFieldRef(OutputSink& out, const DexContext& context, uint32_t fieldIdx)
+    {
+        const std::span<const DexFieldId> fieldIds = context.getFieldIds();
+        if (fieldIdx >= fieldIds.size())
+        {
+            out.write("field@");
+            writeLiteral(out, fieldIdx);
+            return;
+        }
+
+        const DexFieldId& field = fieldIds[fieldIdx];
+        out.write(typeDescriptor(context, field.classIdx));
+        out.write("->");
+        out.write(stringData(context, field.nameIdx));
+        out.put(':');
+        out.write(typeDescriptor(context, field.typeIdx));
+    }
+
+    // 写入方法引用 Lclass;->name(Params)Ret
+    static void writeMethodRef(OutputSink& out, const DexContext& context, uint32_t methodIdx)
+    {
+        const std::span<const DexMethodId> methodIds = context.getMethodIds();
+        if (methodIdx >= methodIds.size())
+        {
+            out.write("method@");
+            writeLiteral(out, methodIdx);
+            return;
+        }
+
+        const DexMethodId& method = methodIds[methodIdx];
+        out.write(typeDescriptor(context, method.classIdx));
+        out.write("->");
+        out.write(stringData(context, method.nameIdx));
+        writeProto(out, context, method.protoIdx);
+    }
+
+    // 写入指令引用的常量池项
+    static void writeReference(OutputSink& out, const DexContext& context, IndexType type, uint32_t index)
+    {
+        switch (type)
+        {
+            case IndexType::String:
+                writeString(out, stringData(context, index));
+                break;
+            case IndexType::Type:
+                out.write(typeDescriptor(context, index));
+                break;
+            case IndexType::Field:
+                writeFieldRef(out, context, index);
+                break;
+            case IndexType::Method:
+                writeMethodRef(out, context, index);
+                break;
+            case IndexType::Proto:
+                writeProto(out, context, index);
+                break;
+            case IndexType::CallSite:
+                out.write("call_site_");
+                out.writeDec(index);
+                break;
+            case IndexType::MethodHandle:
+                out.write("method_handle_");
+                out.writeDec(index);
+                break;
+            default:
+                writeLiteral(out, index);
+                break;
+        }
+    }
+
+    // 读取encoded_value中size字节的小端数值
+    static uint64_t readValueBits(CheckedReader& reader, uint32_t size)
+    {
+        uint64_t value = 0;
+        for (uint32_t i = 0; i < size; i++)
+        {
+            value |= static_cast<uint64_t>(reader.read<uint8_t>()) << (i * 8);
+        }
+        return value;
+    }
+
+    // 按size字节符号扩展
+    static int64_t signExtend(uint64_t value, uint32_t size)
+    {
+        const uint32_t shift = 64 - size * 8;
+        return static_cast<int64_t>(value << shift) >> shift;
+    }
+
+    /**
+     * 写入一个encoded_value
+     * @return 数据有效且类型受支持时返回true；不支持注解值
+     */
+    static bool writeEncodedValue(OutputSink& out, const DexContext& context, CheckedReader& reader, int depth)
+    {
+        const uint8_t header = reader.read<uint8_t>();
+        const uint8_t type = header & 0x1F;
+        const uint32_t arg = header >> 5;
+        const uint32_t size = arg + 1;
+
+        switch (type)
+        {
+            case VALUE_BYTE:
+                writeLiteral(out, signExtend(readValueBits(reader, 1), 1));
+                out.put('t');
+                break;
+
+            case VALUE_SHORT:
+                writeLiteral(out, signExtend(readValueBits(reader, std::min(size, 2u)), std::min(size, 2u)));
+                out.put('s');
+                break;
+
+            case VALUE_CHAR:
+                out.put('\'');
+                writeEscapedUnit(out, static_cast<uint32_t>(readValueBits(reader, std::min(size, 2u))), '\'');
+                out.put('\'');
+                break;
+
+            case VALUE_INT:
+                writeLiteral(out, signExtend(readValueBits(reader, std::min(size, 4u)), std::min(size, 4u)));
+                break;
+
+            case VALUE_LONG:
+                writeLiteral(out, signExtend(readValueBits(reader, size), size));
+                out.put('L');
+                break;
+
+            case VALUE_FLOAT:
+                {
+                    // 只保存高位字节，低位补0
+                    const uint32_t length = std::min(size, 4u);
+                    const uint32_t bits = static_cast<uint32_t>(readValueBits(reader, length) << ((4 - length) * 8));
+                    float value;
+                    memcpy(&value, &bits, sizeof(value));
+                    writeFloat(out, value, true);
+                }
+                break;
+
+            case VALUE_DOUBLE:
+                {
+                    const uint64_t bits = readValueBits(reader, size) << ((8 - size) * 8);
+                    double value;
+                    memcpy(&value, &bits, sizeof(value));
+                    writeFloat(out, value, false);
+                }
+                break;
+
+            case VALUE_METHOD_TYPE:
+                writeProto(out, context, static_cast<uint32_t>(readValueBits(reader, std::min(size, 4u))));
+                break;
+
+            case VALUE_METHOD_HANDLE:
+                writeReference(out, context, IndexType::MethodHandle,
+                               static_cast<uint32_t>(readValueBits(reader, std::min(size, 4u))));
+                break;
+
+            case VALUE_STRING:
+                writeString(out, stringData(context, static_cast<uint32_t>(readValueBits(reader, std::min(size, 4u)))));
+                break;
+
+            case VALUE_TYPE:
+                out.write(typeDescriptor(context, static_cast<uint32_t>(readValueBits(reader, std::min(size, 4u)))));
+                break;
+
+            case VALUE_FIELD:
+                writeFieldRef(out, context, static_cast<uint32_t>(readValueBits(reader, std::min(size, 4u))));
+                break;
+
+            case VALUE_METHOD:
+                writeMethodRef(out, context, static_cast<uint32_t>(readValueBits(reader, std::min(size, 4u))));
+                break;
+
+            case VALUE_ENUM:
+                out.write(".enum ");
+                writeFieldRef(out, context, static_cast<uint32_t>(readValueBits(reader, std::min(size, 4u))));
+                break;
+
+            case VALUE_ARRAY:
+                {
+                    if (depth >= kMaxValueDepth)
+                    {
+                        return false;
+                    }
+                    const uint32_t count = reader.readULEB128();
+                    if (count > reader.remaining())
+                    {
+                        return false;
+                    }
+                    out.write("{ ");
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        if (i > 0)
+                        {
+                            out.write(", ");
+                        }
+                        if (!writeEncodedValue(out, context, reader, depth + 1))
+                        {
+                            return false;
+                        }
+                    }
+                    out.write(" }");
+                }
+                break;
+
+            case VALUE_NULL:
+                out.write("null");
+                break;
+
+            case VALUE_BOOLEAN:
+                out.write(arg != 0 ? "true" : "false");
+                break;
+
+            default:
+                // 注解值只出现在注解中，静态字段初始值不会使用
+                return false;
+        }
+
+        return reader.ok();
+    }
+
+    // 写入寄存器名，参数寄存器写为p0、p1...
+    static void writeRegister(OutputSink& out, const RegisterLayout& layout, uint32_t reg)
+    {
+        if (reg >= layout.firstParam && reg < layout.registersSize)
+        {
+            out.put('p');
+            out.writeDec(reg - layout.firstParam);
+        }
+        else
+        {
+            out.put('v');
+            out.writeDec(reg);
+        }
+    }
+
+    // 写入标签引用 :kind_addr
+    static void writeLabel(OutputSink& out, const char* kind, uint32_t address)
+    {
+        out.put(':');
+        out.write(kind);
+        out.put('_');
+        writeHex(out, address);
+    }
+
+    // 计算分支目标地址，越界时返回false
+    static bool branchTarget(uint32_t offset, int64_t branch, uint32_t insnsSize, uint32_t& target)
+    {
+        const int64_t address = static_cast<int64_t>(offset) + branch;
+        if (address < 0 || address > static_cast<int64_t>(insnsSize))
+        {
+            return false;
+        }
+        target = static_cast<uint32_t>(address);
+        return true;
+    }
+
+    // 读取指令数组中的32位值（小端，两个16位字）
+    static int32_t readInsns32(const uint16_t* insns, uint32_t offset)
+    {
+        return static_cast<int32_t>(insns[offset] | (static_cast<uint32_t>(insns[offset + 1]) << 16));
+    }
+
+    // 标记switch数据中各分支的目标标签
+    static void markSwitchTargets(MethodLabels& labels, const uint16_t* insns, uint32_t insnsSize,
+                                  uint32_t switchAddr, uint32_t payloadAddr)
+    {
+        DecodedInstruction payload;
+        if (!CodeParser::decodeInstruction(insns, insnsSize, payloadAddr, payload))
+        {
+            return;
+        }
+
+        const uint32_t count = insns[payloadAddr + 1];
+        uint32_t targetsAt;
+        uint16_t kind;
+        if (payload.opcode == kPackedSwitchPayload)
+        {
+            targetsAt = payloadAddr + 4;
+            kind = LABEL_PSWITCH;
+        }
+        else if (payload.opcode == kSparseSwitchPayload)
+        {
+            targetsAt = payloadAddr + 2 + count * 2;
+            kind = LABEL_SSWITCH;
+        }
+        else
+        {
+            return;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t target;
+            if (branchTarget(switchAddr, readInsns32(insns, targetsAt + i * 2), insnsSize, target))
+            {
+                labels.kinds[target] |= kind;
+            }
+        }
+    }
+
+    // 第一遍扫描：收集分支、switch、数组数据和try/catch的标签
+    static void collectLabels(MethodLabels& labels, const uint16_t* insns, uint32_t insnsSize, const CodeInfo& codeInfo)
+    {
+        labels.kinds.assign(static_cast<size_t>(insnsSize) + 1, 0);
+
+        DecodedInstruction decoded;
+        for (uint32_t offset = 0; offset < insnsSize; offset += decoded.length)
+        {
+            if (!CodeParser::decodeInstruction(insns, insnsSize, offset, decoded) || decoded.length == 0)
+            {
+                break;
+            }
+
+            uint32_t target;
+            switch (decoded.format)
+            {
+                case dex::parser::kFmt10t:
+                case dex::parser::kFmt20t:
+                case dex::parser::kFmt30t:
+                    if (branchTarget(offset, decoded.branch, insnsSize, target))
+                    {
+                        labels.kinds[target] |= LABEL_GOTO;
+                    }
+                    break;
+
+                case dex::parser::kFmt21t:
+                case dex::parser::kFmt22t:
+                    if (branchTarget(offset, decoded.branch, insnsSize, target))
+                    {
+                        labels.kinds[target] |= LABEL_COND;
+                    }
+                    break;
+
+                case dex::parser::kFmt31t:
+                    if (branchTarget(offset, decoded.branch, insnsSize, target))
+                    {
+                        if (decoded.opcode == kOpPackedSwitch)
+                        {
+                            labels.kinds[target] |= LABEL_PSWITCH_DATA;
+                        }
+                        else if (decoded.opcode == kOpSparseSwitch)
+                        {
+                            labels.kinds[target] |= LABEL_SSWITCH_DATA;
+                        }
+                        else
+                        {
+                            labels.kinds[target] |= LABEL_ARRAY;
+                        }
+                        labels.payloadOwners.emplace(target, offset);
+                        if (decoded.opcode != kOpFillArrayData)
+                        {
+                            markSwitchTargets(labels, insns, insnsSize, offset, target);
+                        }
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        for (const TryBlockInfo& tryBlock : codeInfo.tries)
+        {
+            if (tryBlock.startAddr < insnsSize)
+            {
+                labels.kinds[tryBlock.startAddr] |= LABEL_TRY_START;
+            }
+            if (tryBlock.handlerIdx >= codeInfo.handlers.size())
+            {
+                continue;
+            }
+
+            const CatchHandlerInfo& handler = codeInfo.handlers[tryBlock.handlerIdx];
+            for (const CatchHandlerInfo::CatchInfo& catchInfo : handler.catches)
+            {
+                if (catchInfo.address <= insnsSize)
+                {
+                    labels.kinds[catchInfo.address] |= LABEL_CATCH;
+                }
+            }
+            if (handler.hasCatchAll && handler.catchAllAddr <= insnsSize)
+            {
+                labels.kinds[handler.catchAllAddr] |= LABEL_CATCHALL;
+            }
+        }
+    }
+
+    // 写入try块结束标签和.catch指令
+    static void writeTryEnd(OutputSink& out, const DexContext& context, const CodeInfo& codeInfo,
+                            const TryBlockInfo& tryBlock)
+    {
+        const uint32_t endAddr = tryBlock.startAddr + tryBlock.insnCount;
+        out.write("    ");
+        writeLabel(out, "try_end", endAddr);
+        out.put('\n');
+
+        if (tryBlock.handlerIdx >= codeInfo.handlers.size())
+        {
+            return;
+        }
+
+        const CatchHandlerInfo& handler = codeInfo.handlers[tryBlock.handlerIdx];
+        const auto writeRange = [&]()
+        {
+            out.write(" {");
+            writeLabel(out, "try_start", tryBlock.startAddr);
+            out.write(" .. ");
+            writeLabel(out, "try_end", endAddr);
+            out.write("} ");
+        };
+
+        for (const CatchHandlerInfo::CatchInfo& catchInfo : handler.catches)
+        {
+            out.write("    .catch ");
+            out.write(typeDescriptor(context, catchInfo.typeIdx));
+            writeRange();
+            writeLabel(out, "catch", catchInfo.address);
+            out.put('\n');
+        }
+        if (handler.hasCatchAll)
+        {
+            out.write("    .catchall");
+            writeRange();
+            writeLabel(out, "catchall", handler.catchAllAddr);
+            out.put('\n');
+        }
+    }
+
+    // 写入局部变量的名称和类型 "name":Type
+    static void writeLocal(OutputSink& out, const DexContext& context, const LocalVarInfo& local)
+    {
+        if (local.nameIdx < context.getStringIdsCount())
+        {
+            writeString(out, stringData(context, local.nameIdx));
+        }
+        else
+        {
+            out.write("null");
+        }
+        out.put(':');
+        if (local.typeIdx < context.getTypeIdsCount())
+        {
+            out.write(typeDescriptor(context, local.typeIdx));
+        }
+        else
+        {
+            out.write("V");
+        }
+    }
+
+    // 写入局部变量作用域事件
+    static void writeLocalEvent(OutputSink& out, const DexContext& context, const RegisterLayout& layout,
+                                const DebugInfoData& debugInfo, const LocalScopeEvent& event)
+    {
+        const LocalVarInfo* local = event.localIdx < debugInfo.localVars.size()
+            ? &debugInfo.localVars[event.localIdx] : nullptr;
+
+        switch (event.kind)
+        {
+            case LOCAL_START:
+                out.write("    .local ");
+                writeRegister(out, layout, event.registerNum);
+                out.write(", ");
+                writeLocal(out, context, *local);
+                if (local->sigIdx < context.getStringIdsCount())
+                {
+                    out.write(", ");
+                    writeString(out, stringData(context, local->sigIdx));
+                }
+                break;
+
+            case LOCAL_END:
+            case LOCAL_RESTART:
+                out.write(event.kind == LOCAL_END ? "    .end local " : "    .restart local ");
+                writeRegister(out, layout, event.registerNum);
+                if (local != nullptr)
+                {
+                    out.write("    # ");
+                    writeLocal(out, context, *local);
+                }
+                break;
+        }
+        out.put('\n');
+    }
+
+    // 写入switch和数组数据伪指令
+    static void writePayload(OutputSink& out, const MethodLabels& labels, const uint16_t* insns,
+                             uint32_t insnsSize, uint32_t offset, const DecodedInstruction& decoded)
+    {
+        const auto owner = labels.payloadOwners.find(offset);
+        if (decoded.opcode == kFillArrayDataPayload)
+        {
+            const uint32_t width = insns[offset + 1];
+            const uint32_t count = static_cast<uint32_t>(readInsns32(insns, offset + 2));
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(insns + offset + 4);
+            const char* suffix = width == 1 ? "t" : width == 2 ? "s" : width == 8 ? "L" : "";
+
+            out.write("    .array-data ");
+            out.writeDec(width);
+            out.put('\n');
+            if (width == 1 || width == 2 || width == 4 || width == 8)
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    uint64_t value = 0;
+                    memcpy(&value, data + static_cast<size_t>(i) * width, width);
+                    out.write("        ");
+                    writeLiteral(out, signExtend(value, width));
+                    out.write(suffix);
+                    out.put('\n');
+                }
+            }
+            out.write("    .end array-data\n");
+            return;
+        }
+
+        // switch的分支偏移量相对于switch指令
+        const uint32_t count = insns[offset + 1];
+        if (owner == labels.payloadOwners.end())
+        {
+            out.write("    # 没有被引用的switch数据\n");
+            return;
+        }
+
+        const uint32_t switchAddr = owner->second;
+        uint32_t target;
+        if (decoded.opcode == kPackedSwitchPayload)
+        {
+            out.write("    .packed-switch ");
+            writeLiteral(out, readInsns32(insns, offset + 2));
+            out.put('\n');
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (branchTarget(switchAddr, readInsns32(insns, offset + 4 + i * 2), insnsSize, target))
+                {
+                    out.write("        ");
+                    writeLabel(out, "pswitch", target);
+                    out.put('\n');
+                }
+            }
+            out.write("    .end packed-switch\n");
+        }
+        else
+        {
+            out.write("    .sparse-switch\n");
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (branchTarget(switchAddr, readInsns32(insns, offset + 2 + count * 2 + i * 2), insnsSize, target))
+                {
+                    out.write("        ");
+                    writeLiteral(out, readInsns32(insns, offset + 2 + i * 2));
+                    out.write(" -> ");
+                    writeLabel(out, "sswitch", target);
+                    out.put('\n');
+                }
+            }
+            out.write("    .end sparse-switch\n");
+        }
+    }
+
+    // 写入一条指令
+    static void writeInstruction(OutputSink& out, const DexContext& context, const RegisterLayout& layout,
+                                 uint32_t offset, uint32_t insnsSize, const DecodedInstruction& decoded)
+    {
+        using namespace dex::parser;
+
+        const auto reg = [&](uint32_t r)
+        {
+            writeRegister(out, layout, r);
+        };
+        const auto branch = [&](const char* kind)
+        {
+            uint32_t target;
+            if (branchTarget(offset, decoded.branch, insnsSize, target))
+            {
+                writeLabel(out, kind, target);
+            }
+            else
+            {
+                writeLiteral(out, decoded.branch);
+            }
+        };
+        const auto literal = [&]()
+        {
+            writeLiteral(out, decoded.literal);
+            if (decoded.opcode >= kOpConstWide16 && decoded.opcode <= kOpConstWideHigh16)
+            {
+                out.put('L');
+            }
+        };
+
+        // 格式为10x但不是nop/return-void的是未定义的操作码，smali无法表示
+        if (decoded.format == kFmt10x && decoded.opcode != kOpNop && decoded.opcode != kOpReturnVoid)
+        {
+            out.write("    # 未定义的操作码: 0x");
+            writeHex(out, decoded.opcode);
+            out.put('\n');
+            return;
+        }
+
+        out.write("    ");
+        out.write(CodeParser::getOpcodeMnemonic(decoded.opcode));
+
+        switch (decoded.format)
+        {
+            case kFmt10x:
+                break;
+
+            case kFmt11x:
+                out.put(' ');
+                reg(decoded.vA);
+                break;
+
+            case kFmt12x:
+            case kFmt22x:
+            case kFmt32x:
+                out.put(' ');
+                reg(decoded.vA);
+                out.write(", ");
+                reg(decoded.vB);
+                break;
+
+            case kFmt11n:
+            case kFmt21s:
+            case kFmt21h:
+            case kFmt31i:
+            case kFmt51l:
+                out.put(' ');
+                reg(decoded.vA);
+                out.write(", ");
+                literal();
+                break;
+
+            case kFmt10t:
+            case kFmt20t:
+            case kFmt30t:
+                out.put(' ');
+                branch("goto");
+                break;
+
+            case kFmt21t:
+                out.put(' ');
+                reg(decoded.vA);
+                out.write(", ");
+                branch("cond");
+                break;
+
+            case kFmt22t:
+                out.put(' ');
+                reg(decoded.vA);
+                out.write(", ");
+                reg(decoded.vB);
+                out.write(", ");
+                branch("cond");
+                break;
+
+            case kFmt31t:
+                out.put(' ');
+                reg(decoded.vA);
+                out.write(", ");
+                branch(decoded.opcode == kOpPackedSwitch ? "pswitch_data"
+                       : decoded.opcode == kOpSparseSwitch ? "sswitch_data" : "array");
+                break;
+
+            case kFmt21c:
+            case kFmt31c:
+                out.put(' ');
+                reg(decoded.vA);
+                out.write(", ");
+                writeReference(out, context, decoded.indexType, decoded.index);
+                break;
+
+            case kFmt23x:
+                out.put(' ');
+                reg(decoded.vA);
+                out.write(", ");
+                reg(decoded.vB);
+                out.write(", ");
+                reg(decoded.vC);
+                break;
+
+            case kFmt22b:
+            case kFmt22s:
+                out.put(' ');
+                reg(decoded.vA);
+                out.write(", ");
+                reg(decoded.vB);
+                out.write(", ");
+                literal();
+                break;
+
+            case kFmt22c:
+                out.put(' ');
+                reg(decoded.vA);
+                out.write(", ");
+                reg(decoded.vB);
+                out.write(", ");
+                writeReference(out, context, decoded.indexType, decoded.index);
+                break;
+
+            case kFmt35c:
+            case kFmt45cc:
+                out.write(" {");
+                for (uint32_t i = 0; i < decoded.vA && i < 5; i++)
+                {
+                    if (i > 0)
+                    {
+                        out.write(", ");
+                    }
+                    reg(decoded.args[i]);
+                }
+                out.write("}, ");
+                writeReference(out, context, decoded.indexType, decoded.index);
+                if (decoded.format == kFmt45cc)
+                {
+                    out.write(", ");
+                    writeProto(out, context, decoded.index2);
+                }
+                break;
+
+            case kFmt3rc:
+            case kFmt4rcc:
+                out.write(" {");
+                if (decoded.vA > 0)
+                {
+                    reg(decoded.vC);
+                    out.write(" .. ");
+                    reg(decoded.vC + decoded.vA - 1);
+                }
+                out.write("}, ");
+                writeReference(out, context, decoded.indexType, decoded.index);
+                if (decoded.format == kFmt4rcc)
+                {
+                    out.write(", ");
+                    writeProto(out, context, decoded.index2);
+                }
+                break;
+
+            default:
+                // 优化后的指令(22cs/35ms/3rms等)只出现在odex中
+                out.write("    # 不支持的指令格式");
+                break;
+        }
+        out.put('\n');
+    }
+
+    // 写入方法参数名 .param pN, "name"    # Type
+    static void writeParameters(OutputSink& out, const DexContext& context, const RegisterLayout& layout,
+                                uint32_t methodIdx, bool isStatic, const DebugInfoData& debugInfo)
+    {
+        const std::span<const DexMethodId> methodIds = context.getMethodIds();
+        const std::span<const DexProtoId> protoIds = context.getProtoIds();
+        if (methodIdx >= methodIds.size() || methodIds[methodIdx].protoIdx >= protoIds.size())
+        {
+            return;
+        }
+
+        // 实例方法的p0为this，long/double参数占两个寄存器
+        uint32_t reg = layout.firstParam + (isStatic ? 0 : 1);
+        const std::span<const DexTypeItem> params =
+            typeList(context, protoIds[methodIds[methodIdx].protoIdx].parameters_off);
+        for (size_t i = 0; i < params.size(); i++)
+        {
+            const std::string_view type = typeDescriptor(context, params[i].typeIdx);
+            if (i < debugInfo.parameterNames.size() && !debugInfo.parameterNames[i].empty())
+            {
+                out.write("    .param ");
+                writeRegister(out, layout, reg);
+                out.write(", ");
+                // 参数名已解码，按Latin-1逐字节转义
+                out.put('"');
+                for (const char c : debugInfo.parameterNames[i])
+                {
+                    writeEscapedUnit(out, static_cast<unsigned char>(c), '"');
+                }
+                out.write("\"    # ");
+                out.write(type);
+                out.put('\n');
+            }
+            reg += (type == "J" || type == "D") ? 2 : 1;
+        }
+    }
+
+    // 写入方法代码
+    static void writeCode(OutputSink& out, const DexContext& context, uint32_t methodIdx, uint32_t accessFlags,
+                          uint32_t codeOff)
+    {
+        const DexCode* code = context.getCodeItem(codeOff);
+        if (code == nullptr)
+        {
+            out.write("    # 代码偏移量无效\n");
+            return;
+        }
+
+        const uint32_t insnsSize = code->insns_size;
+        const uint16_t* insns = code->insns;
+        const RegisterLayout layout = {
+            code->registers_size,
+            code->registers_size >= code->ins_size ? static_cast<uint32_t>(code->registers_size - code->ins_size) : 0u
+        };
+
+        out.write("    .registers ");
+        out.writeDec(code->registers_size);
+        out.put('\n');
+
+        // try/catch和调试信息都直接解码，不经过上下文的共享缓存
+        CodeInfo codeInfo;
+        if (code->tries_size > 0)
+        {
+            context.parseTryCatchInfo(codeOff, codeInfo);
+        }
+
+        DebugInfoData debugInfo;
+        std::vector<PositionInfo> positions;
+        if (code->debug_info_off != 0 && context.decodeDebugInfo(code->debug_info_off, debugInfo))
+        {
+            writeParameters(out, context, layout, methodIdx, (accessFlags & ACC_STATIC) != 0, debugInfo);
+            positions = debugInfo.lines.decode();
+        }
+        out.put('\n');
+
+        MethodLabels labels;
+        collectLabels(labels, insns, insnsSize, codeInfo);
+
+        // try块按结束地址排序，在结束地址处的指令之前输出.catch
+        std::vector<const TryBlockInfo*> tryEnds;
+        for (const TryBlockInfo& tryBlock : codeInfo.tries)
+        {
+            tryEnds.push_back(&tryBlock);
+        }
+        std::stable_sort(tryEnds.begin(), tryEnds.end(), [](const TryBlockInfo* a, const TryBlockInfo* b)
+        {
+            return a->startAddr + a->insnCount < b->startAddr + b->insnCount;
+        });
+
+        size_t tryCursor = 0;
+        size_t lineCursor = 0;
+        size_t eventCursor = 0;
+        const auto writeBefore = [&](uint32_t address)
+        {
+            while (tryCursor < tryEnds.size() &&
+                   tryEnds[tryCursor]->startAddr + tryEnds[tryCursor]->insnCount <= address)
+            {
+                writeTryEnd(out, context, codeInfo, *tryEnds[tryCursor++]);
+            }
+
+            if (address < labels.kinds.size() && labels.kinds[address] != 0)
+            {
+                for (size_t bit = 0; bit < std::size(kLabelNames); bit++)
+                {
+                    if ((labels.kinds[address] & (1u << bit)) != 0)
+                    {
+                        out.write("    ");
+                        writeLabel(out, kLabelNames[bit], address);
+                        out.put('\n');
+                    }
+                }
+            }
+
+            while (lineCursor < positions.size() && positions[lineCursor].address <= address)
+            {
+                out.write("    .line ");
+                out.writeDec(positions[lineCursor++].lineNum);
+                out.put('\n');
+            }
+            while (eventCursor < debugInfo.localEvents.size() && debugInfo.localEvents[eventCursor].address <= address)
+            {
+                writeLocalEvent(out, context, layout, debugInfo, debugInfo.localEvents[eventCursor++]);
+            }
+        };
+
+        DecodedInstruction decoded;
+        uint32_t offset = 0;
+        while (offset < insnsSize)
+        {
+            if (!CodeParser::decodeInstruction(insns, insnsSize, offset, decoded) || decoded.length == 0)
+            {
+                out.write("    # 指令超出代码段范围\n");
+                break;
+            }
+
+            writeBefore(offset);
+            if (decoded.format == dex::parser::kFmtPayload)
+            {
+                writePayload(out, labels, insns, insnsSize, offset, decoded);
+            }
+            else
+            {
+                writeInstruction(out, context, layout, offset, insnsSize, decoded);
+            }
+            offset += decoded.length;
+        }
+        writeBefore(insnsSize);
+    }
+
+    // 写入方法
+    static void writeMethod(OutputSink& out, const DexContext& context,
+                            const ClassDefInfo::ClassDataInfo::EncodedMethodInfo& method)
+    {
+        out.write(".method ");
+        writeAccessFlags(out, method.accessFlags, kMethodFlags);
+        const std::span<const DexMethodId> methodIds = context.getMethodIds();
+        if (method.methodIdx < methodIds.size())
+        {
+            out.write(stringData(context, methodIds[method.methodIdx].nameIdx));
+            writeProto(out, context, methodIds[method.methodIdx].protoIdx);
+        }
+        out.put('\n');
+
+        if (method.codeOff != 0)
+        {
+            writeCode(out, context, method.methodIdx, method.accessFlags, method.codeOff);
+        }
+        out.write(".end method\n");
+    }
+
+    // 写入字段，静态字段带初始值；初始值无效时返回false，之后的初始值不再读取
+    static bool writeField(OutputSink& out, const DexContext& context,
+                           const ClassDefInfo::ClassDataInfo::EncodedFieldInfo& field, CheckedReader* values)
+    {
+        out.write(".field ");
+        writeAccessFlags(out, field.accessFlags, kFieldFlags);
+        const std::span<const DexFieldId> fieldIds = context.getFieldIds();
+        if (field.fieldIdx < fieldIds.size())
+        {
+            out.write(stringData(context, fieldIds[field.fieldIdx].nameIdx));
+            out.put(':');
+            out.write(typeDescriptor(context, fieldIds[field.fieldIdx].typeIdx));
+        }
+
+        if (values != nullptr)
+        {
+            // 先渲染到临时缓冲区，数据无效时不输出半个值
+            MemorySink value(64);
+            if (!writeEncodedValue(value, context, *values, 0))
+            {
+                out.put('\n');
+                return false;
+            }
+            out.write(" = ");
+            out.write(value.str());
+        }
+        out.put('\n');
+        return true;
+    }
+
+    SmaliPrint::SmaliPrint(std::string outputDir)
+        : outputDir_(std::move(outputDir))
+    {
+    }
+
+    std::string SmaliPrint::classFilePath(std::string_view descriptor)
+    {
+        if (descriptor.size() >= 2 && descriptor.front() == 'L' && descriptor.back() == ';')
+        {
+            descriptor = descriptor.substr(1, descriptor.size() - 2);
+        }
+
+        std::string path;
+        path.reserve(descriptor.size() + 6);
+        size_t segmentStart = 0;
+        for (size_t i = 0; i <= descriptor.size(); i++)
+        {
+            if (i < descriptor.size() && descriptor[i] != '/')
+            {
+                continue;
+            }
+
+            // 空段、.和..会改变目录层级，替换为_
+            const std::string_view segment = descriptor.substr(segmentStart, i - segmentStart);
+            if (segment.empty() || segment == "." || segment == "..")
+            {
+                path += '_';
+            }
+            else
+            {
+                for (const char c : segment)
+                {
+                    const unsigned char u = static_cast<unsigned char>(c);
+                    path += (u < 0x20 || std::strchr("<>:\"\\|?*", c) != nullptr) ? '_' : c;
+                }
+            }
+            path += i < descriptor.size() ? "/" : ".smali";
+            segmentStart = i + 1;
+        }
+        return path;
+    }
+
+    void SmaliPrint::printClass(OutputSink& out, uint32_t classDefIdx) const
+    {
+        const DexContext& context = getContext();
+        const std::span<const DexClassDef> classDefs = context.getClassDefs();
+        if (classDefIdx >= classDefs.size())
+        {
+            LOGE("类定义索引无效: %u", classDefIdx);
+            return;
+        }
+
+        const DexClassDef& classDef = classDefs[classDefIdx];
+        const ClassDefInfo classInfo = context.getClassDefInfo(classDefIdx);
+        const ClassDefInfo::ClassDataInfo& classData = classInfo.classData;
+
+        out.write(".class ");
+        writeAccessFlags(out, classDef.accessFlags, kClassFlags);
+        out.write(typeDescriptor(context, classDef.classIdx));
+        out.put('\n');
+        if (classDef.superclassIdx != kNoIndex)
+        {
+            out.write(".super ");
+            out.write(typeDescriptor(context, classDef.superclassIdx));
+            out.put('\n');
+        }
+        if (classDef.sourceFileIdx != kNoIndex && classDef.sourceFileIdx < context.getStringIdsCount())
+        {
+            out.write(".source ");
+            writeString(out, stringData(context, classDef.sourceFileIdx));
+            out.put('\n');
+        }
+
+        const std::span<const DexTypeItem> interfaces = typeList(context, classDef.interfacesOff);
+        if (!interfaces.empty())
+        {
+            out.write("\n# interfaces\n");
+            for (const DexTypeItem& item : interfaces)
+            {
+                out.write(".implements ");
+                out.write(typeDescriptor(context, item.typeIdx));
+                out.put('\n');
+            }
+        }
+
+        // 静态字段的初始值按顺序存放在encoded_array中，数量可以少于静态字段数量
+        // 编码值长度无法预知，读取器以encoded_array_item段结尾为界
+        CheckedReader values(context.getFileData(),
+                             context.getSectionEnd(kDexTypeEncodedArrayItem, classDef.staticValuesOff),
+                             classDef.staticValuesOff);
+        uint32_t valueCount = 0;
+        if (classDef.staticValuesOff != 0)
+        {
+            valueCount = values.readULEB128();
+            if (!values.ok())
+            {
+                valueCount = 0;
+            }
+        }
+
+        if (!classData.staticFields.empty())
+        {
+            out.write("\n\n# static fields\n");
+            for (size_t i = 0; i < classData.staticFields.size(); i++)
+            {
+                if (i > 0)
+                {
+                    out.put('\n');
+                }
+                if (!writeField(out, context, classData.staticFields[i], i < valueCount ? &values : nullptr))
+                {
+                    valueCount = 0;
+                }
+            }
+        }
+
+        if (!classData.instanceFields.empty())
+        {
+            out.write("\n\n# instance fields\n");
+            for (size_t i = 0; i < classData.instanceFields.size(); i++)
+            {
+                if (i > 0)
+                {
+                    out.put('\n');
+                }
+                writeField(out, context, classData.instanceFields[i], nullptr);
+            }
+        }
+
+        if (!classData.directMethods.empty())
+        {
+            out.write("\n\n# direct methods\n");
+            for (size_t i = 0; i < classData.directMethods.size(); i++)
+            {
+                if (i > 0)
+                {
+                    out.put('\n');
+                }
+                writeMethod(out, context, classData.directMethods[i]);
+            }
+        }
+
+        if (!classData.virtualMethods.empty())
+        {
+            out.write("\n\n# virtual methods\n");
+            for (size_t i = 0; i < classData.virtualMethods.size(); i++)
+            {
+                if (i > 0)
+                {
+                    out.put('\n');
+                }
+                writeMethod(out, context, classData.virtualMethods[i]);
+            }
+        }
+    }
+
+    void SmaliPrint::print()
+    {
+        OutputSink& out = getSink();
+        const DexContext& context = getContext();
+
+        if (!context.isValid())
+        {
+            LOGE("DEX解析未完成或无效，无法输出smali");
+            return;
+        }
+
+        // 设置了类过滤器时只输出选中的类
+        const std::span<const uint32_t> selected = context.getSelectedClassDefs();
+        const uint32_t classCount = static_cast<uint32_t>(selected.size());
+        if (classCount == 0)
+        {
+            out.write("Class表为空\n");
+            out.flush();
+            return;
+        }
+
+        // 并行输出时各线程只读取缓存，先加载全部类定义
+        context.loadAllClassDefs();
+
+        // 先确定每个类的文件路径并创建目录；路径在不区分大小写的文件系统上重复时追加类定义索引
+        const std::filesystem::path root(outputDir_);
+        std::vector<std::filesystem::path> paths(classCount);
+        std::unordered_set<std::string> usedPaths;
+        std::unordered_set<std::string> createdDirs;
+        for (uint32_t i = 0; i < classCount; i++)
+        {
+            const uint32_t classIdx = context.getClassDefs()[selected[i]].classIdx;
+            std::string relative = classFilePath(typeDescriptor(context, classIdx));
+            std::string key = relative;
+            std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return std::tolower(c); });
+            if (!usedPaths.insert(key).second)
+            {
+                relative.insert(relative.size() - 6, "_" + std::to_string(selected[i]));
+            }
+
+            paths[i] = root / std::filesystem::path(std::u8string(relative.begin(), relative.end()));
+            const std::filesystem::path parent = paths[i].parent_path();
+            if (createdDirs.insert(parent.string()).second)
+            {
+                std::error_code ec;
+                std::filesystem::create_directories(parent, ec);
+                if (ec)
+                {
+                    LOGE("创建目录失败: %s", parent.string().c_str());
+                    return;
+                }
+            }
+        }
+
+        std::atomic<uint32_t> failed{0};
+        parallelFor(classCount, kClassesPerChunk, context.getThreadCount(),
+                    [&](size_t, size_t begin, size_t end)
+                    {
+                        MemorySink text;
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            printClass(text, selected[i]);
+                            const std::string& content = text.str();
+
+                            std::ofstream file(paths[i], std::ios::binary | std::ios::trunc);
+                            file.write(content.data(), static_cast<std::streamsize>(content.size()));
+                            if (!file)
+                            {
+                                LOGE("写入smali文件失败: %s", paths[i].string().c_str());
+                                failed.fetch_add(1, std::memory_order_relaxed);
+                            }
+                            text.clear();
+                        }
+                    });
+
+        out.printf("已输出 %u 个类的smali文件到 %s", classCount - failed.load(), outputDir_.c_str());
+        if (failed.load() != 0)
+        {
+            out.printf("，%u 个失败", failed.load());
+        }
+        out.put('\n');
+        out.flush();
+    }
+}
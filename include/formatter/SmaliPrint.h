@@ -0,0 +1,64 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef SMALIPRINT_H
+#define SMALIPRINT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "BasePrint.h"
+
+namespace dex::print
+{
+    /**
+     * smali反汇编输出类
+     * 按smali语法输出整个DEX文件，每个类一个文件：<输出目录>/<包路径>/<类名>.smali。
+     * 包含类头部、带静态初始值的字段、方法（.registers、参数名、分支/switch/try标签、
+     * .catch、.line/.local调试信息以及switch和数组数据），可以直接交给smali重新汇编。
+     * 类之间并行渲染，渲染过程只读取映射的文件和预先加载的缓存。
+     * 注解、call_site和method_handle引用不在输出范围内。
+     */
+    class SmaliPrint final : public BasePrint
+    {
+    public:
+        /**
+         * 构造函数
+         * @param outputDir 输出目录，不存在时自动创建
+         */
+        explicit SmaliPrint(std::string outputDir);
+
+        /**
+         * 析构函数
+         */
+        ~SmaliPrint() override = default;
+
+        /**
+         * 实现基类的打印接口（把全部类写入输出目录，向输出目标写入汇总）
+         */
+        void print() override;
+
+        /**
+         * 输出单个类的smali文本
+         * 调用前需要加载全部类定义（DexContext::loadAllClassDefs）
+         * @param out 输出目标
+         * @param classDefIdx 类定义索引
+         */
+        void printClass(OutputSink& out, uint32_t classDefIdx) const;
+
+        /**
+         * 获取类描述符对应的smali文件相对路径
+         * 去掉描述符首尾的L和;，路径中不能用作文件名的字符替换为_
+         * @param descriptor 类描述符（MUTF-8）
+         * @return 相对路径，例如com/example/Foo.smali
+         */
+        static std::string classFilePath(std::string_view descriptor);
+
+    private:
+        // 输出目录
+        std::string outputDir_;
+    };
+}
+
+#endif //SMALIPRINT_H
@@ -0,0 +1,169 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "StatsPrint.h"
+#include <algorithm>
+#include <string>
+#include "JsonWriter.h"
+#include "log/log.h"
+
+namespace dex::print
+{
+    namespace
+    {
+        // 选中类中的代码统计
+        struct CodeStats
+        {
+            uint64_t classes = 0;          // 类数量
+            uint64_t classesWithData = 0;  // 有class_data的类数量
+            uint64_t methods = 0;          // 定义的方法数量
+            uint64_t methodsWithCode = 0;  // 有代码的方法数量
+            uint64_t codeUnits = 0;        // 指令总长度(16位字)
+            uint64_t maxCodeUnits = 0;     // 最长方法的指令长度
+            uint64_t maxRegisters = 0;     // 最大寄存器数量
+            uint64_t tryBlocks = 0;        // try块总数
+            uint64_t debugInfos = 0;       // 带调试信息的方法数量
+        };
+
+        CodeStats collectCodeStats(const DexContext& context)
+        {
+            CodeStats stats;
+            context.loadAllClassDefs();
+
+            const auto countMethods = [&](const std::vector<ClassDefInfo::ClassDataInfo::EncodedMethodInfo>& methods)
+            {
+                stats.methods += methods.size();
+                for (const auto& method : methods)
+                {
+                    const DexCode* code = method.codeOff != 0 ? context.getCodeItem(method.codeOff) : nullptr;
+                    if (code == nullptr)
+                    {
+                        continue;
+                    }
+                    stats.methodsWithCode++;
+                    stats.codeUnits += code->insns_size;
+                    stats.maxCodeUnits = std::max<uint64_t>(stats.maxCodeUnits, code->insns_size);
+                    stats.maxRegisters = std::max<uint64_t>(stats.maxRegisters, code->registers_size);
+                    stats.tryBlocks += code->tries_size;
+                    stats.debugInfos += code->debug_info_off != 0 ? 1 : 0;
+                }
+            };
+
+            for (const uint32_t classDefIdx : context.getSelectedClassDefs())
+            {
+                const ClassDefInfo info = context.getClassDefInfo(classDefIdx);
+                stats.classes++;
+                if (!info.classData.isLoaded)
+                {
+                    continue;
+                }
+                stats.classesWithData++;
+                countMethods(info.classData.directMethods);
+                countMethods(info.classData.virtualMethods);
+            }
+            return stats;
+        }
+    }
+
+    StatsPrint::StatsPrint(bool json) : json_(json)
+    {
+    }
+
+    void StatsPrint::print()
+    {
+        OutputSink& out = getSink();
+        const DexContext& context = getContext();
+
+        if (!context.isValid())
+        {
+            LOGE("DEX解析未完成或无效，无法打印统计信息");
+            return;
+        }
+
+        const CodeStats stats = collectCodeStats(context);
+        const MemoryUsage usage = context.getMemoryUsage();
+        constexpr auto kCacheCount = static_cast<size_t>(CacheKind::Count);
+
+        if (json_)
+        {
+            JsonWriter json(out);
+            json.beginObject();
+            json.field("kind", "stats");
+            json.field("fileSize", context.getFileSize());
+            json.field("strings", context.getStringIdsCount());
+            json.field("types", context.getTypeIdsCount());
+            json.field("protos", context.getProtoIdsCount());
+            json.field("fields", context.getFieldIdsCount());
+            json.field("methods", context.getMethodIdsCount());
+            json.field("classDefs", context.getClassDefsCount());
+            json.field("mapSections", context.getMapSections().size());
+            json.field("selectedClasses", stats.classes);
+            json.field("classesWithData", stats.classesWithData);
+            json.field("definedMethods", stats.methods);
+            json.field("methodsWithCode", stats.methodsWithCode);
+            json.field("codeUnits", stats.codeUnits);
+            json.field("maxCodeUnits", stats.maxCodeUnits);
+            json.field("maxRegisters", stats.maxRegisters);
+            json.field("tryBlocks", stats.tryBlocks);
+            json.field("debugInfos", stats.debugInfos);
+            json.field("cacheBytes", usage.totalBytes());
+            json.field("cacheBudget", context.getMemoryBudget());
+            json.beginObject("caches");
+            for (size_t i = 0; i < kCacheCount; i++)
+            {
+                const auto kind = static_cast<CacheKind>(i);
+                json.beginObject(DexContext::getCacheName(kind));
+                json.field("entries", usage[kind].entries);
+                json.field("bytes", usage[kind].bytes);
+                json.endObject();
+            }
+            json.endObject();
+            json.endObject();
+            out.flush();
+            return;
+        }
+
+        const auto row = [&out](const char* name, uint64_t value)
+        {
+            out.printf("| %-22s | %-15llu |\n", name, static_cast<unsigned long long>(value));
+        };
+
+        out.write("/-----------------------------------------------\\\n");
+        out.write("|              DEX Statistics                 |\n");
+        out.write("+-----------------------+-----------------------+\n");
+        row("File Size:", context.getFileSize());
+        row("Map Sections:", context.getMapSections().size());
+        out.write("+-----------------------+-----------------------+\n");
+        row("Strings:", context.getStringIdsCount());
+        row("Types:", context.getTypeIdsCount());
+        row("Protos:", context.getProtoIdsCount());
+        row("Fields:", context.getFieldIdsCount());
+        row("Methods:", context.getMethodIdsCount());
+        row("Class Defs:", context.getClassDefsCount());
+        out.write("+-----------------------+-----------------------+\n");
+        row("Selected Classes:", stats.classes);
+        row("Classes With Data:", stats.classesWithData);
+        row("Defined Methods:", stats.methods);
+        row("Methods With Code:", stats.methodsWithCode);
+        row("Code Units:", stats.codeUnits);
+        row("Max Code Units:", stats.maxCodeUnits);
+        row("Max Registers:", stats.maxRegisters);
+        row("Try Blocks:", stats.tryBlocks);
+        row("Debug Infos:", stats.debugInfos);
+        out.write("+-----------------------+-----------------------+\n");
+        for (size_t i = 0; i < kCacheCount; i++)
+        {
+            const auto kind = static_cast<CacheKind>(i);
+            const std::string name = std::string("Cache ") + DexContext::getCacheName(kind) + ":";
+            row(name.c_str(), usage[kind].bytes);
+        }
+        row("Cache Total:", usage.totalBytes());
+        if (context.getMemoryBudget() != 0)
+        {
+            row("Cache Budget:", context.getMemoryBudget());
+        }
+        out.write("\\-----------------------------------------------/\n");
+        out.flush();
+    }
+}
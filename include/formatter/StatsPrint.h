@@ -0,0 +1,48 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef STATSPRINT_H
+#define STATSPRINT_H
+
+#include <cstdint>
+#include "BasePrint.h"
+
+namespace dex::print
+{
+    /**
+     * DEX统计信息输出类
+     * 汇总各ID表的大小以及选中类中的方法代码规模（代码单元、寄存器、try块、调试信息），
+     * 只读取类定义和代码段头部，不解码指令。最后列出上下文各缓存的内存占用。
+     */
+    class StatsPrint final : public BasePrint
+    {
+    public:
+        /**
+         * 构造函数
+         */
+        StatsPrint() = default;
+
+        /**
+         * 构造函数
+         * @param json 是否输出一条JSON记录（kind为stats）而不是表格
+         */
+        explicit StatsPrint(bool json);
+
+        /**
+         * 析构函数
+         */
+        ~StatsPrint() override = default;
+
+        /**
+         * 打印统计信息
+         */
+        void print() override;
+
+    private:
+        // 是否输出JSON
+        bool json_ = false;
+    };
+}
+
+#endif //STATSPRINT_H
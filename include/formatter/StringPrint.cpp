@@ -13,6 +13,8 @@ namespace dex::print
 {
     void StringPrint::print()
     {
+        OutputSink& out = getSink();
+
         // 获取上下文
         const DexContext& context = getContext();
         
@@ -31,14 +33,14 @@ namespace dex::print
             return;
         }
         
-        printf("\n/----------------------------------------------------------\\\n");
-        printf("|                    DEX String Table                    |\n");
-        printf("+------+----------------+-------------------------------+\n");
-        printf("| %-4s | %-14s | %-29s |\n", "索引", "偏移量", "字符串内容");
-        printf("+------+----------------+-------------------------------+\n");
+        out.write("\n/----------------------------------------------------------\\\n");
+        out.write("|                    DEX String Table                    |\n");
+        out.write("+------+----------------+-------------------------------+\n");
+        out.printf("| %-4s | %-14s | %-29s |\n", "索引", "偏移量", "字符串内容");
+        out.write("+------+----------------+-------------------------------+\n");
         
         // 获取字符串ID表
-        const std::vector<DexStringId>& stringIds = context.getStringIds();
+        std::span<const DexStringId> stringIds = context.getStringIds();
         
         // 打印字符串表
         for (uint32_t i = 0; i < stringCount; i++)
@@ -62,20 +64,27 @@ namespace dex::print
             }
             
             // 打印行
-            printf("| %4u | 0x%12X | %-29s |\n", 
-                i, stringIds[i].stringDataOff, content.c_str());
+            out.write("| ");
+            out.writeDec(i, 4);
+            out.write(" | 0x");
+            out.writeHex(stringIds[i].stringDataOff, 12, ' ');
+            out.write(" | ");
+            out.writePadded(content, 29);
+            out.write(" |\n");
             
             // 每25行打印一次表头
             if ((i + 1) % 25 == 0 && i + 1 < stringCount)
             {
-                printf("+------+----------------+-------------------------------+\n");
-                printf("| %-4s | %-14s | %-29s |\n", "索引", "偏移量", "字符串内容");
-                printf("+------+----------------+-------------------------------+\n");
+                out.write("+------+----------------+-------------------------------+\n");
+                out.printf("| %-4s | %-14s | %-29s |\n", "索引", "偏移量", "字符串内容");
+                out.write("+------+----------------+-------------------------------+\n");
             }
         }
         
-        printf("+------+----------------+-------------------------------+\n");
-        printf("| 共计: %-42u |\n", stringCount);
-        printf("\\----------------------------------------------------------/\n");
+        out.write("+------+----------------+-------------------------------+\n");
+        out.printf("| 共计: %-42u |\n", stringCount);
+        out.write("\\----------------------------------------------------------/\n");
+
+        out.flush();
     }
 } 
\ No newline at end of file
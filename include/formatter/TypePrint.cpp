@@ -10,6 +10,8 @@ namespace dex::print
 {
     void TypePrint::print()
     {
+        OutputSink& out = getSink();
+
         // 通过上下文获取TypeID表
         const DexContext& context = getContext();
 
@@ -26,15 +28,15 @@ namespace dex::print
             LOGW("类型表为空\n");
             return;
         }
-        printf("\n/----------------------------------------------------------\\\n");
-        printf("|                       DEX Type Table                              |\n");
-        printf("+------+----------------+-------------------------------+\n");
-        printf("| %-4s | %-14s | %-29s |\n", "索引", "偏移量", "字符串内容");
-        printf("+------+----------------+-------------------------------+\n");
+        out.write("\n/----------------------------------------------------------\\\n");
+        out.write("|                       DEX Type Table                              |\n");
+        out.write("+------+----------------+-------------------------------+\n");
+        out.printf("| %-4s | %-14s | %-29s |\n", "索引", "偏移量", "字符串内容");
+        out.write("+------+----------------+-------------------------------+\n");
 
 
         // 获取TypeIds表
-        const std::vector<DexTypeId>& typeIds = context.getTypeIds();
+        std::span<const DexTypeId> typeIds = context.getTypeIds();
         // 打印类型表
         for (int i = 0; i < typeCount; ++i)
         {
@@ -55,16 +57,23 @@ namespace dex::print
             }
 
             // 打印行
-            printf("| %4u | 0x%12X | %-29s |\n",
-                   i, typeIds[i].descriptor_idx, type.c_str());
+            out.write("| ");
+            out.writeDec(i, 4);
+            out.write(" | 0x");
+            out.writeHex(typeIds[i].descriptor_idx, 12, ' ');
+            out.write(" | ");
+            out.writePadded(type, 29);
+            out.write(" |\n");
 
             // 每25行打印一次表头
             if ((i + 1) % 25 == 0 && i + 1 < typeCount)
             {
-                printf("+------+----------------+-------------------------------+\n");
-                printf("| %-4s | %-14s | %-29s |\n", "索引", "偏移量", "字符串内容");
-                printf("+------+----------------+-------------------------------+\n");
+                out.write("+------+----------------+-------------------------------+\n");
+                out.printf("| %-4s | %-14s | %-29s |\n", "索引", "偏移量", "字符串内容");
+                out.write("+------+----------------+-------------------------------+\n");
             }
         }
+
+        out.flush();
     }
 }
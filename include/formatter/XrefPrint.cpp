@@ -0,0 +1,137 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "XrefPrint.h"
+#include <string>
+#include <utility>
+#include "parser/CodeParser.h"
+#include "log/log.h"
+
+namespace dex::print
+{
+    namespace
+    {
+        const char* typeUsageName(TypeUsageKind kind)
+        {
+            switch (kind)
+            {
+                case TYPE_USAGE_NEW_INSTANCE: return "new-instance";
+                case TYPE_USAGE_CHECK_CAST: return "check-cast";
+                case TYPE_USAGE_INSTANCE_OF: return "instance-of";
+                case TYPE_USAGE_CONST_CLASS: return "const-class";
+                case TYPE_USAGE_NEW_ARRAY: return "new-array";
+                case TYPE_USAGE_CATCH: return "catch";
+                default: return "unknown";
+            }
+        }
+
+        // 输出 Lc;->name 形式的方法名
+        void writeMethodName(OutputSink& out, const DexContext& context, uint32_t methodIdx)
+        {
+            const MethodInfo info = context.getMethodInfo(methodIdx);
+            out.write(info.className);
+            out.write("->");
+            out.write(info.name);
+        }
+    }
+
+    XrefPrint::XrefPrint(std::vector<uint32_t> fieldIdxs, std::vector<uint32_t> typeIdxs)
+        : fieldIdxs_(std::move(fieldIdxs)), typeIdxs_(std::move(typeIdxs))
+    {
+    }
+
+    void XrefPrint::print()
+    {
+        if (!getContext().isValid())
+        {
+            LOGE("DEX解析未完成或无效，无法打印交叉引用");
+            return;
+        }
+
+        for (const uint32_t fieldIdx : fieldIdxs_)
+        {
+            printFieldAccessors(fieldIdx);
+        }
+        for (const uint32_t typeIdx : typeIdxs_)
+        {
+            printTypeUsages(typeIdx);
+        }
+        getSink().flush();
+    }
+
+    void XrefPrint::printFieldAccessors(uint32_t fieldIdx)
+    {
+        OutputSink& out = getSink();
+        const DexContext& context = getContext();
+
+        if (fieldIdx >= context.getFieldIdsCount())
+        {
+            LOGE("字段索引越界: %u (共 %u 个字段)", fieldIdx, context.getFieldIdsCount());
+            return;
+        }
+        if (!context.buildFieldXrefs())
+        {
+            LOGE("构建字段交叉引用索引失败");
+            return;
+        }
+
+        const FieldInfo field = context.getFieldInfo(fieldIdx);
+        out.printf("\n字段 #%u: %s->%s:%s (读取 %u, 写入 %u)\n", fieldIdx, field.className.c_str(),
+                   field.name.c_str(), field.typeName.c_str(), context.getFieldReaderCount(fieldIdx),
+                   context.getFieldWriterCount(fieldIdx));
+
+        const std::span<const FieldAccessSite> sites = context.getFieldAccessors(fieldIdx);
+        if (sites.empty())
+        {
+            out.write("  没有访问点\n");
+            return;
+        }
+        for (const FieldAccessSite& site : sites)
+        {
+            out.write("  ");
+            out.write(site.isWrite ? "W " : "R ");
+            out.writePadded(parser::CodeParser::getOpcodeMnemonic(site.opcode), 16);
+            out.write(" 0x");
+            out.writeHex(site.pc * 2ULL, 4);
+            out.write("  ");
+            writeMethodName(out, context, site.methodIdx);
+            out.put('\n');
+        }
+    }
+
+    void XrefPrint::printTypeUsages(uint32_t typeIdx)
+    {
+        OutputSink& out = getSink();
+        const DexContext& context = getContext();
+
+        if (typeIdx >= context.getTypeIdsCount())
+        {
+            LOGE("类型索引越界: %u (共 %u 个类型)", typeIdx, context.getTypeIdsCount());
+            return;
+        }
+        if (!context.buildTypeUsages())
+        {
+            LOGE("构建类型使用索引失败");
+            return;
+        }
+
+        const std::span<const TypeUsageSite> sites = context.getTypeUsages(typeIdx);
+        out.printf("\n类型 #%u: %s (%zu 处使用)\n", typeIdx, context.getType(typeIdx).c_str(), sites.size());
+        if (sites.empty())
+        {
+            out.write("  没有使用点\n");
+            return;
+        }
+        for (const TypeUsageSite& site : sites)
+        {
+            out.write("  ");
+            out.writePadded(typeUsageName(site.kind), 14);
+            out.write(" 0x");
+            out.writeHex(site.pc * 2ULL, 4);
+            out.write("  ");
+            writeMethodName(out, context, site.methodIdx);
+            out.put('\n');
+        }
+    }
+}
@@ -0,0 +1,54 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef XREFPRINT_H
+#define XREFPRINT_H
+
+#include <cstdint>
+#include <vector>
+#include "BasePrint.h"
+
+namespace dex::print
+{
+    /**
+     * 交叉引用输出类
+     * 列出指定字段的全部访问点和指定类型的全部使用点（方法、指令地址、访问方式），
+     * 数据来自DexContext的字段交叉引用索引和类型使用索引。
+     */
+    class XrefPrint final : public BasePrint
+    {
+    public:
+        /**
+         * 构造函数
+         * @param fieldIdxs 要列出访问点的字段索引
+         * @param typeIdxs 要列出使用点的类型索引
+         */
+        XrefPrint(std::vector<uint32_t> fieldIdxs, std::vector<uint32_t> typeIdxs);
+
+        /**
+         * 析构函数
+         */
+        ~XrefPrint() override = default;
+
+        /**
+         * 打印全部指定字段和类型的交叉引用
+         */
+        void print() override;
+
+        // 打印单个字段的访问点
+        void printFieldAccessors(uint32_t fieldIdx);
+
+        // 打印单个类型的使用点
+        void printTypeUsages(uint32_t typeIdx);
+
+    private:
+        // 字段索引
+        std::vector<uint32_t> fieldIdxs_;
+
+        // 类型索引
+        std::vector<uint32_t> typeIdxs_;
+    };
+}
+
+#endif //XREFPRINT_H
@@ -4,6 +4,9 @@
 LogLevel g_logLevel = LOG_LEVEL_INFO;
 bool g_logColorEnabled = false;
 
+// 当前线程的日志捕获缓冲区
+static thread_local std::string* t_logCapture = nullptr;
+
 // 日志级别文本表示
 static const char* LOG_LEVEL_NAMES[] = {
     "VERBOSE", "DEBUG", "INFO", "WARNING", "ERROR", "FATAL"
@@ -52,6 +55,12 @@ void log_enable_color(bool enable)
     }
 }
 
+void log_set_thread_capture(std::string* buffer)
+{
+    t_logCapture = buffer;
+}
+
+#ifdef _WIN32
 char* log_win_error_msg(DWORD error_code)
 {
     static char error_msg[1024]; // 静态缓冲区，避免内存泄漏
@@ -81,6 +90,7 @@ char* log_win_error_msg(DWORD error_code)
 
     return error_msg;
 }
+#endif
 
 const char* log_extract_filename(const char* path)
 {
@@ -106,6 +116,19 @@ void log_print(LogLevel level, const char* file, int line, const char* func, con
         return;
     }
 
+    // 捕获到缓冲区时只保留级别和内容
+    if (t_logCapture != nullptr)
+    {
+        char message[1024];
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(message, sizeof(message), fmt, args);
+        va_end(args);
+
+        t_logCapture->append("[").append(LOG_LEVEL_NAMES[level]).append("] ").append(message).push_back('\n');
+        return;
+    }
+
     // 获取当前时间
     time_t now = time(nullptr);
     if (now == static_cast<time_t>(-1))
@@ -115,7 +138,11 @@ void log_print(LogLevel level, const char* file, int line, const char* func, con
     }
 
     tm tm_info;
+#ifdef _WIN32
     if (localtime_s(&tm_info, &now) != 0)
+#else
+    if (localtime_r(&now, &tm_info) == nullptr)
+#endif
     {
         fprintf(stderr, "[ERROR] Failed to convert time!\n");
         return;
@@ -10,6 +10,7 @@
 #include <ctime>
 #include <cstring>
 #include <cstdlib>
+#include <string>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -54,6 +55,9 @@ void log_init();
 // 设置是否启用颜色
 void log_enable_color(bool enable);
 
+// 设置当前线程的日志捕获缓冲区，不为nullptr时本线程的日志（不含时间和位置）追加到缓冲区而不输出到stderr
+void log_set_thread_capture(std::string* buffer);
+
 #ifdef _WIN32
 // 将Windows错误代码转换为错误消息
  char* log_win_error_msg(DWORD error_code);
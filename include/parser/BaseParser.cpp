@@ -9,7 +9,8 @@
 namespace dex::parser
 {
     BaseParser::BaseParser(const uint8_t* fileData, size_t fileSize, const DexHeader* header)
-        : BaseFileData_(fileData), BaseFileSize_(fileSize), BaseHeader_(header), lastError_()
+        : BaseFileData_(fileData), BaseFileSize_(fileSize), BaseHeader_(header), BaseReader_(fileData, fileSize),
+          lastError_()
     {
     }
 
@@ -22,7 +23,7 @@ namespace dex::parser
         return lastError_;
     }
 
-    bool BaseParser::isValidOffset(const uint32_t offset, const uint32_t size) const
+    bool BaseParser::isValidOffset(const uint32_t offset, const size_t size) const
     {
         // 检查偏移量是否在文件范围内
         if (offset >= BaseFileSize_)
@@ -30,13 +31,8 @@ namespace dex::parser
             return false;
         }
 
-        // 如果提供了大小，则检查偏移量+大小是否超出文件范围
-        if (size > 0 && offset + size > BaseFileSize_)
-        {
-            return false;
-        }
-
-        return true;
+        // 用剩余长度比较，避免offset + size溢出
+        return BaseReader_.isValidRange(offset, size);
     }
 
     void BaseParser::setError(const std::string& error) const
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <string>
 #include "core/DexFile.h"
+#include "core/DexReader.h"
 
 namespace dex::parser
 {
@@ -63,12 +64,12 @@ namespace dex::parser
 
     protected:
         /**
-         * 检查偏移量是否有效
+         * 检查偏移量是否有效（offset位于文件内，且[offset, offset + size)不超出文件范围）
          * @param offset 偏移量
          * @param size 大小
          * @return 是否有效
          */
-        bool isValidOffset(uint32_t offset, uint32_t size = 0) const;
+        bool isValidOffset(uint32_t offset, size_t size = 0) const;
 
         // 文件数据指针
         const uint8_t* BaseFileData_;
@@ -79,6 +80,9 @@ namespace dex::parser
         // DEX头部指针
         const DexHeader* BaseHeader_;
 
+        // 整个文件的带检查读取器
+        CheckedReader BaseReader_;
+
         // 最后一次错误信息
         mutable std::string lastError_;
     };
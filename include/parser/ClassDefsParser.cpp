@@ -39,16 +39,14 @@ namespace dex::parser
             return true; // 空表也是有效的
         }
 
-        // 检查ClassDef表偏移量是否有效
-        if (header.classDefsOff + header.classDefsSize * sizeof(DexClassDef) > BaseFileSize_)
+        // 获取ClassDef表指针（按条目数检查范围，避免条目数乘元素大小时溢出）
+        classDefs_ = BaseReader_.array<DexClassDef>(header.classDefsOff, header.classDefsSize);
+        if (classDefs_ == nullptr)
         {
             setError("ClassDef表偏移量或大小无效");
             return false;
         }
-
-        // 获取ClassDef表指针
         classDefsSize_ = header.classDefsSize;
-        classDefs_ = reinterpret_cast<const DexClassDef*>(BaseFileData_ + header.classDefsOff);
         
         // 验证ClassDef表数据
         for (uint32_t i = 0; i < classDefsSize_; i++)
@@ -4,119 +4,499 @@
 
 #include "CodeParser.h"
 #include "log/log.h"
-#include <sstream>
-#include <iomanip>
 
+#include "OperandFormat.h"
 #include "core/DexContext.h"
+#include "core/PhaseStats.h"
 
 namespace dex::parser
 {
-    // Dalvik指令集格式标志
-    enum DalvikFormatFlag
-    {
-        kFmt00x = 0,    // 无操作数
-        kFmt10x,        // 单字节操作码
-        kFmt12x,        // 寄存器对
-        kFmt11n,        // 寄存器和常量4位
-        kFmt11x,        // 单寄存器
-        kFmt10t,        // 10位偏移量
-        kFmt20t,        // 20位偏移量
-        kFmt20bc,       // 字段或方法引用
-        kFmt22x,        // 16位寄存器引用
-        kFmt21t,        // 带8位寄存器的21位偏移量
-        kFmt21s,        // 带8位寄存器的16位常量
-        kFmt21h,        // 带8位寄存器的高16位常量
-        kFmt21c,        // 8位寄存器和索引
-        kFmt23x,        // 三个8位寄存器
-        kFmt22b,        // 两个8位寄存器和一个8位常量
-        kFmt22t,        // 两个4位寄存器和一个16位偏移量
-        kFmt22s,        // 两个4位寄存器和一个16位常量
-        kFmt22c,        // 两个4位寄存器和一个16位常量索引
-        kFmt22cs,       // 快速实例字段访问
-        kFmt30t,        // 30位偏移量
-        kFmt32x,        // 两个16位寄存器
-        kFmt31i,        // 8位寄存器和32位常量
-        kFmt31t,        // 8位寄存器和32位偏移量
-        kFmt31c,        // 8位寄存器和运行时常量索引
-        kFmt35c,        // 3-5个寄存器和类/方法/字段索引
-        kFmt35ms,       // 类似35c但用于快速方法调用
-        kFmt3rc,        // 范围调用 (N个连续寄存器)
-        kFmt3rms,       // 类似3rc但用于快速方法调用
-        kFmt51l,        // 8位寄存器和64位常量
-        kFmtUnknown,    // 未知格式
-    };
-
     // 操作码和助记符映射
     struct OpcodeMapEntry
     {
         uint16_t opcode;
         const char* mnemonic;
         DalvikFormatFlag format;
+        IndexType indexType;
     };
 
-    // Dalvik指令集操作码映射表
+    // Dalvik指令集操作码映射表（按操作码顺序排列，可直接用操作码索引）
     static const OpcodeMapEntry gOpcodeMap[] = {
-        {0x00, "nop", kFmt10x},
-        {0x01, "move", kFmt12x},
-        {0x02, "move/from16", kFmt22x},
-        {0x03, "move/16", kFmt32x},
-        {0x04, "move-wide", kFmt12x},
-        {0x05, "move-wide/from16", kFmt22x},
-        {0x06, "move-wide/16", kFmt32x},
-        {0x07, "move-object", kFmt12x},
-        {0x08, "move-object/from16", kFmt22x},
-        {0x09, "move-object/16", kFmt32x},
-        {0x0a, "move-result", kFmt11x},
-        {0x0b, "move-result-wide", kFmt11x},
-        {0x0c, "move-result-object", kFmt11x},
-        {0x0d, "move-exception", kFmt11x},
-        {0x0e, "return-void", kFmt10x},
-        {0x0f, "return", kFmt11x},
-        {0x10, "return-wide", kFmt11x},
-        {0x11, "return-object", kFmt11x},
-        {0x12, "const/4", kFmt11n},
-        {0x13, "const/16", kFmt21s},
-        {0x14, "const", kFmt31i},
-        {0x15, "const/high16", kFmt21h},
-        {0x16, "const-wide/16", kFmt21s},
-        {0x17, "const-wide/32", kFmt31i},
-        {0x18, "const-wide", kFmt51l},
-        {0x19, "const-wide/high16", kFmt21h},
-        {0x1a, "const-string", kFmt21c},
-        {0x1b, "const-string/jumbo", kFmt31c},
-        {0x1c, "const-class", kFmt21c},
-        {0x1d, "monitor-enter", kFmt11x},
-        {0x1e, "monitor-exit", kFmt11x},
-        {0x1f, "check-cast", kFmt21c},
-        {0x20, "instance-of", kFmt22c},
-        {0x21, "array-length", kFmt12x},
-        {0x22, "new-instance", kFmt21c},
-        {0x23, "new-array", kFmt22c},
-        {0x24, "filled-new-array", kFmt35c},
-        {0x25, "filled-new-array/range", kFmt3rc},
-        {0x26, "fill-array-data", kFmt31t},
-        {0x27, "throw", kFmt11x},
-        {0x28, "goto", kFmt10t},
-        {0x29, "goto/16", kFmt20t},
-        {0x2a, "goto/32", kFmt30t},
-        {0x2b, "packed-switch", kFmt31t},
-        {0x2c, "sparse-switch", kFmt31t},
-        // add-int/sub-int/mul-int等基本算术操作已省略...
-        {0xfe, "invoke-polymorphic", kFmt35c},
-        {0xff, "invoke-polymorphic/range", kFmt3rc},
+        {0x00, "nop", kFmt10x, IndexType::None},
+        {0x01, "move", kFmt12x, IndexType::None},
+        {0x02, "move/from16", kFmt22x, IndexType::None},
+        {0x03, "move/16", kFmt32x, IndexType::None},
+        {0x04, "move-wide", kFmt12x, IndexType::None},
+        {0x05, "move-wide/from16", kFmt22x, IndexType::None},
+        {0x06, "move-wide/16", kFmt32x, IndexType::None},
+        {0x07, "move-object", kFmt12x, IndexType::None},
+        {0x08, "move-object/from16", kFmt22x, IndexType::None},
+        {0x09, "move-object/16", kFmt32x, IndexType::None},
+        {0x0a, "move-result", kFmt11x, IndexType::None},
+        {0x0b, "move-result-wide", kFmt11x, IndexType::None},
+        {0x0c, "move-result-object", kFmt11x, IndexType::None},
+        {0x0d, "move-exception", kFmt11x, IndexType::None},
+        {0x0e, "return-void", kFmt10x, IndexType::None},
+        {0x0f, "return", kFmt11x, IndexType::None},
+        {0x10, "return-wide", kFmt11x, IndexType::None},
+        {0x11, "return-object", kFmt11x, IndexType::None},
+        {0x12, "const/4", kFmt11n, IndexType::None},
+        {0x13, "const/16", kFmt21s, IndexType::None},
+        {0x14, "const", kFmt31i, IndexType::None},
+        {0x15, "const/high16", kFmt21h, IndexType::None},
+        {0x16, "const-wide/16", kFmt21s, IndexType::None},
+        {0x17, "const-wide/32", kFmt31i, IndexType::None},
+        {0x18, "const-wide", kFmt51l, IndexType::None},
+        {0x19, "const-wide/high16", kFmt21h, IndexType::None},
+        {0x1a, "const-string", kFmt21c, IndexType::String},
+        {0x1b, "const-string/jumbo", kFmt31c, IndexType::String},
+        {0x1c, "const-class", kFmt21c, IndexType::Type},
+        {0x1d, "monitor-enter", kFmt11x, IndexType::None},
+        {0x1e, "monitor-exit", kFmt11x, IndexType::None},
+        {0x1f, "check-cast", kFmt21c, IndexType::Type},
+        {0x20, "instance-of", kFmt22c, IndexType::Type},
+        {0x21, "array-length", kFmt12x, IndexType::None},
+        {0x22, "new-instance", kFmt21c, IndexType::Type},
+        {0x23, "new-array", kFmt22c, IndexType::Type},
+        {0x24, "filled-new-array", kFmt35c, IndexType::Type},
+        {0x25, "filled-new-array/range", kFmt3rc, IndexType::Type},
+        {0x26, "fill-array-data", kFmt31t, IndexType::None},
+        {0x27, "throw", kFmt11x, IndexType::None},
+        {0x28, "goto", kFmt10t, IndexType::None},
+        {0x29, "goto/16", kFmt20t, IndexType::None},
+        {0x2a, "goto/32", kFmt30t, IndexType::None},
+        {0x2b, "packed-switch", kFmt31t, IndexType::None},
+        {0x2c, "sparse-switch", kFmt31t, IndexType::None},
+        {0x2d, "cmpl-float", kFmt23x, IndexType::None},
+        {0x2e, "cmpg-float", kFmt23x, IndexType::None},
+        {0x2f, "cmpl-double", kFmt23x, IndexType::None},
+        {0x30, "cmpg-double", kFmt23x, IndexType::None},
+        {0x31, "cmp-long", kFmt23x, IndexType::None},
+        {0x32, "if-eq", kFmt22t, IndexType::None},
+        {0x33, "if-ne", kFmt22t, IndexType::None},
+        {0x34, "if-lt", kFmt22t, IndexType::None},
+        {0x35, "if-ge", kFmt22t, IndexType::None},
+        {0x36, "if-gt", kFmt22t, IndexType::None},
+        {0x37, "if-le", kFmt22t, IndexType::None},
+        {0x38, "if-eqz", kFmt21t, IndexType::None},
+        {0x39, "if-nez", kFmt21t, IndexType::None},
+        {0x3a, "if-ltz", kFmt21t, IndexType::None},
+        {0x3b, "if-gez", kFmt21t, IndexType::None},
+        {0x3c, "if-gtz", kFmt21t, IndexType::None},
+        {0x3d, "if-lez", kFmt21t, IndexType::None},
+        {0x3e, "unused", kFmt10x, IndexType::None},
+        {0x3f, "unused", kFmt10x, IndexType::None},
+        {0x40, "unused", kFmt10x, IndexType::None},
+        {0x41, "unused", kFmt10x, IndexType::None},
+        {0x42, "unused", kFmt10x, IndexType::None},
+        {0x43, "unused", kFmt10x, IndexType::None},
+        {0x44, "aget", kFmt23x, IndexType::None},
+        {0x45, "aget-wide", kFmt23x, IndexType::None},
+        {0x46, "aget-object", kFmt23x, IndexType::None},
+        {0x47, "aget-boolean", kFmt23x, IndexType::None},
+        {0x48, "aget-byte", kFmt23x, IndexType::None},
+        {0x49, "aget-char", kFmt23x, IndexType::None},
+        {0x4a, "aget-short", kFmt23x, IndexType::None},
+        {0x4b, "aput", kFmt23x, IndexType::None},
+        {0x4c, "aput-wide", kFmt23x, IndexType::None},
+        {0x4d, "aput-object", kFmt23x, IndexType::None},
+        {0x4e, "aput-boolean", kFmt23x, IndexType::None},
+        {0x4f, "aput-byte", kFmt23x, IndexType::None},
+        {0x50, "aput-char", kFmt23x, IndexType::None},
+        {0x51, "aput-short", kFmt23x, IndexType::None},
+        {0x52, "iget", kFmt22c, IndexType::Field},
+        {0x53, "iget-wide", kFmt22c, IndexType::Field},
+        {0x54, "iget-object", kFmt22c, IndexType::Field},
+        {0x55, "iget-boolean", kFmt22c, IndexType::Field},
+        {0x56, "iget-byte", kFmt22c, IndexType::Field},
+        {0x57, "iget-char", kFmt22c, IndexType::Field},
+        {0x58, "iget-short", kFmt22c, IndexType::Field},
+        {0x59, "iput", kFmt22c, IndexType::Field},
+        {0x5a, "iput-wide", kFmt22c, IndexType::Field},
+        {0x5b, "iput-object", kFmt22c, IndexType::Field},
+        {0x5c, "iput-boolean", kFmt22c, IndexType::Field},
+        {0x5d, "iput-byte", kFmt22c, IndexType::Field},
+        {0x5e, "iput-char", kFmt22c, IndexType::Field},
+        {0x5f, "iput-short", kFmt22c, IndexType::Field},
+        {0x60, "sget", kFmt21c, IndexType::Field},
+        {0x61, "sget-wide", kFmt21c, IndexType::Field},
+        {0x62, "sget-object", kFmt21c, IndexType::Field},
+        {0x63, "sget-boolean", kFmt21c, IndexType::Field},
+        {0x64, "sget-byte", kFmt21c, IndexType::Field},
+        {0x65, "sget-char", kFmt21c, IndexType::Field},
+        {0x66, "sget-short", kFmt21c, IndexType::Field},
+        {0x67, "sput", kFmt21c, IndexType::Field},
+        {0x68, "sput-wide", kFmt21c, IndexType::Field},
+        {0x69, "sput-object", kFmt21c, IndexType::Field},
+        {0x6a, "sput-boolean", kFmt21c, IndexType::Field},
+        {0x6b, "sput-byte", kFmt21c, IndexType::Field},
+        {0x6c, "sput-char", kFmt21c, IndexType::Field},
+        {0x6d, "sput-short", kFmt21c, IndexType::Field},
+        {0x6e, "invoke-virtual", kFmt35c, IndexType::Method},
+        {0x6f, "invoke-super", kFmt35c, IndexType::Method},
+        {0x70, "invoke-direct", kFmt35c, IndexType::Method},
+        {0x71, "invoke-static", kFmt35c, IndexType::Method},
+        {0x72, "invoke-interface", kFmt35c, IndexType::Method},
+        {0x73, "unused", kFmt10x, IndexType::None},
+        {0x74, "invoke-virtual/range", kFmt3rc, IndexType::Method},
+        {0x75, "invoke-super/range", kFmt3rc, IndexType::Method},
+        {0x76, "invoke-direct/range", kFmt3rc, IndexType::Method},
+        {0x77, "invoke-static/range", kFmt3rc, IndexType::Method},
+        {0x78, "invoke-interface/range", kFmt3rc, IndexType::Method},
+        {0x79, "unused", kFmt10x, IndexType::None},
+        {0x7a, "unused", kFmt10x, IndexType::None},
+        {0x7b, "neg-int", kFmt12x, IndexType::None},
+        {0x7c, "not-int", kFmt12x, IndexType::None},
+        {0x7d, "neg-long", kFmt12x, IndexType::None},
+        {0x7e, "not-long", kFmt12x, IndexType::None},
+        {0x7f, "neg-float", kFmt12x, IndexType::None},
+        {0x80, "neg-double", kFmt12x, IndexType::None},
+        {0x81, "int-to-long", kFmt12x, IndexType::None},
+        {0x82, "int-to-float", kFmt12x, IndexType::None},
+        {0x83, "int-to-double", kFmt12x, IndexType::None},
+        {0x84, "long-to-int", kFmt12x, IndexType::None},
+        {0x85, "long-to-float", kFmt12x, IndexType::None},
+        {0x86, "long-to-double", kFmt12x, IndexType::None},
+        {0x87, "float-to-int", kFmt12x, IndexType::None},
+        {0x88, "float-to-long", kFmt12x, IndexType::None},
+        {0x89, "float-to-double", kFmt12x, IndexType::None},
+        {0x8a, "double-to-int", kFmt12x, IndexType::None},
+        {0x8b, "double-to-long", kFmt12x, IndexType::None},
+        {0x8c, "double-to-float", kFmt12x, IndexType::None},
+        {0x8d, "int-to-byte", kFmt12x, IndexType::None},
+        {0x8e, "int-to-char", kFmt12x, IndexType::None},
+        {0x8f, "int-to-short", kFmt12x, IndexType::None},
+        {0x90, "add-int", kFmt23x, IndexType::None},
+        {0x91, "sub-int", kFmt23x, IndexType::None},
+        {0x92, "mul-int", kFmt23x, IndexType::None},
+        {0x93, "div-int", kFmt23x, IndexType::None},
+        {0x94, "rem-int", kFmt23x, IndexType::None},
+        {0x95, "and-int", kFmt23x, IndexType::None},
+        {0x96, "or-int", kFmt23x, IndexType::None},
+        {0x97, "xor-int", kFmt23x, IndexType::None},
+        {0x98, "shl-int", kFmt23x, IndexType::None},
+        {0x99, "shr-int", kFmt23x, IndexType::None},
+        {0x9a, "ushr-int", kFmt23x, IndexType::None},
+        {0x9b, "add-long", kFmt23x, IndexType::None},
+        {0x9c, "sub-long", kFmt23x, IndexType::None},
+        {0x9d, "mul-long", kFmt23x, IndexType::None},
+        {0x9e, "div-long", kFmt23x, IndexType::None},
+        {0x9f, "rem-long", kFmt23x, IndexType::None},
+        {0xa0, "and-long", kFmt23x, IndexType::None},
+        {0xa1, "or-long", kFmt23x, IndexType::None},
+        {0xa2, "xor-long", kFmt23x, IndexType::None},
+        {0xa3, "shl-long", kFmt23x, IndexType::None},
+        {0xa4, "shr-long", kFmt23x, IndexType::None},
+        {0xa5, "ushr-long", kFmt23x, IndexType::None},
+        {0xa6, "add-float", kFmt23x, IndexType::None},
+        {0xa7, "sub-float", kFmt23x, IndexType::None},
+        {0xa8, "mul-float", kFmt23x, IndexType::None},
+        {0xa9, "div-float", kFmt23x, IndexType::None},
+        {0xaa, "rem-float", kFmt23x, IndexType::None},
+        {0xab, "add-double", kFmt23x, IndexType::None},
+        {0xac, "sub-double", kFmt23x, IndexType::None},
+        {0xad, "mul-double", kFmt23x, IndexType::None},
+        {0xae, "div-double", kFmt23x, IndexType::None},
+        {0xaf, "rem-double", kFmt23x, IndexType::None},
+        {0xb0, "add-int/2addr", kFmt12x, IndexType::None},
+        {0xb1, "sub-int/2addr", kFmt12x, IndexType::None},
+        {0xb2, "mul-int/2addr", kFmt12x, IndexType::None},
+        {0xb3, "div-int/2addr", kFmt12x, IndexType::None},
+        {0xb4, "rem-int/2addr", kFmt12x, IndexType::None},
+        {0xb5, "and-int/2addr", kFmt12x, IndexType::None},
+        {0xb6, "or-int/2addr", kFmt12x, IndexType::None},
+        {0xb7, "xor-int/2addr", kFmt12x, IndexType::None},
+        {0xb8, "shl-int/2addr", kFmt12x, IndexType::None},
+        {0xb9, "shr-int/2addr", kFmt12x, IndexType::None},
+        {0xba, "ushr-int/2addr", kFmt12x, IndexType::None},
+        {0xbb, "add-long/2addr", kFmt12x, IndexType::None},
+        {0xbc, "sub-long/2addr", kFmt12x, IndexType::None},
+        {0xbd, "mul-long/2addr", kFmt12x, IndexType::None},
+        {0xbe, "div-long/2addr", kFmt12x, IndexType::None},
+        {0xbf, "rem-long/2addr", kFmt12x, IndexType::None},
+        {0xc0, "and-long/2addr", kFmt12x, IndexType::None},
+        {0xc1, "or-long/2addr", kFmt12x, IndexType::None},
+        {0xc2, "xor-long/2addr", kFmt12x, IndexType::None},
+        {0xc3, "shl-long/2addr", kFmt12x, IndexType::None},
+        {0xc4, "shr-long/2addr", kFmt12x, IndexType::None},
+        {0xc5, "ushr-long/2addr", kFmt12x, IndexType::None},
+        {0xc6, "add-float/2addr", kFmt12x, IndexType::None},
+        {0xc7, "sub-float/2addr", kFmt12x, IndexType::None},
+        {0xc8, "mul-float/2addr", kFmt12x, IndexType::None},
+        {0xc9, "div-float/2addr", kFmt12x, IndexType::None},
+        {0xca, "rem-float/2addr", kFmt12x, IndexType::None},
+        {0xcb, "add-double/2addr", kFmt12x, IndexType::None},
+        {0xcc, "sub-double/2addr", kFmt12x, IndexType::None},
+        {0xcd, "mul-double/2addr", kFmt12x, IndexType::None},
+        {0xce, "div-double/2addr", kFmt12x, IndexType::None},
+        {0xcf, "rem-double/2addr", kFmt12x, IndexType::None},
+        {0xd0, "add-int/lit16", kFmt22s, IndexType::None},
+        {0xd1, "rsub-int", kFmt22s, IndexType::None},
+        {0xd2, "mul-int/lit16", kFmt22s, IndexType::None},
+        {0xd3, "div-int/lit16", kFmt22s, IndexType::None},
+        {0xd4, "rem-int/lit16", kFmt22s, IndexType::None},
+        {0xd5, "and-int/lit16", kFmt22s, IndexType::None},
+        {0xd6, "or-int/lit16", kFmt22s, IndexType::None},
+        {0xd7, "xor-int/lit16", kFmt22s, IndexType::None},
+        {0xd8, "add-int/lit8", kFmt22b, IndexType::None},
+        {0xd9, "rsub-int/lit8", kFmt22b, IndexType::None},
+        {0xda, "mul-int/lit8", kFmt22b, IndexType::None},
+        {0xdb, "div-int/lit8", kFmt22b, IndexType::None},
+        {0xdc, "rem-int/lit8", kFmt22b, IndexType::None},
+        {0xdd, "and-int/lit8", kFmt22b, IndexType::None},
+        {0xde, "or-int/lit8", kFmt22b, IndexType::None},
+        {0xdf, "xor-int/lit8", kFmt22b, IndexType::None},
+        {0xe0, "shl-int/lit8", kFmt22b, IndexType::None},
+        {0xe1, "shr-int/lit8", kFmt22b, IndexType::None},
+        {0xe2, "ushr-int/lit8", kFmt22b, IndexType::None},
+        {0xe3, "unused", kFmt10x, IndexType::None},
+        {0xe4, "unused", kFmt10x, IndexType::None},
+        {0xe5, "unused", kFmt10x, IndexType::None},
+        {0xe6, "unused", kFmt10x, IndexType::None},
+        {0xe7, "unused", kFmt10x, IndexType::None},
+        {0xe8, "unused", kFmt10x, IndexType::None},
+        {0xe9, "unused", kFmt10x, IndexType::None},
+        {0xea, "unused", kFmt10x, IndexType::None},
+        {0xeb, "unused", kFmt10x, IndexType::None},
+        {0xec, "unused", kFmt10x, IndexType::None},
+        {0xed, "unused", kFmt10x, IndexType::None},
+        {0xee, "unused", kFmt10x, IndexType::None},
+        {0xef, "unused", kFmt10x, IndexType::None},
+        {0xf0, "unused", kFmt10x, IndexType::None},
+        {0xf1, "unused", kFmt10x, IndexType::None},
+        {0xf2, "unused", kFmt10x, IndexType::None},
+        {0xf3, "unused", kFmt10x, IndexType::None},
+        {0xf4, "unused", kFmt10x, IndexType::None},
+        {0xf5, "unused", kFmt10x, IndexType::None},
+        {0xf6, "unused", kFmt10x, IndexType::None},
+        {0xf7, "unused", kFmt10x, IndexType::None},
+        {0xf8, "unused", kFmt10x, IndexType::None},
+        {0xf9, "unused", kFmt10x, IndexType::None},
+        {0xfa, "invoke-polymorphic", kFmt45cc, IndexType::Method},
+        {0xfb, "invoke-polymorphic/range", kFmt4rcc, IndexType::Method},
+        {0xfc, "invoke-custom", kFmt35c, IndexType::CallSite},
+        {0xfd, "invoke-custom/range", kFmt3rc, IndexType::CallSite},
+        {0xfe, "const-method-handle", kFmt21c, IndexType::MethodHandle},
+        {0xff, "const-method-type", kFmt21c, IndexType::Proto},
     };
 
+    static_assert(sizeof(gOpcodeMap) / sizeof(gOpcodeMap[0]) == 256, "操作码表必须覆盖0x00-0xff");
+
+    // 数据伪指令标识（位于nop操作码的高字节）
+    static constexpr uint16_t kPackedSwitchPayload = 0x0100;
+    static constexpr uint16_t kSparseSwitchPayload = 0x0200;
+    static constexpr uint16_t kFillArrayDataPayload = 0x0300;
+
     // 操作码到格式的映射
     static DalvikFormatFlag getOpcodeFormat(uint16_t opcode)
     {
-        for (const auto& entry : gOpcodeMap)
+        return gOpcodeMap[opcode & 0xFF].format;
+    }
+
+    // 各格式的指令长度(16位字的数量)，数据伪指令的长度取决于内容，单独计算
+    static uint32_t getFormatLength(DalvikFormatFlag format)
+    {
+        switch (format)
         {
-            if (entry.opcode == opcode)
+            case kFmt10x:
+            case kFmt12x:
+            case kFmt11n:
+            case kFmt11x:
+            case kFmt10t:
+                return 1;
+
+            case kFmt20t:
+            case kFmt20bc:
+            case kFmt22x:
+            case kFmt21t:
+            case kFmt21s:
+            case kFmt21h:
+            case kFmt21c:
+            case kFmt23x:
+            case kFmt22b:
+            case kFmt22t:
+            case kFmt22s:
+            case kFmt22c:
+            case kFmt22cs:
+                return 2;
+
+            case kFmt30t:
+            case kFmt32x:
+            case kFmt31i:
+            case kFmt31t:
+            case kFmt31c:
+            case kFmt35c:
+            case kFmt35ms:
+            case kFmt3rc:
+            case kFmt3rms:
+                return 3;
+
+            case kFmt45cc:
+            case kFmt4rcc:
+                return 4;
+
+            case kFmt51l:
+                return 5;
+
+            default:
+                return 1;
+        }
+    }
+
+    namespace
+    {
+        // 字符串常量最多显示的字节数，超出时截断并以...结尾
+        constexpr size_t kMaxStringLiteral = 20;
+
+        /**
+         * 通过DexContext把常量池引用解析为文本
+         * 只读取映射的文件，不经过任何缓存；索引无效时退回为kind@索引
+         */
+        struct ContextResolver
+        {
+            const DexContext& context;
+
+            void operator()(OperandWriter& out, IndexType type, uint32_t index) const
             {
-                return entry.format;
+                switch (type)
+                {
+                    case IndexType::String:
+                        if (index < context.getStringIdsCount())
+                        {
+                            writeString(out, context.getStringData(index));
+                            return;
+                        }
+                        break;
+
+                    case IndexType::Type:
+                        if (index < context.getTypeIdsCount())
+                        {
+                            out.write(typeDescriptor(index));
+                            return;
+                        }
+                        break;
+
+                    case IndexType::Field:
+                        if (index < context.getFieldIds().size())
+                        {
+                            const DexFieldId& field = context.getFieldIds()[index];
+                            out.write(typeDescriptor(field.classIdx));
+                            out.write("->");
+                            out.write(context.getStringData(field.nameIdx));
+                            out.put(':');
+                            out.write(typeDescriptor(field.typeIdx));
+                            return;
+                        }
+                        break;
+
+                    case IndexType::Method:
+                        if (index < context.getMethodIds().size())
+                        {
+                            const DexMethodId& method = context.getMethodIds()[index];
+                            out.write(typeDescriptor(method.classIdx));
+                            out.write("->");
+                            out.write(context.getStringData(method.nameIdx));
+                            writeProto(out, method.protoIdx);
+                            return;
+                        }
+                        break;
+
+                    case IndexType::Proto:
+                        if (index < context.getProtoIds().size())
+                        {
+                            writeProto(out, index);
+                            return;
+                        }
+                        break;
+
+                    default:
+                        break;
+                }
+
+                IndexResolver()(out, type, index);
             }
-        }
-        return kFmtUnknown;
+
+            // 类型描述符，索引无效时返回空
+            std::string_view typeDescriptor(uint32_t typeIdx) const
+            {
+                const std::span<const DexTypeId> typeIds = context.getTypeIds();
+                return typeIdx < typeIds.size() ? context.getStringData(typeIds[typeIdx].descriptor_idx)
+                                                : std::string_view();
+            }
+
+            // 方法原型 (参数)返回类型，参数列表直接从文件读取
+            void writeProto(OperandWriter& out, uint32_t protoIdx) const
+            {
+                const std::span<const DexProtoId> protoIds = context.getProtoIds();
+                if (protoIdx >= protoIds.size())
+                {
+                    out.write("(?)");
+                    return;
+                }
+
+                const DexProtoId& proto = protoIds[protoIdx];
+                out.put('(');
+                if (proto.parameters_off != 0 && proto.parameters_off % 4 == 0 &&
+                    context.isInSection(kDexTypeTypeList, proto.parameters_off, sizeof(uint32_t)))
+                {
+                    // 参数列表整体位于type_list段内时逐项读取不再检查
+                    const auto* list = reinterpret_cast<const DexTypeList*>(context.getFileData() + proto.parameters_off);
+                    if (context.isInSection(kDexTypeTypeList, proto.parameters_off,
+                                            sizeof(uint32_t) + static_cast<uint64_t>(list->size) * sizeof(DexTypeItem)))
+                    {
+                        for (uint32_t i = 0; i < list->size; i++)
+                        {
+                            out.write(typeDescriptor(list->list[i].typeIdx));
+                        }
+                    }
+                }
+                out.put(')');
+                out.write(typeDescriptor(proto.return_type_idx));
+            }
+
+            // 带引号的字符串常量，控制字符和非ASCII字节转义，过长时截断
+            static void writeString(OperandWriter& out, std::string_view text)
+            {
+                const bool truncated = text.size() > kMaxStringLiteral;
+                if (truncated)
+                {
+                    text = text.substr(0, kMaxStringLiteral - 3);
+                }
+
+                out.put('"');
+                for (const char c : text)
+                {
+                    const unsigned char byte = static_cast<unsigned char>(c);
+                    if (c == '\n')
+                    {
+                        out.write("\\n");
+                    }
+                    else if (c == '\r')
+                    {
+                        out.write("\\r");
+                    }
+                    else if (c == '\t')
+                    {
+                        out.write("\\t");
+                    }
+                    else if (byte < 32 || byte > 126)
+                    {
+                        out.write("\\x");
+                        out.put("0123456789abcdef"[byte >> 4]);
+                        out.put("0123456789abcdef"[byte & 0xF]);
+                    }
+                    else
+                    {
+                        out.put(c);
+                    }
+                }
+                if (truncated)
+                {
+                    out.write("...");
+                }
+                out.put('"');
+            }
+        };
     }
 
     CodeParser::CodeParser(const uint8_t* fileData, size_t fileSize)
@@ -140,16 +520,14 @@ namespace dex::parser
         CodeSectionInfo codeInfo = {};
         codeInfo.codeOffset = codeOffset;
         
-        // 检查偏移量是否有效
-        if (codeOffset == 0 || codeOffset >= BaseFileSize_)
+        // 获取DexCode结构（头部和指令数组都已检查位于文件范围内，指令解码不再逐条检查文件边界）
+        const DexCode* dexCode = DexContext::getInstance().getCodeItem(codeOffset);
+        if (dexCode == nullptr)
         {
             LOGE("代码偏移量无效: 0x%08X", codeOffset);
             return codeInfo;
         }
         
-        // 获取DexCode结构
-        const DexCode* dexCode = reinterpret_cast<const DexCode*>(BaseFileData_ + codeOffset);
-        
         // 填充代码段信息
         codeInfo.registersSize = dexCode->registers_size;
         codeInfo.insSize = dexCode->ins_size;
@@ -162,25 +540,34 @@ namespace dex::parser
         if (codeInfo.insnsSize > 0)
         {
             // 解析指令
-            codeInfo.instructions = parseInstructions(codeOffset, dexCode->insns, codeInfo.insnsSize);
+            PhaseTimer timer(Phase::CodeDecode);
+            parseInstructions(dexCode->insns, codeInfo.insnsSize, codeInfo);
+            timer.addBytes(codeInfo.insnsSize * sizeof(uint16_t));
+            timer.addItems(codeInfo.instructions.size());
         }
         
         return codeInfo;
     }
 
-    std::vector<InstructionInfo> CodeParser::parseInstructions(uint32_t codeOffset, const uint16_t* insns, uint32_t insnsSize)
+    void CodeParser::parseInstructions(const uint16_t* insns, uint32_t insnsSize, CodeSectionInfo& codeInfo)
     {
-        std::vector<InstructionInfo> instructions;
-        
-        // 计算指令数组起始偏移量
-        uint32_t insnsOffset = codeOffset + offsetof(DexCode, insns);
-        
+        std::vector<InstructionInfo>& instructions = codeInfo.instructions;
+        std::string& operandText = codeInfo.operandText;
+
         // 遍历指令数组
         uint32_t offset = 0;
         while (offset < insnsSize)
         {
+            // 解码指令，截断的指令说明代码段已损坏
+            DecodedInstruction decoded;
+            if (!decodeInstruction(insns, insnsSize, offset, decoded))
+            {
+                LOGW("指令超出代码段范围: 0x%04X", offset);
+                break;
+            }
+
             // 获取操作码
-            uint16_t opcode = insns[offset] & 0xFF;
+            uint16_t opcode = decoded.opcode;
             
             // 创建指令信息
             InstructionInfo insInfo = {};
@@ -189,10 +576,17 @@ namespace dex::parser
             insInfo.mnemonic = getOpcodeMnemonic(opcode);
             
             // 获取指令长度
-            insInfo.length = getInstructionLength(opcode);
+            insInfo.length = decoded.length;
             
-            // 解析操作数
-            insInfo.operands = parseOperands(opcode, insns, offset);
+            // 解析操作数（数据伪指令没有操作数），文本追加到整个代码段共用的缓冲区
+            insInfo.operandsOffset = static_cast<uint32_t>(operandText.size());
+            if (decoded.format != kFmtPayload)
+            {
+                char operands[kOperandBufferSize];
+                const size_t length = writeOperands(decoded, offset, operands, sizeof(operands));
+                operandText.append(operands, length);
+                insInfo.operandsLength = static_cast<uint32_t>(length);
+            }
             
             // 添加到指令列表
             instructions.push_back(insInfo);
@@ -200,114 +594,262 @@ namespace dex::parser
             // 更新偏移量
             offset += insInfo.length;
         }
-        
-        return instructions;
     }
 
-    std::string CodeParser::getOpcodeMnemonic(uint16_t opcode)
+    const char* CodeParser::getOpcodeMnemonic(uint16_t opcode)
     {
-        for (const auto& entry : gOpcodeMap)
+        switch (opcode)
         {
-            if (entry.opcode == opcode)
-            {
-                return entry.mnemonic;
-            }
+            case kPackedSwitchPayload:
+                return "packed-switch-payload";
+            case kSparseSwitchPayload:
+                return "sparse-switch-payload";
+            case kFillArrayDataPayload:
+                return "fill-array-data-payload";
+            default:
+                break;
+        }
+
+        if (opcode > 0xFF)
+        {
+            return "unknown";
         }
-        return "unknown";
+        return gOpcodeMap[opcode].mnemonic;
     }
 
-    std::string CodeParser::parseOperands(uint16_t opcode, const uint16_t* insns, uint32_t offset)
+    size_t CodeParser::writeOperands(const DecodedInstruction& insn, uint32_t offset, char* buffer, size_t size)
     {
-        std::stringstream ss;
-        DalvikFormatFlag format = getOpcodeFormat(opcode);
-        
-        uint16_t instr = insns[offset];
-        
-        switch (format)
+        return renderOperands(insn, offset, ContextResolver{DexContext::getInstance()}, buffer, size);
+    }
+
+    uint32_t CodeParser::getInstructionLength(uint16_t opcode)
+    {
+        return getFormatLength(getOpcodeFormat(opcode));
+    }
+
+    bool CodeParser::decodeInstruction(const uint16_t* insns, uint32_t insnsSize, uint32_t offset,
+                                       DecodedInstruction& out)
+    {
+        out = {};
+        if (insns == nullptr || offset >= insnsSize)
         {
-            case kFmt10x: // 单字节操作码，无操作数
-                break;
-                
-            case kFmt12x: // 寄存器对
+            return false;
+        }
+
+        const uint16_t w0 = insns[offset];
+        const uint32_t remaining = insnsSize - offset;
+        const OpcodeMapEntry& entry = gOpcodeMap[w0 & 0xFF];
+
+        out.opcode = w0 & 0xFF;
+        out.format = entry.format;
+        out.indexType = entry.indexType;
+
+        // 数据伪指令: nop操作码，高字节为ident，长度由内容决定
+        if (w0 == kPackedSwitchPayload || w0 == kSparseSwitchPayload || w0 == kFillArrayDataPayload)
+        {
+            if (remaining < 2)
             {
-                uint8_t vA = (instr >> 8) & 0xF;
-                uint8_t vB = (instr >> 12) & 0xF;
-                ss << "v" << static_cast<int>(vA) << ", v" << static_cast<int>(vB);
-                break;
+                return false;
             }
-                
-            case kFmt11n: // 寄存器和常量4位
+
+            uint64_t length = 0;
+            if (w0 == kPackedSwitchPayload)
             {
-                uint8_t vA = (instr >> 8) & 0xF;
-                int8_t val = (instr >> 12) & 0xF;
-                ss << "v" << static_cast<int>(vA) << ", #" << static_cast<int>(val);
-                break;
+                length = 4 + static_cast<uint64_t>(insns[offset + 1]) * 2;
             }
-                
-            case kFmt11x: // 单寄存器
+            else if (w0 == kSparseSwitchPayload)
             {
-                uint8_t vA = (instr >> 8) & 0xFF;
-                ss << "v" << static_cast<int>(vA);
-                break;
+                length = 2 + static_cast<uint64_t>(insns[offset + 1]) * 4;
             }
-                
-            case kFmt10t: // 10位偏移量
+            else
             {
-                int8_t offset = static_cast<int8_t>((instr >> 8) & 0xFF);
-                ss << "+" << static_cast<int>(offset);
-                break;
+                if (remaining < 4)
+                {
+                    return false;
+                }
+                const uint64_t width = insns[offset + 1];
+                const uint64_t count = insns[offset + 2] | (static_cast<uint32_t>(insns[offset + 3]) << 16);
+                length = 4 + (width * count + 1) / 2;
             }
-                
-            // 支持更多指令格式... (为简洁起见这里省略了部分实现)
-                
-            default:
-                ss << "格式" << format << "(未详细解析)";
-                break;
+
+            out.opcode = w0;
+            out.format = kFmtPayload;
+            out.indexType = IndexType::None;
+            out.length = static_cast<uint32_t>(length);
+            return length <= remaining;
         }
-        
-        return ss.str();
-    }
 
-    uint32_t CodeParser::getInstructionLength(uint16_t opcode)
-    {
-        DalvikFormatFlag format = getOpcodeFormat(opcode);
-        
-        switch (format)
+        out.length = getFormatLength(entry.format);
+        if (out.length > remaining)
+        {
+            return false;
+        }
+
+        const uint16_t* w = insns + offset;
+        switch (entry.format)
         {
             case kFmt10x:
+                break;
+
             case kFmt12x:
+                out.vA = (w0 >> 8) & 0xF;
+                out.vB = w0 >> 12;
+                break;
+
             case kFmt11n:
+                out.vA = (w0 >> 8) & 0xF;
+                out.literal = static_cast<int8_t>(w0 >> 8) >> 4;
+                break;
+
             case kFmt11x:
+                out.vA = w0 >> 8;
+                break;
+
             case kFmt10t:
-                return 1; // 1个16位字
-                
+                out.branch = static_cast<int8_t>(w0 >> 8);
+                break;
+
             case kFmt20t:
+                out.branch = static_cast<int16_t>(w[1]);
+                break;
+
+            case kFmt20bc:
+            case kFmt21c:
+                out.vA = w0 >> 8;
+                out.index = w[1];
+                break;
+
             case kFmt22x:
+                out.vA = w0 >> 8;
+                out.vB = w[1];
+                break;
+
             case kFmt21t:
+                out.vA = w0 >> 8;
+                out.branch = static_cast<int16_t>(w[1]);
+                break;
+
             case kFmt21s:
+                out.vA = w0 >> 8;
+                out.literal = static_cast<int16_t>(w[1]);
+                break;
+
             case kFmt21h:
-            case kFmt21c:
+                out.vA = w0 >> 8;
+                // const/high16 填充高16位，const-wide/high16 填充高16位(64位)
+                out.literal = static_cast<int64_t>(static_cast<int16_t>(w[1])) * (out.opcode == 0x19 ? (1LL << 48) : (1LL << 16));
+                break;
+
             case kFmt23x:
+                out.vA = w0 >> 8;
+                out.vB = w[1] & 0xFF;
+                out.vC = w[1] >> 8;
+                break;
+
             case kFmt22b:
+                out.vA = w0 >> 8;
+                out.vB = w[1] & 0xFF;
+                out.literal = static_cast<int8_t>(w[1] >> 8);
+                break;
+
             case kFmt22t:
+                out.vA = (w0 >> 8) & 0xF;
+                out.vB = w0 >> 12;
+                out.branch = static_cast<int16_t>(w[1]);
+                break;
+
             case kFmt22s:
+                out.vA = (w0 >> 8) & 0xF;
+                out.vB = w0 >> 12;
+                out.literal = static_cast<int16_t>(w[1]);
+                break;
+
             case kFmt22c:
-                return 2; // 2个16位字
-                
+            case kFmt22cs:
+                out.vA = (w0 >> 8) & 0xF;
+                out.vB = w0 >> 12;
+                out.index = w[1];
+                break;
+
             case kFmt30t:
+                out.branch = static_cast<int32_t>(w[1] | (static_cast<uint32_t>(w[2]) << 16));
+                break;
+
             case kFmt32x:
+                out.vA = w[1];
+                out.vB = w[2];
+                break;
+
             case kFmt31i:
+                out.vA = w0 >> 8;
+                out.literal = static_cast<int32_t>(w[1] | (static_cast<uint32_t>(w[2]) << 16));
+                break;
+
             case kFmt31t:
+                out.vA = w0 >> 8;
+                out.branch = static_cast<int32_t>(w[1] | (static_cast<uint32_t>(w[2]) << 16));
+                break;
+
             case kFmt31c:
+                out.vA = w0 >> 8;
+                out.index = w[1] | (static_cast<uint32_t>(w[2]) << 16);
+                break;
+
             case kFmt35c:
+            case kFmt35ms:
+            case kFmt45cc:
+                // A|G|op BBBB F|E|D|C [HHHH]
+                out.vA = w0 >> 12;
+                out.index = w[1];
+                out.args[0] = w[2] & 0xF;
+                out.args[1] = (w[2] >> 4) & 0xF;
+                out.args[2] = (w[2] >> 8) & 0xF;
+                out.args[3] = w[2] >> 12;
+                out.args[4] = (w0 >> 8) & 0xF;
+                out.vC = out.args[0];
+                if (entry.format == kFmt45cc)
+                {
+                    out.index2 = w[3];
+                }
+                break;
+
             case kFmt3rc:
-                return 3; // 3个16位字
-                
+            case kFmt3rms:
+            case kFmt4rcc:
+                // AA|op BBBB CCCC [HHHH]
+                out.vA = w0 >> 8;
+                out.index = w[1];
+                out.vC = w[2];
+                if (entry.format == kFmt4rcc)
+                {
+                    out.index2 = w[3];
+                }
+                break;
+
             case kFmt51l:
-                return 5; // 5个16位字
-                
+                out.vA = w0 >> 8;
+                out.literal = static_cast<int64_t>(static_cast<uint64_t>(w[1]) |
+                                                   (static_cast<uint64_t>(w[2]) << 16) |
+                                                   (static_cast<uint64_t>(w[3]) << 32) |
+                                                   (static_cast<uint64_t>(w[4]) << 48));
+                break;
+
             default:
-                return 1; // 默认值
+                break;
         }
+
+        return true;
+    }
+
+    bool CodeParser::isFieldWrite(uint16_t opcode)
+    {
+        // iput系列: 0x59-0x5f，sput系列: 0x67-0x6d
+        return (opcode >= 0x59 && opcode <= 0x5f) || (opcode >= 0x67 && opcode <= 0x6d);
+    }
+
+    bool CodeParser::isStaticFieldAccess(uint16_t opcode)
+    {
+        // sget/sput系列: 0x60-0x6d
+        return opcode >= 0x60 && opcode <= 0x6d;
     }
-} 
\ No newline at end of file
+}
@@ -6,10 +6,84 @@
 #define CODEPARSER_H
 
 #include "BaseParser.h"
+#include <string_view>
 #include <vector>
 
 namespace dex::parser
 {
+    // Dalvik指令集格式标志
+    enum DalvikFormatFlag
+    {
+        kFmt00x = 0,    // 无操作数
+        kFmt10x,        // 单字节操作码
+        kFmt12x,        // 寄存器对
+        kFmt11n,        // 寄存器和常量4位
+        kFmt11x,        // 单寄存器
+        kFmt10t,        // 10位偏移量
+        kFmt20t,        // 20位偏移量
+        kFmt20bc,       // 字段或方法引用
+        kFmt22x,        // 16位寄存器引用
+        kFmt21t,        // 带8位寄存器的21位偏移量
+        kFmt21s,        // 带8位寄存器的16位常量
+        kFmt21h,        // 带8位寄存器的高16位常量
+        kFmt21c,        // 8位寄存器和索引
+        kFmt23x,        // 三个8位寄存器
+        kFmt22b,        // 两个8位寄存器和一个8位常量
+        kFmt22t,        // 两个4位寄存器和一个16位偏移量
+        kFmt22s,        // 两个4位寄存器和一个16位常量
+        kFmt22c,        // 两个4位寄存器和一个16位常量索引
+        kFmt22cs,       // 快速实例字段访问
+        kFmt30t,        // 30位偏移量
+        kFmt32x,        // 两个16位寄存器
+        kFmt31i,        // 8位寄存器和32位常量
+        kFmt31t,        // 8位寄存器和32位偏移量
+        kFmt31c,        // 8位寄存器和运行时常量索引
+        kFmt35c,        // 3-5个寄存器和类/方法/字段索引
+        kFmt35ms,       // 类似35c但用于快速方法调用
+        kFmt3rc,        // 范围调用 (N个连续寄存器)
+        kFmt3rms,       // 类似3rc但用于快速方法调用
+        kFmt51l,        // 8位寄存器和64位常量
+        kFmt45cc,       // invoke-polymorphic (方法索引 + 原型索引)
+        kFmt4rcc,       // invoke-polymorphic/range
+        kFmtPayload,    // switch/fill-array-data 数据伪指令
+        kFmtUnknown,    // 未知格式
+    };
+
+    /**
+     * 指令引用的常量池类型
+     */
+    enum class IndexType : uint8_t
+    {
+        None = 0,       // 不引用常量池
+        String,         // string_ids
+        Type,           // type_ids
+        Field,          // field_ids
+        Method,         // method_ids
+        Proto,          // proto_ids
+        CallSite,       // call_site_ids
+        MethodHandle,   // method_handles
+    };
+
+    /**
+     * 解码后的指令
+     * 按指令格式拆出寄存器、立即数、分支偏移和常量池索引，供交叉引用等分析使用
+     */
+    struct DecodedInstruction
+    {
+        uint16_t opcode;         // 操作码(低8位)；数据伪指令为完整的ident(0x0100/0x0200/0x0300)
+        DalvikFormatFlag format; // 指令格式
+        IndexType indexType;     // 引用的常量池类型
+        uint32_t length;         // 指令长度(16位字的数量)
+        uint32_t vA;             // 第一个寄存器(35c/3rc中为参数数量)
+        uint32_t vB;             // 第二个寄存器
+        uint32_t vC;             // 第三个寄存器(3rc中为起始寄存器)
+        uint32_t index;          // 常量池索引
+        uint32_t index2;         // 第二个索引(45cc/4rcc中的原型索引)
+        int64_t literal;         // 立即数
+        int32_t branch;          // 分支偏移(16位字)
+        uint16_t args[5];        // 35c/45cc的参数寄存器列表
+    };
+
     /**
      * 指令信息结构
      */
@@ -18,8 +92,9 @@ namespace dex::parser
         uint16_t opcode;         // 操作码
         uint32_t offset;         // 指令偏移量
         uint32_t length;         // 指令长度(16位字的数量)
-        std::string mnemonic;    // 指令助记符
-        std::string operands;    // 操作数字符串
+        std::string_view mnemonic; // 指令助记符（指向静态的操作码表）
+        uint32_t operandsOffset; // 操作数文本在CodeSectionInfo::operandText中的起始位置
+        uint32_t operandsLength; // 操作数文本长度（常量池引用已解析）
     };
     
     /**
@@ -35,6 +110,13 @@ namespace dex::parser
         uint32_t debugInfoOff;      // 调试信息偏移量
         uint32_t insnsSize;         // 指令数量(16位字的数量)
         std::vector<InstructionInfo> instructions; // 指令信息列表
+        std::string operandText;    // 全部指令的操作数文本依次存放，不为每条指令单独分配
+
+        // 获取指令的操作数文本
+        std::string_view operands(const InstructionInfo& instruction) const
+        {
+            return std::string_view(operandText).substr(instruction.operandsOffset, instruction.operandsLength);
+        }
     };
 
     /**
@@ -68,32 +150,58 @@ namespace dex::parser
          * @return 解析是否成功
          */
         bool parse() override;
-        
-    private:
+
         /**
-         * 解析指令
-         * @param codeOffset 代码偏移量
+         * 解码一条指令
          * @param insns 指令数组
-         * @param insnsSize 指令数量
-         * @return 指令信息列表
+         * @param insnsSize 指令数组大小(16位字的数量)
+         * @param offset 指令偏移(16位字)
+         * @param out 解码结果
+         * @return 指令是否完整地位于指令数组内
          */
-        std::vector<InstructionInfo> parseInstructions(uint32_t codeOffset, const uint16_t* insns, uint32_t insnsSize);
-        
+        static bool decodeInstruction(const uint16_t* insns, uint32_t insnsSize, uint32_t offset,
+                                      DecodedInstruction& out);
+
         /**
-         * 获取操作码的助记符
+         * 判断字段访问指令是否为写操作(iput/sput)
          * @param opcode 操作码
+         * @return 是否为写操作
+         */
+        static bool isFieldWrite(uint16_t opcode);
+
+        /**
+         * 判断字段访问指令是否为静态字段访问(sget/sput)
+         * @param opcode 操作码
+         * @return 是否为静态访问
+         */
+        static bool isStaticFieldAccess(uint16_t opcode);
+
+        /**
+         * 获取操作码的助记符
+         * @param opcode 操作码（数据伪指令为完整的ident）
          * @return 助记符
          */
-        std::string getOpcodeMnemonic(uint16_t opcode);
+        static const char* getOpcodeMnemonic(uint16_t opcode);
+
+        /**
+         * 把指令的操作数写入调用者提供的缓冲区
+         * 字符串、类型、字段、方法和原型引用通过DexContext解析为文本，只读取映射的文件，可在并行任务中调用
+         * @param insn 解码后的指令
+         * @param offset 指令偏移(16位字)
+         * @param buffer 输出缓冲区（建议kOperandBufferSize字节），写入结尾的0
+         * @param size 缓冲区大小，至少为1
+         * @return 文本长度
+         */
+        static size_t writeOperands(const DecodedInstruction& insn, uint32_t offset, char* buffer, size_t size);
         
+    private:
         /**
-         * 解析操作数
-         * @param opcode 操作码
+         * 解析指令，填充codeInfo的指令列表和操作数文本
          * @param insns 指令数组
-         * @param offset 当前偏移
-         * @return 操作数字符串
+         * @param insnsSize 指令数量
+         * @param codeInfo 输出参数，代码区段信息
          */
-        std::string parseOperands(uint16_t opcode, const uint16_t* insns, uint32_t offset);
+        void parseInstructions(const uint16_t* insns, uint32_t insnsSize, CodeSectionInfo& codeInfo);
         
         /**
          * 获取指令长度
@@ -39,16 +39,14 @@ namespace dex::parser
             return true; // 空表也是有效的
         }
 
-        // 检查Field ID表偏移量是否有效
-        if (header.fieldIdsOff + header.fieldIdsSize * sizeof(DexFieldId) > BaseFileSize_)
+        // 获取Field ID表指针（按条目数检查范围，避免条目数乘元素大小时溢出）
+        fieldIds_ = BaseReader_.array<DexFieldId>(header.fieldIdsOff, header.fieldIdsSize);
+        if (fieldIds_ == nullptr)
         {
             setError("Field ID表偏移量或大小无效");
             return false;
         }
-
-        // 获取Field ID表指针
         fieldIdsSize_ = header.fieldIdsSize;
-        fieldIds_ = reinterpret_cast<const DexFieldId*>(BaseFileData_ + header.fieldIdsOff);
         
         // 验证Field ID表数据
         for (uint32_t i = 0; i < fieldIdsSize_; i++)
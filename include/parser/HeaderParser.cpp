@@ -4,6 +4,9 @@
 
 #include "HeaderParser.h"
 
+#include <cstddef>
+
+#include "core/Adler32.h"
 #include "log/log.h"
 
 namespace dex::parser
@@ -59,6 +62,16 @@ namespace dex::parser
             return false;
         }
 
+        if (verifyChecksum_ && !validateChecksum())
+        {
+            return false;
+        }
+
+        if (verifySignature_ && !validateSignature())
+        {
+            return false;
+        }
+
         // 所有验证通过
         isValid_ = true;
         header_ = getHeader();
@@ -88,6 +101,26 @@ namespace dex::parser
         return true;
     }
 
+    void HeaderParser::setVerifyChecksum(bool verify)
+    {
+        verifyChecksum_ = verify;
+    }
+
+    void HeaderParser::setVerifySignature(bool verify)
+    {
+        verifySignature_ = verify;
+    }
+
+    const Sha1Digest* HeaderParser::getContentHash() const
+    {
+        return hasContentHash_ ? &contentHash_ : nullptr;
+    }
+
+    void HeaderParser::setThreadCount(uint32_t threadCount)
+    {
+        threadCount_ = threadCount;
+    }
+
     bool HeaderParser::validateMagic() const
     {
         // 检查魔数是否为"dex\n"
@@ -150,12 +183,12 @@ namespace dex::parser
 
     bool HeaderParser::validateSectionOffsets() const
     {
-        // 检查各个段的偏移量是否在文件范围内
+        // 检查各个段的偏移量是否在文件范围内（按元素个数检查，避免条目数乘元素大小时32位溢出）
 
         // 检查字符串ID表
         if (header_.stringIdsSize > 0)
         {
-            if (!isValidOffset(header_.stringIdsOff, header_.stringIdsSize * 4))
+            if (!BaseReader_.isValidArray<DexStringId>(header_.stringIdsOff, header_.stringIdsSize))
             {
                 setError("字符串ID表偏移量无效");
                 return false;
@@ -165,7 +198,7 @@ namespace dex::parser
         // 检查类型ID表
         if (header_.typeIdsSize > 0)
         {
-            if (!isValidOffset(header_.typeIdsOff, header_.typeIdsSize * 4))
+            if (!BaseReader_.isValidArray<DexTypeId>(header_.typeIdsOff, header_.typeIdsSize))
             {
                 setError("类型ID表偏移量无效");
                 return false;
@@ -175,7 +208,7 @@ namespace dex::parser
         // 检查原型ID表
         if (header_.protoIdsSize > 0)
         {
-            if (!isValidOffset(header_.protoIdsOff, header_.protoIdsSize * 12))
+            if (!BaseReader_.isValidArray<DexProtoId>(header_.protoIdsOff, header_.protoIdsSize))
             {
                 setError("原型ID表偏移量无效");
                 return false;
@@ -185,7 +218,7 @@ namespace dex::parser
         // 检查字段ID表
         if (header_.fieldIdsSize > 0)
         {
-            if (!isValidOffset(header_.fieldIdsOff, header_.fieldIdsSize * 8))
+            if (!BaseReader_.isValidArray<DexFieldId>(header_.fieldIdsOff, header_.fieldIdsSize))
             {
                 setError("字段ID表偏移量无效");
                 return false;
@@ -195,7 +228,7 @@ namespace dex::parser
         // 检查方法ID表
         if (header_.methodIdsSize > 0)
         {
-            if (!isValidOffset(header_.methodIdsOff, header_.methodIdsSize * 8))
+            if (!BaseReader_.isValidArray<DexMethodId>(header_.methodIdsOff, header_.methodIdsSize))
             {
                 setError("方法ID表偏移量无效");
                 return false;
@@ -205,7 +238,7 @@ namespace dex::parser
         // 检查类定义表
         if (header_.classDefsSize > 0)
         {
-            if (!isValidOffset(header_.classDefsOff, header_.classDefsSize * 32))
+            if (!BaseReader_.isValidArray<DexClassDef>(header_.classDefsOff, header_.classDefsSize))
             {
                 setError("类定义表偏移量无效");
                 // setError("类定义表偏移量无效");
@@ -225,4 +258,49 @@ namespace dex::parser
 
         return true;
     }
+
+    bool HeaderParser::validateChecksum() const
+    {
+        // 校验和覆盖magic和checksum字段之后的全部数据
+        constexpr size_t kChecksumStart = offsetof(DexHeader, signature);
+        if (BaseFileSize_ < kChecksumStart)
+        {
+            setError("文件过小，无法校验校验和");
+            return false;
+        }
+
+        const uint32_t checksum = adler32Parallel(BaseFileData_ + kChecksumStart,
+                                                  BaseFileSize_ - kChecksumStart, threadCount_);
+        if (checksum != header_.checksum)
+        {
+            setError("校验和不匹配: 头部声明 0x%08X, 实际 0x%08X", header_.checksum, checksum);
+            return false;
+        }
+
+        LOGI("校验和验证通过: 0x%08X", checksum);
+        return true;
+    }
+
+    bool HeaderParser::validateSignature()
+    {
+        // 签名覆盖magic、checksum和signature字段之后的全部数据
+        constexpr size_t kSignatureStart = offsetof(DexHeader, fileSize);
+        if (BaseFileSize_ < kSignatureStart)
+        {
+            setError("文件过小，无法校验签名");
+            return false;
+        }
+
+        contentHash_ = Sha1::hash(BaseFileData_ + kSignatureStart, BaseFileSize_ - kSignatureStart);
+        hasContentHash_ = true;
+
+        if (memcmp(contentHash_.data(), header_.signature, kSHA1DigestLen) != 0)
+        {
+            setError("SHA-1签名不匹配: 实际 %s", Sha1::toHex(contentHash_).c_str());
+            return false;
+        }
+
+        LOGI("SHA-1签名验证通过");
+        return true;
+    }
 }
@@ -5,6 +5,7 @@
 #ifndef HEADERPARSER_H
 #define HEADERPARSER_H
 #include "BaseParser.h"
+#include "core/Sha1.h"
 
 namespace dex::parser
 {
@@ -47,6 +48,30 @@ namespace dex::parser
          */
         [[nodiscard]] static bool isValid(const uint8_t* fileData);
 
+        /**
+         * 设置是否校验Adler-32校验和（默认校验）
+         * @param verify 是否校验
+         */
+        void setVerifyChecksum(bool verify);
+
+        /**
+         * 设置是否校验SHA-1签名（默认校验）
+         * @param verify 是否校验
+         */
+        void setVerifySignature(bool verify);
+
+        /**
+         * 获取校验签名时计算的内容哈希（偏移32到文件末尾的SHA-1）
+         * @return 摘要指针，未校验签名时返回nullptr
+         */
+        const Sha1Digest* getContentHash() const;
+
+        /**
+         * 设置校验使用的线程数
+         * @param threadCount 线程数，0表示使用默认线程数
+         */
+        void setThreadCount(uint32_t threadCount);
+
     private:
 
         /**
@@ -79,11 +104,38 @@ namespace dex::parser
          */
         bool validateSectionOffsets() const;
 
+        /**
+         * 验证Adler-32校验和（覆盖偏移12到文件末尾）
+         * @return 是否一致
+         */
+        bool validateChecksum() const;
+
+        /**
+         * 验证SHA-1签名（覆盖偏移32到文件末尾），同时记录内容哈希
+         * @return 是否一致
+         */
+        bool validateSignature();
+
         // 解析后的头部结构
         DexHeader header_{};
 
         // 头部是否有效
         bool isValid_{};
+
+        // 是否校验校验和
+        bool verifyChecksum_ = true;
+
+        // 是否校验签名
+        bool verifySignature_ = true;
+
+        // 校验使用的线程数
+        uint32_t threadCount_ = 0;
+
+        // 内容哈希
+        Sha1Digest contentHash_{};
+
+        // 是否已计算内容哈希
+        bool hasContentHash_ = false;
     };
 }
 
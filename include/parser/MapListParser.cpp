@@ -0,0 +1,276 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "MapListParser.h"
+
+#include "log/log.h"
+
+namespace dex::parser
+{
+    namespace
+    {
+        // 段类型的固定属性
+        struct SectionSpec
+        {
+            uint16_t type;        // 段类型
+            const char* name;     // 段名称
+            uint32_t itemSize;    // 定长条目大小，0表示变长
+            bool aligned;         // 是否要求4字节对齐
+        };
+
+        // 规范中定义的全部段类型（map_list自身的大小由条目数决定，单独处理）
+        constexpr SectionSpec kSectionSpecs[] = {
+            {kDexTypeHeaderItem, "header_item", sizeof(DexHeader), true},
+            {kDexTypeStringIdItem, "string_id_item", sizeof(DexStringId), true},
+            {kDexTypeTypeIdItem, "type_id_item", sizeof(DexTypeId), true},
+            {kDexTypeProtoIdItem, "proto_id_item", sizeof(DexProtoId), true},
+            {kDexTypeFieldIdItem, "field_id_item", sizeof(DexFieldId), true},
+            {kDexTypeMethodIdItem, "method_id_item", sizeof(DexMethodId), true},
+            {kDexTypeClassDefItem, "class_def_item", sizeof(DexClassDef), true},
+            {kDexTypeCallSiteIdItem, "call_site_id_item", 4, true},
+            {kDexTypeMethodHandleItem, "method_handle_item", 8, true},
+            {kDexTypeMapList, "map_list", 0, true},
+            {kDexTypeTypeList, "type_list", 0, true},
+            {kDexTypeAnnotationSetRefList, "annotation_set_ref_list", 0, true},
+            {kDexTypeAnnotationSetItem, "annotation_set_item", 0, true},
+            {kDexTypeClassDataItem, "class_data_item", 0, false},
+            {kDexTypeCodeItem, "code_item", 0, true},
+            {kDexTypeStringDataItem, "string_data_item", 0, false},
+            {kDexTypeDebugInfoItem, "debug_info_item", 0, false},
+            {kDexTypeAnnotationItem, "annotation_item", 0, false},
+            {kDexTypeEncodedArrayItem, "encoded_array_item", 0, false},
+            {kDexTypeAnnotationsDirectoryItem, "annotations_directory_item", 0, true},
+            {kDexTypeHiddenapiClassDataItem, "hiddenapi_class_data_item", 0, true},
+        };
+
+        constexpr size_t kSectionSpecCount = sizeof(kSectionSpecs) / sizeof(kSectionSpecs[0]);
+
+        // 查找段类型在规范表中的位置，未知类型返回kSectionSpecCount
+        size_t findSpec(uint16_t type)
+        {
+            for (size_t i = 0; i < kSectionSpecCount; i++)
+            {
+                if (kSectionSpecs[i].type == type)
+                {
+                    return i;
+                }
+            }
+            return kSectionSpecCount;
+        }
+    }
+
+    MapListParser::MapListParser(const uint8_t* fileData, size_t fileSize)
+        : BaseParser(fileData, fileSize, &DexContext::getInstance().getHeader()),
+          mapList_(nullptr)
+    {
+        if (fileData == nullptr || fileSize == 0)
+        {
+            LOGE("文件数据为空");
+            return;
+        }
+    }
+
+    const char* MapListParser::getSectionName(uint16_t type)
+    {
+        const size_t spec = findSpec(type);
+        return spec < kSectionSpecCount ? kSectionSpecs[spec].name : "unknown";
+    }
+
+    bool MapListParser::parse()
+    {
+        // 检查文件数据是否有效
+        if (!BaseFileData_)
+        {
+            setError("文件数据为空，无法解析map_list");
+            return false;
+        }
+
+        const DexHeader& header = *BaseHeader_;
+
+        // 没有map_list的文件仍可按头部信息解析，只是缺少段表
+        if (header.mapOff == 0)
+        {
+            LOGW("DEX文件没有map_list");
+            DexContext::getInstance().setMapList(nullptr, {});
+            return true;
+        }
+
+        // 检查map_list自身的位置
+        const size_t fileSize = BaseFileSize_;
+        const size_t mapOff = header.mapOff;
+        mapList_ = BaseReader_.at<DexMapList>(mapOff, sizeof(uint32_t));
+        if (mapOff % 4 != 0 || mapList_ == nullptr)
+        {
+            setError("map_list偏移量无效: 0x%08X", header.mapOff);
+            return false;
+        }
+
+        const uint32_t count = mapList_->size;
+        const DexMapItem* items = BaseReader_.array<DexMapItem>(mapOff + sizeof(uint32_t), count);
+        if (items == nullptr)
+        {
+            setError("map_list条目数量超出文件范围: %u", count);
+            return false;
+        }
+        const size_t mapEnd = mapOff + sizeof(uint32_t) + static_cast<size_t>(count) * sizeof(DexMapItem);
+
+        // 一次线性扫描：map_list规范要求按偏移量升序排列，因此只需与前一段比较即可检查顺序和重叠
+        sections_.clear();
+        sections_.reserve(count);
+        bool seen[kSectionSpecCount] = {};
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const DexMapItem& item = items[i];
+            const size_t spec = findSpec(item.type);
+            if (spec == kSectionSpecCount)
+            {
+                setError("map_list条目 %u 的段类型未知: 0x%04X", i, item.type);
+                return false;
+            }
+
+            const char* name = kSectionSpecs[spec].name;
+            if (seen[spec])
+            {
+                setError("map_list中段 %s 重复出现", name);
+                return false;
+            }
+            seen[spec] = true;
+
+            if (item.offset >= fileSize)
+            {
+                setError("段 %s 的偏移量超出文件范围: 0x%08X", name, item.offset);
+                return false;
+            }
+
+            if (kSectionSpecs[spec].aligned && item.offset % 4 != 0)
+            {
+                setError("段 %s 的偏移量未按4字节对齐: 0x%08X", name, item.offset);
+                return false;
+            }
+
+            if (!sections_.empty())
+            {
+                MapSection& prev = sections_.back();
+                if (item.offset <= prev.offset)
+                {
+                    setError("map_list未按偏移量排序: %s(0x%08X) 位于 %s(0x%08X) 之后",
+                             name, item.offset, getSectionName(prev.type), prev.offset);
+                    return false;
+                }
+
+                // 变长段的结束位置即下一段的起始位置
+                if (prev.endOffset == 0)
+                {
+                    prev.endOffset = item.offset;
+                }
+                else if (prev.endOffset > item.offset)
+                {
+                    setError("段 %s 与 %s 重叠", getSectionName(prev.type), name);
+                    return false;
+                }
+            }
+
+            // 计算定长段的结束位置（64位运算，条目数量来自文件，不可信）
+            uint64_t byteSize = 0;
+            bool fixedSize = true;
+            if (item.type == kDexTypeHeaderItem)
+            {
+                if (item.offset != 0 || item.size != 1)
+                {
+                    setError("header_item段无效: 偏移量0x%08X, 数量%u", item.offset, item.size);
+                    return false;
+                }
+                byteSize = header.headerSize;
+            }
+            else if (item.type == kDexTypeMapList)
+            {
+                if (item.offset != mapOff || item.size != 1)
+                {
+                    setError("map_list段与头部不一致: 偏移量0x%08X, 数量%u", item.offset, item.size);
+                    return false;
+                }
+                byteSize = mapEnd - mapOff;
+            }
+            else
+            {
+                byteSize = static_cast<uint64_t>(item.size) * kSectionSpecs[spec].itemSize;
+                fixedSize = kSectionSpecs[spec].itemSize != 0;
+            }
+
+            MapSection section{item.type, item.size, item.offset, 0};
+            if (fixedSize)
+            {
+                if (byteSize > fileSize - item.offset)
+                {
+                    setError("段 %s 超出文件范围: 偏移量0x%08X, 数量%u", name, item.offset, item.size);
+                    return false;
+                }
+                section.endOffset = static_cast<uint32_t>(item.offset + byteSize);
+            }
+            sections_.push_back(section);
+        }
+
+        // 最后一个变长段延伸到文件末尾
+        if (!sections_.empty() && sections_.back().endOffset == 0)
+        {
+            sections_.back().endOffset = static_cast<uint32_t>(fileSize);
+        }
+
+        if (!seen[findSpec(kDexTypeHeaderItem)] || !seen[findSpec(kDexTypeMapList)])
+        {
+            setError("map_list缺少header_item或map_list段");
+            return false;
+        }
+
+        // 与头部中的ID表信息交叉校验
+        if (!checkHeaderSection(kDexTypeStringIdItem, header.stringIdsSize, header.stringIdsOff) ||
+            !checkHeaderSection(kDexTypeTypeIdItem, header.typeIdsSize, header.typeIdsOff) ||
+            !checkHeaderSection(kDexTypeProtoIdItem, header.protoIdsSize, header.protoIdsOff) ||
+            !checkHeaderSection(kDexTypeFieldIdItem, header.fieldIdsSize, header.fieldIdsOff) ||
+            !checkHeaderSection(kDexTypeMethodIdItem, header.methodIdsSize, header.methodIdsOff) ||
+            !checkHeaderSection(kDexTypeClassDefItem, header.classDefsSize, header.classDefsOff))
+        {
+            return false;
+        }
+
+        // 将段表存入全局上下文
+        DexContext::getInstance().setMapList(mapList_, std::move(sections_));
+
+        LOGI("成功解析map_list，共 %u 个段", count);
+        return true;
+    }
+
+    bool MapListParser::checkHeaderSection(uint16_t type, uint32_t size, uint32_t offset) const
+    {
+        const MapSection* section = nullptr;
+        for (const MapSection& s : sections_)
+        {
+            if (s.type == type)
+            {
+                section = &s;
+                break;
+            }
+        }
+
+        // 空表在map_list中可以省略
+        if (section == nullptr)
+        {
+            if (size == 0)
+            {
+                return true;
+            }
+            setError("map_list缺少段 %s", getSectionName(type));
+            return false;
+        }
+
+        if (section->size != size || (size > 0 && section->offset != offset))
+        {
+            setError("段 %s 与头部不一致: map_list(%u @ 0x%08X), 头部(%u @ 0x%08X)",
+                     getSectionName(type), section->size, section->offset, size, offset);
+            return false;
+        }
+        return true;
+    }
+}
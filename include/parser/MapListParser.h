@@ -0,0 +1,67 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef MAPLISTPARSER_H
+#define MAPLISTPARSER_H
+
+#include <vector>
+#include "BaseParser.h"
+#include "core/DexContext.h"
+
+namespace dex::parser
+{
+    /**
+     * map_list解析器
+     * 将map_list解析为按偏移量排序的段表，并在一次线性扫描中验证
+     * 段的顺序、重叠和边界，同时与头部中的ID表信息交叉校验
+     */
+    class MapListParser final : public BaseParser
+    {
+    public:
+        using BaseParser::BaseParser;
+
+        /**
+         * 构造函数
+         * @param fileData 文件数据
+         * @param fileSize 文件大小
+         */
+        MapListParser(const uint8_t* fileData, size_t fileSize);
+
+        /**
+         * 析构函数
+         */
+        ~MapListParser() override = default;
+
+        /**
+         * 实现解析函数
+         * @return 解析是否成功
+         */
+        bool parse() override;
+
+        /**
+         * 获取段类型名称
+         * @param type 段类型(DexMapItemType)
+         * @return 段类型名称，未知类型返回"unknown"
+         */
+        static const char* getSectionName(uint16_t type);
+
+    private:
+        /**
+         * 检查头部中的ID表与map_list中的对应段是否一致
+         * @param type 段类型
+         * @param size 头部记录的条目数量
+         * @param offset 头部记录的偏移量
+         * @return 是否一致
+         */
+        bool checkHeaderSection(uint16_t type, uint32_t size, uint32_t offset) const;
+
+        // map_list指针
+        const DexMapList* mapList_;
+
+        // 解析出的段表
+        std::vector<MapSection> sections_;
+    };
+}
+
+#endif //MAPLISTPARSER_H
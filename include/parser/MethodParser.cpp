@@ -39,16 +39,14 @@ namespace dex::parser
             return true; // 空表也是有效的
         }
 
-        // 检查Method ID表偏移量是否有效
-        if (header.methodIdsOff + header.methodIdsSize * sizeof(DexMethodId) > BaseFileSize_)
+        // 获取Method ID表指针（按条目数检查范围，避免条目数乘元素大小时溢出）
+        methodIds_ = BaseReader_.array<DexMethodId>(header.methodIdsOff, header.methodIdsSize);
+        if (methodIds_ == nullptr)
         {
             setError("Method ID表偏移量或大小无效");
             return false;
         }
-
-        // 获取Method ID表指针
         methodIdsSize_ = header.methodIdsSize;
-        methodIds_ = reinterpret_cast<const DexMethodId*>(BaseFileData_ + header.methodIdsOff);
         
         // 验证Method ID表数据
         for (uint32_t i = 0; i < methodIdsSize_; i++)
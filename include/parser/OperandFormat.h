@@ -0,0 +1,353 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef OPERANDFORMAT_H
+#define OPERANDFORMAT_H
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include "CodeParser.h"
+
+namespace dex::parser
+{
+    // 操作数文本缓冲区的建议大小，超出部分被截断
+    inline constexpr size_t kOperandBufferSize = 256;
+
+    /**
+     * OperandWriter - 向调用者提供的缓冲区写入操作数文本
+     * 不分配内存，空间不足时截断；缓冲区大小至少为1，末尾保留一个字节写入结尾的0
+     */
+    class OperandWriter
+    {
+    public:
+        OperandWriter(char* buffer, size_t size)
+            : begin_(buffer), cur_(buffer), end_(buffer + size - 1)
+        {
+        }
+
+        void put(char c)
+        {
+            if (cur_ < end_)
+            {
+                *cur_++ = c;
+            }
+        }
+
+        void write(std::string_view text)
+        {
+            const size_t count = std::min(text.size(), static_cast<size_t>(end_ - cur_));
+            std::copy_n(text.data(), count, cur_);
+            cur_ += count;
+        }
+
+        // 写入无符号十进制数
+        void writeDec(uint64_t value)
+        {
+            char digits[20];
+            write(std::string_view(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr - digits));
+        }
+
+        // 写入有符号十进制数
+        void writeSigned(int64_t value)
+        {
+            char digits[20];
+            write(std::string_view(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr - digits));
+        }
+
+        // 写入大写十六进制数，不足minDigits位时补0
+        void writeHex(uint64_t value, int minDigits = 1)
+        {
+            char digits[16];
+            int count = 0;
+            do
+            {
+                digits[count++] = "0123456789ABCDEF"[value & 0xF];
+                value >>= 4;
+            } while (value != 0 || count < minDigits);
+            while (count > 0)
+            {
+                put(digits[--count]);
+            }
+        }
+
+        // 写入寄存器 vN
+        void reg(uint32_t number)
+        {
+            put('v');
+            writeDec(number);
+        }
+
+        // 写入结尾的0，返回文本长度
+        size_t finish()
+        {
+            *cur_ = '\0';
+            return static_cast<size_t>(cur_ - begin_);
+        }
+
+    private:
+        char* begin_;
+        char* cur_;
+        char* end_;
+    };
+
+    /**
+     * 只输出常量池索引的引用解析器，例如string@12、method@305
+     * 自定义解析器需要提供相同签名的调用运算符
+     */
+    struct IndexResolver
+    {
+        void operator()(OperandWriter& out, IndexType type, uint32_t index) const
+        {
+            switch (type)
+            {
+                case IndexType::String: out.write("string@"); break;
+                case IndexType::Type: out.write("type@"); break;
+                case IndexType::Field: out.write("field@"); break;
+                case IndexType::Method: out.write("method@"); break;
+                case IndexType::Proto: out.write("proto@"); break;
+                case IndexType::CallSite: out.write("call_site@"); break;
+                case IndexType::MethodHandle: out.write("method_handle@"); break;
+                default: out.write("@"); break;
+            }
+            out.writeDec(index);
+        }
+    };
+
+    namespace detail
+    {
+        // 分支目标：与CodePrint偏移量列相同的字节偏移
+        inline void writeBranch(OperandWriter& out, const DecodedInstruction& insn, uint32_t offset)
+        {
+            out.write("0x");
+            out.writeHex(static_cast<uint32_t>(offset + insn.branch) * 2ULL, 4);
+        }
+
+        // 35c/35ms/45cc的参数寄存器列表 {vC, vD, ...}
+        inline void writeArgs(OperandWriter& out, const DecodedInstruction& insn)
+        {
+            out.put('{');
+            const uint32_t count = std::min<uint32_t>(insn.vA, 5);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (i > 0)
+                {
+                    out.write(", ");
+                }
+                out.reg(insn.args[i]);
+            }
+            out.put('}');
+        }
+
+        // 3rc/3rms/4rcc的寄存器范围 {vCCCC .. vNNNN}
+        inline void writeRange(OperandWriter& out, const DecodedInstruction& insn)
+        {
+            out.put('{');
+            if (insn.vA > 0)
+            {
+                out.reg(insn.vC);
+                if (insn.vA > 1)
+                {
+                    out.write(" .. ");
+                    out.reg(insn.vC + insn.vA - 1);
+                }
+            }
+            out.put('}');
+        }
+    }
+
+    /**
+     * 按指令格式输出操作数，每种格式一个实例
+     * @param insn 解码后的指令
+     * @param offset 指令偏移(16位字)
+     * @param resolve 常量池引用解析器
+     * @param out 输出缓冲区
+     */
+    template <DalvikFormatFlag Format, typename Resolver>
+    void formatOperands(const DecodedInstruction& insn, uint32_t offset, const Resolver& resolve, OperandWriter& out)
+    {
+        if constexpr (Format == kFmt12x || Format == kFmt22x || Format == kFmt32x)
+        {
+            out.reg(insn.vA);
+            out.write(", ");
+            out.reg(insn.vB);
+        }
+        else if constexpr (Format == kFmt11n || Format == kFmt21s || Format == kFmt31i || Format == kFmt51l)
+        {
+            out.reg(insn.vA);
+            out.write(", #");
+            out.writeSigned(insn.literal);
+        }
+        else if constexpr (Format == kFmt21h)
+        {
+            // 只有高16位有效，按十六进制输出更直观
+            out.reg(insn.vA);
+            out.write(", #0x");
+            out.writeHex(insn.opcode == 0x19 ? static_cast<uint64_t>(insn.literal)
+                                             : static_cast<uint32_t>(insn.literal));
+        }
+        else if constexpr (Format == kFmt11x)
+        {
+            out.reg(insn.vA);
+        }
+        else if constexpr (Format == kFmt10t || Format == kFmt20t || Format == kFmt30t)
+        {
+            detail::writeBranch(out, insn, offset);
+        }
+        else if constexpr (Format == kFmt21t || Format == kFmt31t)
+        {
+            out.reg(insn.vA);
+            out.write(", ");
+            detail::writeBranch(out, insn, offset);
+        }
+        else if constexpr (Format == kFmt22t)
+        {
+            out.reg(insn.vA);
+            out.write(", ");
+            out.reg(insn.vB);
+            out.write(", ");
+            detail::writeBranch(out, insn, offset);
+        }
+        else if constexpr (Format == kFmt23x)
+        {
+            out.reg(insn.vA);
+            out.write(", ");
+            out.reg(insn.vB);
+            out.write(", ");
+            out.reg(insn.vC);
+        }
+        else if constexpr (Format == kFmt22b || Format == kFmt22s)
+        {
+            out.reg(insn.vA);
+            out.write(", ");
+            out.reg(insn.vB);
+            out.write(", #");
+            out.writeSigned(insn.literal);
+        }
+        else if constexpr (Format == kFmt20bc)
+        {
+            // throw-verification-error: 错误类型和引用索引
+            out.put('#');
+            out.writeDec(insn.vA);
+            out.write(", @");
+            out.writeDec(insn.index);
+        }
+        else if constexpr (Format == kFmt21c || Format == kFmt31c)
+        {
+            out.reg(insn.vA);
+            out.write(", ");
+            resolve(out, insn.indexType, insn.index);
+        }
+        else if constexpr (Format == kFmt22c)
+        {
+            out.reg(insn.vA);
+            out.write(", ");
+            out.reg(insn.vB);
+            out.write(", ");
+            resolve(out, insn.indexType, insn.index);
+        }
+        else if constexpr (Format == kFmt22cs)
+        {
+            out.reg(insn.vA);
+            out.write(", ");
+            out.reg(insn.vB);
+            out.write(", [obj+0x");
+            out.writeHex(insn.index, 4);
+            out.put(']');
+        }
+        else if constexpr (Format == kFmt35c || Format == kFmt3rc)
+        {
+            if constexpr (Format == kFmt35c)
+            {
+                detail::writeArgs(out, insn);
+            }
+            else
+            {
+                detail::writeRange(out, insn);
+            }
+            out.write(", ");
+            resolve(out, insn.indexType, insn.index);
+        }
+        else if constexpr (Format == kFmt35ms || Format == kFmt3rms)
+        {
+            if constexpr (Format == kFmt35ms)
+            {
+                detail::writeArgs(out, insn);
+            }
+            else
+            {
+                detail::writeRange(out, insn);
+            }
+            out.write(", [vtable #0x");
+            out.writeHex(insn.index, 4);
+            out.put(']');
+        }
+        else if constexpr (Format == kFmt45cc || Format == kFmt4rcc)
+        {
+            if constexpr (Format == kFmt45cc)
+            {
+                detail::writeArgs(out, insn);
+            }
+            else
+            {
+                detail::writeRange(out, insn);
+            }
+            out.write(", ");
+            resolve(out, IndexType::Method, insn.index);
+            out.write(", ");
+            resolve(out, IndexType::Proto, insn.index2);
+        }
+        else
+        {
+            // kFmt00x/kFmt10x/kFmtPayload/kFmtUnknown没有操作数
+            (void)insn;
+            (void)offset;
+            (void)resolve;
+            (void)out;
+        }
+    }
+
+    namespace detail
+    {
+        template <typename Resolver>
+        using FormatFn = void (*)(const DecodedInstruction&, uint32_t, const Resolver&, OperandWriter&);
+
+        template <typename Resolver, size_t... Formats>
+        constexpr std::array<FormatFn<Resolver>, sizeof...(Formats)> makeFormatTable(std::index_sequence<Formats...>)
+        {
+            return {&formatOperands<static_cast<DalvikFormatFlag>(Formats), Resolver>...};
+        }
+    }
+
+    /**
+     * 把一条指令的操作数写入调用者提供的缓冲区
+     * 按指令格式查表分派到对应的formatOperands实例，不使用流也不分配内存
+     * @param insn 解码后的指令
+     * @param offset 指令偏移(16位字)，用于计算分支目标
+     * @param resolve 常量池引用解析器
+     * @param buffer 输出缓冲区，写入结尾的0
+     * @param size 缓冲区大小，至少为1
+     * @return 文本长度
+     */
+    template <typename Resolver = IndexResolver>
+    size_t renderOperands(const DecodedInstruction& insn, uint32_t offset, const Resolver& resolve,
+                          char* buffer, size_t size)
+    {
+        static constexpr auto kFormatTable =
+            detail::makeFormatTable<Resolver>(std::make_index_sequence<kFmtUnknown + 1>());
+
+        OperandWriter out(buffer, size);
+        if (static_cast<size_t>(insn.format) < kFormatTable.size())
+        {
+            kFormatTable[insn.format](insn, offset, resolve, out);
+        }
+        return out.finish();
+    }
+}
+
+#endif //OPERANDFORMAT_H
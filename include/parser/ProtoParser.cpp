@@ -41,16 +41,14 @@ namespace dex::parser
             return true; // 空表也是有效的
         }
 
-        // 检查Proto ID表偏移量是否有效
-        if (header.protoIdsOff + header.protoIdsSize * sizeof(DexProtoId) > BaseFileSize_)
+        // 获取Proto ID表指针（按条目数检查范围，避免条目数乘元素大小时溢出）
+        protoIds_ = BaseReader_.array<DexProtoId>(header.protoIdsOff, header.protoIdsSize);
+        if (protoIds_ == nullptr)
         {
             setError("Proto ID表偏移量或大小无效");
             return false;
         }
-
-        // 获取Proto ID表指针
         protoIdsSize_ = header.protoIdsSize;
-        protoIds_ = reinterpret_cast<const DexProtoId*>(BaseFileData_ + header.protoIdsOff);
         
         // 验证Proto ID表数据
         for (uint32_t i = 0; i < protoIdsSize_; i++)
@@ -72,19 +70,17 @@ namespace dex::parser
             // 验证parameters_off（如果有）
             if (protoIds_[i].parameters_off != 0)
             {
-                if (protoIds_[i].parameters_off >= BaseFileSize_)
+                // 验证TypeList结构
+                const uint32_t paramsOff = protoIds_[i].parameters_off;
+                const DexTypeList* typeList = BaseReader_.at<DexTypeList>(paramsOff, sizeof(uint32_t));
+                if (typeList == nullptr)
                 {
-                    setError("Proto ID %u 的 parameters_off 无效: %u", i, protoIds_[i].parameters_off);
+                    setError("Proto ID %u 的 parameters_off 无效: %u", i, paramsOff);
                     return false;
                 }
                 
-                // 验证TypeList结构
-                const DexTypeList* typeList = reinterpret_cast<const DexTypeList*>(
-                    BaseFileData_ + protoIds_[i].parameters_off);
-                
                 // 检查TypeList大小是否有效
-                if (protoIds_[i].parameters_off + sizeof(typeList->size) +
-                    typeList->size * sizeof(DexTypeItem) > BaseFileSize_)
+                if (BaseReader_.array<DexTypeItem>(paramsOff + sizeof(uint32_t), typeList->size) == nullptr)
                 {
                     setError("Proto ID %u 的 TypeList 大小无效: %u", i, typeList->size);
                     return false;
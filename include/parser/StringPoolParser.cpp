@@ -41,18 +41,17 @@ namespace dex::parser
             return true; // 空表也是有效的
         }
 
-        // 检查字符串ID表偏移量是否有效
-        if (header.stringIdsOff + header.stringIdsSize * sizeof(DexStringId) > BaseFileSize_)
+        // 获取字符串ID表指针（按条目数检查范围，避免条目数乘元素大小时溢出）
+        stringIds_ = BaseReader_.array<DexStringId>(header.stringIdsOff, header.stringIdsSize);
+        if (stringIds_ == nullptr)
         {
             setError("字符串ID表偏移量或大小无效");
             return false;
         }
-
-        // 获取字符串ID表指针
         stringIdsSize_ = header.stringIdsSize;
-        stringIds_ = reinterpret_cast<const DexStringId*>(BaseFileData_ + header.stringIdsOff);
         
-        // 验证字符串数据偏移量
+        // 验证字符串数据：ULEB128长度和随后的内容都必须位于文件范围内，
+        // 验证通过后DexContext读取字符串时不再做边界检查
         for (uint32_t i = 0; i < stringIdsSize_; i++)
         {
             const uint32_t offset = stringIds_[i].stringDataOff;
@@ -61,28 +60,16 @@ namespace dex::parser
                 setError("字符串数据偏移量无效: %u", offset);
                 return false;
             }
-            
-            // 简单检查字符串格式
-            const uint8_t* data = BaseFileData_ + offset;
-            uint8_t byte;
-            uint32_t len = 0;
-            uint32_t shift = 0;
-            
-            // 解析ULEB128长度
-            do {
-                if (offset + (data - (BaseFileData_ + offset)) >= BaseFileSize_)
-                {
-                    setError("字符串长度解析超出文件范围");
-                    return false;
-                }
-                
-                byte = *data++;
-                len |= (byte & 0x7F) << shift;
-                shift += 7;
-            } while (byte & 0x80);
-            
-            // 检查字符串内容不会超出文件范围
-            if (offset + (data - (BaseFileData_ + offset)) + len > BaseFileSize_)
+
+            CheckedReader reader(BaseFileData_, BaseFileSize_, offset);
+            const uint32_t len = reader.readULEB128();
+            if (!reader.ok())
+            {
+                setError("字符串长度解析超出文件范围");
+                return false;
+            }
+
+            if (!reader.skip(len))
             {
                 setError("字符串内容超出文件范围");
                 return false;
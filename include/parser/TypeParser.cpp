@@ -25,13 +25,8 @@ namespace dex::parser
     bool TypeParser::parse()
     {
         typeIdsSize_ = BaseHeader_->typeIdsSize;
-        typeIds_ = reinterpret_cast<const DexTypeId*>(BaseFileData_+BaseHeader_->typeIdsOff);
+        typeIds_ = BaseReader_.array<DexTypeId>(BaseHeader_->typeIdsOff, typeIdsSize_);
         if (typeIds_ == nullptr)
-        {
-            setError("类型ID表为空");
-            return false;
-        }
-        if (BaseHeader_->typeIdsOff + typeIdsSize_ * sizeof(DexTypeId) > BaseFileSize_)
         {
             setError("TypeID表偏移量或大小无效");
             return false;
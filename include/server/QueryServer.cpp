@@ -0,0 +1,857 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#include "QueryServer.h"
+
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "core/DexDump.h"
+#include "core/ThreadPool.h"
+#include "formatter/CodePrint.h"
+#include "formatter/OutputSink.h"
+#include "formatter/StatsPrint.h"
+#include "formatter/XrefPrint.h"
+#include "log/log.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace dex::server
+{
+    namespace
+    {
+        // 请求行的最大长度
+        constexpr size_t kMaxLineLength = 64 * 1024;
+
+        // 等待连接和请求时检查停止标记的间隔（毫秒）
+        constexpr int kPollInterval = 200;
+
+        // 连接在这段时间内没有发来完整的请求行时关闭，空闲或逐字节发送的客户端不能一直占用工作线程
+        constexpr std::chrono::seconds kIdleTimeout{10};
+
+        // 解析无符号十进制数，必须完整消耗文本
+        bool parseIndex(std::string_view text, uint32_t& value)
+        {
+            const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            return ec == std::errc() && ptr == text.data() + text.size() && !text.empty();
+        }
+
+        // 解析指令地址，0x开头时按十六进制
+        bool parseAddress(std::string_view text, uint32_t& value)
+        {
+            if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+            {
+                text.remove_prefix(2);
+                const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value, 16);
+                return ec == std::errc() && ptr == text.data() + text.size();
+            }
+            return parseIndex(text, value);
+        }
+
+        // 把捕获的日志合并为一行错误信息
+        std::string errorMessage(const std::string& log, const char* fallback)
+        {
+            std::string message;
+            size_t begin = 0;
+            while (begin < log.size())
+            {
+                size_t end = log.find('\n', begin);
+                if (end == std::string::npos)
+                {
+                    end = log.size();
+                }
+                // 去掉日志级别前缀 "[ERROR] "
+                size_t text = begin;
+                if (log[begin] == '[')
+                {
+                    if (const size_t close = log.find("] ", begin); close != std::string::npos && close < end)
+                    {
+                        text = close + 2;
+                    }
+                }
+                if (end > text)
+                {
+                    if (!message.empty())
+                    {
+                        message += "; ";
+                    }
+                    message.append(log, text, end - text);
+                }
+                begin = end + 1;
+            }
+            return message.empty() ? fallback : message;
+        }
+
+        // 输出单行字符串，转义换行、制表符等控制字符
+        void writeEscaped(print::OutputSink& out, std::string_view text)
+        {
+            for (const char c : text)
+            {
+                switch (c)
+                {
+                    case '\n': out.write("\\n"); break;
+                    case '\r': out.write("\\r"); break;
+                    case '\t': out.write("\\t"); break;
+                    case '\\': out.write("\\\\"); break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            out.write("\\x");
+                            out.writeHex(static_cast<unsigned char>(c), 2);
+                        }
+                        else
+                        {
+                            out.put(c);
+                        }
+                        break;
+                }
+            }
+        }
+
+        // 查找Lcom/Foo;->bar形式的方法，返回全部重载的方法索引
+        std::vector<uint32_t> findMethods(const DexContext& context, std::string_view reference)
+        {
+            std::vector<uint32_t> found;
+            const size_t arrow = reference.find("->");
+            if (arrow == std::string_view::npos)
+            {
+                return found;
+            }
+            const std::string_view className = reference.substr(0, arrow);
+            const std::string_view methodName = reference.substr(arrow + 2);
+
+            const std::span<const DexTypeId> typeIds = context.getTypeIds();
+            const std::span<const DexMethodId> methodIds = context.getMethodIds();
+            for (uint32_t i = 0; i < methodIds.size(); i++)
+            {
+                const DexMethodId& method = methodIds[i];
+                if (method.classIdx < typeIds.size() &&
+                    context.getStringData(method.nameIdx) == methodName &&
+                    context.getStringData(typeIds[method.classIdx].descriptor_idx) == className)
+                {
+                    found.push_back(i);
+                }
+            }
+            return found;
+        }
+
+        // 解析方法索引或Lcom/Foo;->bar形式的方法引用
+        bool resolveMethods(const DexContext& context, const std::string& reference, std::vector<uint32_t>& methodIdxs)
+        {
+            methodIdxs.clear();
+            if (uint32_t methodIdx = 0; parseIndex(reference, methodIdx))
+            {
+                if (methodIdx >= context.getMethodIdsCount())
+                {
+                    LOGE("无效的方法索引: %u", methodIdx);
+                    return false;
+                }
+                methodIdxs.push_back(methodIdx);
+                return true;
+            }
+
+            methodIdxs = findMethods(context, reference);
+            if (methodIdxs.empty())
+            {
+                LOGE("没有找到方法: %s", reference.c_str());
+                return false;
+            }
+            return true;
+        }
+
+#ifndef _WIN32
+        // 写入全部数据
+        bool writeAll(int fd, std::string_view data)
+        {
+            while (!data.empty())
+            {
+                const ssize_t written = ::send(fd, data.data(), data.size(), 0);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return false;
+                }
+                data.remove_prefix(static_cast<size_t>(written));
+            }
+            return true;
+        }
+
+        // 填充套接字地址，路径过长时返回false
+        bool makeAddress(const std::string& path, sockaddr_un& address)
+        {
+            memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            if (path.empty() || path.size() >= sizeof(address.sun_path))
+            {
+                LOGE("套接字路径为空或过长: %s", path.c_str());
+                return false;
+            }
+            memcpy(address.sun_path, path.c_str(), path.size());
+            return true;
+        }
+
+        // 连接到套接字，失败时返回-1
+        int connectTo(const std::string& path)
+        {
+            sockaddr_un address{};
+            if (!makeAddress(path, address))
+            {
+                return -1;
+            }
+            const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd < 0)
+            {
+                return -1;
+            }
+            if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+            {
+                ::close(fd);
+                return -1;
+            }
+            return fd;
+        }
+
+        // 编码响应
+        std::string encodeResult(const QueryResult& result)
+        {
+            if (!result.ok)
+            {
+                std::string response = "ERR ";
+                for (const char c : result.text)
+                {
+                    response.push_back(c == '\n' || c == '\r' ? ' ' : c);
+                }
+                response.push_back('\n');
+                return response;
+            }
+            std::string response = "OK " + std::to_string(result.text.size()) + "\n";
+            response += result.text;
+            return response;
+        }
+#endif
+    }
+
+    QueryServer::QueryServer(std::string socketPath, uint64_t memoryBudget, const DexContext& config)
+        : socketPath_(std::move(socketPath)), cache_(memoryBudget, config)
+    {
+    }
+
+    void QueryServer::setThreadCount(uint32_t threadCount)
+    {
+        threadCount_ = threadCount;
+    }
+
+    void QueryServer::stop()
+    {
+        stopping_.store(true, std::memory_order_relaxed);
+    }
+
+    bool QueryServer::splitArguments(std::string_view line, std::vector<std::string>& args)
+    {
+        args.clear();
+        size_t i = 0;
+        while (true)
+        {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t'))
+            {
+                i++;
+            }
+            if (i == line.size())
+            {
+                return true;
+            }
+
+            std::string arg;
+            while (i < line.size() && line[i] != ' ' && line[i] != '\t')
+            {
+                if (line[i] != '"')
+                {
+                    arg.push_back(line[i++]);
+                    continue;
+                }
+                // 引号内保留空白，\"和\\转义
+                i++;
+                while (true)
+                {
+                    if (i == line.size())
+                    {
+                        return false;
+                    }
+                    if (line[i] == '"')
+                    {
+                        i++;
+                        break;
+                    }
+                    if (line[i] == '\\' && i + 1 < line.size() && (line[i + 1] == '"' || line[i + 1] == '\\'))
+                    {
+                        i++;
+                    }
+                    arg.push_back(line[i++]);
+                }
+            }
+            args.push_back(std::move(arg));
+        }
+    }
+
+    std::string QueryServer::joinArguments(const std::vector<std::string>& args)
+    {
+        std::string line;
+        for (const std::string& arg : args)
+        {
+            if (!line.empty())
+            {
+                line.push_back(' ');
+            }
+            if (!arg.empty() && arg.find_first_of(" \t\"") == std::string::npos)
+            {
+                line += arg;
+                continue;
+            }
+            line.push_back('"');
+            for (const char c : arg)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    line.push_back('\\');
+                }
+                line.push_back(c);
+            }
+            line.push_back('"');
+        }
+        return line;
+    }
+
+    QueryResult QueryServer::handleRequest(std::string_view line)
+    {
+        QueryResult result;
+        std::vector<std::string> args;
+        if (!splitArguments(line, args))
+        {
+            result.text = "引号不匹配";
+            return result;
+        }
+        if (args.empty())
+        {
+            result.text = "请求为空";
+            return result;
+        }
+
+        const std::string& command = args[0];
+        if (command == "ping")
+        {
+            result.ok = true;
+            result.text = "pong\n";
+            return result;
+        }
+        if (command == "cache")
+        {
+            char summary[128];
+            snprintf(summary, sizeof(summary), "共 %zu 个文件，%.1f MB / %.1f MB\n", cache_.list().size(),
+                     static_cast<double>(cache_.memoryUsage()) / (1024.0 * 1024.0),
+                     static_cast<double>(cache_.memoryBudget()) / (1024.0 * 1024.0));
+            result.text = summary;
+            for (const ContextCache::EntryInfo& entry : cache_.list())
+            {
+                result.text += std::to_string(entry.cost) + "\t" + entry.path + "\n";
+            }
+            result.ok = true;
+            return result;
+        }
+        if (command != "method" && command != "line" && command != "catch" && command != "string" &&
+            command != "xrefs" && command != "stats")
+        {
+            result.text = "未知请求: " + command;
+            return result;
+        }
+        if (args.size() < 2)
+        {
+            result.text = "缺少文件参数";
+            return result;
+        }
+
+        // 文件的解析错误和请求的错误都返回给客户端
+        std::string log;
+        log_set_thread_capture(&log);
+        {
+            const ContextCache::Lease lease = cache_.acquire(args[1]);
+            if (!lease)
+            {
+                log_set_thread_capture(nullptr);
+                result.text = errorMessage(log, "打开文件失败");
+                return result;
+            }
+
+            ScopedDexContext scope(lease.entry->context);
+            print::MemorySink sink;
+            result.ok = dispatch(args, sink);
+            result.text = result.ok ? sink.take() : errorMessage(log, "请求失败");
+            cache_.updateCost(lease);
+        }
+        log_set_thread_capture(nullptr);
+        return result;
+    }
+
+    bool QueryServer::dispatch(const std::vector<std::string>& args, print::OutputSink& out)
+    {
+        const DexContext& context = DexContext::getInstance();
+        const std::string& command = args[0];
+
+        if (command == "method")
+        {
+            if (args.size() != 3)
+            {
+                LOGE("用法: method <文件> <方法索引|Lcom/Foo;->bar>");
+                return false;
+            }
+            std::vector<uint32_t> methodIdxs;
+            if (!resolveMethods(context, args[2], methodIdxs))
+            {
+                return false;
+            }
+
+            print::CodePrint code_print{};
+            code_print.setSink(out);
+            for (const uint32_t methodIdx : methodIdxs)
+            {
+                if (!DexDump::parseCode(methodIdx))
+                {
+                    LOGE("解析方法 %u 的代码失败", methodIdx);
+                    return false;
+                }
+                code_print.printMethodCode(methodIdx);
+            }
+            out.flush();
+            return true;
+        }
+
+        if (command == "line")
+        {
+            uint32_t value = 0;
+            if (args.size() != 5 || (args[3] != "pc" && args[3] != "line") ||
+                !(args[3] == "pc" ? parseAddress(args[4], value) : parseIndex(args[4], value)))
+            {
+                LOGE("用法: line <文件> <方法索引|Lcom/Foo;->bar> pc <地址>|line <行号>");
+                return false;
+            }
+            std::vector<uint32_t> methodIdxs;
+            if (!resolveMethods(context, args[2], methodIdxs))
+            {
+                return false;
+            }
+
+            // 每行以方法索引开头，按名字查询时区分各个重载；地址以16位代码单元为单位
+            for (const uint32_t methodIdx : methodIdxs)
+            {
+                if (args[3] == "pc")
+                {
+                    const int32_t line = context.lineForPc(methodIdx, value);
+                    if (line >= 0)
+                    {
+                        out.write(std::to_string(methodIdx));
+                        out.put('\t');
+                        out.write(std::to_string(line));
+                        out.put('\n');
+                    }
+                    continue;
+                }
+
+                for (const PcRange& range : context.pcRangeForLine(methodIdx, value))
+                {
+                    out.write(std::to_string(methodIdx));
+                    out.write("\t0x");
+                    out.writeHex(range.startPc, 4);
+                    out.write("-0x");
+                    out.writeHex(range.endPc, 4);
+                    out.put('\n');
+                }
+            }
+            out.flush();
+            return true;
+        }
+
+        if (command == "catch")
+        {
+            uint32_t pc = 0;
+            if (args.size() != 4 || !parseAddress(args[3], pc))
+            {
+                LOGE("用法: catch <文件> <方法索引|Lcom/Foo;->bar> <地址>");
+                return false;
+            }
+            std::vector<uint32_t> methodIdxs;
+            if (!resolveMethods(context, args[2], methodIdxs))
+            {
+                return false;
+            }
+
+            // 每行为方法索引、捕获的异常类型（catch-all为<any>）和处理器地址
+            for (const uint32_t methodIdx : methodIdxs)
+            {
+                const std::shared_ptr<const CatchHandlerInfo> handler = context.findCatchHandler(methodIdx, pc);
+                if (handler == nullptr)
+                {
+                    continue;
+                }
+                const auto writeHandler = [&](std::string_view type, uint32_t address)
+                {
+                    out.write(std::to_string(methodIdx));
+                    out.put('\t');
+                    out.write(type);
+                    out.write("\t0x");
+                    out.writeHex(address, 4);
+                    out.put('\n');
+                };
+                for (const CatchHandlerInfo::CatchInfo& catchInfo : handler->catches)
+                {
+                    writeHandler(context.getType(catchInfo.typeIdx), catchInfo.address);
+                }
+                if (handler->hasCatchAll)
+                {
+                    writeHandler("<any>", handler->catchAllAddr);
+                }
+            }
+            out.flush();
+            return true;
+        }
+
+        if (command == "string")
+        {
+            uint32_t limit = UINT32_MAX;
+            if (args.size() < 3 || args.size() > 4 || (args.size() == 4 && !parseIndex(args[3], limit)))
+            {
+                LOGE("用法: string <文件> <文本> [最多条数]");
+                return false;
+            }
+            // 在MUTF-8数据上直接查找，只解码匹配的字符串
+            const std::string_view text = args[2];
+            const uint32_t count = context.getStringIdsCount();
+            uint32_t matched = 0;
+            for (uint32_t i = 0; i < count && matched < limit; i++)
+            {
+                if (context.getStringData(i).find(text) == std::string_view::npos)
+                {
+                    continue;
+                }
+                matched++;
+                out.write(std::to_string(i));
+                out.put('\t');
+                writeEscaped(out, context.getString(i));
+                out.put('\n');
+            }
+            out.flush();
+            return true;
+        }
+
+        if (command == "xrefs")
+        {
+            if (args.size() < 4 || (args[2] != "field" && args[2] != "type"))
+            {
+                LOGE("用法: xrefs <文件> field|type <索引>...");
+                return false;
+            }
+            const bool field = args[2] == "field";
+            const uint32_t limit = field ? context.getFieldIdsCount() : context.getTypeIdsCount();
+            std::vector<uint32_t> idxs;
+            for (size_t i = 3; i < args.size(); i++)
+            {
+                uint32_t idx = 0;
+                if (!parseIndex(args[i], idx) || idx >= limit)
+                {
+                    LOGE("无效的%s索引: %s", field ? "字段" : "类型", args[i].c_str());
+                    return false;
+                }
+                idxs.push_back(idx);
+            }
+
+            print::XrefPrint xref_print = field ? print::XrefPrint{std::move(idxs), {}}
+                                                : print::XrefPrint{{}, std::move(idxs)};
+            xref_print.setSink(out);
+            xref_print.print();
+            return true;
+        }
+
+        // stats
+        if (args.size() != 2)
+        {
+            LOGE("用法: stats <文件>");
+            return false;
+        }
+        print::StatsPrint stats_print{};
+        stats_print.setSink(out);
+        stats_print.print();
+        out.flush();
+        return true;
+    }
+
+#ifndef _WIN32
+    bool QueryServer::run()
+    {
+        // 客户端提前断开时send返回错误而不是终止进程
+        signal(SIGPIPE, SIG_IGN);
+
+        sockaddr_un address{};
+        if (!makeAddress(socketPath_, address))
+        {
+            return false;
+        }
+
+        // 删除失效的套接字，已有服务在监听时不抢占
+        struct stat status{};
+        if (lstat(socketPath_.c_str(), &status) == 0)
+        {
+            if (!S_ISSOCK(status.st_mode))
+            {
+                LOGE("路径已存在且不是套接字: %s", socketPath_.c_str());
+                return false;
+            }
+            if (const int fd = connectTo(socketPath_); fd >= 0)
+            {
+                ::close(fd);
+                LOGE("已有服务在监听: %s", socketPath_.c_str());
+                return false;
+            }
+            ::unlink(socketPath_.c_str());
+        }
+
+        const int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0)
+        {
+            LOGE("创建套接字失败: %s", strerror(errno));
+            return false;
+        }
+        // 只允许当前用户连接
+        const mode_t oldMask = umask(0077);
+        const bool bound = ::bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+        umask(oldMask);
+        if (!bound || ::listen(listenFd, SOMAXCONN) != 0)
+        {
+            LOGE("监听套接字失败: %s (%s)", socketPath_.c_str(), strerror(errno));
+            ::close(listenFd);
+            return false;
+        }
+        LOGI("开始监听: %s", socketPath_.c_str());
+
+        // 有上限的工作线程，每个线程一次处理一个连接
+        std::mutex queueMutex;
+        std::condition_variable queueReady;
+        std::deque<int> pending;
+        const uint32_t threadCount = threadCount_ == 0 ? getDefaultThreadCount() : threadCount_;
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; i++)
+        {
+            workers.emplace_back(
+                [&]()
+                {
+                    while (true)
+                    {
+                        int fd;
+                        {
+                            std::unique_lock lock(queueMutex);
+                            queueReady.wait(lock, [&]() { return !pending.empty() || stopping_.load(); });
+                            if (pending.empty())
+                            {
+                                return;
+                            }
+                            fd = pending.front();
+                            pending.pop_front();
+                        }
+                        serveConnection(fd);
+                        ::close(fd);
+                    }
+                });
+        }
+
+        while (!stopping_.load(std::memory_order_relaxed))
+        {
+            pollfd pfd{listenFd, POLLIN, 0};
+            const int ready = ::poll(&pfd, 1, kPollInterval);
+            if (ready <= 0)
+            {
+                continue;
+            }
+            const int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd < 0)
+            {
+                continue;
+            }
+            {
+                std::lock_guard lock(queueMutex);
+                pending.push_back(fd);
+            }
+            queueReady.notify_one();
+        }
+
+        // 停止：不再接受连接，关闭尚未处理的连接，等待处理中的请求结束
+        ::close(listenFd);
+        ::unlink(socketPath_.c_str());
+        {
+            std::lock_guard lock(queueMutex);
+            for (const int fd : pending)
+            {
+                ::close(fd);
+            }
+            pending.clear();
+        }
+        queueReady.notify_all();
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        LOGI("服务已停止");
+        return true;
+    }
+
+    void QueryServer::serveConnection(int fd)
+    {
+        std::string buffer;
+        char chunk[4096];
+        auto deadline = std::chrono::steady_clock::now() + kIdleTimeout;
+        while (!stopping_.load(std::memory_order_relaxed))
+        {
+            // 处理缓冲区中完整的请求行
+            size_t newline;
+            while ((newline = buffer.find('\n')) != std::string::npos)
+            {
+                std::string_view line(buffer.data(), newline);
+                if (!line.empty() && line.back() == '\r')
+                {
+                    line.remove_suffix(1);
+                }
+                if (line == "quit")
+                {
+                    return;
+                }
+                if (!line.empty() && !writeAll(fd, encodeResult(handleRequest(line))))
+                {
+                    return;
+                }
+                buffer.erase(0, newline + 1);
+                deadline = std::chrono::steady_clock::now() + kIdleTimeout;
+            }
+            if (buffer.size() > kMaxLineLength)
+            {
+                writeAll(fd, encodeResult({false, "请求过长"}));
+                return;
+            }
+
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                LOGI("连接空闲超时，关闭连接");
+                return;
+            }
+
+            pollfd pfd{fd, POLLIN, 0};
+            const int ready = ::poll(&pfd, 1, kPollInterval);
+            if (ready == 0 || (ready < 0 && errno == EINTR))
+            {
+                continue;
+            }
+            if (ready < 0)
+            {
+                return;
+            }
+            const ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0)
+            {
+                if (received < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                return;
+            }
+            buffer.append(chunk, static_cast<size_t>(received));
+        }
+    }
+
+    bool sendQuery(const std::string& socketPath, const std::string& request, QueryResult& result)
+    {
+        signal(SIGPIPE, SIG_IGN);
+
+        const int fd = connectTo(socketPath);
+        if (fd < 0)
+        {
+            LOGE("无法连接查询服务: %s (%s)", socketPath.c_str(), strerror(errno));
+            return false;
+        }
+        if (!writeAll(fd, request + "\nquit\n"))
+        {
+            LOGE("发送请求失败: %s", strerror(errno));
+            ::close(fd);
+            return false;
+        }
+
+        // 读取到连接关闭为止，服务在quit之后关闭连接
+        std::string response;
+        char chunk[65536];
+        while (true)
+        {
+            const ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (received < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (received <= 0)
+            {
+                break;
+            }
+            response.append(chunk, static_cast<size_t>(received));
+        }
+        ::close(fd);
+
+        const size_t newline = response.find('\n');
+        if (newline == std::string::npos)
+        {
+            LOGE("查询服务的响应不完整");
+            return false;
+        }
+        const std::string_view status(response.data(), newline);
+        if (status.starts_with("ERR "))
+        {
+            result.ok = false;
+            result.text = status.substr(4);
+            return true;
+        }
+        uint32_t length = 0;
+        if (!status.starts_with("OK ") || !parseIndex(status.substr(3), length) ||
+            response.size() - newline - 1 != length)
+        {
+            LOGE("查询服务的响应格式错误");
+            return false;
+        }
+        result.ok = true;
+        result.text = response.substr(newline + 1);
+        return true;
+    }
+#else
+    bool QueryServer::run()
+    {
+        LOGE("查询服务只支持POSIX系统");
+        return false;
+    }
+
+    void QueryServer::serveConnection(int)
+    {
+    }
+
+    bool sendQuery(const std::string&, const std::string&, QueryResult&)
+    {
+        LOGE("查询服务只支持POSIX系统");
+        return false;
+    }
+#endif
+}
@@ -0,0 +1,113 @@
+//
+// Created by DexDump on 2026-10-19.
+//
+
+#ifndef QUERYSERVER_H
+#define QUERYSERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/ContextCache.h"
+#include "formatter/OutputSink.h"
+
+namespace dex::server
+{
+    /**
+     * 请求的处理结果
+     * ok为true时text是输出内容，否则是单行错误信息
+     */
+    struct QueryResult
+    {
+        bool ok = false;
+        std::string text;
+    };
+
+    /**
+     * QueryServer - 常驻查询服务
+     * 在本地Unix域套接字上监听，按行接收请求，用ContextCache中已解析的文件回答，
+     * 避免反复解析同一组大文件。每个连接由有上限的工作线程处理，一个连接可以发送多条请求；
+     * 连接在10秒内没有发来完整的请求行时被关闭，空闲的客户端不会占满工作线程。
+     *
+     * 请求是一行以空白分隔的参数，含空白的参数用双引号括起（\"和\\转义）：
+     *   method <文件> <方法索引|Lcom/Foo;->bar>   方法代码，按名字时输出全部重载
+     *   line <文件> <方法> pc <地址>|line <行号>   地址所在的源代码行或源代码行的地址范围
+     *   catch <文件> <方法> <地址>                 覆盖地址的try块的异常处理器
+     *   string <文件> <文本> [最多条数]             包含文本的字符串
+     *   xrefs <文件> field|type <索引>...          字段访问点或类型使用点
+     *   stats <文件>                               统计信息
+     *   cache                                      缓存中的文件
+     *   ping                                       检查服务是否可用
+     *   quit                                       关闭连接
+     * 响应为 "OK <字节数>\n" 加上输出内容，或 "ERR <错误信息>\n"。
+     *
+     * 仅支持POSIX系统。
+     */
+    class QueryServer
+    {
+    public:
+        /**
+         * 构造函数
+         * @param socketPath 套接字路径
+         * @param memoryBudget 缓存的内存预算（字节），0表示不限制
+         * @param config 配置来源，每个文件的上下文复制其校验选项、快照目录和类过滤器
+         */
+        QueryServer(std::string socketPath, uint64_t memoryBudget, const DexContext& config);
+
+        // 设置同时处理的连接数，0表示使用硬件线程数
+        void setThreadCount(uint32_t threadCount);
+
+        /**
+         * 监听并处理连接，直到调用stop()
+         * 套接字路径上已有的失效套接字会被删除，已有服务在监听时失败
+         * @return 创建或监听套接字失败时返回false
+         */
+        bool run();
+
+        // 请求停止服务，可以在信号处理函数中调用
+        void stop();
+
+        /**
+         * 处理一条请求
+         * @param line 请求行，不含换行
+         * @return 处理结果
+         */
+        QueryResult handleRequest(std::string_view line);
+
+        /**
+         * 把请求行拆分为参数
+         * @param line 请求行
+         * @param args 输出参数，拆分后的参数
+         * @return 引号不匹配时返回false
+         */
+        static bool splitArguments(std::string_view line, std::vector<std::string>& args);
+
+        // 把参数拼接为请求行，必要时加引号
+        static std::string joinArguments(const std::vector<std::string>& args);
+
+    private:
+        // 处理一个连接上的全部请求
+        void serveConnection(int fd);
+
+        // 在已锁定并绑定的文件上执行请求
+        bool dispatch(const std::vector<std::string>& args, print::OutputSink& out);
+
+        std::string socketPath_;
+        ContextCache cache_;
+        uint32_t threadCount_ = 0;
+        std::atomic<bool> stopping_{false};
+    };
+
+    /**
+     * 向查询服务发送一条请求
+     * @param socketPath 套接字路径
+     * @param request 请求行，不含换行
+     * @param result 输出参数，服务返回的结果
+     * @return 连接失败或响应格式错误时返回false
+     */
+    bool sendQuery(const std::string& socketPath, const std::string& request, QueryResult& result);
+}
+
+#endif //QUERYSERVER_H
@@ -1,24 +1,869 @@
-// //
-// // Created by GaGa on 25-5-9.
-// //
-// #include <stdio.h>
-// #include <stdlib.h>
 //
+// Created by GaGa on 25-5-9.
 //
-// void UserMain()
-// {
-//
-// }
-// int main(int __argc, char* __argv[])
-// {
-//     while (true)
-//     {
-//         if (__argc < 0)
-//         {
-//             break;
-//         }
-//     }
-//
-//     UserMain();
-//     return 0;
-// }
+
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/BatchRunner.h"
+#include "core/DexDump.h"
+#include "core/PhaseStats.h"
+#include "formatter/ClassPrint.h"
+#include "formatter/CodePrint.h"
+#include "formatter/DebugInfoPrint.h"
+#include "formatter/FieldPrint.h"
+#include "formatter/HeaderPrint.h"
+#include "formatter/JsonPrint.h"
+#include "formatter/JsonWriter.h"
+#include "formatter/MethodPrint.h"
+#include "formatter/PhaseStatsPrint.h"
+#include "formatter/ProtoPrint.h"
+#include "formatter/SmaliPrint.h"
+#include "formatter/StatsPrint.h"
+#include "formatter/StringPrint.h"
+#include "formatter/TypePrint.h"
+#include "formatter/XrefPrint.h"
+#include "log/log.h"
+#include "server/QueryServer.h"
+
+namespace
+{
+    // 退出码
+    constexpr int kExitOk = 0;          // 全部文件处理成功
+    constexpr int kExitFailure = 1;     // 至少一个文件打开、解析或输出失败
+    constexpr int kExitUsage = 2;       // 命令行参数错误
+
+    constexpr const char* kVersion = "1.0.0";
+
+    constexpr const char* kDefaultSocket = "/tmp/dexdump.sock";
+    constexpr uint32_t kDefaultMemoryBudget = 1024;     // 查询服务的内存预算（MB）
+
+    enum class Command
+    {
+        Header,
+        Strings,
+        Types,
+        Protos,
+        Fields,
+        Methods,
+        Classes,
+        Code,
+        Debug,
+        Xrefs,
+        Stats,
+        Smali,
+        Serve,
+        Query,
+    };
+
+    struct CommandName
+    {
+        std::string_view name;
+        Command command;
+        const char* help;
+    };
+
+    constexpr CommandName kCommands[] = {
+        {"header", Command::Header, "头部信息"},
+        {"strings", Command::Strings, "字符串表"},
+        {"types", Command::Types, "类型表"},
+        {"protos", Command::Protos, "方法原型表"},
+        {"fields", Command::Fields, "字段表"},
+        {"methods", Command::Methods, "方法表"},
+        {"classes", Command::Classes, "类定义"},
+        {"code", Command::Code, "方法代码，--method指定单个方法"},
+        {"debug", Command::Debug, "调试信息，--method指定单个方法"},
+        {"xrefs", Command::Xrefs, "字段读写统计，--field/--type列出访问点"},
+        {"stats", Command::Stats, "统计信息"},
+        {"smali", Command::Smali, "smali反汇编，每个类一个文件，需要-o指定输出目录"},
+        {"serve", Command::Serve, "常驻查询服务，缓存已解析的文件，在--socket上按行接收请求"},
+        {"query", Command::Query, "向查询服务发送一条请求，例如 query method app.dex 12"},
+    };
+
+    // 命令行选项
+    struct Options
+    {
+        Command command = Command::Header;
+        bool json = false;
+        uint32_t threads = 0;
+        std::string output;
+        std::string snapshotDir;
+        bool verify = true;
+        LogLevel logLevel = LOG_LEVEL_WARNING;
+        dex::ClassFilter filter;
+        std::vector<uint32_t> methodIdxs;
+        std::vector<uint32_t> fieldIdxs;
+        std::vector<uint32_t> typeIdxs;
+        std::vector<std::string> files;
+        std::string filesFrom;
+        std::string socket = kDefaultSocket;
+        uint32_t memoryBudget = kDefaultMemoryBudget;
+        uint32_t cacheBudget = 0;
+        bool phaseStats = false;
+    };
+
+    void printUsage(FILE* out)
+    {
+        fprintf(out,
+                "用法: DexDump <命令> [选项] <DEX文件、APK或目录>...\n"
+                "      DexDump serve [--socket PATH] [--memory-budget MB] [-j N]\n"
+                "      DexDump query [--socket PATH] <请求>...\n\n命令:\n");
+        for (const CommandName& command : kCommands)
+        {
+            fprintf(out, "  %-10.*s%s\n", static_cast<int>(command.name.size()), command.name.data(), command.help);
+        }
+        fprintf(out,
+                "\n选项:\n"
+                "  -f, --format text|json   输出格式（默认text，json为JSON Lines）\n"
+                "  -j, --threads N          并行线程数，0表示使用硬件线程数（默认0）；批量处理时为同时处理的文件数\n"
+                "  -o, --output PATH        输出到文件（smali命令为输出目录），默认标准输出\n"
+                "      --files-from PATH    从文件逐行读取DEX路径，-表示标准输入\n"
+                "      --filter PATTERN     只处理匹配的类，可重复，例如com.ourco.或Lcom/ourco/**Activity;\n"
+                "      --method IDX         code/debug命令只输出指定方法，可重复\n"
+                "      --field IDX          xrefs命令列出字段的访问点，可重复\n"
+                "      --type IDX           xrefs命令列出类型的使用点，可重复\n"
+                "      --snapshot-dir DIR   使用解析快照目录\n"
+                "      --no-verify          不校验校验和与签名\n"
+                "      --stats              结束时向标准错误输出各阶段的耗时、CPU时间和吞吐量（-f json时为一条JSON记录）\n"
+                "      --socket PATH        查询服务的套接字路径（默认%s）\n"
+                "      --memory-budget MB   查询服务缓存的内存预算（默认%u）\n"
+                "      --cache-budget MB    每个文件解析缓存的内存预算（默认0，不限制）：超出时淘汰调试信息和try/catch信息，\n"
+                "                           debug、json等逐类输出和查询服务的请求之间还会淘汰类数据\n"
+                "  -v, --verbose            输出详细日志\n"
+                "  -q, --quiet              只输出错误日志\n"
+                "  -h, --help               显示帮助\n"
+                "      --version            显示版本\n"
+                "\n多个文件、APK（处理其中全部classes*.dex）、目录（递归查找.dex和.apk）或路径列表按批量处理，输出按输入顺序汇总，结束时报告吞吐量。\n"
+                "\n查询服务的请求:\n"
+                "  method <文件> <方法索引|Lcom/Foo;->bar>  方法代码\n"
+                "  line <文件> <方法> pc <地址>|line <行号> 地址所在的源代码行或源代码行的地址范围\n"
+                "  catch <文件> <方法> <地址>               覆盖地址的try块的异常处理器\n"
+                "  string <文件> <文本> [最多条数]           包含文本的字符串\n"
+                "  xrefs <文件> field|type <索引>...        字段访问点或类型使用点\n"
+                "  stats <文件>                             统计信息\n"
+                "  cache                                    缓存中的文件\n"
+                "\n退出码: 0 成功, 1 文件处理失败, 2 参数错误\n",
+                kDefaultSocket, kDefaultMemoryBudget);
+    }
+
+    // 解析无符号十进制数，必须完整消耗文本
+    bool parseIndex(std::string_view text, uint32_t& value)
+    {
+        const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return ec == std::errc() && ptr == text.data() + text.size() && !text.empty();
+    }
+
+    /**
+     * 解析命令行
+     * @return 解析成功返回-1，否则返回进程退出码
+     */
+    int parseArguments(int argc, char* argv[], Options& options)
+    {
+        bool hasCommand = false;
+        bool endOfOptions = false;
+
+        for (int i = 1; i < argc; i++)
+        {
+            std::string_view arg = argv[i];
+
+            // 位置参数：第一个是命令，其余是文件
+            if (endOfOptions || arg.size() < 2 || arg[0] != '-')
+            {
+                if (hasCommand)
+                {
+                    options.files.emplace_back(arg);
+                    continue;
+                }
+                const CommandName* found = nullptr;
+                for (const CommandName& command : kCommands)
+                {
+                    if (command.name == arg)
+                    {
+                        found = &command;
+                        break;
+                    }
+                }
+                if (found == nullptr)
+                {
+                    fprintf(stderr, "未知命令: %.*s\n", static_cast<int>(arg.size()), arg.data());
+                    return kExitUsage;
+                }
+                options.command = found->command;
+                hasCommand = true;
+                continue;
+            }
+
+            if (arg == "--")
+            {
+                endOfOptions = true;
+                continue;
+            }
+
+            // 支持 --name=value 和 --name value 两种写法
+            std::string_view value;
+            bool hasInlineValue = false;
+            if (arg.starts_with("--"))
+            {
+                if (const size_t eq = arg.find('='); eq != std::string_view::npos)
+                {
+                    value = arg.substr(eq + 1);
+                    arg = arg.substr(0, eq);
+                    hasInlineValue = true;
+                }
+            }
+            const auto takeValue = [&]() -> bool
+            {
+                if (hasInlineValue)
+                {
+                    return true;
+                }
+                if (i + 1 >= argc)
+                {
+                    fprintf(stderr, "选项 %.*s 缺少参数\n", static_cast<int>(arg.size()), arg.data());
+                    return false;
+                }
+                value = argv[++i];
+                return true;
+            };
+            const auto takeIndex = [&](std::vector<uint32_t>& target) -> bool
+            {
+                uint32_t index = 0;
+                if (!takeValue())
+                {
+                    return false;
+                }
+                if (!parseIndex(value, index))
+                {
+                    fprintf(stderr, "无效的索引: %.*s\n", static_cast<int>(value.size()), value.data());
+                    return false;
+                }
+                target.push_back(index);
+                return true;
+            };
+
+            if (arg == "-h" || arg == "--help")
+            {
+                printUsage(stdout);
+                return kExitOk;
+            }
+            if (arg == "--version")
+            {
+                printf("DexDump %s\n", kVersion);
+                return kExitOk;
+            }
+            if (arg == "-f" || arg == "--format")
+            {
+                if (!takeValue())
+                {
+                    return kExitUsage;
+                }
+                if (value != "text" && value != "json")
+                {
+                    fprintf(stderr, "未知输出格式: %.*s\n", static_cast<int>(value.size()), value.data());
+                    return kExitUsage;
+                }
+                options.json = value == "json";
+            }
+            else if (arg == "-j" || arg == "--threads")
+            {
+                if (!takeValue())
+                {
+                    return kExitUsage;
+                }
+                if (!parseIndex(value, options.threads))
+                {
+                    fprintf(stderr, "无效的线程数: %.*s\n", static_cast<int>(value.size()), value.data());
+                    return kExitUsage;
+                }
+            }
+            else if (arg == "-o" || arg == "--output")
+            {
+                if (!takeValue())
+                {
+                    return kExitUsage;
+                }
+                options.output = value;
+            }
+            else if (arg == "--filter")
+            {
+                if (!takeValue())
+                {
+                    return kExitUsage;
+                }
+                if (!options.filter.addPattern(value))
+                {
+                    fprintf(stderr, "类过滤模式不能为空\n");
+                    return kExitUsage;
+                }
+            }
+            else if (arg == "--method")
+            {
+                if (!takeIndex(options.methodIdxs))
+                {
+                    return kExitUsage;
+                }
+            }
+            else if (arg == "--field")
+            {
+                if (!takeIndex(options.fieldIdxs))
+                {
+                    return kExitUsage;
+                }
+            }
+            else if (arg == "--type")
+            {
+                if (!takeIndex(options.typeIdxs))
+                {
+                    return kExitUsage;
+                }
+            }
+            else if (arg == "--files-from")
+            {
+                if (!takeValue())
+                {
+                    return kExitUsage;
+                }
+                options.filesFrom = value;
+            }
+            else if (arg == "--snapshot-dir")
+            {
+                if (!takeValue())
+                {
+                    return kExitUsage;
+                }
+                options.snapshotDir = value;
+            }
+            else if (arg == "--socket")
+            {
+                if (!takeValue())
+                {
+                    return kExitUsage;
+                }
+                options.socket = value;
+            }
+            else if (arg == "--memory-budget")
+            {
+                if (!takeValue())
+                {
+                    return kExitUsage;
+                }
+                if (!parseIndex(value, options.memoryBudget))
+                {
+                    fprintf(stderr, "无效的内存预算: %.*s\n", static_cast<int>(value.size()), value.data());
+                    return kExitUsage;
+                }
+            }
+            else if (arg == "--cache-budget")
+            {
+                if (!takeValue())
+                {
+                    return kExitUsage;
+                }
+                if (!parseIndex(value, options.cacheBudget))
+                {
+                    fprintf(stderr, "无效的缓存预算: %.*s\n", static_cast<int>(value.size()), value.data());
+                    return kExitUsage;
+                }
+            }
+            else if (arg == "--stats" && !hasInlineValue)
+            {
+                options.phaseStats = true;
+            }
+            else if (arg == "--no-verify" && !hasInlineValue)
+            {
+                options.verify = false;
+            }
+            else if ((arg == "-v" || arg == "--verbose") && !hasInlineValue)
+            {
+                options.logLevel = LOG_LEVEL_INFO;
+            }
+            else if ((arg == "-q" || arg == "--quiet") && !hasInlineValue)
+            {
+                options.logLevel = LOG_LEVEL_ERROR;
+            }
+            else
+            {
+                fprintf(stderr, "未知选项: %s\n", argv[i]);
+                return kExitUsage;
+            }
+        }
+
+        if (!hasCommand)
+        {
+            printUsage(stderr);
+            return kExitUsage;
+        }
+        if (options.command == Command::Serve)
+        {
+            if (!options.files.empty() || !options.filesFrom.empty())
+            {
+                fprintf(stderr, "serve命令不接受文件参数，文件在请求中指定\n");
+                return kExitUsage;
+            }
+            return -1;
+        }
+        if (options.command == Command::Query)
+        {
+            if (options.files.empty())
+            {
+                fprintf(stderr, "缺少请求参数\n");
+                return kExitUsage;
+            }
+            return -1;
+        }
+        if (options.files.empty() && options.filesFrom.empty())
+        {
+            fprintf(stderr, "缺少DEX文件参数\n");
+            return kExitUsage;
+        }
+
+        // 检查命令与选项的组合
+        if (!options.methodIdxs.empty() && options.command != Command::Code && options.command != Command::Debug)
+        {
+            fprintf(stderr, "--method只能用于code和debug命令\n");
+            return kExitUsage;
+        }
+        if ((!options.fieldIdxs.empty() || !options.typeIdxs.empty()) && options.command != Command::Xrefs)
+        {
+            fprintf(stderr, "--field和--type只能用于xrefs命令\n");
+            return kExitUsage;
+        }
+        if (options.json && (options.command == Command::Xrefs || options.command == Command::Smali ||
+                             !options.methodIdxs.empty()))
+        {
+            fprintf(stderr, "该命令不支持json格式\n");
+            return kExitUsage;
+        }
+        if (options.command == Command::Smali && options.output.empty())
+        {
+            fprintf(stderr, "smali命令需要用-o指定输出目录\n");
+            return kExitUsage;
+        }
+
+        return -1;
+    }
+
+    // 以JSON Lines格式输出当前文件
+    void runJson(const Options& options, dex::print::OutputSink& out)
+    {
+        if (options.command == Command::Stats)
+        {
+            dex::print::StatsPrint stats_print{true};
+            stats_print.setSink(out);
+            stats_print.print();
+            return;
+        }
+
+        dex::print::JsonPrint json_print{};
+        json_print.setSink(out);
+        switch (options.command)
+        {
+            case Command::Header: json_print.printHeader(); break;
+            case Command::Strings: json_print.printStrings(); break;
+            case Command::Types: json_print.printTypes(); break;
+            case Command::Protos: json_print.printProtos(); break;
+            case Command::Fields: json_print.printFields(); break;
+            case Command::Methods: json_print.printMethods(); break;
+            case Command::Classes: json_print.printClasses(); break;
+            case Command::Code: json_print.printCode(); break;
+            case Command::Debug: json_print.printDebugInfo(); break;
+            default: break;
+        }
+        out.flush();
+    }
+
+    /**
+     * 以文本格式输出当前文件
+     * @return 指定的方法无效时返回false
+     */
+    bool runText(const Options& options, dex::print::OutputSink& out)
+    {
+        bool ok = true;
+        switch (options.command)
+        {
+            case Command::Header:
+            {
+                dex::print::HeaderPrint header_print{};
+                header_print.setSink(out);
+                header_print.print();
+                break;
+            }
+            case Command::Strings:
+            {
+                dex::print::StringPrint string_print{};
+                string_print.setSink(out);
+                string_print.print();
+                break;
+            }
+            case Command::Types:
+            {
+                dex::print::TypePrint type_print{};
+                type_print.setSink(out);
+                type_print.print();
+                break;
+            }
+            case Command::Protos:
+            {
+                dex::print::ProtoPrint proto_print{};
+                proto_print.setSink(out);
+                proto_print.print();
+                break;
+            }
+            case Command::Fields:
+            {
+                dex::print::FieldPrint field_print{};
+                field_print.setSink(out);
+                field_print.print();
+                break;
+            }
+            case Command::Methods:
+            {
+                dex::print::MethodPrint method_print{};
+                method_print.setSink(out);
+                method_print.print();
+                break;
+            }
+            case Command::Classes:
+            {
+                dex::print::ClassPrint class_print{};
+                class_print.setSink(out);
+                class_print.print();
+                break;
+            }
+            case Command::Code:
+            {
+                dex::print::CodePrint code_print{};
+                code_print.setSink(out);
+                if (options.methodIdxs.empty())
+                {
+                    code_print.print();
+                    break;
+                }
+                for (const uint32_t methodIdx : options.methodIdxs)
+                {
+                    if (!dex::DexDump::parseCode(methodIdx))
+                    {
+                        LOGE("解析方法 %u 的代码失败", methodIdx);
+                        ok = false;
+                        continue;
+                    }
+                    code_print.printMethodCode(methodIdx);
+                    dex::DexContext::getInstance().trimCaches();
+                }
+                break;
+            }
+            case Command::Debug:
+            {
+                dex::print::DebugInfoPrint debug_print{};
+                debug_print.setSink(out);
+                if (options.methodIdxs.empty())
+                {
+                    debug_print.print();
+                    break;
+                }
+                for (const uint32_t methodIdx : options.methodIdxs)
+                {
+                    if (!dex::DexDump::parseDebugInfo(methodIdx))
+                    {
+                        LOGE("解析方法 %u 的调试信息失败", methodIdx);
+                        ok = false;
+                        continue;
+                    }
+                    debug_print.printMethodDebugInfo(methodIdx);
+                    dex::DexContext::getInstance().trimCaches();
+                }
+                break;
+            }
+            case Command::Xrefs:
+            {
+                if (options.fieldIdxs.empty() && options.typeIdxs.empty())
+                {
+                    dex::print::FieldPrint field_print{true};
+                    field_print.setSink(out);
+                    field_print.print();
+                    break;
+                }
+                dex::print::XrefPrint xref_print{options.fieldIdxs, options.typeIdxs};
+                xref_print.setSink(out);
+                xref_print.print();
+                break;
+            }
+            case Command::Stats:
+            {
+                dex::print::StatsPrint stats_print{};
+                stats_print.setSink(out);
+                stats_print.print();
+                break;
+            }
+            case Command::Smali:
+            {
+                dex::print::SmaliPrint smali_print{options.output};
+                smali_print.setSink(out);
+                smali_print.print();
+                break;
+            }
+            case Command::Serve:
+            case Command::Query:
+                // 查询服务的命令在main中处理，不输出文件
+                break;
+        }
+        out.flush();
+        return ok;
+    }
+
+    /**
+     * 按输出格式输出当前文件，计入format阶段
+     * @param parallel 文件内部是否并行，为true时统计进程所有线程的CPU时间
+     * @return 指定的方法无效时返回false
+     */
+    bool runFormat(const Options& options, dex::print::OutputSink& out, bool parallel)
+    {
+        dex::PhaseTimer timer(dex::Phase::Format, parallel);
+        const uint64_t start = out.bytesWritten();
+        bool ok = true;
+        if (options.json)
+        {
+            runJson(options, out);
+        }
+        else
+        {
+            ok = runText(options, out);
+        }
+        timer.addBytes(out.bytesWritten() - start);
+        timer.addItems(1);
+        return ok;
+    }
+
+    // 收到SIGINT/SIGTERM时停止的查询服务
+    dex::server::QueryServer* g_server = nullptr;
+
+    void stopServer(int)
+    {
+        if (g_server != nullptr)
+        {
+            g_server->stop();
+        }
+    }
+
+    // 运行查询服务直到收到SIGINT或SIGTERM
+    int runServer(const Options& options, const dex::DexContext& config)
+    {
+        dex::server::QueryServer server(options.socket, static_cast<uint64_t>(options.memoryBudget) * 1024 * 1024,
+                                        config);
+        server.setThreadCount(options.threads);
+        g_server = &server;
+        signal(SIGINT, stopServer);
+        signal(SIGTERM, stopServer);
+        const bool ok = server.run();
+        g_server = nullptr;
+        return ok ? kExitOk : kExitFailure;
+    }
+
+    // 发送一条请求，输出写到标准输出，错误写到标准错误
+    int runQuery(const Options& options)
+    {
+        // 相对路径按客户端的工作目录解析，服务的工作目录可能不同
+        std::vector<std::string> args = options.files;
+        if (args.size() >= 2 && args[0] != "cache" && args[0] != "ping")
+        {
+            std::error_code ec;
+            if (const std::filesystem::path absolute = std::filesystem::absolute(args[1], ec); !ec)
+            {
+                args[1] = absolute.string();
+            }
+        }
+
+        dex::server::QueryResult result;
+        if (!dex::server::sendQuery(options.socket, dex::server::QueryServer::joinArguments(args), result))
+        {
+            return kExitFailure;
+        }
+        if (!result.ok)
+        {
+            fprintf(stderr, "%s\n", result.text.c_str());
+            return kExitFailure;
+        }
+        if (fwrite(result.text.data(), 1, result.text.size(), stdout) != result.text.size() || fflush(stdout) != 0)
+        {
+            LOGE("写入输出失败: %s", strerror(errno));
+            return kExitFailure;
+        }
+        return kExitOk;
+    }
+
+    // 批量处理时在每个文件的输出前标注文件名，失败的文件附上捕获的日志
+    void writeFileHeader(const Options& options, const dex::BatchFile& file, dex::print::OutputSink& out)
+    {
+        if (options.json)
+        {
+            dex::print::JsonWriter json(out);
+            json.beginObject();
+            json.field("kind", "file");
+            json.field("path", file.path);
+            json.key("ok");
+            json.value(file.opened);
+            if (!file.opened)
+            {
+                json.field("error", file.log);
+            }
+            json.endObject();
+            return;
+        }
+
+        out.write("==> ");
+        out.write(file.path);
+        out.write(" <==\n");
+        if (!file.opened)
+        {
+            out.write("处理失败\n");
+            out.write(file.log);
+        }
+    }
+
+    // 写出全部输出，写入失败（例如磁盘已满、管道已关闭）时报告错误
+    bool finishOutput(dex::print::OutputSink& out)
+    {
+        if (out.finish())
+        {
+            return true;
+        }
+        LOGE("写入输出失败: %s", strerror(out.getWriteError()));
+        return false;
+    }
+
+    /**
+     * 展开输入并处理全部文件
+     * @param total 整个运行过程的计时，记录输入的字节数和文件数
+     * @return 进程退出码
+     */
+    int processFiles(const Options& options, dex::PhaseTimer& total)
+    {
+        // 展开目录、APK和路径列表；只有一个DEX文件参数时单独处理，文件内部并行
+        std::vector<std::string> files;
+        if (!dex::BatchRunner::collectInputs(options.files, options.filesFrom, files))
+        {
+            return kExitFailure;
+        }
+        const bool batch = options.files.size() != 1 || !options.filesFrom.empty() || files.size() != 1 ||
+                           files.front() != options.files.front();
+        if (files.empty())
+        {
+            LOGE("没有找到DEX文件");
+            return kExitFailure;
+        }
+
+        // smali命令的-o是输出目录，汇总仍写到标准输出
+        std::unique_ptr<dex::print::FileSink> file_sink;
+        if (!options.output.empty() && options.command != Command::Smali)
+        {
+            file_sink = dex::print::FileSink::open(options.output.c_str());
+            if (file_sink == nullptr)
+            {
+                LOGE("无法创建输出文件: %s", options.output.c_str());
+                return kExitFailure;
+            }
+        }
+        dex::print::OutputSink& out = file_sink != nullptr ? *file_sink : dex::print::OutputSink::stdoutSink();
+
+        if (!batch)
+        {
+            dex::DexDump dex_dump{};
+            if (!dex_dump.open(files.front().c_str()))
+            {
+                LOGE("打开DEX文件失败: %s", files.front().c_str());
+                return kExitFailure;
+            }
+
+            total.addBytes(dex::DexContext::getInstance().getFileSize());
+            total.addItems(1);
+            const bool ok = runFormat(options, out, true);
+            dex_dump.close();
+            if (!finishOutput(out))
+            {
+                return kExitFailure;
+            }
+            return ok ? kExitOk : kExitFailure;
+        }
+
+        // 批量处理：线程数为同时处理的文件数
+        dex::BatchRunner runner(dex::DexContext::getInstance());
+        runner.setThreadCount(options.threads);
+        const dex::BatchStats stats = runner.run(
+            files, out,
+            [&options](const dex::BatchFile& file, dex::print::OutputSink& sink)
+            {
+                writeFileHeader(options, file, sink);
+                if (!file.opened)
+                {
+                    return false;
+                }
+                return runFormat(options, sink, false);
+            });
+        const bool written = finishOutput(out);
+        total.addBytes(stats.bytes);
+        total.addItems(stats.files);
+
+        if (options.logLevel <= LOG_LEVEL_WARNING)
+        {
+            fprintf(stderr, "共处理 %zu 个文件，失败 %zu 个，%.1f MB，耗时 %.2f 秒，%.1f 文件/秒，%.1f MB/秒\n",
+                    stats.files, stats.failed, static_cast<double>(stats.bytes) / (1024.0 * 1024.0), stats.seconds,
+                    stats.filesPerSecond(), stats.megabytesPerSecond());
+        }
+        return stats.failed == 0 && written ? kExitOk : kExitFailure;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (const int result = parseArguments(argc, argv, options); result >= 0)
+    {
+        return result;
+    }
+
+    log_set_level(options.logLevel);
+    dex::PhaseStats::setEnabled(options.phaseStats);
+
+    // 全局上下文配置在打开文件之间保留，批量处理时复制到每个文件的上下文
+    dex::DexContext& context = dex::DexContext::getInstance();
+    context.setThreadCount(options.threads);
+    context.setVerifyChecksum(options.verify);
+    context.setVerifySignature(options.verify);
+    context.setSnapshotDir(options.snapshotDir);
+    context.setClassFilter(options.filter);
+    context.setMemoryBudget(static_cast<uint64_t>(options.cacheBudget) * 1024 * 1024);
+
+    if (options.command == Command::Serve)
+    {
+        return runServer(options, context);
+    }
+    if (options.command == Command::Query)
+    {
+        return runQuery(options);
+    }
+
+    int result;
+    {
+        dex::PhaseTimer total(dex::Phase::Total, true);
+        result = processFiles(options, total);
+    }
+
+    // 阶段耗时写到标准错误，不与输出混在一起
+    if (options.phaseStats)
+    {
+        dex::print::FileSink err_sink(stderr);
+        dex::print::PhaseStatsPrint phase_stats_print{options.json};
+        phase_stats_print.setSink(err_sink);
+        phase_stats_print.print();
+    }
+    return result;
+}